@@ -0,0 +1,9 @@
+(set-info :status unsat)
+(set-option :auto-config true)
+(set-option :numeral-as-real true)
+(declare-const a Real)
+(declare-const b Real)
+(assert (and true (< 6 a)))
+(assert (and true))
+(assert (not (and true (<= (/ 4828571480782314523591505305683696980806790994672643118087958323994856042048706993557178293550717861921803082460887104880772439164391299315536111175767904 2657265551368037740521402587869827479141609411093451579245177658718543544818598739287511620306598197444731605977610879278167230404574613696517112789739489) (^ a (/ 1.0 3.0))))))
+(check-sat)
@@ -0,0 +1,9 @@
+(set-info :status unsat)
+(set-option :auto-config true)
+(set-option :numeral-as-real true)
+(declare-const a Real)
+(declare-const b Real)
+(assert (and true (< 1 a)))
+(assert (and true (< 1 b) (<= b 4)))
+(assert (not (and true (< (/ 1 4) (/ a b)))))
+(check-sat)
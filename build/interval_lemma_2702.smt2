@@ -0,0 +1,9 @@
+(set-info :status unsat)
+(set-option :auto-config true)
+(set-option :numeral-as-real true)
+(declare-const a Real)
+(declare-const b Real)
+(assert (and true (< (- 9) a)))
+(assert (and true))
+(assert (not (and true (<= (- (/ 23401 11250)) (^ a (/ 1.0 3.0))))))
+(check-sat)
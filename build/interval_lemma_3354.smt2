@@ -0,0 +1,9 @@
+(set-info :status unsat)
+(set-option :auto-config true)
+(set-option :numeral-as-real true)
+(declare-const a Real)
+(declare-const b Real)
+(assert (and true (<= 5 a)))
+(assert (and true))
+(assert (not (and true (<= (/ 24256016288979677371623289629989957305321848578988783337439450456488411128939915671504147995483527106361572299569527762877816257507831848647326890720391212519648515097645 14185004445585091692871357361988954575723645772779677766331228797645983753074604509478920954370729132841178740783062370687234091586395227058339461722779104240445660434449) (^ a (/ 1.0 3.0))))))
+(check-sat)
@@ -0,0 +1,9 @@
+(set-info :status unsat)
+(set-option :auto-config true)
+(set-option :numeral-as-real true)
+(declare-const a Real)
+(declare-const b Real)
+(assert (and true (< (- 7) a)))
+(assert (and true))
+(assert (not (and true (<= (- (/ 667417843030861460871117011057178743900690137565953583 348897832681285299252716073832768355331787856189290281)) (^ a (/ 1.0 3.0))))))
+(check-sat)
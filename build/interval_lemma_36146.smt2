@@ -0,0 +1,9 @@
+(set-info :status unsat)
+(set-option :auto-config true)
+(set-option :numeral-as-real true)
+(declare-const a Real)
+(declare-const b Real)
+(assert (and true (< (- 1) a) (< a 1)))
+(assert (and true (<= (- 1) b) (<= b 3)))
+(assert (not (and true (< (- 3) (* a b)))))
+(check-sat)
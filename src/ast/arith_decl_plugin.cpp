@@ -75,6 +75,7 @@ algebraic_numbers::manager & arith_decl_plugin::am() const {
 }
 
 app * arith_decl_plugin::mk_numeral(algebraic_numbers::anum const & val, bool is_int) {
+    ast_manager::scoped_lock l(*m_manager);
     if (am().is_rational(val)) {
         rational rval;
         am().to_rational(val, rval);
@@ -416,6 +417,7 @@ inline decl_kind arith_decl_plugin::fix_kind(decl_kind k, unsigned arity) {
 #define MAX_SMALL_NUM_TO_CACHE 16
 
 app * arith_decl_plugin::mk_numeral(rational const & val, bool is_int) {
+    ast_manager::scoped_lock l(*m_manager);
     if (is_int && !val.is_int()) {
         m_manager->raise_exception("invalid rational value passed as an integer");
     }
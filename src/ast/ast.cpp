@@ -610,6 +610,73 @@ void ast_table::erase(ast * n) {
     }
 }
 
+concurrent_ast_table::concurrent_ast_table() {
+    m_stripes = alloc_vect<stripe>(c_num_stripes);
+}
+
+concurrent_ast_table::~concurrent_ast_table() {
+    dealloc_vect(m_stripes, c_num_stripes);
+}
+
+bool concurrent_ast_table::contains(ast * n) const {
+    stripe & s = get_stripe(n);
+    omp_set_lock(&s.m_lock);
+    bool r = s.m_table.contains(n);
+    omp_unset_lock(&s.m_lock);
+    return r;
+}
+
+void concurrent_ast_table::erase(ast * n) {
+    stripe & s = get_stripe(n);
+    omp_set_lock(&s.m_lock);
+    s.m_table.erase(n);
+    omp_unset_lock(&s.m_lock);
+}
+
+unsigned concurrent_ast_table::size() const {
+    unsigned r = 0;
+    for (unsigned i = 0; i < c_num_stripes; i++)
+        r += m_stripes[i].m_table.size();
+    return r;
+}
+
+void concurrent_ast_table::push_zombie(ast * n) {
+    stripe & s = get_stripe(n);
+    omp_set_lock(&s.m_lock);
+    s.m_zombies.insert(n);
+    omp_unset_lock(&s.m_lock);
+}
+
+void concurrent_ast_table::get_zombies(ptr_vector<ast> & r) {
+    for (unsigned i = 0; i < c_num_stripes; i++) {
+        obj_hashtable<ast> & zs = m_stripes[i].m_zombies;
+        obj_hashtable<ast>::iterator it  = zs.begin();
+        obj_hashtable<ast>::iterator end = zs.end();
+        for (; it != end; ++it)
+            r.push_back(*it);
+        zs.finalize();
+    }
+}
+
+void concurrent_ast_table::move_from(ast_table & t) {
+    ast_table::iterator it  = t.begin();
+    ast_table::iterator end = t.end();
+    for (; it != end; ++it)
+        get_stripe(*it).m_table.insert(*it);
+    t.finalize();
+}
+
+void concurrent_ast_table::move_to(ast_table & t) {
+    for (unsigned i = 0; i < c_num_stripes; i++) {
+        ast_table & s = m_stripes[i].m_table;
+        ast_table::iterator it  = s.begin();
+        ast_table::iterator end = s.end();
+        for (; it != end; ++it)
+            t.insert(*it);
+        s.finalize();
+    }
+}
+
 // -----------------------------------
 //
 // decl_plugin
@@ -1306,6 +1373,9 @@ ast_manager::ast_manager(ast_manager const & src, bool disable_proofs):
 }
 
 void ast_manager::init() {
+    m_concurrent = false;
+    m_concurrent_ast_table = 0;
+    omp_init_nest_lock(&m_lock);
     m_int_real_coercions = true;
     m_debug_ref_count = false;
     m_fresh_id = 0;
@@ -1338,6 +1408,7 @@ void ast_manager::init() {
 
 ast_manager::~ast_manager() {
     SASSERT(is_format_manager() || !m_family_manager.has_family(symbol("format")));
+    enable_concurrency(false);
 
     dec_ref(m_bool_sort);
     dec_ref(m_proof_sort);
@@ -1384,6 +1455,46 @@ ast_manager::~ast_manager() {
         dealloc(m_trace_stream);
         m_trace_stream = 0;
     }
+    if (m_concurrent_ast_table != 0)
+        dealloc(m_concurrent_ast_table);
+    omp_destroy_nest_lock(&m_lock);
+}
+
+void ast_manager::enable_concurrency(bool f) {
+    if (m_concurrent == f)
+        return;
+    if (f) {
+        if (m_concurrent_ast_table == 0)
+            m_concurrent_ast_table = alloc(concurrent_ast_table);
+        m_concurrent_ast_table->move_from(m_ast_table);
+    }
+    else {
+        collect_zombies();
+        m_concurrent_ast_table->move_to(m_ast_table);
+    }
+    m_concurrent = f;
+}
+
+void ast_manager::collect_zombies() {
+    if (!m_concurrent)
+        return;
+    ptr_vector<ast> zombies;
+    m_concurrent_ast_table->get_zombies(zombies);
+    // A zombie may have been resurrected, and it may be a child of another zombie
+    // (e.g., it was resurrected by the creation of the other one). Thus, deleting a zombie
+    // may delete other zombies. The zombies are protected by an extra reference while
+    // they are processed, and the last dec_ref deletes them.
+    // No other thread is using the manager, so the reference counters are updated
+    // without atomic operations, and the nodes are deleted immediately.
+    ptr_vector<ast>::iterator it  = zombies.begin();
+    ptr_vector<ast>::iterator end = zombies.end();
+    for (; it != end; ++it)
+        (*it)->inc_ref();
+    for (it = zombies.begin(); it != end; ++it) {
+        (*it)->dec_ref();
+        if ((*it)->get_ref_count() == 0)
+            delete_node(*it);
+    }
 }
 
 void ast_manager::set_cancel(bool f) {
@@ -1574,11 +1685,12 @@ bool ast_manager::slow_not_contains(ast const * n) {
 #endif
 
 ast * ast_manager::register_node_core(ast * n) {
+    n->m_heap_allocated = m_concurrent;
     unsigned h = get_node_hash(n); 
     n->m_hash = h;
 #ifdef Z3DEBUG
-    bool contains = m_ast_table.contains(n);
-    CASSERT("nondet_bug", contains || slow_not_contains(n));
+    bool contains = this->contains(n);
+    CASSERT("nondet_bug", contains || m_concurrent || slow_not_contains(n));
 #endif
 
 #if 0
@@ -1588,7 +1700,20 @@ ast * ast_manager::register_node_core(ast * n) {
         verbose_stream() << "[ast-table] counter: " << counter << " collisions: " << m_ast_table.collisions() << " capacity: " << m_ast_table.capacity() << " size: " << m_ast_table.size() << "\n";
 #endif
 
-    ast * r = m_ast_table.insert_if_not_there(n);
+    ast * r;
+    if (m_concurrent) {
+        // n is initialized before the stripe is unlocked, otherwise
+        // another thread could use it before its id, flags and children are set.
+        concurrent_ast_table::scoped_stripe_lock l(*m_concurrent_ast_table, n);
+        r = l.insert_if_not_there(n);
+        if (r == n) {
+            init_node(n);
+            return n;
+        }
+    }
+    else {
+        r = m_ast_table.insert_if_not_there(n);
+    }
     SASSERT(r->m_hash == h);
     if (r != n) {
 #if 0
@@ -1597,8 +1722,8 @@ ast * ast_manager::register_node_core(ast * n) {
         if (reused % 100000 == 0)
             verbose_stream() << "[ast-table] reused: " << reused << "\n";
 #endif
-        SASSERT(contains);
-        SASSERT(m_ast_table.contains(n));
+        SASSERT(contains || m_concurrent);
+        SASSERT(this->contains(n));
         if (is_func_decl(r) && to_func_decl(r)->get_range() != to_func_decl(n)->get_range()) {
             std::ostringstream buffer;
             buffer << "Recycling of declaration for the same name '" << to_func_decl(r)->get_name().str().c_str() << "'"
@@ -1608,12 +1733,20 @@ ast * ast_manager::register_node_core(ast * n) {
         deallocate_node(n, ::get_node_size(n));
         return r;
     }
-    else {
-        SASSERT(!contains);
-        SASSERT(m_ast_table.contains(n));
-    }
+    SASSERT(!contains);
+    SASSERT(this->contains(n));
+    init_node(n);
+    return n;
+}
 
-    n->m_id   = is_decl(n) ? m_decl_id_gen.mk() : m_expr_id_gen.mk();
+/**
+   \brief Set the id and flags of a new node, and increment the reference counters of its children.
+*/
+void ast_manager::init_node(ast * n) {
+    if (m_concurrent)
+        n->m_id = is_decl(n) ? m_decl_id_gen.mk_atomic() : m_expr_id_gen.mk_atomic();
+    else
+        n->m_id = is_decl(n) ? m_decl_id_gen.mk() : m_expr_id_gen.mk();
 
     TRACE("ast", tout << "Object " << n->m_id << " was created.\n";);
     TRACE("mk_var_bug", tout << "mk_ast: " << n->m_id << "\n";);
@@ -1697,7 +1830,6 @@ ast * ast_manager::register_node_core(ast * n) {
     default:
 	break;
     }
-    return n;
 }
 
 void ast_manager::delete_node(ast * n) {
@@ -1714,9 +1846,12 @@ void ast_manager::delete_node(ast * n) {
         TRACE("mk_var_bug", tout << "del_ast: " << n->m_id << "\n";);
         TRACE("ast_delete_node", tout << mk_bounded_pp(n, *this) << "\n";);
 
-        SASSERT(m_ast_table.contains(n));
-        m_ast_table.erase(n);
-        SASSERT(!m_ast_table.contains(n));
+        SASSERT(contains(n));
+        if (m_concurrent)
+            m_concurrent_ast_table->erase(n);
+        else
+            m_ast_table.erase(n);
+        SASSERT(!contains(n));
         SASSERT(!m_debug_ref_count || !m_debug_free_indices.contains(n->m_id));
 
 #ifdef RECYCLE_FREE_AST_INDICES
@@ -1768,6 +1903,7 @@ void ast_manager::delete_node(ast * n) {
 }
 
 sort * ast_manager::mk_sort(family_id fid, decl_kind k, unsigned num_parameters, parameter const * parameters) {
+    scoped_lock l(*this);
     decl_plugin * p = get_plugin(fid);
     if (p)
         return p->mk_sort(k, num_parameters, parameters);
@@ -1776,6 +1912,7 @@ sort * ast_manager::mk_sort(family_id fid, decl_kind k, unsigned num_parameters,
     
 func_decl * ast_manager::mk_func_decl(family_id fid, decl_kind k, unsigned num_parameters, parameter const * parameters,
                                       unsigned arity, sort * const * domain, sort * range) {
+    scoped_lock l(*this);
     decl_plugin * p = get_plugin(fid);
     if (p)
         return p->mk_func_decl(k, num_parameters, parameters, arity, domain, range);
@@ -1784,6 +1921,7 @@ func_decl * ast_manager::mk_func_decl(family_id fid, decl_kind k, unsigned num_p
 
 func_decl * ast_manager::mk_func_decl(family_id fid, decl_kind k, unsigned num_parameters, parameter const * parameters, 
                                       unsigned num_args, expr * const * args, sort * range) {
+    scoped_lock l(*this);
     decl_plugin * p = get_plugin(fid);
     if (p)
         return p->mk_func_decl(k, num_parameters, parameters, num_args, args, range);
@@ -1824,6 +1962,7 @@ sort * ast_manager::mk_sort(symbol const & name, sort_info * info) {
 }
 
 sort * ast_manager::mk_uninterpreted_sort(symbol const & name, unsigned num_parameters, parameter const * parameters) {
+    scoped_lock l(*this);
     user_sort_plugin * plugin = get_user_sort_plugin();
     decl_kind kind = plugin->register_name(name);
     return plugin->mk_sort(kind, num_parameters, parameters);
@@ -2060,6 +2199,7 @@ app * ast_manager::mk_app(func_decl * decl, unsigned num_args, expr * const * ar
 
 func_decl * ast_manager::mk_fresh_func_decl(symbol const & prefix, symbol const & suffix, unsigned arity, 
                                             sort * const * domain, sort * range) {
+    scoped_lock l(*this);
     func_decl_info info(null_family_id, null_decl_kind);
     info.m_skolem = true;
     SASSERT(info.is_skolem());
@@ -2085,6 +2225,7 @@ func_decl * ast_manager::mk_fresh_func_decl(symbol const & prefix, symbol const
 }
 
 sort * ast_manager::mk_fresh_sort(char const * prefix) {
+    scoped_lock l(*this);
     string_buffer<32> buffer;
     buffer << prefix << "!" << m_fresh_id;
     m_fresh_id++;
@@ -2092,6 +2233,7 @@ sort * ast_manager::mk_fresh_sort(char const * prefix) {
 }
 
 symbol ast_manager::mk_fresh_var_name(char const * prefix) {
+    scoped_lock l(*this);
     string_buffer<32> buffer;
     buffer << (prefix ? prefix : "var") << "!" << m_fresh_id;
     m_fresh_id++;
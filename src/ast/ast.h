@@ -44,6 +44,8 @@ Revision History:
 #include"chashtable.h"
 #include"z3_exception.h"
 #include"dependency.h"
+#include"z3_omp.h"
+#include"z3_atomic.h"
 
 #define RECYCLE_FREE_AST_INDICES
 
@@ -431,6 +433,8 @@ protected:
     //    shared_occs used one of the public marks.
     //  - This was a constant source of assertion violations.
     unsigned m_mark_shared_occs:1; 
+    // True if the node was allocated using memory::allocate (see ast_manager::allocate_node).
+    unsigned m_heap_allocated:1;
     friend class shared_occs_mark;
     void mark_so(bool flag) { m_mark_shared_occs = flag; }
     void reset_mark_so() { m_mark_shared_occs = false; }
@@ -452,8 +456,19 @@ protected:
         SASSERT(m_ref_count > 0); 
         m_ref_count --; 
     }
+
+    // Reference counter updates used when the manager is in concurrent mode.
+    void inc_ref_atomic() { 
+        SASSERT(m_ref_count < UINT_MAX);
+        atomic_inc(m_ref_count);
+    }
+
+    unsigned dec_ref_atomic() { 
+        SASSERT(m_ref_count > 0); 
+        return atomic_dec(m_ref_count);
+    }
     
-    ast(ast_kind k):m_id(UINT_MAX), m_kind(k), m_mark1(false), m_mark2(false), m_mark_shared_occs(false), m_ref_count(0) {
+    ast(ast_kind k):m_id(UINT_MAX), m_kind(k), m_mark1(false), m_mark2(false), m_mark_shared_occs(false), m_heap_allocated(false), m_ref_count(0) {
         DEBUG_CODE({
             m_mark1_owner = 0;
             m_mark2_owner = 0;
@@ -893,6 +908,63 @@ public:
     void erase(ast * n);
 };
 
+/**
+   \brief Hash-consing table used by ast_manager in concurrent mode.
+   The table is split in stripes, each one is an ast_table protected by its own lock.
+   The stripe of a node is selected using its hash code. So, threads creating different
+   nodes rarely wait for each other, and each stripe grows independently.
+*/
+class concurrent_ast_table {
+    struct stripe {
+        ast_table           m_table;
+        obj_hashtable<ast>  m_zombies; // nodes of the stripe whose reference counter reached zero.
+        omp_lock_t          m_lock;
+        stripe() { omp_init_lock(&m_lock); }
+        ~stripe() { omp_destroy_lock(&m_lock); }
+    };
+    static const unsigned c_num_stripes_log = 6;
+    static const unsigned c_num_stripes     = 1 << c_num_stripes_log;
+    stripe *   m_stripes;
+
+    stripe & get_stripe(ast const * n) const { 
+        // ast_table uses the least significant bits of the hash code.
+        return m_stripes[hash_u(n->hash()) >> (32 - c_num_stripes_log)]; 
+    }
+public:
+    concurrent_ast_table();
+    ~concurrent_ast_table();
+    /**
+       \brief Lock the stripe of a node. Other threads may find a node as soon as it is
+       inserted. So, a new node must be initialized before the lock is released.
+    */
+    class scoped_stripe_lock {
+        stripe & m_stripe;
+    public:
+        scoped_stripe_lock(concurrent_ast_table & t, ast const * n):m_stripe(t.get_stripe(n)) { omp_set_lock(&m_stripe.m_lock); }
+        ~scoped_stripe_lock() { omp_unset_lock(&m_stripe.m_lock); }
+        ast * insert_if_not_there(ast * n) { return m_stripe.m_table.insert_if_not_there(n); }
+    };
+    bool contains(ast * n) const;
+    void erase(ast * n);
+    unsigned size() const;
+    /**
+       \brief Record a node whose reference counter reached zero. A node is recorded at most once.
+    */
+    void push_zombie(ast * n);
+    /**
+       \brief Store the recorded nodes in \c r, and forget them.
+    */
+    void get_zombies(ptr_vector<ast> & r);
+    /**
+       \brief Move the nodes in \c t to this table. 
+    */
+    void move_from(ast_table & t);
+    /**
+       \brief Move the nodes in this table to \c t.
+    */
+    void move_to(ast_table & t);
+};
+
 // -----------------------------------
 //
 // decl_plugin
@@ -1452,6 +1524,10 @@ protected:
     bool slow_not_contains(ast const * n);
 #endif
     ast_manager *             m_format_manager; // hack for isolating format objects in a different manager.
+    // Concurrent mode (see enable_concurrency)
+    bool                      m_concurrent;
+    concurrent_ast_table *    m_concurrent_ast_table; // replaces m_ast_table in concurrent mode.
+    omp_nest_lock_t           m_lock;
 
     void init();
 
@@ -1468,6 +1544,47 @@ public:
     void cancel() { set_cancel(true); }
     void reset_cancel() { set_cancel(false); }
 
+    /**
+       \brief Enable/disable concurrent mode. In concurrent mode, several threads may 
+       create, inc_ref and dec_ref ASTs owned by this manager. 
+       
+       - Reference counters are updated using atomic operations.
+       - Nodes are hash-consed using a concurrent_ast_table, and allocated using 
+         memory::allocate instead of the manager small object allocator.
+       - The creation of sorts and declarations by plugins is serialized by the manager lock. 
+       - Nodes whose reference counter reaches zero are not deleted. Another thread may still
+         find them in the hash-consing table. They are recorded in the stripe of the node, 
+         and reclaimed by collect_zombies (if they were not resurrected in the meantime). 
+         Long running clients should invoke collect_zombies between parallel rounds.
+       
+       Remark: this method must be invoked when no other thread is using the manager.
+       Remark: no solver creates terms in several threads yet, concurrent mode is only 
+       used by the tests (see src/test/ast.cpp and src/test/concurrent_ast_table.cpp).
+       Remark: marks, compact_memory, compress_ids, expr_array and expr_dependency 
+       objects are not thread safe.
+    */
+    void enable_concurrency(bool f);
+    bool concurrency_enabled() const { return m_concurrent; }
+
+    /**
+       \brief Delete the nodes whose reference counter reached zero in concurrent mode.
+       
+       Remark: this method must be invoked when no other thread is using the manager.
+    */
+    void collect_zombies();
+
+    /**
+       \brief Acquire the manager lock when the manager is in concurrent mode.
+       Decl plugins use it to protect their caches.
+    */
+    class scoped_lock {
+        ast_manager & m_manager;
+    public:
+        scoped_lock(ast_manager & m):m_manager(m) { if (m.m_concurrent) omp_set_nest_lock(&m.m_lock); }
+        ~scoped_lock() { if (m_manager.m_concurrent) omp_unset_nest_lock(&m_manager.m_lock); }
+    };
+    friend class scoped_lock;
+
     bool has_trace_stream() const { return m_trace_stream != 0; }
     std::ostream & trace_stream() { SASSERT(has_trace_stream()); return *m_trace_stream; }
 
@@ -1553,22 +1670,32 @@ public:
     
     bool are_distinct(expr * a, expr * b) const;
     
-    bool contains(ast * a) const { return m_ast_table.contains(a); }
+    bool contains(ast * a) const { return m_concurrent ? m_concurrent_ast_table->contains(a) : m_ast_table.contains(a); }
     
-    unsigned get_num_asts() const { return m_ast_table.size(); }
+    unsigned get_num_asts() const { return m_concurrent ? m_concurrent_ast_table->size() : m_ast_table.size(); }
 
     void debug_ref_count() { m_debug_ref_count = true; }
     
     void inc_ref(ast * n) { 
-        if (n)
-            n->inc_ref();
+        if (n) {
+            if (m_concurrent)
+                n->inc_ref_atomic();
+            else
+                n->inc_ref();
+        }
     }
     
     void dec_ref(ast * n) {
         if (n) {
-            n->dec_ref();
-            if (n->get_ref_count() == 0)
-                delete_node(n);
+            if (m_concurrent) {
+                if (n->dec_ref_atomic() == 0)
+                    m_concurrent_ast_table->push_zombie(n);
+            }
+            else {
+                n->dec_ref();
+                if (n->get_ref_count() == 0)
+                    delete_node(n);
+            }
         }
     }
     
@@ -1594,6 +1721,8 @@ public:
     
 protected:
     ast * register_node_core(ast * n);
+
+    void init_node(ast * n);
     
     template<typename T>
     T * register_node(T * n) { 
@@ -1603,11 +1732,16 @@ protected:
     void delete_node(ast * n);
     
     void * allocate_node(unsigned size) { 
+        if (m_concurrent)
+            return memory::allocate(size);
         return m_alloc.allocate(size);
     }
     
     void deallocate_node(ast * n, unsigned sz) {
-        m_alloc.deallocate(sz, n);
+        if (n->m_heap_allocated)
+            memory::deallocate(n);
+        else
+            m_alloc.deallocate(sz, n);
     }
     
 public:
@@ -2324,6 +2458,53 @@ typedef ast_fast_mark<2> ast_fast_mark2;
 typedef ast_fast_mark1   expr_fast_mark1;
 typedef ast_fast_mark2   expr_fast_mark2;
 
+// -----------------------------------
+//
+// expr_epoch_mark
+//
+// -----------------------------------
+
+/**
+   \brief Marks indexed by expression ids. An expression is marked iff its stamp is equal to the 
+   current epoch. reset() is O(1) since it just starts a new epoch. So, an object that is reused 
+   by many traversals does not need to clear or reallocate its storage.
+
+   Remark: the memory used is proportional to the biggest id marked. So, this kind
+   of mark should be owned by long lived objects. ast_fast_mark is a better option for
+   short lived ones.
+*/
+class expr_epoch_mark {
+    unsigned_vector m_stamps;
+    unsigned        m_epoch;
+public:
+    expr_epoch_mark():m_epoch(1) {}
+    bool is_marked(expr const * n) const { 
+        unsigned id = n->get_id();
+        return id < m_stamps.size() && m_stamps[id] == m_epoch;
+    }
+    void mark(expr const * n) {
+        unsigned id = n->get_id();
+        if (id >= m_stamps.size())
+            m_stamps.resize(id + 1, 0);
+        m_stamps[id] = m_epoch;
+    }
+    void reset_mark(expr const * n) {
+        unsigned id = n->get_id();
+        if (id < m_stamps.size())
+            m_stamps[id] = 0;
+    }
+    void mark(expr const * n, bool flag) { if (flag) mark(n); else reset_mark(n); }
+    void reset() {
+        m_epoch++;
+        if (m_epoch == 0) {
+            // wrap around: stamps of old epochs may become valid again.
+            m_stamps.fill(0);
+            m_epoch = 1;
+        }
+    }
+    void finalize() { m_stamps.finalize(); m_epoch = 1; }
+};
+
 /**
    Similar to ast_fast_mark, but increases reference counter. 
 */
@@ -15,79 +15,102 @@ Author:
 
 Notes:
 
---*/    
-
+--*/ 
 #include "expr_abstract.h"
+#include "expr_traversal.h"
 #include "map.h"
 
+struct expr_abstractor::proc {
+    expr_abstractor & m_owner;
+    proc(expr_abstractor & o):m_owner(o) {}
+    bool pre_visit(expr * n) {
+        if (is_quantifier(n)) {
+            m_owner.abstract_quantifier(to_quantifier(n));
+            return false;
+        }
+        return true;
+    }
+    void post_visit(expr * n) {
+        m_owner.abstract_app_or_var(n);
+    }
+};
+
+// Visited nodes are the ones in the map: in a DAG, a node cannot be reached
+// again before being post-visited.
+struct expr_abstractor::visited_mark {
+    obj_map<expr, expr*> & m_map;
+    visited_mark(obj_map<expr, expr*> & m):m_map(m) {}
+    bool is_marked(expr * n) const { return m_map.contains(n); }
+    void mark(expr * n) {}
+};
+
+expr_abstractor::~expr_abstractor() {
+    if (m_nested)
+        dealloc(m_nested);
+}
+
+void expr_abstractor::abstract_app_or_var(expr * n) {
+    if (is_var(n)) {
+        m_map.insert(n, n);
+        return;
+    }
+    SASSERT(is_app(n));
+    app * a  = to_app(n);
+    bool changed = false;
+    m_args.reset();
+    for (unsigned i = 0; i < a->get_num_args(); ++i) {
+        expr * arg = a->get_arg(i);
+        expr * b   = m_map.find(arg);
+        if (b != arg)
+            changed = true;
+        m_args.push_back(b);
+    }
+    expr * b = a;
+    if (changed) {
+        b = m.mk_app(a->get_decl(), m_args.size(), m_args.c_ptr());
+        m_pinned.push_back(b);
+    }
+    m_map.insert(n, b);
+}
+
+void expr_abstractor::abstract_quantifier(quantifier * q) {
+    // the quantifier shifts the indices of the new variables, so its children are
+    // abstracted by a nested abstractor. Thus, the C++ stack depth is bounded by the
+    // number of nested quantifiers.
+    if (m_nested == 0)
+        m_nested = alloc(expr_abstractor, m);
+    expr_ref_buffer patterns(m);
+    expr_ref result1(m);
+    unsigned new_base = m_base + q->get_num_decls();
+    for (unsigned i = 0; i < q->get_num_patterns(); ++i) {
+        (*m_nested)(new_base, m_num_bound, m_bound, q->get_pattern(i), result1);
+        patterns.push_back(result1.get());
+    }
+    (*m_nested)(new_base, m_num_bound, m_bound, q->get_expr(), result1);
+    expr * b = m.update_quantifier(q, patterns.size(), patterns.c_ptr(), result1.get());
+    m_pinned.push_back(b);            
+    m_map.insert(q, b);
+}
+
 void expr_abstractor::operator()(unsigned base, unsigned num_bound, expr* const* bound, expr* n, expr_ref& result) {
-    
-    expr * curr = 0, *b = 0;
     SASSERT(n->get_ref_count() > 0);
-
-    m_stack.push_back(n);
+    m_base      = base;
+    m_num_bound = num_bound;
+    m_bound     = bound;
 
     for (unsigned i = 0; i < num_bound; ++i) {
-        b = bound[i];
-        expr* v = m.mk_var(base + num_bound - i - 1, m.get_sort(b));
+        expr * b = bound[i];
+        expr * v = m.mk_var(base + num_bound - i - 1, m.get_sort(b));
         m_pinned.push_back(v);
         m_map.insert(b, v);
     }
 
-    while(!m_stack.empty()) {
-        curr = m_stack.back();
-        if (m_map.contains(curr)) {
-            m_stack.pop_back();
-            continue;
-        }
-        switch(curr->get_kind()) {
-        case AST_VAR: {
-            m_map.insert(curr, curr);
-            m_stack.pop_back();
-            break;
-        }
-        case AST_APP: {
-            app* a = to_app(curr);
-            bool all_visited = true;
-            m_args.reset();
-            for (unsigned i = 0; i < a->get_num_args(); ++i) {
-                if (!m_map.find(a->get_arg(i), b)) {
-                    m_stack.push_back(a->get_arg(i));
-                    all_visited = false;
-                }
-                else {
-                    m_args.push_back(b);
-                }
-            }
-            if (all_visited) {
-                b = m.mk_app(a->get_decl(), m_args.size(), m_args.c_ptr());
-                m_pinned.push_back(b);
-                m_map.insert(curr, b);
-                m_stack.pop_back();
-            }
-            break;
-        }
-        case AST_QUANTIFIER: {
-            quantifier* q = to_quantifier(curr);
-            expr_ref_buffer patterns(m);
-            expr_ref result1(m);
-            unsigned new_base = base + q->get_num_decls();
-        
-            for (unsigned i = 0; i < q->get_num_patterns(); ++i) {
-                expr_abstract(m, new_base, num_bound, bound, q->get_pattern(i), result1);
-                patterns.push_back(result1.get());
-            }
-            expr_abstract(m, new_base, num_bound, bound, q->get_expr(), result1);
-            b = m.update_quantifier(q, patterns.size(), patterns.c_ptr(), result1.get());
-            m_pinned.push_back(b);            
-            m_map.insert(curr, b);
-            m_stack.pop_back();            
-            break;
-        }
-        default:
-            UNREACHABLE();
-        }
-    }
+    proc         p(*this);
+    visited_mark visited(m_map);
+    m_stack.reset();
+    traverse_expr_core<proc, visited_mark, svector<expr_frame>, true, true>(p, visited, m_stack, n);
+
+    expr * b = 0;
     VERIFY (m_map.find(n, b));
     result = b;
     m_pinned.reset();
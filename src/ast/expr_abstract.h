@@ -20,15 +20,27 @@ Notes:
 #define _EXPR_ABSTRACT_H_
 
 #include"ast.h"
+#include"expr_traversal.h"
 
 class expr_abstractor {
+    struct proc;
+    struct visited_mark;
+    friend struct proc;
     ast_manager& m;
     expr_ref_vector m_pinned;
-    ptr_vector<expr> m_stack, m_args;
+    svector<expr_frame> m_stack;
+    ptr_vector<expr> m_args;
     obj_map<expr, expr*> m_map;
-    
+    expr_abstractor * m_nested; // used to abstract the children of quantifiers.
+    unsigned m_base;
+    unsigned m_num_bound;
+    expr * const * m_bound;
+
+    void abstract_app_or_var(expr * n);
+    void abstract_quantifier(quantifier * q);
 public:
-    expr_abstractor(ast_manager& m): m(m), m_pinned(m) {}
+    expr_abstractor(ast_manager& m): m(m), m_pinned(m), m_nested(0), m_base(0), m_num_bound(0), m_bound(0) {}
+    ~expr_abstractor();
     void operator()(unsigned base, unsigned num_bound, expr* const* bound, expr* n, expr_ref& result);
 };
 
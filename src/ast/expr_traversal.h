@@ -0,0 +1,176 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    expr_traversal.h
+
+Abstract:
+
+    Iterative traversal of expression DAGs.
+
+    traverse_expr_core is the engine used by for_each_expr,
+    recurse_expr, num_occurs, occurs, etc. The visited marks and the
+    frame stack are provided by the caller, so they can be reused.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Notes:
+
+--*/
+#ifndef _EXPR_TRAVERSAL_H_
+#define _EXPR_TRAVERSAL_H_
+
+#include"ast.h"
+
+/**
+   \brief Mapping from expressions to values based on expr_epoch_mark.
+   reset() is O(1): the values of previous epochs are just ignored.
+*/
+template<typename T, bool CallDestructors = false>
+class expr_epoch_map {
+    expr_epoch_mark            m_mark;
+    vector<T, CallDestructors> m_values;
+public:
+    bool contains(expr const * n) const { return m_mark.is_marked(n); }
+    bool find(expr const * n, T & v) const {
+        if (!contains(n))
+            return false;
+        v = m_values[n->get_id()];
+        return true;
+    }
+    T const & find(expr const * n) const { SASSERT(contains(n)); return m_values[n->get_id()]; }
+    void insert(expr const * n, T const & v) {
+        unsigned id = n->get_id();
+        if (id >= m_values.size())
+            m_values.resize(id + 1, T());
+        m_values[id] = v;
+        m_mark.mark(n);
+    }
+    // Remark: a key marked using marks() without a value is associated with T().
+    expr_epoch_mark & marks() { return m_mark; }
+    void reset() { m_mark.reset(); }
+    void finalize() { m_mark.finalize(); m_values.finalize(); }
+};
+
+struct expr_frame {
+    expr *   m_curr;
+    unsigned m_idx;  // next child to be visited
+    expr_frame(expr * n):m_curr(n), m_idx(0) {}
+};
+
+/**
+   \brief Iterative DAG traversal. Every node reachable from n that is not marked in \c visited is visited once.
+
+   - proc.pre_visit(t) is invoked the first time t is reached. If it returns false,
+     the children of t are not visited, and proc.post_visit(t) is not invoked.
+   - proc.post_visit(t) is invoked after all children of t have been visited.
+
+   If MarkAll is false, only shared nodes (reference counter > 1) are marked,
+   i.e., unshared nodes are assumed to be reachable from a single parent.
+   If IgnorePatterns is true, the patterns of quantifiers are not visited.
+
+   Remark: the traversal does not use the C++ stack, so it can be used on very deep terms.
+*/
+template<typename Proc, typename Mark, typename Stack, bool MarkAll, bool IgnorePatterns>
+void traverse_expr_core(Proc & proc, Mark & visited, Stack & stack, expr * n) {
+    if (MarkAll || n->get_ref_count() > 1) {
+        if (visited.is_marked(n))
+            return;
+        visited.mark(n);
+    }
+    if (!proc.pre_visit(n))
+        return;
+    SASSERT(stack.empty());
+    stack.push_back(expr_frame(n));
+    while (!stack.empty()) {
+    start:
+        expr_frame & fr = stack.back();
+        expr * curr     = fr.m_curr;
+        unsigned num;
+        switch (curr->get_kind()) {
+        case AST_APP:
+            num = to_app(curr)->get_num_args();
+            break;
+        case AST_QUANTIFIER:
+            num = IgnorePatterns ? 1 : to_quantifier(curr)->get_num_children();
+            break;
+        default:
+            num = 0;
+            break;
+        }
+        while (fr.m_idx < num) {
+            expr * child = is_app(curr) ? to_app(curr)->get_arg(fr.m_idx) : to_quantifier(curr)->get_child(fr.m_idx);
+            fr.m_idx++;
+            if (MarkAll || child->get_ref_count() > 1) {
+                if (visited.is_marked(child))
+                    continue;
+                visited.mark(child);
+            }
+            if (!proc.pre_visit(child))
+                continue;
+            if (is_var(child) || (is_app(child) && to_app(child)->get_num_args() == 0)) {
+                // leaves are not pushed into the stack
+                proc.post_visit(child);
+                continue;
+            }
+            stack.push_back(expr_frame(child));
+            goto start;
+        }
+        stack.pop_back();
+        proc.post_visit(curr);
+    }
+}
+
+/**
+   \brief Reusable DAG traversal. The frame stack and the epoch based marks
+   survive between invocations, so after a warm-up traversing does not allocate memory,
+   and forgetting the visited nodes is O(1).
+
+   Remark: it is not reentrant, proc must not use the same object.
+*/
+class expr_traversal {
+    svector<expr_frame> m_stack;
+    expr_epoch_mark     m_visited;
+    bool                m_ignore_patterns;
+public:
+    expr_traversal(bool ignore_patterns = false):m_ignore_patterns(ignore_patterns) {}
+
+    expr_epoch_mark & visited() { return m_visited; }
+    bool is_visited(expr * n) const { return m_visited.is_marked(n); }
+
+    /**
+       \brief Forget all visited nodes.
+    */
+    void reset() { m_visited.reset(); }
+    void finalize() { m_visited.finalize(); m_stack.finalize(); }
+
+    /**
+       \brief Visit the nodes reachable from n that were not visited since the last reset().
+    */
+    template<typename Proc>
+    void visit(Proc & proc, expr * n) {
+        m_stack.reset();
+        if (m_ignore_patterns)
+            traverse_expr_core<Proc, expr_epoch_mark, svector<expr_frame>, true, true>(proc, m_visited, m_stack, n);
+        else
+            traverse_expr_core<Proc, expr_epoch_mark, svector<expr_frame>, true, false>(proc, m_visited, m_stack, n);
+    }
+
+    template<typename Proc>
+    void operator()(Proc & proc, expr * n) {
+        reset();
+        visit(proc, n);
+    }
+
+    template<typename Proc>
+    void operator()(Proc & proc, unsigned num, expr * const * ns) {
+        reset();
+        for (unsigned i = 0; i < num; i++)
+            visit(proc, ns[i]);
+    }
+};
+
+#endif /* _EXPR_TRAVERSAL_H_ */
@@ -21,87 +21,29 @@ Revision History:
 
 #include"ast.h"
 #include"trace.h"
+#include"expr_traversal.h"
 
-template<typename ForEachProc, typename ExprMark, bool MarkAll, bool IgnorePatterns>
-void for_each_expr_core(ForEachProc & proc, ExprMark & visited, expr * n) {
-    typedef std::pair<expr *, unsigned> frame;
-
-    if (MarkAll || n->get_ref_count() > 1) {
-        if (visited.is_marked(n))
-            return;
-        visited.mark(n);
-    }
-
-    sbuffer<frame> stack;    
-    
-    stack.push_back(frame(n, 0));
-    while (!stack.empty()) {
-    start:
-        frame & fr  = stack.back();
-        expr * curr = fr.first;
-        switch (curr->get_kind()) {
-        case AST_VAR:
-            proc(to_var(curr));
-            stack.pop_back();
-            break;
-        case AST_APP: {
-            unsigned num_args = to_app(curr)->get_num_args();
-            while (fr.second < num_args) {
-                expr * arg = to_app(curr)->get_arg(fr.second);
-                fr.second++;
-                if (MarkAll || arg->get_ref_count() > 1) {
-                    if (visited.is_marked(arg))
-                        continue;
-                    visited.mark(arg);
-                }
-                switch (arg->get_kind()) {
-                case AST_VAR:
-                    proc(to_var(arg));
-                    break;
-                case AST_QUANTIFIER:
-                    stack.push_back(frame(arg, 0));
-                    goto start;
-                case AST_APP:
-                    if (to_app(arg)->get_num_args() == 0) {
-                        proc(to_app(arg));
-                    }
-                    else {
-                        stack.push_back(frame(arg, 0));
-                        goto start;
-                    }
-                    break;
-                default:
-                    UNREACHABLE();
-                    break;
-                }
-            }
-            stack.pop_back();
-            proc(to_app(curr));
-            break;
-        }
-        case AST_QUANTIFIER: {
-            quantifier * q        = to_quantifier(curr);
-            unsigned num_children = IgnorePatterns ? 1 : q->get_num_children();
-            while (fr.second < num_children) {
-                expr * child = q->get_child(fr.second);
-                fr.second++;
-                if (MarkAll || child->get_ref_count() > 1) {
-                    if (visited.is_marked(child))
-                        continue;
-                    visited.mark(child);
-                }
-                stack.push_back(frame(child, 0));
-                goto start;
-            }
-            stack.pop_back();
-            proc(to_quantifier(curr));
-            break;
-        }
-        default:
-            UNREACHABLE();
-            break;
+template<typename ForEachProc>
+struct for_each_expr_adapter {
+    ForEachProc & m_proc;
+    for_each_expr_adapter(ForEachProc & p):m_proc(p) {}
+    bool pre_visit(expr * n) { return true; }
+    void post_visit(expr * n) {
+        switch (n->get_kind()) {
+        case AST_APP:        m_proc(to_app(n)); break;
+        case AST_VAR:        m_proc(to_var(n)); break;
+        case AST_QUANTIFIER: m_proc(to_quantifier(n)); break;
+        default:             UNREACHABLE(); break;
         }
     }
+};
+
+template<typename ForEachProc, typename ExprMark, bool MarkAll, bool IgnorePatterns>
+void for_each_expr_core(ForEachProc & proc, ExprMark & visited, expr * n) {
+    typedef for_each_expr_adapter<ForEachProc> adapter;
+    adapter p(proc);
+    sbuffer<expr_frame> stack;
+    traverse_expr_core<adapter, ExprMark, sbuffer<expr_frame>, MarkAll, IgnorePatterns>(p, visited, stack, n);
 }
 
 template<typename T>
@@ -128,6 +70,16 @@ void for_each_expr(ForEachProc & proc, expr * n) {
     for_each_expr_core<ForEachProc, expr_mark, false, false>(proc, visited, n);
 }
 
+/**
+   \brief Similar to for_each_expr(proc, visited, n), but the marks and the stack of \c t are reused.
+   The nodes visited since the last t.reset() are skipped.
+*/
+template<typename ForEachProc>
+void for_each_expr(ForEachProc & proc, expr_traversal & t, expr * n) {
+    for_each_expr_adapter<ForEachProc> p(proc);
+    t.visit(p, n);
+}
+
 template<typename ForEachProc>
 void quick_for_each_expr(ForEachProc & proc, expr_fast_mark1 & visited, expr * n) {
     for_each_expr_core<ForEachProc, expr_fast_mark1, false, false>(proc, visited, n);
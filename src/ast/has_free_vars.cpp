@@ -22,21 +22,30 @@ Revision History:
 
 class contains_vars {
     typedef hashtable<expr_delta_pair, obj_hash<expr_delta_pair>, default_eq<expr_delta_pair> > cache;
-    cache                    m_cache;
+    expr_fast_mark1          m_visited; // nodes visited with delta == 0
+    cache                    m_cache;   // nodes visited with delta > 0, i.e., below a quantifier.
     svector<expr_delta_pair> m_todo;
     bool                     m_contains;
     unsigned                 m_window;
 
-    void visit(expr * n, unsigned delta, bool & visited) {
-        expr_delta_pair e(n, delta);
-        if (!m_cache.contains(e)) {
-            m_todo.push_back(e);
-            visited = false;
+    void visit(expr * n, unsigned delta) {
+        if (is_ground(n))
+            return; // n does not contain variables
+        if (delta == 0) {
+            if (m_visited.is_marked(n))
+                return;
+            m_visited.mark(n);
         }
+        else {
+            expr_delta_pair e(n, delta);
+            if (m_cache.contains(e))
+                return;
+            m_cache.insert(e);
+        }
+        m_todo.push_back(expr_delta_pair(n, delta));
     }
 
-    bool visit_children(expr * n, unsigned delta) {
-        bool visited = true;
+    void visit_children(expr * n, unsigned delta) {
         unsigned dw;
         unsigned j;
         switch (n->get_kind()) {
@@ -49,18 +58,17 @@ class contains_vars {
             j = to_app(n)->get_num_args();
             while (j > 0) {
                 --j;
-                visit(to_app(n)->get_arg(j), delta, visited);
+                visit(to_app(n)->get_arg(j), delta);
             }
             break;
         case AST_QUANTIFIER:
             if (delta <= UINT_MAX - to_quantifier(n)->get_num_decls()) {
-                visit(to_quantifier(n)->get_expr(), delta + to_quantifier(n)->get_num_decls(), visited);
+                visit(to_quantifier(n)->get_expr(), delta + to_quantifier(n)->get_num_decls());
             }
-        break;
+            break;
         default:
             break;
         }
-        return visited;
     }
 
 public:
@@ -70,13 +78,12 @@ public:
         m_window     = end - begin;
         m_todo.reset();
         m_cache.reset();
-        m_todo.push_back(expr_delta_pair(n, begin));
+        m_visited.reset();
+        visit(n, begin);
         while (!m_todo.empty()) {
             expr_delta_pair e = m_todo.back();
-            if (visit_children(e.m_node, e.m_delta)) {
-                m_cache.insert(e);
-                m_todo.pop_back();
-            }
+            m_todo.pop_back();
+            visit_children(e.m_node, e.m_delta);
             if (m_contains) {
                 return true;
             }
@@ -91,4 +98,3 @@ bool has_free_vars(expr * n) {
     return p(n);
 }
 
-
@@ -18,46 +18,42 @@ Revision History:
 --*/
 
 #include"num_occurs.h"
+#include"expr_traversal.h"
 
-void num_occurs::process(expr * t, expr_fast_mark1 & visited) {
-    ptr_buffer<expr, 128> stack;
-    
-#define VISIT(ARG) {                                                                                    \
-        if (!m_ignore_ref_count1 || ARG->get_ref_count() > 1) {                                         \
-            obj_map<expr, unsigned>::obj_map_entry * entry = m_num_occurs.insert_if_not_there2(ARG, 0); \
-            entry->get_data().m_value++;                                                                \
-        }                                                                                               \
-        if (!visited.is_marked(ARG)) {                                                                  \
-            visited.mark(ARG, true);                                                                    \
-            stack.push_back(ARG);                                                                       \
-        }                                                                                               \
+void num_occurs::inc_occs(expr * n) {
+    if (!m_ignore_ref_count1 || n->get_ref_count() > 1) {
+        obj_map<expr, unsigned>::obj_map_entry * entry = m_num_occurs.insert_if_not_there2(n, 0);
+        entry->get_data().m_value++;
     }
+}
 
-    VISIT(t);
-
-    while (!stack.empty()) {
-        expr * t = stack.back();
-        stack.pop_back();
-        unsigned j;
-        switch (t->get_kind()) {
-        case AST_APP:
-            j = to_app(t)->get_num_args();
-            while (j > 0) {
-                --j;
-                expr * arg = to_app(t)->get_arg(j);
-                VISIT(arg);
-            }
+struct num_occurs::proc {
+    num_occurs & m_owner;
+    proc(num_occurs & o):m_owner(o) {}
+    bool pre_visit(expr * n) { return !m_owner.m_ignore_quantifiers || !is_quantifier(n); }
+    // each edge is counted when the parent is visited
+    void post_visit(expr * n) {
+        switch (n->get_kind()) {
+        case AST_APP: {
+            unsigned num = to_app(n)->get_num_args();
+            for (unsigned i = 0; i < num; i++)
+                m_owner.inc_occs(to_app(n)->get_arg(i));
             break;
+        }
         case AST_QUANTIFIER:
-            if (!m_ignore_quantifiers) {
-                expr * child = to_quantifier(t)->get_expr();
-                VISIT(child);
-            }
+            m_owner.inc_occs(to_quantifier(n)->get_expr());
             break;
         default:
             break;
         }
     }
+};
+
+void num_occurs::process(expr * t, expr_fast_mark1 & visited) {
+    inc_occs(t);
+    proc p(*this);
+    sbuffer<expr_frame, 128> stack;
+    traverse_expr_core<proc, expr_fast_mark1, sbuffer<expr_frame, 128>, true, true>(p, visited, stack, t);
 }
 
 void num_occurs::operator()(expr * t) {
@@ -71,4 +67,3 @@ void num_occurs::operator()(unsigned num, expr * const * ts) {
         process(ts[i], visited);
     }
 }
-
@@ -31,6 +31,9 @@ protected:
     bool m_ignore_quantifiers;
     obj_map<expr, unsigned>        m_num_occurs;
 
+    struct proc;
+    friend struct proc;
+    void inc_occs(expr * n);
     void process(expr * t, expr_fast_mark1 & visited);
 public:
     num_occurs(bool ignore_ref_count1 = false, bool ignore_quantifiers = false):
@@ -27,51 +27,47 @@ Revision History:
 // -----------------------------------
 
 namespace occurs_namespace {
-    struct found {}; 
-    
     struct proc {
         expr * m_n;
-
-#define CHECK() { if (n == m_n) throw found(); }
-
-        proc(expr * n):m_n(n) {}
-        void operator()(var const * n) { CHECK(); }
-        void operator()(app const * n) { CHECK(); }
-        void operator()(quantifier const * n) { CHECK(); }
+        bool   m_found;
+        proc(expr * n):m_n(n), m_found(false) {}
+        // the traversal is cut as soon as m_n is found.
+        bool pre_visit(expr * n) { 
+            if (n == m_n) 
+                m_found = true; 
+            return !m_found; 
+        }
+        void post_visit(expr * n) {}
     };
 
     struct decl_proc {
         func_decl * m_d;
-
-        decl_proc(func_decl * d):m_d(d) {}
-        void operator()(var const * n) { }
-        void operator()(app const * n) { if (n->get_decl() == m_d) throw found(); }
-        void operator()(quantifier const * n) { }
+        bool        m_found;
+        decl_proc(func_decl * d):m_d(d), m_found(false) {}
+        bool pre_visit(expr * n) { 
+            if (is_app(n) && to_app(n)->get_decl() == m_d) 
+                m_found = true; 
+            return !m_found; 
+        }
+        void post_visit(expr * n) {}
     };
 
-
+    template<typename Proc>
+    bool search(Proc & p, expr * n) {
+        expr_fast_mark1     visited;
+        sbuffer<expr_frame> stack;
+        traverse_expr_core<Proc, expr_fast_mark1, sbuffer<expr_frame>, false, false>(p, visited, stack, n);
+        return p.m_found;
+    }
 };
 
 // Return true if n1 occurs in n2
 bool occurs(expr * n1, expr * n2) {
     occurs_namespace::proc p(n1);
-    try {
-        quick_for_each_expr(p, n2);
-    }
-    catch (occurs_namespace::found) {
-        return true;
-    }
-    return false;
+    return occurs_namespace::search(p, n2);
 }
 
 bool occurs(func_decl * d, expr * n) {
     occurs_namespace::decl_proc p(d);
-    try {
-        quick_for_each_expr(p, n);
-    }
-    catch (occurs_namespace::found) {
-        return true;
-    }
-    return false;
+    return occurs_namespace::search(p, n);
 }
-
@@ -20,26 +20,26 @@ Revision History:
 #define _RECURSE_EXPR_H_
 
 #include"ast.h"
-#include"obj_hashtable.h"
+#include"expr_traversal.h"
 
 template<typename T, typename Visitor, bool IgnorePatterns=false, bool CallDestructors=true>
 class recurse_expr : public Visitor {
-    obj_map<expr, T>                          m_cache;
-    ptr_vector<expr>                          m_todo;
+    struct proc;
+    friend struct proc;
+    expr_epoch_map<T, CallDestructors>        m_cache;
+    svector<expr_frame>                       m_todo;
     vector<T, CallDestructors>                m_results1;
     vector<T, CallDestructors>                m_results2;
 
-    bool is_cached(expr * n) const { T c; return m_cache.find(n, c); }
     T get_cached(expr * n) const { return m_cache.find(n); }
     void cache_result(expr * n, T c) { m_cache.insert(n, c); }
     
-    void visit(expr * n, bool & visited);
-    bool visit_children(expr * n);
     void process(expr * n);
     
 public:
     recurse_expr(Visitor const & v = Visitor()):Visitor(v) {}
     T operator()(expr * n);
+    // Remark: reset() is O(1), the cached values are only destroyed by finalize() or when they are overwritten.
     void reset() { m_cache.reset(); m_todo.reset(); }
     void finalize() { m_cache.finalize(); m_todo.finalize(); }
 };
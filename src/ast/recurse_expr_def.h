@@ -22,39 +22,12 @@ Revision History:
 #include"recurse_expr.h"
 
 template<typename T, typename Visitor, bool IgnorePatterns, bool CallDestructors>
-inline void recurse_expr<T, Visitor, IgnorePatterns, CallDestructors>::visit(expr * n, bool & visited) {
-    if (!is_cached(n)) {
-        m_todo.push_back(n);
-        visited = false;
-    }
-}
-
-template<typename T, typename Visitor, bool IgnorePatterns, bool CallDestructors>
-bool recurse_expr<T, Visitor, IgnorePatterns, CallDestructors>::visit_children(expr * n) {
-    bool visited = true;
-    unsigned num;
-    switch (n->get_kind()) {
-    case AST_APP:
-        num = to_app(n)->get_num_args();
-        for (unsigned j = 0; j < num; j++) 
-            visit(to_app(n)->get_arg(j), visited);
-        break;
-    case AST_QUANTIFIER:
-        if (!IgnorePatterns) {
-            num = to_quantifier(n)->get_num_patterns();
-            for (unsigned j = 0; j < num; j++)
-                visit(to_quantifier(n)->get_pattern(j), visited);
-            num = to_quantifier(n)->get_num_no_patterns();
-            for (unsigned j = 0; j < num; j++)
-                visit(to_quantifier(n)->get_no_pattern(j), visited);
-        }
-        visit(to_quantifier(n)->get_expr(), visited);
-        break;
-    default:
-        break;
-    }
-    return visited;
-}
+struct recurse_expr<T, Visitor, IgnorePatterns, CallDestructors>::proc {
+    recurse_expr & m_owner;
+    proc(recurse_expr & o):m_owner(o) {}
+    bool pre_visit(expr * n) { return true; }
+    void post_visit(expr * n) { m_owner.process(n); }
+};
 
 template<typename T, typename Visitor, bool IgnorePatterns, bool CallDestructors>
 void recurse_expr<T, Visitor, IgnorePatterns, CallDestructors>::process(expr * n) {
@@ -93,15 +66,17 @@ void recurse_expr<T, Visitor, IgnorePatterns, CallDestructors>::process(expr * n
 
 template<typename T, typename Visitor, bool IgnorePatterns, bool CallDestructors>
 T recurse_expr<T, Visitor, IgnorePatterns, CallDestructors>::operator()(expr * r) {
-    m_todo.push_back(r);
-    while (!m_todo.empty()) {
-        expr * n = m_todo.back();
-        if (is_cached(n))
-            m_todo.pop_back();
-        else if (visit_children(n)) {
-            m_todo.pop_back();
-            process(n);
-        }
+    proc p(*this);
+    m_todo.reset();
+    try {
+        // The marks of m_cache are used as the visited marks. A node is cached when it is 
+        // post-visited, and in a DAG it cannot be reached again before that.
+        traverse_expr_core<proc, expr_epoch_mark, svector<expr_frame>, true, IgnorePatterns>(p, m_cache.marks(), m_todo, r);
+    }
+    catch (...) {
+        // marked nodes that were not processed must not be considered cached.
+        reset();
+        throw;
     }
     return get_cached(r);
 }
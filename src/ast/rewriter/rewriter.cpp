@@ -19,6 +19,7 @@ Notes:
 #include"rewriter_def.h"
 #include"ast_ll_pp.h"
 #include"ast_smt2_pp.h"
+#include"rewriter_cache.h"
 
 void rewriter_core::init_cache_stack() {
     SASSERT(m_cache_stack.empty());
@@ -52,6 +53,7 @@ void rewriter_core::cache_result(expr * k, expr * v) {
     TRACE("rewriter_cache_result", tout << mk_ismt2_pp(k, m()) << "\n--->\n" << mk_ismt2_pp(v, m()) << "\n";);
 
     m_cache->insert(k, v);
+    cache_shared_result(k, v);
 #if 0
     static unsigned num_cached = 0;
     num_cached ++;
@@ -67,6 +69,27 @@ void rewriter_core::cache_result(expr * k, expr * v, proof * pr) {
     m_cache_pr->insert(k, pr);
 }
 
+expr * rewriter_core::get_shared_cached(expr * k) {
+    SASSERT(m_shared_cache != 0 && !m_proof_gen);
+    expr * r = m_shared_cache->find(k, m_shared_config);
+    if (r != 0)
+        m_cache->insert(k, r);
+    return r;
+}
+
+void rewriter_core::cache_shared_result(expr * k, expr * v) {
+    if (m_shared_cache != 0 && m_scopes.empty()) {
+        SASSERT(!m_proof_gen);
+        m_shared_cache->insert(k, m_shared_config, v);
+    }
+}
+
+void rewriter_core::set_shared_cache(rewriter_cache * c, unsigned config) {
+    SASSERT(c == 0 || &(c->m()) == &m());
+    m_shared_cache  = m_proof_gen ? 0 : c;
+    m_shared_config = config;
+}
+
 unsigned rewriter_core::get_cache_size() const {
     return m_cache->size();
 }
@@ -173,7 +196,9 @@ rewriter_core::rewriter_core(ast_manager & m, bool proof_gen):
     m_proof_gen(proof_gen),
     m_result_stack(m),
     m_result_pr_stack(m),
-    m_num_qvars(0) {
+    m_num_qvars(0),
+    m_shared_cache(0),
+    m_shared_config(0) {
     init_cache_stack();
 }
 
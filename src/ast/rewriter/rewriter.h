@@ -23,6 +23,8 @@ Notes:
 #include"rewriter_types.h"
 #include"act_cache.h"
 
+class rewriter_cache;
+
 /**
    \brief Common infrastructure for AST rewriters.
 */
@@ -68,6 +70,10 @@ protected:
         scope(expr * r, unsigned n):m_old_root(r), m_old_num_qvars(n) {}
     };
     svector<scope>             m_scopes;
+    // Cache shared with other rewriters. It is only used at scope level 0 and
+    // when proof generation is disabled.
+    rewriter_cache *           m_shared_cache;
+    unsigned                   m_shared_config;
 
     // Return true if the rewriting result of the given expression must be cached.
     bool must_cache(expr * t) const {
@@ -90,7 +96,14 @@ protected:
     void del_cache_stack();
     void reset_cache();
     void cache_result(expr * k, expr * v);
-    expr * get_cached(expr * k) const { return m_cache->find(k); } 
+    expr * get_shared_cached(expr * k);
+    void cache_shared_result(expr * k, expr * v);
+    expr * get_cached(expr * k) { 
+        expr * r = m_cache->find(k);
+        if (r == 0 && m_shared_cache != 0 && m_scopes.empty())
+            r = get_shared_cached(k);
+        return r;
+    } 
 
     void cache_result(expr * k, expr * v, proof * pr);
     proof * get_cached_pr(expr * k) const { return static_cast<proof*>(m_cache_pr->find(k)); } 
@@ -118,6 +131,14 @@ public:
     void display_stack(std::ostream & out, unsigned pp_depth);
 #endif
     unsigned get_cache_size() const;
+    /**
+       \brief Use \c c as a second level cache. Results stored in \c c are tagged with the given
+       configuration id (see rewriter_cache::get_config_id), and must only be reused by rewriters
+       producing the same results (i.e., same configuration).
+       The shared cache is ignored when proof generation is enabled.
+    */
+    void set_shared_cache(rewriter_cache * c, unsigned config);
+    rewriter_cache * get_shared_cache() const { return m_shared_cache; }
 };
 
 class var_shifter_core : public rewriter_core {
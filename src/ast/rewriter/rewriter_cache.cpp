@@ -0,0 +1,128 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    rewriter_cache.cpp
+
+Abstract:
+
+    Bounded expr -> expr cache that can be shared by several
+    rewriters.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Notes:
+
+--*/
+#include"rewriter_cache.h"
+#include"statistics.h"
+
+rewriter_cache::rewriter_cache(ast_manager & m, unsigned max_size):
+    m_manager(m),
+    m_ref_count(0),
+    m_max_size(max_size == 0 ? 1 : max_size),
+    m_hand(0),
+    m_hits(0),
+    m_misses(0),
+    m_evictions(0) {
+}
+
+rewriter_cache::~rewriter_cache() {
+    reset();
+}
+
+unsigned rewriter_cache::get_config_id(symbol const & config) {
+    unsigned id;
+    if (!m_config2id.find(config, id)) {
+        id = m_config2id.size();
+        m_config2id.insert(config, id);
+    }
+    return id;
+}
+
+expr * rewriter_cache::find(expr * k, unsigned config) {
+    unsigned idx;
+    if (m_key2slot.find(key(k->get_id(), config), idx)) {
+        entry & e = m_entries[idx];
+        SASSERT(e.m_key == k);
+        e.m_used = true;
+        m_hits++;
+        return e.m_value;
+    }
+    m_misses++;
+    return 0;
+}
+
+/**
+   \brief Return a free slot. If the cache is full, an entry is evicted
+   using the clock policy: entries used since the last time the hand
+   passed over them get a second chance.
+*/
+unsigned rewriter_cache::mk_slot() {
+    if (m_entries.size() < m_max_size) {
+        m_entries.push_back(entry());
+        return m_entries.size() - 1;
+    }
+    while (true) {
+        if (m_hand >= m_entries.size())
+            m_hand = 0;
+        entry & e = m_entries[m_hand];
+        if (e.m_used) {
+            e.m_used = false;
+            m_hand++;
+            continue;
+        }
+        unsigned idx = m_hand;
+        m_hand++;
+        m_key2slot.erase(key(e.m_key->get_id(), e.m_config));
+        m_manager.dec_ref(e.m_key);
+        m_manager.dec_ref(e.m_value);
+        m_evictions++;
+        return idx;
+    }
+}
+
+void rewriter_cache::insert(expr * k, unsigned config, expr * v) {
+    unsigned idx;
+    if (m_key2slot.find(key(k->get_id(), config), idx)) {
+        entry & e = m_entries[idx];
+        m_manager.inc_ref(v);
+        m_manager.dec_ref(e.m_value);
+        e.m_value = v;
+        e.m_used  = true;
+        return;
+    }
+    idx = mk_slot();
+    entry & e = m_entries[idx];
+    m_manager.inc_ref(k);
+    m_manager.inc_ref(v);
+    e.m_key         = k;
+    e.m_value       = v;
+    e.m_config      = config;
+    // new entries must be used at least once to survive the next pass of the hand.
+    e.m_used        = false;
+    m_key2slot.insert(key(k->get_id(), config), idx);
+}
+
+void rewriter_cache::reset() {
+    svector<entry>::iterator it  = m_entries.begin();
+    svector<entry>::iterator end = m_entries.end();
+    for (; it != end; ++it) {
+        m_manager.dec_ref(it->m_key);
+        m_manager.dec_ref(it->m_value);
+    }
+    m_entries.reset();
+    m_key2slot.reset();
+    // m_config2id is preserved, since the rewriters using this cache keep their ids.
+    m_hand = 0;
+}
+
+void rewriter_cache::collect_statistics(statistics & st) const {
+    st.update("rewriter cache hits", m_hits);
+    st.update("rewriter cache misses", m_misses);
+    st.update("rewriter cache evictions", m_evictions);
+    st.update("rewriter cache size", m_entries.size());
+}
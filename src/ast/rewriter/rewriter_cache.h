@@ -0,0 +1,91 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    rewriter_cache.h
+
+Abstract:
+
+    Bounded expr -> expr cache that can be shared by several
+    rewriters (e.g., by the simplification stages of a tactic
+    pipeline working on the same goal).
+
+    Entries are tagged with the id of the rewriter configuration
+    that produced them, and are evicted using the clock
+    (second-chance) policy when the cache is full.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Notes:
+
+--*/
+#ifndef _REWRITER_CACHE_H_
+#define _REWRITER_CACHE_H_
+
+#include"ast.h"
+#include"map.h"
+#include"symbol.h"
+
+class statistics;
+
+class rewriter_cache {
+    struct entry {
+        expr *   m_key;
+        expr *   m_value;
+        unsigned m_config;
+        bool     m_used;
+    };
+    typedef std::pair<unsigned, unsigned> key;
+    typedef pair_hash<unsigned_hash, unsigned_hash> key_hash;
+    typedef map<key, unsigned, key_hash, default_eq<key> > key2slot;
+    typedef map<symbol, unsigned, symbol_hash_proc, symbol_eq_proc> config2id;
+
+    ast_manager &   m_manager;
+    unsigned        m_ref_count;
+    unsigned        m_max_size;
+    svector<entry>  m_entries;
+    key2slot        m_key2slot;
+    config2id       m_config2id;
+    unsigned        m_hand;   // clock hand
+    unsigned        m_hits;
+    unsigned        m_misses;
+    unsigned        m_evictions;
+
+    unsigned mk_slot();
+public:
+    rewriter_cache(ast_manager & m, unsigned max_size);
+    ~rewriter_cache();
+
+    void inc_ref() { ++m_ref_count; }
+    void dec_ref() { SASSERT(m_ref_count > 0); --m_ref_count; if (m_ref_count == 0) dealloc(this); }
+
+    ast_manager & m() const { return m_manager; }
+
+    /**
+       \brief Return the id of the given rewriter configuration. Two configurations
+       have the same id iff they are the same string. The ids are not reused,
+       not even after reset().
+    */
+    unsigned get_config_id(symbol const & config);
+
+    /**
+       \brief Return the cached result for k produced by a rewriter with the given
+       configuration id, or 0 if there is none.
+    */
+    expr * find(expr * k, unsigned config);
+    void insert(expr * k, unsigned config, expr * v);
+    void reset();
+
+    unsigned size() const { return m_entries.size(); }
+    unsigned max_size() const { return m_max_size; }
+    unsigned hits() const { return m_hits; }
+    unsigned misses() const { return m_misses; }
+    unsigned evictions() const { return m_evictions; }
+    void collect_statistics(statistics & st) const;
+    void reset_statistics() { m_hits = 0; m_misses = 0; m_evictions = 0; }
+};
+
+#endif
@@ -17,6 +17,7 @@ Notes:
 
 --*/
 #include"rewriter.h"
+#include"rewriter_cache.h"
 #include"ast_smt2_pp.h"
 
 template<typename Config>
@@ -552,6 +553,14 @@ void rewriter_tpl<Config>::main_loop(expr * t, expr_ref & result, proof_ref & re
     m_root      = t;
     m_num_qvars = 0;
     m_num_steps = 0;
+    if (!ProofGen && m_shared_cache != 0) {
+        // the root is not stored in the local cache, but it is worth sharing.
+        expr * r = m_shared_cache->find(t, m_shared_config);
+        if (r != 0) {
+            result = r;
+            return;
+        }
+    }
     if (visit<ProofGen>(t, RW_UNBOUNDED_DEPTH)) {
         result = result_stack().back();
         result_stack().pop_back();
@@ -563,9 +572,14 @@ void rewriter_tpl<Config>::main_loop(expr * t, expr_ref & result, proof_ref & re
                 result_pr = m().mk_reflexivity(t);
             SASSERT(result_pr_stack().empty());
         }
+        else {
+            cache_shared_result(t, result);
+        }
         return;
     }
     resume_core<ProofGen>(result, result_pr);
+    if (!ProofGen)
+        cache_shared_result(t, result);
 }
 
 /**
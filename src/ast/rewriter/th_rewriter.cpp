@@ -18,6 +18,7 @@ Notes:
 --*/
 #include"th_rewriter.h"
 #include"rewriter_params.hpp"
+#include"gparams.h"
 #include"bool_rewriter.h"
 #include"arith_rewriter.h"
 #include"bv_rewriter.h"
@@ -32,6 +33,7 @@ Notes:
 #include"var_subst.h"
 #include"ast_util.h"
 #include"well_sorted.h"
+#include<sstream>
 
 struct th_rewriter_cfg : public default_rewriter_cfg {
     bool_rewriter       m_b_rw;
@@ -687,8 +689,25 @@ struct th_rewriter::imp : public rewriter_tpl<th_rewriter_cfg> {
     }
 };
 
+/**
+   \brief Return the configuration used by th_rewriter_cfg::updt_params(p): the parameters p,
+   and the global parameters of the rewriter module (all rewriters read their parameters
+   from this module).
+*/
+static symbol mk_config(params_ref const & p) {
+    std::ostringstream local, buffer;
+    p.display(local);
+    std::string s = local.str();
+    // the length makes the concatenation unambiguous.
+    buffer << s.length() << ":" << s;
+    gparams::get_module("rewriter").display(buffer);
+    return symbol(buffer.str().c_str());
+}
+
 th_rewriter::th_rewriter(ast_manager & m, params_ref const & p):
-    m_params(p) {
+    m_params(p),
+    m_shared_cache(0),
+    m_config(mk_config(p)) {
     m_imp = alloc(imp, m, p);
 }
 
@@ -699,6 +718,22 @@ ast_manager & th_rewriter::m() const {
 void th_rewriter::updt_params(params_ref const & p) {
     m_params = p;
     m_imp->cfg().updt_params(p);
+    m_config = mk_config(p);
+    updt_shared_cache();
+}
+
+void th_rewriter::updt_shared_cache() {
+    // rewriting results depend on the substitution, so they cannot be shared.
+    bool enabled = m_shared_cache != 0 && m_imp->cfg().m_subst == 0;
+    if (enabled)
+        m_imp->set_shared_cache(m_shared_cache, m_shared_cache->get_config_id(m_config));
+    else
+        m_imp->set_shared_cache(0, 0);
+}
+
+void th_rewriter::set_shared_cache(rewriter_cache * c) {
+    m_shared_cache = c;
+    updt_shared_cache();
 }
 
 void th_rewriter::get_param_descrs(param_descrs & r) {
@@ -736,11 +771,13 @@ void th_rewriter::cleanup() {
         dealloc(m_imp);
         m_imp = alloc(imp, m, m_params);
     }
+    updt_shared_cache();
 }
 
 void th_rewriter::reset() {
     m_imp->reset();
     m_imp->cfg().reset();
+    updt_shared_cache();
 }
 
 void th_rewriter::operator()(expr_ref & term) {
@@ -758,12 +795,26 @@ void th_rewriter::operator()(expr * t, expr_ref & result, proof_ref & result_pr)
 }
 
 void th_rewriter::operator()(expr * n, unsigned num_bindings, expr * const * bindings, expr_ref & result) {
-    m_imp->operator()(n, num_bindings, bindings, result);
+    if (m_imp->get_shared_cache() == 0) {
+        m_imp->operator()(n, num_bindings, bindings, result);
+        return;
+    }
+    // the result depends on the bindings.
+    m_imp->set_shared_cache(0, 0);
+    try {
+        m_imp->operator()(n, num_bindings, bindings, result);
+    }
+    catch (...) {
+        updt_shared_cache();
+        throw;
+    }
+    updt_shared_cache();
 }
 
 void th_rewriter::set_substitution(expr_substitution * s) {
     m_imp->reset(); // reset the cache
     m_imp->cfg().set_substitution(s);
+    updt_shared_cache();
 }
 
 expr_dependency * th_rewriter::get_used_dependencies() {
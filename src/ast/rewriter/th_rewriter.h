@@ -24,11 +24,15 @@ Notes:
 #include"params.h"
 
 class expr_substitution;
+class rewriter_cache;
 
 class th_rewriter {
     struct     imp;
     imp *      m_imp;
     params_ref m_params;
+    rewriter_cache * m_shared_cache;
+    symbol           m_config;
+    void updt_shared_cache();
 public:
     th_rewriter(ast_manager & m, params_ref const & p = params_ref());
     ~th_rewriter();
@@ -52,6 +56,17 @@ public:
     void reset();
 
     void set_substitution(expr_substitution * s);
+
+    /**
+       \brief Store (and reuse) rewriting results in the given cache. 
+       Entries are tagged with the id of the configuration of this rewriter: its parameters,
+       and the global parameters of the rewriter module. So the cache can be shared by rewriters
+       with different configurations.
+       The cache is not used when proof generation is enabled, a substitution is set,
+       or when bindings are provided. The caller is responsible for keeping \c c alive,
+       and for resetting it with set_shared_cache(0).
+    */
+    void set_shared_cache(rewriter_cache * c);
     
     // Dependency tracking is very coarse. 
     // The rewriter just keeps accumulating the dependencies of the used substitutions.
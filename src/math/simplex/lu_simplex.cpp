@@ -0,0 +1,482 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    lu_simplex.cpp
+
+Abstract:
+
+    Revised primal simplex in double precision.
+
+    Phase 1 is a bounded primal simplex minimizing the sum of infeasibilities.
+    Each iteration computes the simplex multipliers using btran, prices the
+    nonbasic columns (Dantzig rule, Bland rule after a sequence of degenerate
+    steps), computes the entering column using ftran, and performs a
+    ratio test that also considers bound flips of the entering variable.
+    The basis factorization is updated in product form, and recomputed
+    from scratch every m_refactor_freq pivots.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Revision History:
+
+--*/
+#include<math.h>
+#include"lu_simplex.h"
+#include"sparse_lu.h"
+
+struct lu_simplex::imp {
+    typedef sparse_lu::entry         entry;
+    typedef sparse_lu::sparse_vector sparse_vector;
+    typedef sparse_lu::dense_vector  dense_vector;
+#define null_var UINT_MAX
+
+    vector<sparse_vector> m_cols;        // m_cols[x] = (row, coefficient) entries of x
+    dense_vector          m_value;
+    dense_vector          m_lower;
+    dense_vector          m_upper;
+    svector<bool>         m_has_lower;
+    svector<bool>         m_has_upper;
+    unsigned_vector       m_basis;       // m_basis[r] = basic variable of row r
+    int_vector            m_pos;         // m_pos[x] = row where x is basic, or -1
+    sparse_lu             m_lu;
+    vector<sparse_vector> m_basis_cols;
+    dense_vector          m_y;
+    dense_vector          m_alpha;
+
+    double                m_feas_tol;
+    double                m_pivot_tol;
+    double                m_cost_tol;
+    unsigned              m_refactor_freq;
+    unsigned              m_bland_threshold;
+    unsigned              m_iterations;
+
+    // statistics
+    unsigned              m_num_calls;
+    unsigned              m_num_pivots;
+    unsigned              m_num_bound_flips;
+    unsigned              m_num_factorizations;
+    unsigned              m_num_failures;
+
+    imp():
+        m_feas_tol(1e-9),
+        m_pivot_tol(1e-9),
+        m_cost_tol(1e-9),
+        m_refactor_freq(64),
+        m_bland_threshold(32),
+        m_iterations(0) {
+        reset_statistics();
+    }
+
+    void reset_statistics() {
+        m_num_calls          = 0;
+        m_num_pivots         = 0;
+        m_num_bound_flips    = 0;
+        m_num_factorizations = 0;
+        m_num_failures       = 0;
+    }
+
+    void reset() {
+        m_cols.reset();
+        m_value.reset();
+        m_lower.reset();
+        m_upper.reset();
+        m_has_lower.reset();
+        m_has_upper.reset();
+        m_basis.reset();
+        m_pos.reset();
+        m_iterations = 0;
+    }
+
+    var mk_var(double val) {
+        var x = m_cols.size();
+        m_cols.push_back(sparse_vector());
+        m_value.push_back(val);
+        m_lower.push_back(0.0);
+        m_upper.push_back(0.0);
+        m_has_lower.push_back(false);
+        m_has_upper.push_back(false);
+        m_pos.push_back(-1);
+        return x;
+    }
+
+    void set_lower(var x, double l) {
+        m_lower[x]     = l;
+        m_has_lower[x] = true;
+    }
+
+    void set_upper(var x, double u) {
+        m_upper[x]     = u;
+        m_has_upper[x] = true;
+    }
+
+    void reset_bounds(var x) {
+        m_has_lower[x] = false;
+        m_has_upper[x] = false;
+    }
+
+    /**
+       \brief Move the nonbasic variables inside their bounds.
+    */
+    void fix_nonbasic_values() {
+        unsigned n = m_cols.size();
+        for (var x = 0; x < n; x++) {
+            if (m_pos[x] >= 0)
+                continue;
+            if (m_has_lower[x] && m_value[x] < m_lower[x])
+                m_value[x] = m_lower[x];
+            else if (m_has_upper[x] && m_value[x] > m_upper[x])
+                m_value[x] = m_upper[x];
+        }
+    }
+
+    void add_row(var base, unsigned sz, var const * xs, double const * coeffs) {
+        SASSERT(m_pos[base] == -1);
+        unsigned r = m_basis.size();
+        m_basis.push_back(base);
+        m_pos[base] = r;
+        for (unsigned i = 0; i < sz; i++) {
+            if (coeffs[i] != 0.0)
+                m_cols[xs[i]].push_back(entry(r, coeffs[i]));
+        }
+    }
+
+    double tol(double b) const {
+        return m_feas_tol * (1.0 + fabs(b));
+    }
+
+    bool below_lower(var x) const {
+        return m_has_lower[x] && m_value[x] < m_lower[x] - tol(m_lower[x]);
+    }
+
+    bool above_upper(var x) const {
+        return m_has_upper[x] && m_value[x] > m_upper[x] + tol(m_upper[x]);
+    }
+
+    bool can_increase(var x) const {
+        return !m_has_upper[x] || m_value[x] < m_upper[x] - tol(m_upper[x]);
+    }
+
+    bool can_decrease(var x) const {
+        return !m_has_lower[x] || m_value[x] > m_lower[x] + tol(m_lower[x]);
+    }
+
+    bool factorize() {
+        unsigned m = m_basis.size();
+        m_basis_cols.reset();
+        for (unsigned r = 0; r < m; r++)
+            m_basis_cols.push_back(m_cols[m_basis[r]]);
+        m_num_factorizations++;
+        return m_lu.factorize(m, m_basis_cols);
+    }
+
+    /**
+       \brief Compute the value of the basic variables using the value of the nonbasic ones.
+    */
+    void compute_basic_values() {
+        unsigned m = m_basis.size();
+        m_alpha.reset();
+        m_alpha.resize(m, 0.0);
+        unsigned n = m_cols.size();
+        for (var x = 0; x < n; x++) {
+            if (m_pos[x] >= 0 || m_value[x] == 0.0)
+                continue;
+            sparse_vector const & col = m_cols[x];
+            for (unsigned i = 0; i < col.size(); i++)
+                m_alpha[col[i].m_idx] -= col[i].m_val * m_value[x];
+        }
+        m_lu.ftran(m_alpha);
+        for (unsigned r = 0; r < m; r++)
+            m_value[m_basis[r]] = m_alpha[r];
+    }
+
+    /**
+       \brief Compute the simplex multipliers for the phase 1 cost function.
+       Return false if all basic variables are feasible.
+    */
+    bool compute_multipliers() {
+        unsigned m = m_basis.size();
+        bool infeasible = false;
+        m_y.reset();
+        m_y.resize(m, 0.0);
+        for (unsigned r = 0; r < m; r++) {
+            var x = m_basis[r];
+            if (below_lower(x)) {
+                m_y[r]     = -1.0;
+                infeasible = true;
+            }
+            else if (above_upper(x)) {
+                m_y[r]     = 1.0;
+                infeasible = true;
+            }
+        }
+        if (infeasible)
+            m_lu.btran(m_y);
+        return infeasible;
+    }
+
+    /**
+       \brief Select a nonbasic variable whose reduced cost allows the sum of
+       infeasibilities to decrease. dir is +1 if it should increase and -1 otherwise.
+    */
+    var select_entering(bool bland, int & dir) {
+        var    best       = null_var;
+        double best_score = 0.0;
+        unsigned n = m_cols.size();
+        for (var x = 0; x < n; x++) {
+            if (m_pos[x] >= 0)
+                continue;
+            sparse_vector const & col = m_cols[x];
+            double d = 0.0;
+            for (unsigned i = 0; i < col.size(); i++)
+                d -= m_y[col[i].m_idx] * col[i].m_val;
+            int    x_dir;
+            double score;
+            if (d < -m_cost_tol && can_increase(x)) {
+                x_dir = 1;
+                score = -d;
+            }
+            else if (d > m_cost_tol && can_decrease(x)) {
+                x_dir = -1;
+                score = d;
+            }
+            else {
+                continue;
+            }
+            if (bland) {
+                dir = x_dir;
+                return x;
+            }
+            if (score > best_score) {
+                best       = x;
+                best_score = score;
+                dir        = x_dir;
+            }
+        }
+        return best;
+    }
+
+    /**
+       \brief Ratio test. Return the row of the leaving variable, or -1 if the
+       entering variable should just move to its other bound.
+       The step length is stored in t, and the bound the leaving variable reaches in b.
+    */
+    int select_leaving(var entering, int dir, double & t, double & b) {
+        t = HUGE_VAL;
+        if (dir > 0 && m_has_upper[entering])
+            t = m_upper[entering] - m_value[entering];
+        else if (dir < 0 && m_has_lower[entering])
+            t = m_value[entering] - m_lower[entering];
+        int      leave = -1;
+        unsigned m     = m_basis.size();
+        for (unsigned r = 0; r < m; r++) {
+            double a = m_alpha[r];
+            if (fabs(a) < m_pivot_tol)
+                continue;
+            // change of the basic variable per unit of t
+            double delta = -dir * a;
+            var    x     = m_basis[r];
+            double v     = m_value[x];
+            double bound;
+            if (delta > 0) {
+                if (m_has_lower[x] && v < m_lower[x] - tol(m_lower[x]))
+                    bound = m_lower[x];
+                else if (m_has_upper[x] && v <= m_upper[x] + tol(m_upper[x]))
+                    bound = m_upper[x];
+                else
+                    continue;
+            }
+            else {
+                if (m_has_upper[x] && v > m_upper[x] + tol(m_upper[x]))
+                    bound = m_upper[x];
+                else if (m_has_lower[x] && v >= m_lower[x] - tol(m_lower[x]))
+                    bound = m_lower[x];
+                else
+                    continue;
+            }
+            double tr = (bound - v) / delta;
+            if (tr < 0.0)
+                tr = 0.0;
+            if (tr < t || (tr == t && leave >= 0 && fabs(a) > fabs(m_alpha[leave]))) {
+                t     = tr;
+                leave = r;
+                b     = bound;
+            }
+        }
+        return leave;
+    }
+
+    status fail() {
+        m_num_failures++;
+        return UNKNOWN;
+    }
+
+    status make_feasible(unsigned max_iterations) {
+        m_num_calls++;
+        m_iterations = 0;
+        unsigned m = m_basis.size();
+        if (m == 0)
+            return FEASIBLE;
+        fix_nonbasic_values();
+        if (!factorize())
+            return fail();
+        compute_basic_values();
+        unsigned degenerate = 0;
+        while (true) {
+            if (m_lu.num_updates() >= m_refactor_freq) {
+                if (!factorize())
+                    return fail();
+                compute_basic_values();
+            }
+            if (!compute_multipliers())
+                return FEASIBLE;
+            if (m_iterations >= max_iterations)
+                return fail();
+            int dir = 0;
+            var entering = select_entering(degenerate >= m_bland_threshold, dir);
+            if (entering == null_var)
+                return INFEASIBLE;
+            m_alpha.reset();
+            m_alpha.resize(m, 0.0);
+            sparse_vector const & col = m_cols[entering];
+            for (unsigned i = 0; i < col.size(); i++)
+                m_alpha[col[i].m_idx] += col[i].m_val;
+            m_lu.ftran(m_alpha);
+            double t, b = 0.0;
+            int leave = select_leaving(entering, dir, t, b);
+            if (t == HUGE_VAL)
+                return fail(); // the phase 1 objective is bounded, so this is a numerical problem.
+            m_iterations++;
+            degenerate = t == 0.0 ? degenerate + 1 : 0;
+            double step = dir * t;
+            m_value[entering] += step;
+            for (unsigned r = 0; r < m; r++) {
+                if (m_alpha[r] != 0.0)
+                    m_value[m_basis[r]] -= step * m_alpha[r];
+            }
+            if (leave < 0) {
+                m_value[entering] = dir > 0 ? m_upper[entering] : m_lower[entering];
+                m_num_bound_flips++;
+                continue;
+            }
+            var leaving        = m_basis[leave];
+            m_value[leaving]   = b;
+            bool ok            = m_lu.update(leave, m_alpha);
+            m_basis[leave]     = entering;
+            m_pos[entering]    = leave;
+            m_pos[leaving]     = -1;
+            m_num_pivots++;
+            if (!ok) {
+                if (!factorize())
+                    return fail();
+                compute_basic_values();
+            }
+        }
+    }
+
+    void collect_statistics(statistics & st) const {
+        st.update("lu simplex calls", m_num_calls);
+        st.update("lu simplex pivots", m_num_pivots);
+        st.update("lu simplex bound flips", m_num_bound_flips);
+        st.update("lu simplex factorizations", m_num_factorizations);
+        st.update("lu simplex failures", m_num_failures);
+    }
+};
+
+lu_simplex::lu_simplex() {
+    m_imp = alloc(imp);
+}
+
+lu_simplex::~lu_simplex() {
+    dealloc(m_imp);
+}
+
+void lu_simplex::reset() {
+    m_imp->reset();
+}
+
+lu_simplex::var lu_simplex::mk_var(double val) {
+    return m_imp->mk_var(val);
+}
+
+unsigned lu_simplex::get_num_vars() const {
+    return m_imp->m_cols.size();
+}
+
+void lu_simplex::set_lower(var x, double l) {
+    m_imp->set_lower(x, l);
+}
+
+void lu_simplex::set_upper(var x, double u) {
+    m_imp->set_upper(x, u);
+}
+
+void lu_simplex::reset_bounds(var x) {
+    m_imp->reset_bounds(x);
+}
+
+void lu_simplex::set_value(var x, double val) {
+    m_imp->m_value[x] = val;
+}
+
+void lu_simplex::add_row(var base, unsigned sz, var const * xs, double const * coeffs) {
+    m_imp->add_row(base, sz, xs, coeffs);
+}
+
+lu_simplex::status lu_simplex::make_feasible(unsigned max_iterations) {
+    return m_imp->make_feasible(max_iterations);
+}
+
+bool lu_simplex::is_basic(var x) const {
+    return m_imp->m_pos[x] >= 0;
+}
+
+double lu_simplex::get_value(var x) const {
+    return m_imp->m_value[x];
+}
+
+unsigned lu_simplex::get_num_iterations() const {
+    return m_imp->m_iterations;
+}
+
+void lu_simplex::collect_statistics(statistics & st) const {
+    m_imp->collect_statistics(st);
+}
+
+void lu_simplex::reset_statistics() {
+    m_imp->reset_statistics();
+}
+
+bool lu_simplex::to_fraction(double v, int max_den, int & num, int & den) {
+    if (!(fabs(v) < static_cast<double>(INT_MAX)))
+        return false; // too big, infinite or NaN
+    double tol = 1e-9 * (1.0 + fabs(v));
+    // h_{i-2}/k_{i-2} and h_{i-1}/k_{i-1} are the last two convergents.
+    int64  h0 = 0, h1 = 1;
+    int64  k0 = 1, k1 = 0;
+    double x  = v;
+    while (true) {
+        double a = floor(x);
+        if (fabs(a) > static_cast<double>(INT_MAX))
+            return false;
+        int64 ai = static_cast<int64>(a);
+        int64 h2 = ai * h1 + h0;
+        int64 k2 = ai * k1 + k0;
+        if (k2 > max_den || h2 > INT_MAX || h2 < -INT_MAX)
+            return false;
+        h0 = h1; h1 = h2;
+        k0 = k1; k1 = k2;
+        if (fabs(v - static_cast<double>(h1) / static_cast<double>(k1)) <= tol) {
+            num = static_cast<int>(h1);
+            den = static_cast<int>(k1);
+            return true;
+        }
+        double f = x - a;
+        if (f <= 0.0)
+            return false;
+        x = 1.0 / f;
+    }
+}
@@ -0,0 +1,110 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    lu_simplex.h
+
+Abstract:
+
+    Revised primal simplex in double precision. The basis is kept
+    as a sparse LU factorization (sparse_lu). It is used to find
+    (approximately) feasible bases for the exact simplex in theory_arith.
+
+    The problem is a set of rows  sum a_ij x_j = 0  and bounds
+    l_j <= x_j <= u_j. Each row has a basic variable.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Revision History:
+
+--*/
+#ifndef _LU_SIMPLEX_H_
+#define _LU_SIMPLEX_H_
+
+#include"vector.h"
+#include"statistics.h"
+
+class lu_simplex {
+    struct imp;
+    imp *  m_imp;
+public:
+    typedef unsigned var;
+
+    enum status {
+        FEASIBLE,
+        INFEASIBLE,
+        UNKNOWN     // iteration limit reached, or numerical problems
+    };
+
+    lu_simplex();
+
+    ~lu_simplex();
+
+    /**
+       \brief Remove all variables and rows.
+    */
+    void reset();
+
+    /**
+       \brief Create a new variable with the given initial value.
+       The values of basic variables are ignored, and the values of
+       nonbasic variables are moved inside their bounds by make_feasible.
+    */
+    var mk_var(double val);
+
+    unsigned get_num_vars() const;
+
+    void set_lower(var x, double l);
+
+    void set_upper(var x, double u);
+
+    /**
+       \brief Remove the bounds of x.
+    */
+    void reset_bounds(var x);
+
+    void set_value(var x, double val);
+
+    /**
+       \brief Add the row  coeffs[0]*xs[0] + ... + coeffs[sz-1]*xs[sz-1] = 0.
+       The basic variable \c base must occur in \c xs, and must not be the
+       basic variable of another row.
+    */
+    void add_row(var base, unsigned sz, var const * xs, double const * coeffs);
+
+    /**
+       \brief Minimize the sum of infeasibilities (phase 1) starting from the
+       basis given by add_row, or the basis found by the previous call.
+       Rows, bounds and values can be updated between calls.
+
+       Return FEASIBLE if an assignment satisfying the bounds (modulo tolerances) was found,
+       INFEASIBLE if the sum of infeasibilities cannot be decreased, and UNKNOWN
+       if max_iterations was reached or a numerical problem was detected.
+    */
+    status make_feasible(unsigned max_iterations);
+
+    bool is_basic(var x) const;
+
+    double get_value(var x) const;
+
+    /**
+       \brief Number of iterations (pivots and bound flips) in the last call to make_feasible.
+    */
+    unsigned get_num_iterations() const;
+
+    void collect_statistics(statistics & st) const;
+
+    void reset_statistics();
+
+    /**
+       \brief Find a fraction num/den, with 0 < den <= max_den, that is equal to v
+       modulo the feasibility tolerance. The fraction is computed using the continued
+       fraction expansion of v. Return false if there is no such fraction.
+    */
+    static bool to_fraction(double v, int max_den, int & num, int & den);
+};
+
+#endif /* _LU_SIMPLEX_H_ */
@@ -0,0 +1,353 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sparse_lu.cpp
+
+Abstract:
+
+    Sparse LU factorization of a square matrix in double precision.
+
+    The factorization uses Gaussian elimination with Markowitz pivot
+    selection and threshold partial pivoting. After the factorization,
+    columns of the matrix can be replaced using product form updates.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Revision History:
+
+--*/
+#include<math.h>
+#include"sparse_lu.h"
+
+#define null_col UINT_MAX
+
+sparse_lu::sparse_lu():
+    m_dim(0),
+    m_threshold(0.1),
+    m_zero_tol(1e-12),
+    m_search_limit(4) {
+}
+
+void sparse_lu::reset() {
+    m_L.reset();
+    m_U.reset();
+    m_U_diag.reset();
+    m_pivot_row.reset();
+    m_pivot_col.reset();
+    m_updates.reset();
+}
+
+unsigned sparse_lu::size() const {
+    unsigned r = m_dim;
+    for (unsigned i = 0; i < m_L.size(); i++)
+        r += m_L[i].m_entries.size();
+    for (unsigned i = 0; i < m_U.size(); i++)
+        r += m_U[i].size();
+    for (unsigned i = 0; i < m_updates.size(); i++)
+        r += m_updates[i].m_entries.size() + 1;
+    return r;
+}
+
+void sparse_lu::link_col(unsigned c) {
+    unsigned k = m_col_count[c];
+    m_prev[c]  = null_col;
+    m_next[c]  = m_count_head[k];
+    if (m_count_head[k] != null_col)
+        m_prev[m_count_head[k]] = c;
+    m_count_head[k] = c;
+}
+
+void sparse_lu::unlink_col(unsigned c) {
+    unsigned k = m_col_count[c];
+    if (m_prev[c] != null_col)
+        m_next[m_prev[c]] = m_next[c];
+    else
+        m_count_head[k] = m_next[c];
+    if (m_next[c] != null_col)
+        m_prev[m_next[c]] = m_prev[c];
+}
+
+/**
+   \brief An active row has a new entry in column c.
+*/
+void sparse_lu::inc_col_count(unsigned c) {
+    unlink_col(c);
+    m_col_count[c]++;
+    link_col(c);
+}
+
+/**
+   \brief The active row r does not contain column c anymore.
+*/
+void sparse_lu::dec_col_count(unsigned c, unsigned r) {
+    unsigned_vector & rs = m_col_rows[c];
+    unsigned sz = rs.size();
+    for (unsigned i = 0; i < sz; i++) {
+        if (rs[i] == r) {
+            rs[i] = rs.back();
+            rs.pop_back();
+            break;
+        }
+    }
+    unlink_col(c);
+    m_col_count[c]--;
+    link_col(c);
+}
+
+double sparse_lu::max_abs(sparse_vector const & r) {
+    double m = 0.0;
+    for (unsigned i = 0; i < r.size(); i++) {
+        double v = fabs(r[i].m_val);
+        if (v > m)
+            m = v;
+    }
+    return m;
+}
+
+/**
+   \brief Select a pivot in the active submatrix using the Markowitz cost
+   (r_count - 1) * (c_count - 1). Only the first m_search_limit columns
+   (ordered by number of entries) containing an acceptable pivot are considered.
+   An entry is acceptable if its absolute value is at least m_threshold times
+   the maximal absolute value in its row.
+*/
+bool sparse_lu::select_pivot(unsigned & r, unsigned & c, double & v) {
+    bool     found     = false;
+    unsigned examined  = 0;
+    uint64   best_cost = 0;
+    for (unsigned k = 1; k <= m_dim && examined < m_search_limit; k++) {
+        for (unsigned col = m_count_head[k]; col != null_col && examined < m_search_limit; col = m_next[col]) {
+            bool acceptable = false;
+            unsigned_vector const & rs = m_col_rows[col];
+            for (unsigned i = 0; i < rs.size(); i++) {
+                sparse_vector const & row = m_rows[rs[i]];
+                double a = 0.0;
+                for (unsigned j = 0; j < row.size(); j++) {
+                    if (row[j].m_idx == col) {
+                        a = row[j].m_val;
+                        break;
+                    }
+                }
+                if (fabs(a) <= m_zero_tol || fabs(a) < m_threshold * max_abs(row))
+                    continue;
+                acceptable = true;
+                uint64 cost = static_cast<uint64>(row.size() - 1) * static_cast<uint64>(k - 1);
+                if (!found || cost < best_cost || (cost == best_cost && fabs(a) > fabs(v))) {
+                    found     = true;
+                    best_cost = cost;
+                    r         = rs[i];
+                    c         = col;
+                    v         = a;
+                }
+            }
+            if (acceptable)
+                examined++;
+        }
+    }
+    return found;
+}
+
+/**
+   \brief Eliminate column c from the active submatrix using row r as the pivot row.
+*/
+void sparse_lu::eliminate(unsigned r, unsigned c, double v) {
+    sparse_vector & prow = m_rows[r];
+    m_row_active[r] = false;
+    unlink_col(c);
+    for (unsigned j = 0; j < prow.size(); j++) {
+        if (prow[j].m_idx != c)
+            dec_col_count(prow[j].m_idx, r);
+    }
+
+    m_L.push_back(eta());
+    eta & l = m_L.back();
+    l.m_row = r;
+    unsigned_vector const & rs = m_col_rows[c];
+    for (unsigned i = 0; i < rs.size(); i++) {
+        unsigned row_id = rs[i];
+        if (row_id == r)
+            continue;
+        SASSERT(m_row_active[row_id]);
+        sparse_vector & row = m_rows[row_id];
+        unsigned sz = row.size();
+        for (unsigned j = 0; j < sz; j++)
+            m_pos[row[j].m_idx] = j;
+        SASSERT(m_pos[c] >= 0);
+        double mult = row[m_pos[c]].m_val / v;
+        l.m_entries.push_back(entry(row_id, mult));
+        for (unsigned j = 0; j < prow.size(); j++) {
+            unsigned col = prow[j].m_idx;
+            if (col == c)
+                continue;
+            int pos = m_pos[col];
+            if (pos >= 0) {
+                row[pos].m_val -= mult * prow[j].m_val;
+            }
+            else {
+                // fill-in
+                m_pos[col] = row.size();
+                row.push_back(entry(col, -mult * prow[j].m_val));
+                m_col_rows[col].push_back(row_id);
+                inc_col_count(col);
+            }
+        }
+        // remove column c and cancelled entries
+        unsigned k = 0;
+        sz = row.size();
+        for (unsigned j = 0; j < sz; j++) {
+            unsigned col = row[j].m_idx;
+            m_pos[col] = -1;
+            if (col == c)
+                continue;
+            if (fabs(row[j].m_val) < m_zero_tol) {
+                dec_col_count(col, row_id);
+                continue;
+            }
+            row[k++] = row[j];
+        }
+        row.shrink(k);
+    }
+
+    m_U.push_back(sparse_vector());
+    sparse_vector & u = m_U.back();
+    for (unsigned j = 0; j < prow.size(); j++) {
+        if (prow[j].m_idx != c)
+            u.push_back(prow[j]);
+    }
+    m_U_diag.push_back(v);
+    m_pivot_row.push_back(r);
+    m_pivot_col.push_back(c);
+    prow.finalize();
+}
+
+bool sparse_lu::factorize(unsigned dim, vector<sparse_vector> const & cols) {
+    SASSERT(cols.size() == dim);
+    reset();
+    m_dim = dim;
+    m_rows.reset();
+    m_rows.resize(dim, sparse_vector());
+    m_col_rows.reset();
+    m_col_rows.resize(dim, unsigned_vector());
+    m_col_count.reset();
+    m_col_count.resize(dim, 0);
+    for (unsigned c = 0; c < dim; c++) {
+        sparse_vector const & col = cols[c];
+        for (unsigned i = 0; i < col.size(); i++) {
+            sparse_vector & row = m_rows[col[i].m_idx];
+            if (!row.empty() && row.back().m_idx == c) {
+                // repeated entry
+                row.back().m_val += col[i].m_val;
+            }
+            else {
+                row.push_back(entry(c, col[i].m_val));
+                m_col_rows[c].push_back(col[i].m_idx);
+            }
+        }
+        m_col_count[c] = m_col_rows[c].size();
+    }
+    m_count_head.reset();
+    m_count_head.resize(dim + 1, null_col);
+    m_next.reset();
+    m_next.resize(dim, null_col);
+    m_prev.reset();
+    m_prev.resize(dim, null_col);
+    for (unsigned c = 0; c < dim; c++)
+        link_col(c);
+    m_row_active.reset();
+    m_row_active.resize(dim, true);
+    m_pos.reset();
+    m_pos.resize(dim, -1);
+
+    bool ok = true;
+    for (unsigned k = 0; k < dim; k++) {
+        unsigned r, c;
+        double   v;
+        if (m_count_head[0] != null_col || !select_pivot(r, c, v)) {
+            // an empty column, or no acceptable pivot
+            ok = false;
+            break;
+        }
+        eliminate(r, c, v);
+    }
+    m_rows.finalize();
+    m_col_rows.finalize();
+    return ok;
+}
+
+void sparse_lu::ftran(dense_vector & x) const {
+    SASSERT(x.size() == m_dim);
+    for (unsigned k = 0; k < m_L.size(); k++) {
+        eta const & l = m_L[k];
+        double b = x[l.m_row];
+        if (b == 0.0)
+            continue;
+        for (unsigned i = 0; i < l.m_entries.size(); i++)
+            x[l.m_entries[i].m_idx] -= l.m_entries[i].m_val * b;
+    }
+    m_tmp.resize(m_dim, 0.0);
+    for (unsigned k = m_dim; k-- > 0; ) {
+        double s = x[m_pivot_row[k]];
+        sparse_vector const & u = m_U[k];
+        for (unsigned i = 0; i < u.size(); i++)
+            s -= u[i].m_val * m_tmp[u[i].m_idx];
+        m_tmp[m_pivot_col[k]] = s / m_U_diag[k];
+    }
+    x.swap(m_tmp);
+    for (unsigned k = 0; k < m_updates.size(); k++) {
+        eta const & e = m_updates[k];
+        double xp = x[e.m_row] / e.m_pivot;
+        x[e.m_row] = xp;
+        if (xp == 0.0)
+            continue;
+        for (unsigned i = 0; i < e.m_entries.size(); i++)
+            x[e.m_entries[i].m_idx] -= e.m_entries[i].m_val * xp;
+    }
+}
+
+void sparse_lu::btran(dense_vector & y) const {
+    SASSERT(y.size() == m_dim);
+    for (unsigned k = m_updates.size(); k-- > 0; ) {
+        eta const & e = m_updates[k];
+        double w = y[e.m_row];
+        for (unsigned i = 0; i < e.m_entries.size(); i++)
+            w -= e.m_entries[i].m_val * y[e.m_entries[i].m_idx];
+        y[e.m_row] = w / e.m_pivot;
+    }
+    m_tmp.resize(m_dim, 0.0);
+    for (unsigned k = 0; k < m_dim; k++) {
+        double z = y[m_pivot_col[k]] / m_U_diag[k];
+        m_tmp[m_pivot_row[k]] = z;
+        if (z == 0.0)
+            continue;
+        sparse_vector const & u = m_U[k];
+        for (unsigned i = 0; i < u.size(); i++)
+            y[u[i].m_idx] -= u[i].m_val * z;
+    }
+    y.swap(m_tmp);
+    for (unsigned k = m_L.size(); k-- > 0; ) {
+        eta const & l = m_L[k];
+        double s = y[l.m_row];
+        for (unsigned i = 0; i < l.m_entries.size(); i++)
+            s -= l.m_entries[i].m_val * y[l.m_entries[i].m_idx];
+        y[l.m_row] = s;
+    }
+}
+
+bool sparse_lu::update(unsigned c, dense_vector const & alpha) {
+    SASSERT(alpha.size() == m_dim);
+    if (fabs(alpha[c]) < 1e-9)
+        return false;
+    m_updates.push_back(eta());
+    eta & e   = m_updates.back();
+    e.m_row   = c;
+    e.m_pivot = alpha[c];
+    for (unsigned i = 0; i < m_dim; i++) {
+        if (i != c && fabs(alpha[i]) > m_zero_tol)
+            e.m_entries.push_back(entry(i, alpha[i]));
+    }
+    return true;
+}
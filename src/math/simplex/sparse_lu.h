@@ -0,0 +1,122 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sparse_lu.h
+
+Abstract:
+
+    Sparse LU factorization of a square matrix in double precision.
+    It provides the operations used by a revised simplex procedure:
+    solving B x = b (ftran), y B = d (btran), and replacing a column
+    of B (product form update).
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Revision History:
+
+--*/
+#ifndef _SPARSE_LU_H_
+#define _SPARSE_LU_H_
+
+#include"vector.h"
+
+class sparse_lu {
+public:
+    struct entry {
+        unsigned m_idx;
+        double   m_val;
+        entry():m_idx(0), m_val(0.0) {}
+        entry(unsigned idx, double val):m_idx(idx), m_val(val) {}
+    };
+    typedef svector<entry>  sparse_vector;
+    typedef svector<double> dense_vector;
+
+private:
+    /**
+       \brief Elimination step k: b[m_idx] -= m_val * b[m_row] for each entry.
+       It is also used to store product form updates:
+       column m_row of the update matrix is (m_pivot, m_entries).
+    */
+    struct eta {
+        unsigned      m_row;
+        double        m_pivot;
+        sparse_vector m_entries;
+        eta():m_row(0), m_pivot(1.0) {}
+    };
+
+    unsigned              m_dim;
+    double                m_threshold;      // threshold for partial pivoting
+    double                m_zero_tol;       // values below this tolerance are considered zero
+    unsigned              m_search_limit;   // number of columns considered in the Markowitz search
+
+    vector<eta>           m_L;              // elimination steps
+    vector<sparse_vector> m_U;              // m_U[k] is the (off-diagonal part of) the k-th pivot row
+    dense_vector          m_U_diag;
+    unsigned_vector       m_pivot_row;      // m_pivot_row[k] = row of the k-th pivot
+    unsigned_vector       m_pivot_col;      // m_pivot_col[k] = column of the k-th pivot
+    vector<eta>           m_updates;        // product form updates since the last factorization
+
+    // temporary data used during the factorization
+    vector<sparse_vector> m_rows;
+    vector<unsigned_vector> m_col_rows;
+    unsigned_vector       m_col_count;
+    unsigned_vector       m_count_head;     // m_count_head[k]: first active column with k entries
+    unsigned_vector       m_next;
+    unsigned_vector       m_prev;
+    svector<bool>         m_row_active;
+    int_vector            m_pos;            // temporary: position of a column in a row
+    mutable dense_vector  m_tmp;
+
+    void reset();
+    void link_col(unsigned c);
+    void unlink_col(unsigned c);
+    void inc_col_count(unsigned c);
+    void dec_col_count(unsigned c, unsigned r);
+    static double max_abs(sparse_vector const & r);
+    bool select_pivot(unsigned & r, unsigned & c, double & v);
+    void eliminate(unsigned r, unsigned c, double v);
+
+public:
+    sparse_lu();
+
+    unsigned dim() const { return m_dim; }
+
+    unsigned num_updates() const { return m_updates.size(); }
+
+    /**
+       \brief Return the number of nonzero entries in the factors.
+    */
+    unsigned size() const;
+
+    /**
+       \brief Factorize the dim x dim matrix B whose i-th column is cols[i].
+       The entries of the columns are indexed by row.
+       Return false if B is (numerically) singular.
+    */
+    bool factorize(unsigned dim, vector<sparse_vector> const & cols);
+
+    /**
+       \brief Replace x by B^{-1} x.
+       The input is indexed by rows, and the output by columns.
+    */
+    void ftran(dense_vector & x) const;
+
+    /**
+       \brief Replace y by y B^{-1}.
+       The input is indexed by columns, and the output by rows.
+    */
+    void btran(dense_vector & y) const;
+
+    /**
+       \brief Replace the column c of B with a new column a.
+       alpha must be B^{-1} a (i.e., the result of ftran for a).
+       Return false if alpha[c] is too small.
+    */
+    bool update(unsigned c, dense_vector const & alpha);
+};
+
+#endif /* _SPARSE_LU_H_ */
@@ -26,7 +26,8 @@ namespace sat {
 
     asymm_branch::asymm_branch(solver & _s, params_ref const & p):
         s(_s),
-        m_counter(0) {
+        m_counter(0),
+        m_budget(UINT_MAX) {
         updt_params(p);
         reset_statistics();
     }
@@ -69,7 +70,7 @@ namespace sat {
         report rpt(*this);
         svector<char> saved_phase(s.m_phase);
         m_counter  = 0; // counter is moving down to capture propagate cost.
-        int limit  = -static_cast<int>(m_asymm_branch_limit);
+        int limit  = -static_cast<int>(std::min(m_asymm_branch_limit, m_budget));
         std::stable_sort(s.m_clauses.begin(), s.m_clauses.end(), clause_size_lt());
         m_counter -= s.m_clauses.size();
         SASSERT(s.m_qhead == s.m_trail.size());
@@ -165,7 +166,7 @@ namespace sat {
             literal l = c[i];
             switch (s.value(l)) {
             case l_undef:
-                c[j] = l;
+                std::swap(c[j], c[i]);
                 j++;
                 break;
             case l_false:
@@ -177,6 +178,10 @@ namespace sat {
         }
         new_sz = j;
         m_elim_literals += sz - new_sz;
+        if (s.m_config.m_drat) {
+            // c[0 .. new_sz) is a RUP clause: propagating the negation of its literals yields a conflict
+            s.m_drat.add(new_sz, c.begin());
+        }
         switch(new_sz) {
         case 0:
             s.set_conflict(justification());
@@ -195,6 +200,8 @@ namespace sat {
             SASSERT(s.m_qhead == s.m_trail.size());
             return false;
         default:
+            if (s.m_config.m_drat)
+                s.m_drat.del(c);
             c.shrink(new_sz);
             s.attach_clause(c);
             SASSERT(s.m_qhead == s.m_trail.size());
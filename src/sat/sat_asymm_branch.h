@@ -36,6 +36,7 @@ namespace sat {
         bool                   m_asymm_branch;
         unsigned               m_asymm_branch_rounds;
         unsigned               m_asymm_branch_limit;
+        unsigned               m_budget; // max cost per round set by the inprocessing scheduler
 
         // stats
         unsigned m_elim_literals;
@@ -53,6 +54,10 @@ namespace sat {
         void reset_statistics();
 
         void dec(unsigned c) { m_counter -= c; }
+
+        void set_budget(unsigned b) { m_budget = b; }
+
+        unsigned num_reductions() const { return m_elim_literals; }
     };
 
 };
@@ -31,7 +31,8 @@ namespace sat {
         m_used(false),
         m_frozen(false),
         m_reinit_stack(false),
-        m_inact_rounds(0) {
+        m_inact_rounds(0),
+        m_offset(UINT_MAX) {
         memcpy(m_lits, lits, sizeof(literal) * sz);
         mark_strengthened();
         SASSERT(check_approx());
@@ -118,71 +119,176 @@ namespace sat {
         }
     }
 
+    const unsigned clause_allocator::c_word_bits;
+    const unsigned clause_allocator::c_chunk_bits;
+    const unsigned clause_allocator::c_word_mask;
+    const unsigned clause_allocator::c_max_chunks;
+    const unsigned clause_allocator::c_max_chunk_words;
+    const unsigned clause_allocator::c_init_chunk_words;
+    const unsigned clause_allocator::c_max_free_words;
+    const unsigned clause_allocator::c_min_compact_words;
+    const unsigned clause_allocator::c_null_offset;
+
     clause_allocator::clause_allocator():
-        m_allocator("clause-allocator") {
-#ifdef _AMD64_
-        m_num_segments = 0;
-#endif
-    }
-
-    clause * clause_allocator::get_clause(clause_offset cls_off) const {
-#ifdef _AMD64_
-        return reinterpret_cast<clause *>(m_segments[cls_off & c_aligment_mask] + (static_cast<size_t>(cls_off) & ~c_aligment_mask));
-#else
-        return reinterpret_cast<clause *>(cls_off);
-#endif
-    }
-
-#ifdef _AMD64_
-    unsigned clause_allocator::get_segment(size_t ptr) {
-        SASSERT((ptr & c_aligment_mask) == 0);
-        ptr &= ~0xFFFFFFFFull; // Keep only high part
-        unsigned i = 0;
-        for (i = 0; i < m_num_segments; ++i)
-            if (m_segments[i] == ptr)
-                return i;
-        i = m_num_segments;
-        m_num_segments++;
-        if (i > c_max_segments)
-            throw default_exception("segment out of range");
-        m_segments[i] = ptr;
-        return i;
-    }
-#endif
-
-    clause_offset clause_allocator::get_offset(clause const * ptr) const {
-#ifdef _AMD64_
-        return static_cast<unsigned>(reinterpret_cast<size_t>(ptr)) + const_cast<clause_allocator*>(this)->get_segment(reinterpret_cast<size_t>(ptr));
-#else
-        return reinterpret_cast<size_t>(ptr);
-#endif
+        m_curr_chunk(UINT_MAX),
+        m_curr_top(0),
+        m_next_chunk_words(c_init_chunk_words),
+        m_total_words(0),
+        m_live_words(0),
+        m_free_words(0),
+        m_num_compactions(0) {
+        m_free.resize(c_max_free_words + 1, c_null_offset);
     }
-    
+
+    clause_allocator::~clause_allocator() {
+        for (unsigned i = 0; i < m_chunks.size(); i++) {
+            if (m_chunks[i] != 0)
+                memory::deallocate(m_chunks[i]);
+        }
+    }
+
+    unsigned clause_allocator::mk_chunk(unsigned num_words) {
+        unsigned idx;
+        if (!m_free_chunks.empty()) {
+            idx = m_free_chunks.back();
+            m_free_chunks.pop_back();
+        }
+        else {
+            idx = m_chunks.size();
+            if (idx >= c_max_chunks)
+                throw default_exception("clause arena out of range");
+            m_chunks.push_back(0);
+            m_chunk_words.push_back(0);
+            m_big_chunk.push_back(false);
+        }
+        m_chunks[idx]      = static_cast<char*>(memory::allocate(static_cast<size_t>(num_words) << c_word_bits));
+        m_chunk_words[idx] = num_words;
+        m_big_chunk[idx]   = false;
+        m_total_words     += num_words;
+        return idx;
+    }
+
+    void clause_allocator::del_chunk(unsigned idx) {
+        SASSERT(m_chunks[idx] != 0);
+        SASSERT(idx != m_curr_chunk);
+        memory::deallocate(m_chunks[idx]);
+        m_total_words     -= m_chunk_words[idx];
+        m_chunks[idx]      = 0;
+        m_chunk_words[idx] = 0;
+        m_free_chunks.push_back(idx);
+    }
+
+    clause_offset clause_allocator::allocate(unsigned num_words) {
+        if (num_words > c_max_free_words) {
+            unsigned idx = mk_chunk(num_words);
+            m_big_chunk[idx] = true;
+            return idx << c_chunk_bits;
+        }
+        unsigned & head = m_free[num_words];
+        if (head != c_null_offset) {
+            clause_offset r = head;
+            head = *reinterpret_cast<unsigned*>(get_ptr(r));
+            m_free_words -= num_words;
+            return r;
+        }
+        if (m_curr_chunk == UINT_MAX || m_curr_top + num_words > m_chunk_words[m_curr_chunk]) {
+            m_curr_chunk       = mk_chunk(m_next_chunk_words);
+            m_curr_top         = 0;
+            m_next_chunk_words = std::min(2 * m_next_chunk_words, c_max_chunk_words);
+        }
+        clause_offset r = (m_curr_chunk << c_chunk_bits) | m_curr_top;
+        m_curr_top += num_words;
+        return r;
+    }
+
     clause * clause_allocator::mk_clause(unsigned num_lits, literal const * lits, bool learned) {
-        size_t size = clause::get_obj_size(num_lits);
-#ifdef _AMD64_
-        size_t slot = size >> c_cls_alignment;
-        if ((size & c_aligment_mask) != 0)
-            slot++;
-        size = slot << c_cls_alignment;
-#endif
-        void * mem = m_allocator.allocate(size);
-        clause * cls = new (mem) clause(m_id_gen.mk(), num_lits, lits, learned);
+        unsigned num_words = get_num_words(num_lits);
+        clause_offset off  = allocate(num_words);
+        clause * cls = new (get_ptr(off)) clause(m_id_gen.mk(), num_lits, lits, learned);
+        cls->m_offset = off;
+        m_live_words += num_words;
+        SASSERT(get_clause(off) == cls);
         SASSERT(!learned || cls->is_learned());
         return cls;
     }
 
     void clause_allocator::del_clause(clause * cls) {
         m_id_gen.recycle(cls->id());
-        size_t size = clause::get_obj_size(cls->m_capacity);
-#ifdef _AMD64_
-        size_t slot = size >> c_cls_alignment;
-        if ((size & c_aligment_mask) != 0)
-            slot++;
-        size = slot << c_cls_alignment;
-#endif
+        unsigned num_words = get_num_words(cls->m_capacity);
+        clause_offset off  = cls->m_offset;
+        SASSERT(get_clause(off) == cls);
+        m_live_words -= num_words;
         cls->~clause();
-        m_allocator.deallocate(size, cls);
+        if (num_words > c_max_free_words) {
+            del_chunk(off >> c_chunk_bits);
+        }
+        else {
+            unsigned & head = m_free[num_words];
+            *reinterpret_cast<unsigned*>(cls) = head;
+            head = off;
+            m_free_words += num_words;
+        }
+    }
+
+    size_t clause_allocator::wasted_words() const {
+        // the end of the current chunk is available for new clauses.
+        size_t unused = m_curr_chunk == UINT_MAX ? 0 : m_chunk_words[m_curr_chunk] - m_curr_top;
+        return m_total_words - m_live_words - unused;
+    }
+
+    bool clause_allocator::fragmented() const {
+        return m_total_words >= c_min_compact_words && 2 * wasted_words() > m_live_words;
+    }
+
+    void clause_allocator::begin_compaction() {
+        SASSERT(m_old_chunks.empty());
+        size_t small_words = m_live_words;
+        for (unsigned i = 0; i < m_chunks.size(); i++) {
+            if (m_chunks[i] == 0)
+                continue;
+            if (m_big_chunk[i])
+                small_words -= m_chunk_words[i];
+            else
+                m_old_chunks.push_back(i);
+        }
+        // the free lists and the current chunk are in the old chunks.
+        for (unsigned i = 0; i < m_free.size(); i++)
+            m_free[i] = c_null_offset;
+        m_free_words       = 0;
+        m_curr_chunk       = UINT_MAX;
+        m_curr_top         = 0;
+        m_next_chunk_words = static_cast<unsigned>(std::max(static_cast<size_t>(c_init_chunk_words),
+                                                            std::min(small_words, static_cast<size_t>(c_max_chunk_words))));
+    }
+
+    clause * clause_allocator::relocate(clause * c) {
+        if (is_big(c))
+            return c;
+        unsigned old_num_words = get_num_words(c->m_capacity);
+        unsigned num_words     = get_num_words(c->m_size);
+        clause_offset off      = allocate(num_words);
+        clause * r = reinterpret_cast<clause *>(get_ptr(off));
+        memcpy(r, c, clause::get_obj_size(c->m_size));
+        r->m_capacity = c->m_size;
+        r->m_offset   = off;
+        // c->m_offset is used to forward references to the old location of c.
+        c->m_offset   = off;
+        m_live_words -= old_num_words - num_words;
+        return r;
+    }
+
+    void clause_allocator::end_compaction() {
+        for (unsigned i = 0; i < m_old_chunks.size(); i++)
+            del_chunk(m_old_chunks[i]);
+        m_old_chunks.reset();
+        m_num_compactions++;
+    }
+
+    void clause_allocator::collect_statistics(statistics & st) const {
+        st.update("clause arena compactions", m_num_compactions);
+        st.update("clause arena mb", static_cast<double>(m_total_words << c_word_bits) / static_cast<double>(1024 * 1024));
+        if (m_total_words > 0)
+            st.update("clause arena fragmentation", 100.0 * static_cast<double>(wasted_words()) / static_cast<double>(m_total_words));
     }
 
     std::ostream & operator<<(std::ostream & out, clause const & c) {
@@ -20,8 +20,8 @@ Revision History:
 #define _SAT_CLAUSE_H_
 
 #include"sat_types.h"
-#include"small_object_allocator.h"
 #include"id_gen.h"
+#include"statistics.h"
 
 #ifdef _MSC_VER
 #pragma warning(disable : 4200)
@@ -48,6 +48,7 @@ namespace sat {
         unsigned           m_inact_rounds:8;
         unsigned           m_glue:8; 
         unsigned           m_psm:8;  // transient field used during gc
+        clause_offset      m_offset; // position of the clause in the clause_allocator
         literal            m_lits[0];
 
         static size_t get_obj_size(unsigned num_lits) { return sizeof(clause) + num_lits * sizeof(literal); }
@@ -119,25 +120,83 @@ namespace sat {
     };
 
     /**
-       \brief Simple clause allocator that allows uint (32bit integers) to be used to reference clauses (even in 64bit machines).
+       \brief Clause allocator that allows uint (32bit integers) to be used to reference clauses (even in 64bit machines).
+
+       Clauses are stored in a sequence of memory chunks (the clause arena). A clause_offset
+       is of the form (chunk_idx << c_chunk_bits) | word_idx, where word_idx is the position
+       of the clause in the chunk in 8-byte words. So, consecutively allocated clauses are
+       adjacent in memory.
+
+       The memory of deleted clauses is recycled using free lists indexed by the size of
+       the clause in words. Very big clauses are stored in their own chunks.
+       When the arena becomes fragmented, the solver compacts it by moving the live clauses
+       to fresh chunks (see begin_compaction).
     */
     class clause_allocator {
-        small_object_allocator m_allocator;
+        static const unsigned  c_word_bits         = 3;
+        static const unsigned  c_chunk_bits        = 18;
+        static const unsigned  c_word_mask         = (1u << c_chunk_bits) - 1;
+        static const unsigned  c_max_chunks        = 1u << (32 - c_chunk_bits);
+        static const unsigned  c_max_chunk_words   = 1u << c_chunk_bits;
+        static const unsigned  c_init_chunk_words  = 1u << 11;
+        static const unsigned  c_max_free_words    = 1u << 10; // bigger clauses are stored in their own chunks
+        static const unsigned  c_min_compact_words = 1u << 16; // small arenas are not compacted
+        static const unsigned  c_null_offset       = UINT_MAX;
         id_gen                 m_id_gen;
-#ifdef _AMD64_
-        unsigned get_segment(size_t ptr);
-        static const unsigned  c_cls_alignment = 3; 
-        static const unsigned  c_max_segments  = 1 << c_cls_alignment;
-        static const size_t    c_aligment_mask = (1ull << c_cls_alignment) - 1ull;
-        unsigned               m_num_segments;
-        size_t                 m_segments[c_max_segments];
-#endif
+        ptr_vector<char>       m_chunks;
+        unsigned_vector        m_chunk_words;    // size of each chunk in words
+        svector<bool>          m_big_chunk;      // true if the chunk contains a single big clause
+        unsigned_vector        m_free_chunks;    // indices of deallocated chunks
+        unsigned_vector        m_old_chunks;     // chunks being evacuated by a compaction
+        unsigned               m_curr_chunk;     // chunk used for allocating new clauses
+        unsigned               m_curr_top;       // number of words used in the current chunk
+        unsigned               m_next_chunk_words;
+        unsigned_vector        m_free;           // m_free[n] is a list of free blocks of n words
+        size_t                 m_total_words;    // words in all chunks
+        size_t                 m_live_words;     // words used by live clauses
+        size_t                 m_free_words;     // words in the free lists
+        unsigned               m_num_compactions;
+        static unsigned get_num_words(unsigned num_lits) { return static_cast<unsigned>((clause::get_obj_size(num_lits) + 7) >> c_word_bits); }
+        unsigned mk_chunk(unsigned num_words);
+        void del_chunk(unsigned idx);
+        clause_offset allocate(unsigned num_words);
+        char * get_ptr(clause_offset off) const {
+            return m_chunks[off >> c_chunk_bits] + (static_cast<size_t>(off & c_word_mask) << c_word_bits);
+        }
+        bool is_big(clause const * c) const { return m_big_chunk[c->m_offset >> c_chunk_bits]; }
+        size_t wasted_words() const;
     public:
         clause_allocator();
-        clause *      get_clause(clause_offset cls_off) const;
-        clause_offset get_offset(clause const * ptr) const;
+        ~clause_allocator();
+        clause *      get_clause(clause_offset cls_off) const { return reinterpret_cast<clause *>(get_ptr(cls_off)); }
+        clause_offset get_offset(clause const * ptr) const { return ptr->m_offset; }
         clause *      mk_clause(unsigned num_lits, literal const * lits, bool learned);
         void          del_clause(clause * cls);
+
+        /**
+           \brief Return true if a significant part of the arena is not used by live clauses.
+        */
+        bool fragmented() const;
+
+        /**
+           \brief Compaction is performed in three steps:
+
+           1) begin_compaction()
+
+           2) relocate(c) for every live clause c. It copies c to a fresh chunk and returns its new address.
+              Afterwards, new_offset and get_relocated map the old offset/address of c to the new one.
+              References to relocated clauses must be updated before the next step.
+
+           3) end_compaction() releases the old chunks.
+        */
+        void          begin_compaction();
+        clause *      relocate(clause * c);
+        clause_offset new_offset(clause_offset old_off) const { return get_clause(old_off)->m_offset; }
+        clause *      get_relocated(clause * old) const { return get_clause(old->m_offset); }
+        void          end_compaction();
+
+        void collect_statistics(statistics & st) const;
+        void reset_statistics() { m_num_compactions = 0; }
     };
 
     /**
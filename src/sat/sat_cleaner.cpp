@@ -99,7 +99,7 @@ namespace sat {
                     m_elim_literals++;
                     break;
                 case l_undef:
-                    c[j] = c[i];
+                    std::swap(c[j], c[i]);
                     j++;
                     break;
                 }
@@ -114,6 +114,8 @@ namespace sat {
             }
             else {
                 unsigned new_sz = j;
+                if (s.m_config.m_drat && new_sz < sz)
+                    s.m_drat.add(new_sz, c.begin());
                 CTRACE("sat_cleaner_bug", new_sz < 2, tout << "new_sz: " << new_sz << "\n";
                        if (c.size() > 0) tout << "unit: " << c[0] << "\n";);
                 SASSERT(c.frozen() || new_sz >= 2);
@@ -139,6 +141,8 @@ namespace sat {
                         s.del_clause(c);
                     }
                     else {
+                        if (s.m_config.m_drat && new_sz < sz)
+                            s.m_drat.del(c);
                         c.shrink(new_sz);
                         *it2 = *it;
                         it2++;
@@ -29,11 +29,13 @@ namespace sat {
         m_random("random"),
         m_geometric("geometric"),
         m_luby("luby"),
+        m_ema("ema"),
         m_dyn_psm("dyn_psm"),
         m_psm("psm"),
         m_glue("glue"),
         m_glue_psm("glue_psm"),
-        m_psm_glue("psm_glue") {
+        m_psm_glue("psm_glue"),
+        m_tiers("tiers") {
         updt_params(p); 
     }
 
@@ -46,6 +48,8 @@ namespace sat {
             m_restart = RS_LUBY;
         else if (s == m_geometric)
             m_restart = RS_GEOMETRIC;
+        else if (s == m_ema)
+            m_restart = RS_EMA;
         else
             throw sat_param_exception("invalid restart strategy");
 
@@ -66,6 +70,11 @@ namespace sat {
 
         m_restart_initial = p.restart_initial();
         m_restart_factor  = p.restart_factor();
+        m_restart_min     = p.restart_min();
+        m_restart_margin  = p.restart_margin();
+        m_restart_ema_fast = p.restart_ema_fast();
+        m_restart_ema_slow = p.restart_ema_slow();
+        m_restart_blocking = p.restart_blocking();
         
         m_random_freq     = p.random_freq();
         m_random_seed     = p.random_seed();
@@ -101,13 +110,30 @@ namespace sat {
                 m_gc_strategy = GC_PSM;
             else if (s == m_psm_glue)
                 m_gc_strategy = GC_PSM_GLUE;
+            else if (s == m_tiers)
+                m_gc_strategy = GC_TIERS;
             else 
                 throw sat_param_exception("invalid gc strategy");
             m_gc_initial      = p.gc_initial();
             m_gc_increment    = p.gc_increment();
         }
+        m_gc_tier1_glue   = p.gc_tier1_glue();
+        m_gc_tier2_glue   = p.gc_tier2_glue();
+        m_gc_defrag       = p.gc_defrag();
+        m_inprocess       = p.inprocess();
+        m_inprocess_effort     = p.inprocess_effort();
+        m_inprocess_min_effort = p.inprocess_min_effort();
+        m_inprocess_max_delay  = p.inprocess_max_delay();
+        m_drat_file       = p.drat_file();
+        m_drat            = m_drat_file.size() > 0;
+        m_drat_cnf_file   = p.drat_cnf();
+        if (m_drat && m_drat_cnf_file.size() == 0)
+            m_drat_cnf_file = symbol((m_drat_file.str() + ".cnf").c_str());
+        m_drat_binary     = p.drat_binary();
         m_minimize_lemmas = p.minimize_lemmas();
         m_dyn_sub_res     = p.dyn_sub_res();
+        m_num_threads     = p.threads();
+        m_par_max_glue    = p.par_max_glue();
     }
 
     void config::collect_param_descrs(param_descrs & r) {
@@ -0,0 +1,221 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_drat.cpp
+
+Abstract:
+
+    Produce DRAT proofs (text or binary format) for unsatisfiable problems.
+
+Author:
+
+    agent (agent) 2026-10-16.
+
+Revision History:
+
+--*/
+#include"sat_drat.h"
+#include<fstream>
+#include<iomanip>
+
+namespace sat {
+
+    const unsigned c_drat_buffer_size = 1 << 20;
+    // width of the numbers in the DIMACS header, they are written when the proof is closed.
+    const unsigned c_cnf_header_width = 10;
+
+    drat::drat():
+        m_out(0),
+        m_cnf(0),
+        m_binary(false),
+        m_num_vars(0),
+        m_num_input(0) {
+        reset_statistics();
+    }
+
+    drat::~drat() {
+        close();
+    }
+
+    static std::ofstream * open_file(char const * file_name) {
+        std::ofstream * out = alloc(std::ofstream, file_name, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+        if (out->bad() || out->fail()) {
+            dealloc(out);
+            throw solver_exception("failed to open DRAT proof file");
+        }
+        return out;
+    }
+
+    void drat::open(char const * file_name, char const * cnf_file_name, bool binary) {
+        close();
+        m_cnf = open_file(cnf_file_name);
+        try {
+            m_out = open_file(file_name);
+        }
+        catch (...) {
+            dealloc(m_cnf);
+            m_cnf = 0;
+            throw;
+        }
+        m_binary    = binary;
+        m_num_vars  = 0;
+        m_num_input = 0;
+        write_cnf_header();
+        m_buffer.resize(c_drat_buffer_size + 1024); // preallocate
+        m_buffer.reset();
+        m_pending.resize(c_drat_buffer_size + 1024);
+        m_pending.reset();
+    }
+
+    void drat::write_cnf_header() {
+        *m_cnf << "p cnf " << std::setw(c_cnf_header_width) << m_num_vars
+               << " " << std::setw(c_cnf_header_width) << m_num_input << "\n";
+    }
+
+    void drat::close() {
+        if (m_out == 0)
+            return;
+        flush();
+        wait_pending();
+        m_out->flush();
+        dealloc(m_out);
+        m_out = 0;
+        m_buffer.finalize();
+        m_pending.finalize();
+        // the header has a fixed width, so it is overwritten with the final numbers.
+        m_cnf->seekp(0);
+        write_cnf_header();
+        m_cnf->flush();
+        dealloc(m_cnf);
+        m_cnf = 0;
+    }
+
+    void drat::add_input(unsigned num_lits, literal const * lits) {
+        SASSERT(m_cnf);
+        for (unsigned i = 0; i < num_lits; i++) {
+            unsigned v = lits[i].var() + 1;
+            if (v > m_num_vars)
+                m_num_vars = v;
+            *m_cnf << (lits[i].sign() ? "-" : "") << v << " ";
+        }
+        *m_cnf << "0\n";
+        m_num_input++;
+    }
+
+    /**
+       \brief Write the block handed over by flush.
+    */
+    void drat::write_pending() {
+        m_out->write(m_pending.c_ptr(), m_pending.size());
+        m_pending.reset();
+    }
+
+    void drat::wait_pending() {
+#ifdef SAT_DRAT_TASKS
+        #pragma omp taskwait
+#endif
+    }
+
+    /**
+       \brief Hand the current block to a writer task. Inside the parallel region of
+       solver::check_drat, the task is executed by the other thread of the team.
+       Otherwise, it is executed by the current thread.
+    */
+    void drat::flush() {
+        if (m_buffer.empty())
+            return;
+        // the previous block must be written before m_pending is reused.
+        wait_pending();
+        m_buffer.swap(m_pending);
+#ifdef SAT_DRAT_TASKS
+        #pragma omp task
+#endif
+        write_pending();
+        SASSERT(m_buffer.empty());
+    }
+
+    void drat::begin_record(bool del) {
+        SASSERT(m_out);
+        if (del)
+            m_num_del++;
+        else
+            m_num_add++;
+        if (m_binary) {
+            m_buffer.push_back(del ? 'd' : 'a');
+        }
+        else if (del) {
+            m_buffer.push_back('d');
+            m_buffer.push_back(' ');
+        }
+    }
+
+    void drat::dump_lit(literal l) {
+        unsigned v = l.var() + 1;
+        if (v > m_num_vars)
+            m_num_vars = v;
+        if (m_binary) {
+            // the literal is encoded as 2*v + sign, using 7 bits per byte (the most significant bit marks continuation).
+            unsigned u = 2 * v + (l.sign() ? 1 : 0);
+            while (u > 0x7f) {
+                m_buffer.push_back(static_cast<char>((u & 0x7f) | 0x80));
+                u >>= 7;
+            }
+            m_buffer.push_back(static_cast<char>(u));
+        }
+        else {
+            if (l.sign())
+                m_buffer.push_back('-');
+            char digits[16];
+            unsigned u = v;
+            unsigned n = 0;
+            do {
+                digits[n++] = static_cast<char>('0' + u % 10);
+                u /= 10;
+            }
+            while (u > 0);
+            while (n > 0)
+                m_buffer.push_back(digits[--n]);
+            m_buffer.push_back(' ');
+        }
+    }
+
+    void drat::end_record() {
+        if (m_binary) {
+            m_buffer.push_back(0);
+        }
+        else {
+            m_buffer.push_back('0');
+            m_buffer.push_back('\n');
+        }
+        if (m_buffer.size() >= c_drat_buffer_size)
+            flush();
+    }
+
+    void drat::dump(unsigned num_lits, literal const * lits, bool del) {
+        begin_record(del);
+        for (unsigned i = 0; i < num_lits; i++)
+            dump_lit(lits[i]);
+        end_record();
+    }
+
+    void drat::dump(clause const & c, bool del) {
+        begin_record(del);
+        unsigned sz = c.size();
+        for (unsigned i = 0; i < sz; i++)
+            dump_lit(c[i]);
+        end_record();
+    }
+
+    void drat::collect_statistics(statistics & st) const {
+        st.update("drat added clauses", m_num_add);
+        st.update("drat deleted clauses", m_num_del);
+    }
+
+    void drat::reset_statistics() {
+        m_num_add = 0;
+        m_num_del = 0;
+    }
+
+};
@@ -0,0 +1,101 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_drat.h
+
+Abstract:
+
+    Produce DRAT proofs (text or binary format) for unsatisfiable problems.
+    The solver logs every clause it derives, and the clauses it deletes
+    (see solver::del_clause).
+
+    When a clause is strengthened, the removed literals are swapped past
+    the new size, thus the original clause can still be logged as deleted
+    after the strengthened one is logged as added.
+
+    The input clauses (the clauses given to solver::mk_clause and solver::mk_def_clause)
+    are dumped in DIMACS format to a second file, thus the proof can be checked
+    (e.g., drat-trim input.cnf proof.drat).
+
+    Remark: the variable v is written as v+1 in both files, since 0 terminates a clause.
+    Remark: the proof is only meaningful for checks without assumptions and user scopes.
+    Remark: the records are formatted in a buffer. When the buffer is full, it is written
+    by an OpenMP task, while the solver keeps searching (see solver::check_drat).
+
+Author:
+
+    agent (agent) 2026-10-16.
+
+Revision History:
+
+--*/
+#ifndef _SAT_DRAT_H_
+#define _SAT_DRAT_H_
+
+#include"sat_types.h"
+#include"sat_clause.h"
+#include"statistics.h"
+#include<iosfwd>
+
+// The proof is written by OpenMP tasks, they were introduced in OpenMP 3.0.
+#if defined(_OPENMP) && _OPENMP >= 200805
+#define SAT_DRAT_TASKS
+#endif
+
+namespace sat {
+
+    class drat {
+        std::ostream * m_out;
+        std::ostream * m_cnf;
+        bool           m_binary;
+        // Records are accumulated in m_buffer, and written as a single block when it is full.
+        // Thus, the search does not pay for a stream operation per clause.
+        svector<char>  m_buffer;
+        // block being written by the writer task.
+        svector<char>  m_pending;
+        unsigned       m_num_vars;   // 1 + maximal variable in the proof and in the input clauses
+        unsigned       m_num_input;
+        unsigned       m_num_add;
+        unsigned       m_num_del;
+
+        void begin_record(bool del);
+        void dump_lit(literal l);
+        void end_record();
+        void dump(unsigned num_lits, literal const * lits, bool del);
+        void dump(clause const & c, bool del);
+        void write_pending();
+        void wait_pending();
+        void flush();
+        void write_cnf_header();
+    public:
+        drat();
+        ~drat();
+
+        void open(char const * file_name, char const * cnf_file_name, bool binary);
+        void close();
+        bool is_open() const { return m_out != 0; }
+
+        /**
+           \brief Dump an input clause to the DIMACS file.
+        */
+        void add_input(unsigned num_lits, literal const * lits);
+
+        void add() { dump(0, 0, false); } // empty clause
+        void add(literal l) { dump(1, &l, false); }
+        void add(literal l1, literal l2) { literal ls[2] = { l1, l2 }; dump(2, ls, false); }
+        void add(unsigned num_lits, literal const * lits) { dump(num_lits, lits, false); }
+        void add(clause const & c) { dump(c, false); }
+
+        void del(literal l1, literal l2) { literal ls[2] = { l1, l2 }; dump(2, ls, true); }
+        void del(unsigned num_lits, literal const * lits) { dump(num_lits, lits, true); }
+        void del(clause const & c) { dump(c, true); }
+
+        void collect_statistics(statistics & st) const;
+        void reset_statistics();
+    };
+
+};
+
+#endif
@@ -47,6 +47,13 @@ namespace sat {
                 if (it2->is_binary_clause()) {
                     literal l2 = it2->get_literal();
                     literal r2 = norm(roots, l2);
+                    // Remark: the binary clauses are not deleted from the DRAT proof, since they justify the substitution.
+                    if (m_solver.m_config.m_drat && (l1 != r1 || l2 != r2) && l1.index() < l2.index()) {
+                        if (r1 == r2)
+                            m_solver.m_drat.add(r1);
+                        else if (r1 != ~r2)
+                            m_solver.m_drat.add(r1, r2);
+                    }
                     if (r1 == r2) {
                         m_solver.assign(r1, justification());
                         if (m_solver.inconsistent())
@@ -60,7 +67,7 @@ namespace sat {
                     }
                     if (l1 != r1) {
                         // add half r1 => r2, the other half ~r2 => ~r1 is added when traversing l2 
-                        m_solver.m_watches[(~r1).index()].push_back(watched(r2, it2->is_learned()));
+                        insert_bin_watch(m_solver.m_watches[(~r1).index()], watched(r2, it2->is_learned()));
                         continue;
                     }
                     it2->set_literal(r2); // keep it
@@ -73,6 +80,9 @@ namespace sat {
     }
 
     void elim_eqs::cleanup_clauses(literal_vector const & roots, clause_vector & cs) {
+        // The normalized clause is built in new_lits, thus c is not modified
+        // before it is deleted, and del_clause logs the original clause in the DRAT proof.
+        literal_vector new_lits;
         clause_vector::iterator it  = cs.begin();
         clause_vector::iterator it2 = it;
         clause_vector::iterator end = cs.end();
@@ -96,17 +106,18 @@ namespace sat {
             if (!c.frozen())
                 m_solver.dettach_clause(c);
             // apply substitution
+            new_lits.reset();
             for (i = 0; i < sz; i++) {
                 SASSERT(!m_solver.was_eliminated(c[i].var()));
-                c[i] = norm(roots, c[i]);
+                new_lits.push_back(norm(roots, c[i]));
             }
-            std::sort(c.begin(), c.end());
-            TRACE("elim_eqs", tout << "after normalization/sorting: " << c << "\n";);
+            std::sort(new_lits.begin(), new_lits.end());
+            TRACE("elim_eqs", tout << "after normalization/sorting: " << mk_lits_pp(sz, new_lits.c_ptr()) << "\n";);
             // remove duplicates, and check if it is a tautology
             literal l_prev = null_literal;
             unsigned j = 0;
             for (i = 0; i < sz; i++) {
-                literal l = c[i];
+                literal l = new_lits[i];
                 if (l == l_prev)
                     continue;
                 if (l == ~l_prev)
@@ -117,7 +128,7 @@ namespace sat {
                     break; // clause was satisfied
                 if (val == l_false)
                     continue; // skip
-                c[j] = l;
+                new_lits[j] = l;
                 j++;
             }
             if (i < sz) {
@@ -125,34 +136,41 @@ namespace sat {
                 m_solver.del_clause(c);
                 continue; 
             }
+            if (m_solver.m_config.m_drat)
+                m_solver.m_drat.add(j, new_lits.c_ptr());
             if (j == 0) {
                 // empty clause
                 m_solver.set_conflict(justification());
                 return;
             }
-            TRACE("elim_eqs", tout << "after removing duplicates: " << c << " j: " << j << "\n";);
-            if (j < sz)
-                c.shrink(j);
-            else
-                c.update_approx();
-            SASSERT(c.size() == j);
+            TRACE("elim_eqs", tout << "after removing duplicates: " << mk_lits_pp(j, new_lits.c_ptr()) << " j: " << j << "\n";);
             DEBUG_CODE({
-                for (unsigned i = 0; i < c.size(); i++) {
-                    SASSERT(c[i] == norm(roots, c[i]));
+                for (unsigned i = 0; i < j; i++) {
+                    SASSERT(new_lits[i] == norm(roots, new_lits[i]));
                 }
             });
             SASSERT(j >= 1);
             switch (j) {
             case 1:
-                m_solver.assign(c[0], justification());
+                m_solver.assign(new_lits[0], justification());
                 m_solver.del_clause(c);
                 break;
             case 2:
-                m_solver.mk_bin_clause(c[0], c[1], c.is_learned());
+                m_solver.mk_bin_clause(new_lits[0], new_lits[1], c.is_learned());
                 m_solver.del_clause(c);
                 break;
             default:
                 SASSERT(*it == &c);
+                // c is updated in place
+                if (m_solver.m_config.m_drat)
+                    m_solver.m_drat.del(c);
+                for (i = 0; i < j; i++)
+                    c[i] = new_lits[i];
+                if (j < sz)
+                    c.shrink(j);
+                else
+                    c.update_approx();
+                SASSERT(c.size() == j);
                 *it2 = *it;
                 it2++;
                 if (!c.frozen())
@@ -174,6 +192,10 @@ namespace sat {
             SASSERT(v != r.var());
             if (m_solver.is_external(v)) {
                 // cannot really eliminate v, since we have to notify extension of future assignments
+                if (m_solver.m_config.m_drat) {
+                    m_solver.m_drat.add(~l, r);
+                    m_solver.m_drat.add(l, ~r);
+                }
                 m_solver.mk_bin_clause(~l, r, false);
                 m_solver.mk_bin_clause(l, ~r, false);
             }
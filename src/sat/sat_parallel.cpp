@@ -0,0 +1,135 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_parallel.cpp
+
+Abstract:
+
+    Portfolio of SAT solvers running in parallel.
+    The solvers share unit literals and short learned clauses.
+
+Author:
+
+    agent (agent) 2026-10-16.
+
+Revision History:
+
+--*/
+#include"sat_parallel.h"
+#include"sat_solver.h"
+
+namespace sat {
+
+    void parallel::clause_pool::reserve(unsigned num_owners, unsigned capacity) {
+        m_slots.reset();
+        m_slots.resize(capacity);
+        m_heads.reset();
+        m_heads.resize(num_owners, 0);
+        m_num_added = 0;
+    }
+
+    void parallel::clause_pool::add(unsigned owner, unsigned glue, unsigned num_lits, literal const * lits) {
+        SASSERT(!m_slots.empty());
+        slot & s   = m_slots[m_num_added % m_slots.size()];
+        s.m_owner  = owner;
+        s.m_glue   = glue;
+        s.m_lits.reset();
+        s.m_lits.append(num_lits, lits);
+        m_num_added++;
+    }
+
+    bool parallel::clause_pool::get(unsigned owner, unsigned & glue, literal_vector & lits) {
+        unsigned & head = m_heads[owner];
+        unsigned capacity = m_slots.size();
+        if (m_num_added - head > capacity) {
+            // the oldest clauses were overwritten.
+            head = m_num_added - capacity;
+        }
+        while (head < m_num_added) {
+            slot const & s = m_slots[head % capacity];
+            head++;
+            if (s.m_owner != owner) {
+                glue = s.m_glue;
+                lits.reset();
+                lits.append(s.m_lits);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    parallel::parallel() {
+    }
+
+    parallel::~parallel() {
+    }
+
+    void parallel::init_solvers(solver & s, unsigned num_extra_solvers) {
+        SASSERT(m_solvers.empty());
+        SASSERT(s.scope_lvl() == 0);
+        m_pool.reserve(num_extra_solvers + 1, 1 << 12);
+        m_units.reset();
+        m_unit_set.reset();
+        m_unit_set.resize(2 * s.num_vars(), false);
+        symbol restarts[2] = { symbol("geometric"), symbol("luby") };
+        symbol gcs[4]      = { symbol("glue"), symbol("psm"), symbol("dyn_psm"), symbol("psm_glue") };
+        for (unsigned i = 0; i < num_extra_solvers; i++) {
+            params_ref p;
+            p.copy(s.m_params);
+            p.set_uint("threads", 1);
+            p.set_uint("random_seed", s.m_config.m_random_seed + i + 1);
+            p.set_sym("restart", restarts[i % 2]);
+            p.set_sym("gc", gcs[i % 4]);
+            if (i % 3 == 2)
+                p.set_sym("phase", symbol("random"));
+            solver * new_s = alloc(solver, p, 0);
+            new_s->copy(s);
+            new_s->m_par    = this;
+            new_s->m_par_id = i;
+            m_solvers.push_back(new_s);
+        }
+        s.m_par    = this;
+        s.m_par_id = num_extra_solvers;
+    }
+
+    void parallel::set_cancel(bool f) {
+        for (unsigned i = 0; i < m_solvers.size(); i++)
+            m_solvers[i]->m_cancel = f;
+    }
+
+    void parallel::exchange(literal_vector const & in, unsigned & limit, literal_vector & out) {
+        #pragma omp critical (par_solver)
+        {
+            for (unsigned i = 0; i < in.size(); i++) {
+                literal l = in[i];
+                if (l.index() < m_unit_set.size() && !m_unit_set[l.index()]) {
+                    m_unit_set[l.index()] = true;
+                    m_units.push_back(l);
+                }
+            }
+            out.reset();
+            for (unsigned i = limit; i < m_units.size(); i++)
+                out.push_back(m_units[i]);
+            limit = m_units.size();
+        }
+    }
+
+    void parallel::share_clause(solver const & s, unsigned num_lits, literal const * lits, unsigned glue) {
+        #pragma omp critical (par_solver)
+        {
+            m_pool.add(s.m_par_id, glue, num_lits, lits);
+        }
+    }
+
+    bool parallel::get_clause(solver const & s, unsigned & glue, literal_vector & lits) {
+        bool r;
+        #pragma omp critical (par_solver)
+        {
+            r = m_pool.get(s.m_par_id, glue, lits);
+        }
+        return r;
+    }
+
+};
@@ -0,0 +1,100 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_parallel.h
+
+Abstract:
+
+    Portfolio of SAT solvers running in parallel.
+    The solvers share unit literals and short learned clauses.
+
+Author:
+
+    agent (agent) 2026-10-16.
+
+Revision History:
+
+--*/
+#ifndef _SAT_PARALLEL_H_
+#define _SAT_PARALLEL_H_
+
+#include"sat_types.h"
+#include"scoped_ptr_vector.h"
+
+namespace sat {
+
+    class parallel {
+
+        /**
+           \brief Bounded pool of shared clauses.
+
+           The pool is a ring buffer of m_slots.size() clauses. Each
+           solver keeps the (global) index of the next clause it has not
+           seen yet. If a solver falls behind by more than the capacity
+           of the pool, the oldest clauses are silently skipped.
+
+           All methods must be invoked inside the critical section par_solver.
+        */
+        class clause_pool {
+            struct slot {
+                unsigned       m_owner;
+                unsigned       m_glue;
+                literal_vector m_lits;
+            };
+            vector<slot>       m_slots;
+            unsigned           m_num_added;
+            unsigned_vector    m_heads;
+        public:
+            clause_pool():m_num_added(0) {}
+            void reserve(unsigned num_owners, unsigned capacity);
+            void add(unsigned owner, unsigned glue, unsigned num_lits, literal const * lits);
+            // Store in (glue, lits) the next clause not produced by owner.
+            // Return false if there is no such clause.
+            bool get(unsigned owner, unsigned & glue, literal_vector & lits);
+        };
+
+        scoped_ptr_vector<solver> m_solvers;
+        clause_pool               m_pool;
+        literal_vector            m_units;
+        svector<char>             m_unit_set;
+
+    public:
+        parallel();
+        ~parallel();
+
+        /**
+           \brief Create num_extra_solvers copies of s.
+           Each copy uses a different configuration (seed, restart, phase and gc strategies).
+        */
+        void init_solvers(solver & s, unsigned num_extra_solvers);
+
+        unsigned num_extra_solvers() const { return m_solvers.size(); }
+
+        solver & get_solver(unsigned i) { return *(m_solvers[i]); }
+
+        void set_cancel(bool f);
+
+        /**
+           \brief Publish the units in [in.begin(), in.end()), and store in out
+           the units published by other solvers since limit.
+           The limit is updated.
+        */
+        void exchange(literal_vector const & in, unsigned & limit, literal_vector & out);
+
+        /**
+           \brief Publish a learned clause produced by s.
+        */
+        void share_clause(solver const & s, unsigned num_lits, literal const * lits, unsigned glue);
+
+        /**
+           \brief Store in (glue, lits) the next learned clause published by
+           a solver different from s. Return false if there is none.
+        */
+        bool get_clause(solver const & s, unsigned & glue, literal_vector & lits);
+    };
+
+};
+
+#endif
@@ -22,7 +22,8 @@ Revision History:
 
 namespace sat {
     probing::probing(solver & _s, params_ref const & p):
-        s(_s) {
+        s(_s),
+        m_budget(UINT_MAX) {
         updt_params(p);
         reset_statistics();
         m_stopped_at = 0;
@@ -54,13 +55,27 @@ namespace sat {
         }
     }
 
+    /**
+       \brief Log the derivation of the unit l2 for the DRAT proof: l2 is implied by l and by m_probe,
+       where l is ~m_probe or l is the other literal of a binary clause containing m_probe.
+       The two binary clauses are RUP, and l2 is RUP given them.
+    */
+    void probing::drat_add_implied(literal l, literal l2) {
+        s.m_drat.add(~l, l2);
+        s.m_drat.add(~m_probe, l2);
+        s.m_drat.add(l2);
+        s.m_drat.del(~l, l2);
+        s.m_drat.del(~m_probe, l2);
+    }
+
     // Return true if should keep going.
     // It will assert literals implied by l that are already marked
     // as assigned.
     bool probing::try_lit(literal l, bool updt_cache) {
         SASSERT(s.m_qhead == s.m_trail.size());
         SASSERT(s.value(l.var()) == l_undef);
-        literal_vector * implied_lits = updt_cache ? 0 : cached_implied_lits(l);
+        // Remark: the cached implications may depend on deleted learned clauses, and cannot be justified in a DRAT proof.
+        literal_vector * implied_lits = updt_cache || s.m_config.m_drat ? 0 : cached_implied_lits(l);
         if (implied_lits) {
             literal_vector::iterator it  = implied_lits->begin();
             literal_vector::iterator end = implied_lits->end();
@@ -81,6 +96,8 @@ namespace sat {
             if (s.inconsistent()) {
                 // ~l must be true
                 s.pop(1);
+                if (s.m_config.m_drat)
+                    s.m_drat.add(~l);
                 s.assign(~l, justification());
                 s.propagate(false);
                 return false;
@@ -99,6 +116,8 @@ namespace sat {
             literal_vector::iterator it  = m_to_assert.begin();
             literal_vector::iterator end = m_to_assert.end();
             for (; it != end; ++it) {
+                if (s.m_config.m_drat)
+                    drat_add_implied(l, *it);
                 s.assign(*it, justification());
                 m_num_assigned++;
             }
@@ -120,6 +139,8 @@ namespace sat {
         if (s.inconsistent()) {
             // ~l must be true
             s.pop(1);
+            if (s.m_config.m_drat)
+                s.m_drat.add(~l);
             s.assign(~l, justification());
             s.propagate(false);
             m_num_assigned++;
@@ -134,6 +155,7 @@ namespace sat {
         cache_bins(l, old_tr_sz);
         s.pop(1);
 
+        m_probe = l;
         if (!try_lit(~l, true))
             return;
 
@@ -207,7 +229,7 @@ namespace sat {
         report rpt(*this);
         bool r    = true;
         m_counter = 0;
-        int limit = -static_cast<int>(m_probing_limit);
+        int limit = -static_cast<int>(std::min(m_probing_limit, m_budget));
         unsigned i;
         unsigned num = s.num_vars();
         for (i = 0; i < num; i++) {
@@ -30,6 +30,7 @@ namespace sat {
         solver &        s;
         unsigned        m_stopped_at;  // where did it stop
         literal_set     m_assigned;    // literals assigned in the first branch
+        literal         m_probe;       // literal assigned in the first branch (used in DRAT proofs)
         literal_vector  m_to_assert;
 
         // counters
@@ -38,6 +39,7 @@ namespace sat {
         // config
         bool               m_probing;             // enabled/disabled
         unsigned           m_probing_limit;       // max cost per round
+        unsigned           m_budget;              // max cost per round set by the inprocessing scheduler
         bool               m_probing_cache;       // cache implicit binary clauses
         bool               m_probing_binary;      // try l1 and l2 for binary clauses l1 \/ l2
         unsigned long long m_probing_cache_limit; // memory limit for enabling caching.
@@ -58,6 +60,7 @@ namespace sat {
         void reset_cache(literal l);
         void cache_bins(literal l, unsigned old_tr_sz);
         bool try_lit(literal l, bool updt_cache);
+        void drat_add_implied(literal l, literal l2);
         void process(bool_var v);
         void process_core(bool_var v);
 
@@ -85,6 +88,10 @@ namespace sat {
         }
 
         void dec(unsigned c) { m_counter -= c; }
+
+        void set_budget(unsigned b) { m_budget = b; }
+
+        unsigned num_reductions() const { return m_num_assigned; }
     };
 
 };
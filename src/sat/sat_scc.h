@@ -42,6 +42,8 @@ namespace sat {
 
         void collect_statistics(statistics & st) const;
         void reset_statistics();
+
+        unsigned num_reductions() const { return m_num_elim; }
     };
 };
 
@@ -57,7 +57,9 @@ namespace sat {
 
     simplifier::simplifier(solver & _s, params_ref const & p):
         s(_s),
-        m_num_calls(0) {
+        m_num_calls(0),
+        m_max_occ_size(UINT_MAX),
+        m_budget(UINT_MAX) {
         updt_params(p);
         reset_statistics();
     }
@@ -69,7 +71,8 @@ namespace sat {
 
     inline watch_list const & simplifier::get_wlist(literal l) const { return s.get_wlist(l); }
 
-    inline bool simplifier::is_external(bool_var v) const { return s.is_external(v); }
+    // Remark: variables occurring in problem clauses that are not in the use lists cannot be eliminated either.
+    inline bool simplifier::is_external(bool_var v) const { return s.is_external(v) || m_gated[v]; }
 
     inline bool simplifier::was_eliminated(bool_var v) const { return s.was_eliminated(v); }
 
@@ -79,17 +82,62 @@ namespace sat {
 
     inline void simplifier::checkpoint() { s.checkpoint(); }
 
+    /**
+       \brief Set m_max_occ_size, the maximal size of the clauses inserted in the use lists,
+       such that the number of literal occurrences in the use lists is at most m_occ_limit.
+    */
+    void simplifier::init_occ_gating(bool learned) {
+        m_max_occ_size = UINT_MAX;
+        m_gated.reset();
+        m_gated.resize(s.num_vars(), false);
+        unsigned_vector num_lits; // num_lits[i] is the number of literal occurrences in clauses of size i
+        unsigned long long total = 0;
+        for (unsigned i = 0; i < 2; i++) {
+            if (i == 1 && !learned)
+                break;
+            clause_vector const & cs = i == 0 ? s.m_clauses : s.m_learned;
+            clause_vector::const_iterator it  = cs.begin();
+            clause_vector::const_iterator end = cs.end();
+            for (; it != end; ++it) {
+                clause const & c = *(*it);
+                if (c.frozen())
+                    continue;
+                unsigned sz = c.size();
+                num_lits.reserve(sz + 1, 0);
+                num_lits[sz] += sz;
+                total        += sz;
+            }
+        }
+        if (total <= m_occ_limit)
+            return;
+        total = 0;
+        unsigned sz = 0;
+        for (; sz < num_lits.size(); sz++) {
+            total += num_lits[sz];
+            if (total > m_occ_limit)
+                break;
+        }
+        SASSERT(sz > 0);
+        m_max_occ_size = sz - 1;
+        IF_VERBOSE(SAT_VB_LVL, verbose_stream() << " (sat-simplifier :max-occ-clause-size " << m_max_occ_size << ")\n";);
+    }
+
     void simplifier::register_clauses(clause_vector & cs) {
         std::stable_sort(cs.begin(), cs.end(), size_lt());
         clause_vector::iterator it  = cs.begin();
         clause_vector::iterator end = cs.end();
         for (; it != end; ++it) {
             clause & c = *(*it);
-            if (!c.frozen()) {
+            if (in_use_lists(c)) {
                 m_use_list.insert(c);
                 if (c.strengthened())
                     m_sub_todo.insert(c);
             }
+            else if (!c.frozen() && !c.is_learned()) {
+                unsigned sz = c.size();
+                for (unsigned i = 0; i < sz; i++)
+                    m_gated[c[i].var()] = true;
+            }
         }
     }
 
@@ -128,6 +176,8 @@ namespace sat {
         m_sub_todo.finalize();
         m_sub_bin_todo.finalize();
         m_visited.finalize();
+        m_gated.finalize();
+        m_drat_lits.finalize();
         m_bs_cs.finalize();
         m_bs_ls.finalize();
     }
@@ -146,6 +196,7 @@ namespace sat {
         m_need_cleanup = false;
         m_use_list.init(s.num_vars());
         init_visited();
+        init_occ_gating(learned);
         bool learned_in_use_lists = false;
         if (learned) {
             register_clauses(s.m_learned);
@@ -159,8 +210,8 @@ namespace sat {
         if (!learned)
             m_num_calls++;
 
-        m_sub_counter  = m_subsumption_limit;
-        m_elim_counter = m_res_limit;
+        m_sub_counter  = std::min(m_subsumption_limit, m_budget);
+        m_elim_counter = std::min(m_res_limit, m_budget);
         unsigned old_num_elim_vars = m_num_elim_vars;
 
         do {
@@ -179,12 +230,11 @@ namespace sat {
 
         bool vars_eliminated = m_num_elim_vars > old_num_elim_vars;
 
-        if (!m_need_cleanup) {
+        // Remark: learned clauses with eliminated variables must be removed. This requires the full cleanup,
+        // since cleanup_clauses reattaches the remaining clauses. Variables occurring only in binary clauses
+        // are eliminated without setting m_need_cleanup.
+        if (!m_need_cleanup && !vars_eliminated) {
             TRACE("after_simplifier", tout << "skipping cleanup...\n";);
-            if (vars_eliminated) {
-                // must remove learned clauses with eliminated variables
-                cleanup_clauses(s.m_learned, true, true, learned_in_use_lists);
-            }
             CASSERT("sat_solver", s.check_invariant());
             TRACE("after_simplifier", s.display(tout); tout << "model_converter:\n"; s.m_mc.display(tout););
             free_memory();
@@ -529,24 +579,28 @@ namespace sat {
             literal l = c[i];
             switch (value(l)) {
             case l_undef:
-                c[j] = l;
+                std::swap(c[j], c[i]);
                 j++;
                 break;
             case l_false:
                 m_need_cleanup = true;
-                if (in_use_list && !c.frozen()) {
+                if (in_use_list && in_use_lists(c)) {
                     // Remark: if in_use_list is false, then the given clause was not added to the use lists.
-                    // Remark: frozen clauses are not added to the use lists.
+                    // Remark: frozen clauses and clauses bigger than m_max_occ_size are not added to the use lists.
                     m_use_list.get(l).erase_not_removed(c);
                 }
                 break;
             case l_true:
                 r = true;
-                c[j] = l;
+                std::swap(c[j], c[i]);
                 j++;
                 break;
             }
         }
+        if (s.m_config.m_drat && j < sz) {
+            s.m_drat.add(j, c.begin());
+            s.m_drat.del(c);
+        }
         c.shrink(j);
         return r;
     }
@@ -616,6 +670,14 @@ namespace sat {
         m_need_cleanup = true;
         m_num_elim_lits++;
         insert_todo(l.var());
+        if (s.m_config.m_drat) {
+            m_drat_lits.reset();
+            for (unsigned i = 0; i < c.size(); i++)
+                if (c[i] != l)
+                    m_drat_lits.push_back(c[i]);
+            s.m_drat.add(m_drat_lits.size(), m_drat_lits.c_ptr());
+            s.m_drat.del(c);
+        }
         c.elim(l);
         clause_use_list & occurs = m_use_list.get(l);
         occurs.erase_not_removed(c);
@@ -1045,7 +1107,7 @@ namespace sat {
     void simplifier::elim_blocked_clauses() {
         TRACE("blocked_clause_bug", tout << "trail: " << s.m_trail.size() << "\n"; s.display_watches(tout); s.display(tout););
         blocked_cls_report rpt(*this);
-        blocked_clause_elim elim(*this, m_blocked_clause_limit, s.m_mc, m_use_list, s.m_watches);
+        blocked_clause_elim elim(*this, std::min(m_blocked_clause_limit, m_budget), s.m_mc, m_use_list, s.m_watches);
         elim(s.num_vars());
     }
 
@@ -1214,8 +1276,8 @@ namespace sat {
                 return;
             }
         }
-        wlist1.push_back(watched(l2, false));
-        wlist2.push_back(watched(l1, false));
+        insert_bin_watch(wlist1, watched(l2, false));
+        insert_bin_watch(wlist2, watched(l1, false));
     }
 
     /**
@@ -1370,6 +1432,8 @@ namespace sat {
                 TRACE("resolution_new_cls", tout << *it1 << "\n" << *it2 << "\n-->\n" << m_new_cls << "\n";);
                 if (cleanup_clause(m_new_cls))
                     continue; // clause is already satisfied.
+                if (s.m_config.m_drat)
+                    s.m_drat.add(m_new_cls.size(), m_new_cls.c_ptr());
                 switch (m_new_cls.size()) {
                 case 0:
                     s.set_conflict(justification());
@@ -1401,9 +1465,25 @@ namespace sat {
             }
         }
 
+        if (s.m_config.m_drat) {
+            // the resolvents were logged, thus the binary clauses containing v can be deleted from the proof.
+            // The other clauses are logged when they are released.
+            drat_del(m_pos_cls);
+            drat_del(m_neg_cls);
+        }
+
         return true;
     }
 
+    void simplifier::drat_del(clause_wrapper_vector const & cs) {
+        clause_wrapper_vector::const_iterator it  = cs.begin();
+        clause_wrapper_vector::const_iterator end = cs.end();
+        for (; it != end; ++it) {
+            if (it->is_binary())
+                s.m_drat.del((*it)[0], (*it)[1]);
+        }
+    }
+
     struct simplifier::elim_var_report {
         simplifier & m_simplifier;
         stopwatch    m_watch;
@@ -1465,6 +1545,7 @@ namespace sat {
         m_res_cls_cutoff2         = p.resolution_cls_cutoff2();
         m_subsumption             = p.subsumption();
         m_subsumption_limit       = p.subsumption_limit();
+        m_occ_limit               = p.occ_limit();
     }
 
     void simplifier::collect_param_descrs(param_descrs & r) {
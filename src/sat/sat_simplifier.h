@@ -59,6 +59,11 @@ namespace sat {
 
         // simplifier extra variable fields.
         svector<char>          m_visited; // transient
+        svector<char>          m_gated;   // transient: variable occurs in a problem clause that is not in the use lists
+
+        // clauses bigger than m_max_occ_size are not inserted in the use lists (see init_occ_gating).
+        unsigned               m_max_occ_size;
+        unsigned               m_budget;  // effort limit set by the inprocessing scheduler
 
         // counters
         int                    m_sub_counter;
@@ -82,6 +87,7 @@ namespace sat {
 
         bool                   m_subsumption;
         unsigned               m_subsumption_limit;
+        unsigned               m_occ_limit;
         
         // stats
         unsigned               m_num_blocked_clauses;
@@ -103,6 +109,8 @@ namespace sat {
         void mark_all_but(clause const & c, literal l);
         void unmark_all(clause const & c);
 
+        void init_occ_gating(bool learned);
+        bool in_use_lists(clause const & c) const { return !c.frozen() && c.size() <= m_max_occ_size; }
         void register_clauses(clause_vector & cs);
 
         void remove_clause_core(clause & c);
@@ -155,11 +163,13 @@ namespace sat {
         clause_wrapper_vector m_pos_cls;
         clause_wrapper_vector m_neg_cls;
         literal_vector m_new_cls;
+        literal_vector m_drat_lits; // transient: strengthened clause for the DRAT proof
         bool resolve(clause_wrapper const & c1, clause_wrapper const & c2, literal l, literal_vector & r);
         void save_clauses(model_converter::entry & mc_entry, clause_wrapper_vector const & cs);
         void add_non_learned_binary_clause(literal l1, literal l2);
         void remove_bin_clauses(literal l);
         void remove_clauses(clause_use_list const & cs, literal l);
+        void drat_del(clause_wrapper_vector const & cs);
         bool try_eliminate(bool_var v);
         void elim_vars();
 
@@ -173,6 +183,18 @@ namespace sat {
 
         void insert_todo(bool_var v) { m_elim_todo.insert(v); }
 
+        /**
+           \brief Bound the effort (approx. number of literals visited) of each technique in the next calls.
+        */
+        void set_budget(unsigned b) { m_budget = b; }
+
+        /**
+           \brief Total number of simplifications (subsumed clauses, eliminated literals, variables, ...).
+        */
+        unsigned num_reductions() const {
+            return m_num_blocked_clauses + m_num_subsumed + m_num_sub_res + m_num_elim_lits + m_num_elim_vars;
+        }
+
         void operator()(bool learned);
 
         void updt_params(params_ref const & p);
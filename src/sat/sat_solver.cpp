@@ -18,8 +18,10 @@ Revision History:
 --*/
 #include"sat_solver.h"
 #include"sat_integrity_checker.h"
+#include"sat_parallel.h"
 #include"luby.h"
 #include"trace.h"
+#include"z3_omp.h"
 
 // define to update glue during propagation
 #define UPDATE_GLUE
@@ -45,7 +47,13 @@ namespace sat {
         m_case_split_queue(m_activity),
         m_qhead(0),
         m_scope_lvl(0),
-        m_params(p) {
+        m_params(p),
+        m_par(0),
+        m_par_id(0),
+        m_par_limit_in(0),
+        m_par_num_units_out(0),
+        m_inprocess_propagations(0),
+        m_inprocess_old_reductions(0) {
         updt_params(p);
     }
 
@@ -61,21 +69,37 @@ namespace sat {
     }
 
     void solver::copy(solver const & src) {
-        SASSERT(m_mc.empty() && src.m_mc.empty());
+        SASSERT(m_mc.empty());
+        SASSERT(src.scope_lvl() == 0);
         // create new vars
         if (num_vars() < src.num_vars()) {
             for (bool_var v = num_vars(); v < src.num_vars(); v++) {
-                SASSERT(!src.was_eliminated(v));
                 bool ext  = src.m_external[v] != 0;
                 bool dvar = src.m_decision[v] != 0;
                 bool_var new_v = mk_var(ext, dvar);
                 SASSERT(v == new_v);
+                if (src.was_eliminated(v))
+                    m_eliminated[v] = true;
+            }
+        }
+        m_mc.copy(src.m_mc);
+        if (src.inconsistent()) {
+            set_conflict(justification());
+            return;
+        }
+        {
+            // copy units
+            literal_vector::const_iterator it  = src.m_trail.begin();
+            literal_vector::const_iterator end = src.m_trail.end();
+            for (; it != end; ++it) {
+                literal l = *it;
+                mk_clause(1, &l);
             }
         }
         {
             // copy binary clauses
             vector<watch_list>::const_iterator it  = src.m_watches.begin();
-            vector<watch_list>::const_iterator end = src.m_watches.begin();
+            vector<watch_list>::const_iterator end = src.m_watches.end();
             for (unsigned l_idx = 0; it != end; ++it, ++l_idx) {
                 watch_list const & wlist = *it;
                 literal l = ~to_literal(l_idx);
@@ -85,6 +109,8 @@ namespace sat {
                     if (!it2->is_binary_non_learned_clause())
                         continue;
                     literal l2 = it2->get_literal();
+                    if (l.index() > l2.index())
+                        continue;
                     mk_clause(l, l2);
                 }
             }
@@ -140,7 +166,15 @@ namespace sat {
             for (unsigned i = 0; i < num_lits; i++)
                 SASSERT(m_eliminated[lits[i].var()] == false);
         });
-        mk_clause_core(num_lits, lits, false);
+        if (m_user_scope_literals.empty()) {
+            mk_clause_core(num_lits, lits, false);
+        }
+        else {
+            m_aux_literals.reset();
+            m_aux_literals.append(num_lits, lits);
+            m_aux_literals.push_back(~m_user_scope_literals.back());
+            mk_clause_core(m_aux_literals.size(), m_aux_literals.c_ptr(), false);
+        }
     }
 
     void solver::mk_clause(literal l1, literal l2) {
@@ -153,14 +187,40 @@ namespace sat {
         mk_clause(3, ls);
     }
 
+    void solver::mk_def_clause(unsigned num_lits, literal * lits) {
+        DEBUG_CODE({
+            for (unsigned i = 0; i < num_lits; i++)
+                SASSERT(m_eliminated[lits[i].var()] == false);
+        });
+        mk_clause_core(num_lits, lits, false);
+    }
+
+    void solver::mk_def_clause(literal l1, literal l2) {
+        literal ls[2] = { l1, l2 };
+        mk_def_clause(2, ls);
+    }
+
+    void solver::mk_def_clause(literal l1, literal l2, literal l3) {
+        literal ls[3] = { l1, l2, l3 };
+        mk_def_clause(3, ls);
+    }
+
     clause * solver::mk_clause_core(unsigned num_lits, literal * lits, bool learned) {
         if (!learned) {
             TRACE("sat_mk_clause", tout << "mk_clause: " << mk_lits_pp(num_lits, lits) << "\n";);
+            if (m_config.m_drat)
+                m_drat.add_input(num_lits, lits);
+            unsigned old_num_lits = num_lits;
             bool keep = simplify_clause(num_lits, lits);
             TRACE("sat_mk_clause", tout << "mk_clause (after simp), keep: " << keep << "\n" << mk_lits_pp(num_lits, lits) << "\n";);
             if (!keep) {
                 return 0; // clause is equivalent to true.
             }
+            if (m_config.m_drat && num_lits < old_num_lits)
+                m_drat.add(num_lits, lits);
+        }
+        else if (m_config.m_drat) {
+            m_drat.add(num_lits, lits);
         }
 
         switch (num_lits) {
@@ -188,8 +248,8 @@ namespace sat {
                 m_clauses_to_reinit.push_back(clause_wrapper(l1, l2));
         }
         m_stats.m_mk_bin_clause++;
-        m_watches[(~l1).index()].push_back(watched(l2, learned));
-        m_watches[(~l2).index()].push_back(watched(l1, learned));
+        insert_bin_watch(m_watches[(~l1).index()], watched(l2, learned));
+        insert_bin_watch(m_watches[(~l2).index()], watched(l1, learned));
     }
 
     bool solver::propagate_bin_clause(literal l1, literal l2) {
@@ -467,8 +527,13 @@ namespace sat {
     void solver::assign_core(literal l, justification j) {
         SASSERT(value(l) == l_undef);
         TRACE("sat_assign_core", tout << l << "\n";);
-        if (scope_lvl() == 0)
+        if (scope_lvl() == 0) {
+            // the clauses that imply l may be deleted later (e.g., by the cleaner),
+            // so the proof must contain l as a unit clause.
+            if (m_config.m_drat && !j.is_none())
+                m_drat.add(l);
             j = justification(); // erase justification for level 0
+        }
         m_assignment[l.index()]    = l_true;
         m_assignment[(~l).index()] = l_false;
         bool_var v = l.var();
@@ -540,6 +605,23 @@ namespace sat {
                     *it2 = *it;                 \
                 wlist.set_end(it2);             \
             }
+            // Binary watches are usually stored at the beginning of the watch list (see insert_bin_watch).
+            // They are never removed, so they are propagated without compacting the list.
+            for (; it != end && it->is_binary_clause(); ++it) {
+                l1 = it->get_literal();
+                switch (value(l1)) {
+                case l_false:
+                    set_conflict(justification(not_l), ~l1);
+                    return false;
+                case l_undef:
+                    m_stats.m_bin_propagate++;
+                    assign_core(l1, justification(not_l));
+                    break;
+                case l_true:
+                    break; // skip
+                }
+            }
+            it2 = it;
             for (; it != end; ++it) {
                 switch (it->get_kind()) {
                 case watched::BINARY:
@@ -682,8 +764,22 @@ namespace sat {
     // Search
     //
     // -----------------------
-    lbool solver::check() {
-        SASSERT(scope_lvl() == 0);
+    lbool solver::check(unsigned num_lits, literal const * lits) {
+        pop(scope_lvl());
+        m_core.reset();
+#ifndef _NO_OMP_
+        if (m_config.m_num_threads > 1 && !m_par && !m_ext && !m_config.m_drat && !omp_in_parallel() &&
+            num_lits == 0 && m_user_scope_literals.empty())
+            return check_par();
+#endif
+#ifdef SAT_DRAT_TASKS
+        if (m_drat.is_open() && !omp_in_parallel())
+            return check_drat(num_lits, lits);
+#endif
+        return check_core(num_lits, lits);
+    }
+
+    lbool solver::check_core(unsigned num_lits, literal const * lits) {
 #ifdef CLONE_BEFORE_SOLVING
         if (m_mc.empty()) {
             m_clone = alloc(solver, m_params, 0 /* do not clone extension */);
@@ -691,12 +787,15 @@ namespace sat {
         }
 #endif
         try {
-            if (inconsistent()) return l_false;
+            init_assumptions(num_lits, lits);
+            if (check_inconsistent()) return l_false;
             init_search();
             propagate(false);
-            if (inconsistent()) return l_false;
+            if (check_inconsistent()) return l_false;
             cleanup();
             if (m_config.m_max_conflicts > 0 && m_config.m_burst_search > 0) {
+                reinit_assumptions();
+                if (check_inconsistent()) return l_false;
                 m_restart_threshold = m_config.m_burst_search;
                 lbool r = bounded_search();
                 if (r != l_undef)
@@ -708,8 +807,10 @@ namespace sat {
 
             // iff3_finder(*this)();
             simplify_problem();
+            if (check_inconsistent()) return l_false;
+            reinit_assumptions();
+            if (check_inconsistent()) return l_false;
 
-            if (inconsistent()) return l_false;
             m_next_simplify = m_config.m_restart_initial * m_config.m_simplify_mult1;
 
             if (m_config.m_max_conflicts == 0) {
@@ -730,8 +831,16 @@ namespace sat {
                 }
 
                 restart();
+                if (m_par) {
+                    exchange_par();
+                    if (inconsistent()) return l_false;
+                }
                 if (m_conflicts >= m_next_simplify) {
+                    pop(scope_lvl());
                     simplify_problem();
+                    if (check_inconsistent()) return l_false;
+                    reinit_assumptions();
+                    if (check_inconsistent()) return l_false;
                     m_next_simplify = static_cast<unsigned>(m_conflicts * m_config.m_simplify_mult2);
                     if (m_next_simplify > m_conflicts + m_config.m_simplify_max)
                         m_next_simplify = m_conflicts + m_config.m_simplify_max;
@@ -744,6 +853,380 @@ namespace sat {
         }
     }
 
+    // -----------------------
+    //
+    // Assumptions
+    //
+    // -----------------------
+
+    /**
+       \brief Store the assumptions for the next search. Assumption variables
+       are treated as external by the simplifier, i.e., they are never eliminated.
+       The literals of the user scopes are also assumed.
+    */
+    void solver::init_assumptions(unsigned num_lits, literal const * lits) {
+        m_assumptions.reset();
+        m_assumption_set.reset();
+        for (unsigned i = 0; i < num_lits; i++) {
+            literal l = lits[i];
+            if (was_eliminated(l.var()))
+                throw solver_exception("assumption variable was eliminated, it should be created as an external variable");
+            // the variable may be used as an assumption again in a future check,
+            // so it is protected from elimination for the lifetime of the solver.
+            m_external[l.var()] = true;
+            m_assumption_set.insert(l);
+            m_assumptions.push_back(l);
+        }
+        for (unsigned i = 0; i < m_user_scope_literals.size(); i++) {
+            literal l = m_user_scope_literals[i];
+            m_assumption_set.insert(l);
+            m_assumptions.push_back(l);
+        }
+    }
+
+    /**
+       \brief Assign the assumptions at the search level.
+       This method is invoked whenever the solver backtracks to the base level.
+    */
+    void solver::reinit_assumptions() {
+        if (!tracking_assumptions() || scope_lvl() > 0 || inconsistent())
+            return;
+        propagate(false);
+        if (inconsistent())
+            return;
+        push();
+        literal_vector::iterator it  = m_assumptions.begin();
+        literal_vector::iterator end = m_assumptions.end();
+        for (; it != end && !inconsistent(); ++it) {
+            literal l = *it;
+            TRACE("sat_assumptions", tout << "assuming: " << l << "\n";);
+            if (value(l) == l_false)
+                set_conflict(justification(), ~l);
+            else if (value(l) == l_undef)
+                assign(l, justification());
+        }
+        SASSERT(scope_lvl() == search_lvl());
+    }
+
+    /**
+       \brief Return true if the solver is inconsistent. If it is tracking assumptions,
+       the unsat core is also computed.
+    */
+    bool solver::check_inconsistent() {
+        if (!inconsistent())
+            return false;
+        if (tracking_assumptions())
+            resolve_conflict_for_unsat_core();
+        else if (m_config.m_drat)
+            m_drat.add();
+        return true;
+    }
+
+    void solver::process_antecedent_for_unsat_core(literal antecedent) {
+        bool_var v = antecedent.var();
+        if (!is_marked(v) && lvl(v) > 0) {
+            mark(v);
+            m_unmark.push_back(v);
+        }
+    }
+
+    void solver::process_consequent_for_unsat_core(literal consequent, justification const & js) {
+        switch (js.get_kind()) {
+        case justification::NONE:
+            break;
+        case justification::BINARY:
+            process_antecedent_for_unsat_core(~(js.get_literal()));
+            break;
+        case justification::TERNARY:
+            process_antecedent_for_unsat_core(~(js.get_literal1()));
+            process_antecedent_for_unsat_core(~(js.get_literal2()));
+            break;
+        case justification::CLAUSE: {
+            clause & c = *(m_cls_allocator.get_clause(js.get_clause_offset()));
+            unsigned i = 0;
+            if (consequent != null_literal) {
+                SASSERT(c[0] == consequent || c[1] == consequent);
+                if (c[0] == consequent) {
+                    i = 1;
+                }
+                else {
+                    process_antecedent_for_unsat_core(~c[0]);
+                    i = 2;
+                }
+            }
+            unsigned sz = c.size();
+            for (; i < sz; i++)
+                process_antecedent_for_unsat_core(~c[i]);
+            break;
+        }
+        case justification::EXT_JUSTIFICATION: {
+            fill_ext_antecedents(consequent, js);
+            literal_vector::iterator it  = m_ext_antecedents.begin();
+            literal_vector::iterator end = m_ext_antecedents.end();
+            for (; it != end; ++it)
+                process_antecedent_for_unsat_core(*it);
+            break;
+        }
+        default:
+            UNREACHABLE();
+            break;
+        }
+    }
+
+    /**
+       \brief Compute the subset of the assumptions that is responsible for the current conflict.
+       The conflict is traced back to the assumptions assigned at the search level.
+       The literals of the user scopes are not included in the core.
+    */
+    void solver::resolve_conflict_for_unsat_core() {
+        SASSERT(inconsistent());
+        m_core.reset();
+        if (scope_lvl() == 0)
+            return;
+        unsigned old_size = m_unmark.size();
+        if (m_not_l != null_literal) {
+            process_antecedent_for_unsat_core(m_not_l);
+            if (m_conflict.get_kind() == justification::NONE && is_assumption(~m_not_l))
+                m_core.push_back(~m_not_l);
+        }
+        process_consequent_for_unsat_core(m_not_l, m_conflict);
+        unsigned trail_lim = m_scopes[0].m_trail_lim;
+        unsigned idx       = m_trail.size();
+        while (idx > trail_lim) {
+            --idx;
+            literal l = m_trail[idx];
+            if (!is_marked(l.var()))
+                continue;
+            justification const & js = m_justification[l.var()];
+            if (js.get_kind() == justification::NONE) {
+                SASSERT(lvl(l) == search_lvl());
+                if (is_assumption(l))
+                    m_core.push_back(l);
+            }
+            else {
+                process_consequent_for_unsat_core(l, js);
+            }
+        }
+        reset_unmark(old_size);
+        if (!m_user_scope_literals.empty()) {
+            unsigned j = 0;
+            for (unsigned i = 0; i < m_core.size(); i++) {
+                if (!m_user_scope_literals.contains(m_core[i]))
+                    m_core[j++] = m_core[i];
+            }
+            m_core.shrink(j);
+        }
+        TRACE("sat_core", tout << "core: " << m_core << "\n";);
+    }
+
+    // -----------------------
+    //
+    // User scopes
+    //
+    // -----------------------
+
+    /**
+       \brief Create a new user scope. Clauses added in this scope are
+       guarded by a fresh literal that is assumed in every check, and
+       permanently falsified by user_pop.
+    */
+    void solver::user_push() {
+        pop(scope_lvl());
+        literal l(mk_var(true, false), false);
+        m_user_scope_literals.push_back(l);
+    }
+
+    void solver::user_pop(unsigned num_scopes) {
+        SASSERT(num_scopes <= num_user_scopes());
+        pop(scope_lvl());
+        while (num_scopes > 0) {
+            literal l = ~m_user_scope_literals.back();
+            m_user_scope_literals.pop_back();
+            mk_clause_core(1, &l, false);
+            num_scopes--;
+        }
+    }
+
+    enum par_exception_kind {
+        DEFAULT_EX,
+        ERROR_EX
+    };
+
+    /**
+       \brief Run a portfolio of m_config.m_num_threads diversified solvers.
+       This solver is one of them. The first solver to produce a
+       definite answer cancels the others.
+    */
+#ifdef SAT_DRAT_TASKS
+    /**
+       \brief Search in a parallel region of two threads: the current thread searches,
+       and the other one writes the blocks of the DRAT proof (see drat::flush).
+    */
+    lbool solver::check_drat(unsigned num_lits, literal const * lits) {
+        lbool result               = l_undef;
+        par_exception_kind ex_kind = DEFAULT_EX;
+        std::string        ex_msg;
+        unsigned           error_code = 0;
+        bool               failed = false;
+        #pragma omp parallel num_threads(2)
+        {
+            #pragma omp single
+            {
+                try {
+                    result = check_core(num_lits, lits);
+                }
+                catch (z3_error & err) {
+                    failed     = true;
+                    ex_kind    = ERROR_EX;
+                    error_code = err.error_code();
+                }
+                catch (z3_exception & ex) {
+                    failed  = true;
+                    ex_kind = DEFAULT_EX;
+                    ex_msg  = ex.msg();
+                }
+            }
+        }
+        if (failed) {
+            if (ex_kind == ERROR_EX)
+                throw z3_error(error_code);
+            throw default_exception(ex_msg.c_str());
+        }
+        return result;
+    }
+#endif
+
+    lbool solver::check_par() {
+        if (inconsistent()) return l_false;
+        unsigned num_threads       = m_config.m_num_threads;
+        unsigned num_extra_solvers = num_threads - 1;
+        parallel par;
+        par.init_solvers(*this, num_extra_solvers);
+        int finished_id            = -1;
+        lbool result               = l_undef;
+        par_exception_kind ex_kind = DEFAULT_EX;
+        std::string        ex_msg;
+        unsigned           error_code = 0;
+        bool               failed = false;
+        m_par_limit_in             = 0;
+        m_par_num_units_out        = 0;
+
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(num_threads); i++) {
+            try {
+                lbool r;
+                if (static_cast<unsigned>(i) < num_extra_solvers)
+                    r = par.get_solver(i).check();
+                else
+                    r = check();
+                bool first = false;
+                if (r != l_undef) {
+                    #pragma omp critical (par_solver)
+                    {
+                        if (finished_id == -1) {
+                            finished_id = i;
+                            result      = r;
+                            first       = true;
+                        }
+                    }
+                }
+                if (first) {
+                    for (unsigned j = 0; j < num_extra_solvers; j++) {
+                        if (static_cast<unsigned>(i) != j)
+                            par.get_solver(j).m_cancel = true;
+                    }
+                    if (static_cast<unsigned>(i) != num_extra_solvers)
+                        m_cancel = true;
+                }
+            }
+            catch (z3_error & err) {
+                #pragma omp critical (par_solver)
+                {
+                    failed     = true;
+                    ex_kind    = ERROR_EX;
+                    error_code = err.error_code();
+                }
+            }
+            catch (z3_exception & ex) {
+                #pragma omp critical (par_solver)
+                {
+                    failed  = true;
+                    ex_kind = DEFAULT_EX;
+                    ex_msg  = ex.msg();
+                }
+            }
+        }
+        #pragma omp critical (par_solver)
+        {
+            m_par = 0;
+        }
+        if (finished_id == -1) {
+            if (failed) {
+                if (ex_kind == ERROR_EX)
+                    throw z3_error(error_code);
+                throw default_exception(ex_msg.c_str());
+            }
+            return l_undef;
+        }
+        m_cancel = false;
+        if (static_cast<unsigned>(finished_id) < num_extra_solvers) {
+            solver & s = par.get_solver(finished_id);
+            IF_VERBOSE(SAT_VB_LVL, verbose_stream() << "(sat-par :solver " << finished_id << " :conflicts " << s.m_stats.m_conflict << ")\n";);
+            if (result == l_true) {
+                m_model = s.get_model();
+            }
+            else {
+                pop(scope_lvl());
+                set_conflict(justification());
+            }
+        }
+        return result;
+    }
+
+    /**
+       \brief Share new units and import units and learned clauses produced by the other solvers
+       in the portfolio. This method is only invoked at the base level.
+    */
+    void solver::exchange_par() {
+        SASSERT(scope_lvl() == 0);
+        m_par_lits.reset();
+        unsigned sz = m_trail.size();
+        for (unsigned i = m_par_num_units_out; i < sz; i++)
+            m_par_lits.push_back(m_trail[i]);
+        m_par->exchange(m_par_lits, m_par_limit_in, m_par_units);
+        literal_vector::iterator it  = m_par_units.begin();
+        literal_vector::iterator end = m_par_units.end();
+        for (; it != end && !inconsistent(); ++it) {
+            literal l = *it;
+            if (l.var() >= num_vars() || was_eliminated(l.var()))
+                continue;
+            if (value(l) != l_true) {
+                m_stats.m_par_units++;
+                assign(l, justification());
+            }
+        }
+        unsigned glue;
+        while (!inconsistent() && m_par->get_clause(*this, glue, m_par_lits))
+            import_par_clause(glue);
+        m_par_num_units_out = m_trail.size();
+    }
+
+    void solver::import_par_clause(unsigned glue) {
+        literal_vector::iterator it  = m_par_lits.begin();
+        literal_vector::iterator end = m_par_lits.end();
+        for (; it != end; ++it) {
+            if (it->var() >= num_vars() || was_eliminated(it->var()))
+                return;
+        }
+        unsigned num_lits = m_par_lits.size();
+        if (!simplify_clause(num_lits, m_par_lits.c_ptr()))
+            return;
+        m_stats.m_par_clauses++;
+        clause * c = mk_clause_core(num_lits, m_par_lits.c_ptr(), true);
+        if (c)
+            c->set_glue(std::min(glue, num_lits));
+    }
+
     bool_var solver::next_var() {
         bool_var next;
 
@@ -815,12 +1298,15 @@ namespace sat {
                     return l_false;
                 if (m_conflicts > m_config.m_max_conflicts)
                     return l_undef;
-                if (m_conflicts_since_restart > m_restart_threshold)
+                if (should_restart())
                     return l_undef;
                 if (scope_lvl() == 0) {
                     cleanup(); // cleaner may propagate frozen clauses
-                    if (inconsistent())
+                    if (inconsistent()) {
+                        if (m_config.m_drat)
+                            m_drat.add();
                         return l_false;
+                    }
                     gc();
                 }
             }
@@ -854,6 +1340,12 @@ namespace sat {
         m_conflicts_since_restart = 0;
         m_restart_threshold       = m_config.m_restart_initial;
         m_luby_idx                = 1;
+        m_fast_glue.set_alpha(m_config.m_restart_ema_fast);
+        m_slow_glue.set_alpha(m_config.m_restart_ema_slow);
+        m_trail_avg.set_alpha(1.0/5000.0);
+        m_fast_glue.reset();
+        m_slow_glue.reset();
+        m_trail_avg.reset();
         m_conflicts_since_gc      = 0;
         m_gc_threshold            = m_config.m_gc_initial;
         m_min_d_tk                = 1.0;
@@ -872,15 +1364,24 @@ namespace sat {
         m_cleaner();
         CASSERT("sat_simplify_bug", check_invariant());
 
-        m_scc();
+        init_inprocess_round();
+
+        if (begin_inprocess(IP_SCC)) {
+            m_scc();
+            end_inprocess(IP_SCC);
+        }
         CASSERT("sat_simplify_bug", check_invariant());
 
-        m_simplifier(false);
+        if (begin_inprocess(IP_SIMPLIFY)) {
+            m_simplifier(false);
+            end_inprocess(IP_SIMPLIFY);
+        }
         CASSERT("sat_simplify_bug", check_invariant());
         CASSERT("sat_missed_prop", check_missed_propagation());
 
-        if (!m_learned.empty()) {
+        if (!m_learned.empty() && begin_inprocess(IP_SIMPLIFY_LEARNED)) {
             m_simplifier(true);
+            end_inprocess(IP_SIMPLIFY_LEARNED);
             CASSERT("sat_missed_prop", check_missed_propagation());
             CASSERT("sat_simplify_bug", check_invariant());
         }
@@ -888,11 +1389,18 @@ namespace sat {
         sort_watch_lits();
         CASSERT("sat_simplify_bug", check_invariant());
 
-        m_probing();
+        // when the scheduler is enabled, it replaces the delays used by probing and asymmetric branching.
+        if (begin_inprocess(IP_PROBING)) {
+            m_probing(m_config.m_inprocess);
+            end_inprocess(IP_PROBING);
+        }
         CASSERT("sat_missed_prop", check_missed_propagation());
         CASSERT("sat_simplify_bug", check_invariant());
 
-        m_asymm_branch();
+        if (begin_inprocess(IP_ASYMM_BRANCH)) {
+            m_asymm_branch(m_config.m_inprocess);
+            end_inprocess(IP_ASYMM_BRANCH);
+        }
         CASSERT("sat_missed_prop", check_missed_propagation());
         CASSERT("sat_simplify_bug", check_invariant());
 
@@ -902,6 +1410,98 @@ namespace sat {
         }
     }
 
+    // -----------------------
+    //
+    // Inprocessing
+    //
+    // -----------------------
+
+    /**
+       \brief Set the effort of the simplification techniques for the current round.
+       If the scheduler is enabled, it is proportional to the number of propagations since the previous round.
+    */
+    void solver::init_inprocess_round() {
+        unsigned props  = m_stats.m_propagate + m_stats.m_bin_propagate + m_stats.m_ter_propagate;
+        unsigned budget = UINT_MAX;
+        if (m_config.m_inprocess) {
+            unsigned delta = props >= m_inprocess_propagations ? props - m_inprocess_propagations : props;
+            unsigned long long b = static_cast<unsigned long long>(delta) * m_config.m_inprocess_effort / 1000;
+            b = std::max(b, static_cast<unsigned long long>(m_config.m_inprocess_min_effort));
+            budget = static_cast<unsigned>(std::min(b, static_cast<unsigned long long>(INT_MAX)));
+        }
+        m_inprocess_propagations = props;
+        m_simplifier.set_budget(budget);
+        m_probing.set_budget(budget);
+        m_asymm_branch.set_budget(budget);
+    }
+
+    /**
+       \brief Return true if the technique k should be executed in the current round.
+    */
+    bool solver::begin_inprocess(inprocess_kind k) {
+        inprocess_info & info = m_inprocess[k];
+        if (m_config.m_inprocess && info.m_skip > 0) {
+            info.m_skip--;
+            info.m_skipped++;
+            return false;
+        }
+        info.m_calls++;
+        m_inprocess_old_reductions = num_reductions(k);
+        m_inprocess_watch.reset();
+        m_inprocess_watch.start();
+        return true;
+    }
+
+    /**
+       \brief Update the statistics of the technique k. If the scheduler is enabled and k did not
+       simplify the problem, then k is delayed. The delay is doubled after each unproductive call.
+    */
+    void solver::end_inprocess(inprocess_kind k) {
+        m_inprocess_watch.stop();
+        inprocess_info & info = m_inprocess[k];
+        unsigned r = num_reductions(k) - m_inprocess_old_reductions;
+        info.m_time       += m_inprocess_watch.get_seconds();
+        info.m_reductions += r;
+        if (!m_config.m_inprocess)
+            return;
+        if (r > 0)
+            info.m_delay = 0;
+        else
+            info.m_delay = std::min(2 * info.m_delay + 1, m_config.m_inprocess_max_delay);
+        info.m_skip = info.m_delay;
+    }
+
+    unsigned solver::num_reductions(inprocess_kind k) const {
+        switch (k) {
+        case IP_SCC:              return m_scc.num_reductions();
+        case IP_SIMPLIFY:         return m_simplifier.num_reductions();
+        case IP_SIMPLIFY_LEARNED: return m_simplifier.num_reductions();
+        case IP_PROBING:          return m_probing.num_reductions();
+        case IP_ASYMM_BRANCH:     return m_asymm_branch.num_reductions();
+        default:
+            UNREACHABLE();
+            return 0;
+        }
+    }
+
+    void solver::collect_inprocess_statistics(statistics & st) const {
+        static char const * calls[IP_NUM_KINDS] = {
+            "scc calls", "simplifier calls", "simplifier learned calls", "probing calls", "asymm branch calls" };
+        static char const * skipped[IP_NUM_KINDS] = {
+            "scc skipped", "simplifier skipped", "simplifier learned skipped", "probing skipped", "asymm branch skipped" };
+        static char const * reductions[IP_NUM_KINDS] = {
+            "scc reductions", "simplifier reductions", "simplifier learned reductions", "probing reductions", "asymm branch reductions" };
+        static char const * times[IP_NUM_KINDS] = {
+            "scc time", "simplifier time", "simplifier learned time", "probing time", "asymm branch time" };
+        for (unsigned k = 0; k < IP_NUM_KINDS; k++) {
+            inprocess_info const & info = m_inprocess[k];
+            st.update(calls[k], info.m_calls);
+            st.update(skipped[k], info.m_skipped);
+            st.update(reductions[k], info.m_reductions);
+            st.update(times[k], info.m_time);
+        }
+    }
+
     void solver::sort_watch_lits() {
         vector<watch_list>::iterator it  = m_watches.begin();
         vector<watch_list>::iterator end = m_watches.end();
@@ -971,6 +1571,12 @@ namespace sat {
         }
         if (!m_mc.check_model(m))
             ok = false;
+        for (unsigned i = 0; i < m_assumptions.size(); i++) {
+            if (value_at(m_assumptions[i], m) != l_true) {
+                TRACE("sat_model_bug", tout << "failed assumption: " << m_assumptions[i] << "\n";);
+                ok = false;
+            }
+        }
         CTRACE("sat_model_bug", !ok, tout << m << "\n";);
         return ok;
     }
@@ -982,7 +1588,7 @@ namespace sat {
                    << " :restarts " << m_stats.m_restart << mk_stat(*this)
                    << " :time " << std::fixed << std::setprecision(2) << m_stopwatch.get_current_seconds() << ")\n";);
         IF_VERBOSE(30, display_status(verbose_stream()););
-        pop(scope_lvl());
+        pop(scope_lvl() - search_lvl());
         m_conflicts_since_restart = 0;
         switch (m_config.m_restart) {
         case RS_GEOMETRIC:
@@ -992,6 +1598,10 @@ namespace sat {
             m_luby_idx++;
             m_restart_threshold = m_config.m_restart_initial * get_luby(m_luby_idx);
             break;
+        case RS_EMA:
+            // restarts are triggered by the glue averages (see should_restart).
+            m_restart_threshold = UINT_MAX;
+            break;
         default:
             UNREACHABLE();
             break;
@@ -999,6 +1609,35 @@ namespace sat {
         CASSERT("sat_restart", check_invariant());
     }
 
+    bool solver::should_restart() const {
+        if (m_conflicts_since_restart > m_restart_threshold)
+            return true;
+        return
+            m_config.m_restart == RS_EMA &&
+            m_conflicts_since_restart >= m_config.m_restart_min &&
+            m_fast_glue.value() > m_config.m_restart_margin * m_slow_glue.value();
+    }
+
+    /**
+       \brief Update the glue averages used by the ema restart strategy.
+       As in Glucose, a restart is postponed when the trail is much bigger than
+       usual, since the solver may be close to a model.
+    */
+    void solver::updt_restart_averages(unsigned glue) {
+        if (m_config.m_restart != RS_EMA)
+            return;
+        m_fast_glue.update(glue);
+        m_slow_glue.update(glue);
+        if (m_config.m_restart_blocking > 0.0 &&
+            m_conflicts > 10000 &&
+            m_conflicts_since_restart >= m_config.m_restart_min &&
+            m_trail.size() > m_config.m_restart_blocking * m_trail_avg.value()) {
+            m_conflicts_since_restart = 0;
+            m_stats.m_restart_blocked++;
+        }
+        m_trail_avg.update(m_trail.size());
+    }
+
     // -----------------------
     //
     // GC
@@ -1027,15 +1666,62 @@ namespace sat {
                 return;
             gc_dyn_psm();
             break;
+        case GC_TIERS:
+            gc_tiers();
+            break;
         default:
             UNREACHABLE();
             break;
         }
         m_conflicts_since_gc = 0;
         m_gc_threshold += m_config.m_gc_increment;
+        if (m_config.m_gc_defrag && m_cls_allocator.fragmented())
+            defrag_clauses();
         CASSERT("sat_gc_bug", check_invariant());
     }
 
+    /**
+       \brief Move the clauses to a compact region of the clause arena (in the order
+       they occur in m_clauses and m_learned), and update the references to them:
+       watch lists, justifications of assigned literals and the reinitialization stack.
+    */
+    void solver::defrag_clauses() {
+        m_cls_allocator.begin_compaction();
+        relocate_clauses(m_clauses);
+        relocate_clauses(m_learned);
+        vector<watch_list>::iterator it  = m_watches.begin();
+        vector<watch_list>::iterator end = m_watches.end();
+        for (; it != end; ++it) {
+            watch_list::iterator it2  = it->begin();
+            watch_list::iterator end2 = it->end();
+            for (; it2 != end2; ++it2) {
+                if (it2->is_clause())
+                    it2->set_clause_offset(m_cls_allocator.new_offset(it2->get_clause_offset()));
+            }
+        }
+        literal_vector::iterator it3  = m_trail.begin();
+        literal_vector::iterator end3 = m_trail.end();
+        for (; it3 != end3; ++it3) {
+            justification & js = m_justification[it3->var()];
+            if (js.is_clause())
+                js = justification(m_cls_allocator.new_offset(js.get_clause_offset()));
+        }
+        for (unsigned i = 0; i < m_clauses_to_reinit.size(); i++) {
+            clause_wrapper cw = m_clauses_to_reinit[i];
+            if (!cw.is_binary())
+                m_clauses_to_reinit[i] = clause_wrapper(*m_cls_allocator.get_relocated(cw.get_clause()));
+        }
+        m_cls_allocator.end_compaction();
+        IF_VERBOSE(SAT_VB_LVL, verbose_stream() << "(sat-defrag)\n";);
+    }
+
+    void solver::relocate_clauses(clause_vector & cs) {
+        clause_vector::iterator it  = cs.begin();
+        clause_vector::iterator end = cs.end();
+        for (; it != end; ++it)
+            *it = m_cls_allocator.relocate(*it);
+    }
+
     /**
        \brief Lex on (glue, size)
     */
@@ -1141,6 +1827,67 @@ namespace sat {
         IF_VERBOSE(SAT_VB_LVL, verbose_stream() << "(sat-gc :strategy " << st_name << " :deleted " << (sz - new_sz) << ")\n";);
     }
 
+    /**
+       \brief Three-tier learned clause database.
+       Core clauses (glue <= gc.tier1_glue) are never deleted. Tier2 clauses (glue <= gc.tier2_glue)
+       are kept while they were used in one of the last two gc rounds. The remaining (local) clauses that
+       were not used since the last gc round are sorted by glue, and the worst half is deleted.
+    */
+    void solver::gc_tiers() {
+        unsigned sz   = m_learned.size();
+        unsigned j    = 0;
+        unsigned num_core  = 0;
+        unsigned num_tier2 = 0;
+        clause_vector local;
+        for (unsigned i = 0; i < sz; i++) {
+            clause & c = *(m_learned[i]);
+            bool keep;
+            if (c.glue() <= m_config.m_gc_tier1_glue) {
+                keep = true;
+            }
+            else if (c.was_used()) {
+                c.reset_inact_rounds();
+                keep = true;
+            }
+            else {
+                if (c.inact_rounds() < 255)
+                    c.inc_inact_rounds();
+                keep = c.glue() <= m_config.m_gc_tier2_glue && c.inact_rounds() < 2;
+            }
+            c.unmark_used();
+            if (keep) {
+                if (c.glue() <= m_config.m_gc_tier1_glue)
+                    num_core++;
+                else if (c.glue() <= m_config.m_gc_tier2_glue)
+                    num_tier2++;
+                m_learned[j] = &c;
+                j++;
+            }
+            else {
+                local.push_back(&c);
+            }
+        }
+        std::stable_sort(local.begin(), local.end(), glue_lt());
+        unsigned half    = local.size() / 2;
+        unsigned deleted = 0;
+        for (unsigned i = 0; i < local.size(); i++) {
+            clause & c = *(local[i]);
+            if (i >= half && can_delete(c)) {
+                dettach_clause(c);
+                del_clause(c);
+                deleted++;
+            }
+            else {
+                m_learned[j] = &c;
+                j++;
+            }
+        }
+        m_learned.shrink(j);
+        m_stats.m_gc_clause += deleted;
+        IF_VERBOSE(SAT_VB_LVL, verbose_stream() << "(sat-gc :strategy tiers :core " << num_core << " :tier2 " << num_tier2
+                   << " :local " << (local.size() - deleted) << " :deleted " << deleted << ")\n";);
+    }
+
     /**
        \brief Use gc based on dynamic psm. Clauses are initially frozen.
     */
@@ -1250,13 +1997,15 @@ namespace sat {
             case l_false:
                 break;
             case l_undef:
-                c[j] = c[i];
+                std::swap(c[j], c[i]);
                 j++;
                 break;
             }
         }
         TRACE("sat_gc", tout << "after cleanup:\n" << mk_lits_pp(j, c.begin()) << "\n";);
         unsigned new_sz = j;
+        if (m_config.m_drat && new_sz < sz)
+            m_drat.add(new_sz, c.begin());
         switch (new_sz) {
         case 0:
             set_conflict(justification());
@@ -1268,6 +2017,8 @@ namespace sat {
             mk_bin_clause(c[0], c[1], true);
             return false;
         default:
+            if (m_config.m_drat && new_sz < sz)
+                m_drat.del(c);
             c.shrink(new_sz);
             attach_clause(c);
             return true;
@@ -1321,8 +2072,13 @@ namespace sat {
         m_conflicts_since_gc++;
 
         m_conflict_lvl = get_max_lvl(m_not_l, m_conflict);
-        if (m_conflict_lvl == 0)
+        if (m_conflict_lvl <= search_lvl()) {
+            if (tracking_assumptions())
+                resolve_conflict_for_unsat_core();
+            else if (m_config.m_drat)
+                m_drat.add();
             return false;
+        }
         m_lemma.reset();
 
         forget_phase_of_vars(m_conflict_lvl);
@@ -1369,6 +2125,12 @@ namespace sat {
                 unsigned sz  = c.size();
                 for (; i < sz; i++)
                     process_antecedent(~c[i], num_marks);
+                if (m_config.m_gc_strategy == GC_TIERS && c.is_learned() && c.glue() > m_config.m_gc_tier1_glue) {
+                    // clauses involved in conflicts may move to a better tier.
+                    unsigned glue = num_diff_levels(c.size(), c.begin());
+                    if (glue < c.glue())
+                        c.set_glue(glue);
+                }
                 break;
             }
             case justification::EXT_JUSTIFICATION: {
@@ -1425,6 +2187,10 @@ namespace sat {
         }
 
         unsigned glue = num_diff_levels(m_lemma.size(), m_lemma.c_ptr());
+        updt_restart_averages(glue);
+
+        if (m_par && m_lemma.size() > 1 && (m_lemma.size() == 2 || glue <= m_config.m_par_max_glue))
+            m_par->share_clause(*this, m_lemma.size(), m_lemma.c_ptr(), glue);
 
         pop(m_scope_lvl - new_scope_lvl);
         TRACE("sat_conflict_detail", display(tout); tout << "assignment:\n"; display_assignment(tout););
@@ -1432,6 +2198,10 @@ namespace sat {
         if (lemma) {
             lemma->set_glue(glue);
         }
+        if (scope_lvl() < search_lvl()) {
+            // the lemma is a unit, and the assumptions were retracted.
+            reinit_assumptions();
+        }
         decay_activity();
         updt_phase_counters();
         return true;
@@ -1966,6 +2736,10 @@ namespace sat {
     void solver::updt_params(params_ref const & p) {
         m_params = p;
         m_config.updt_params(p);
+        if (m_config.m_drat && !m_drat.is_open())
+            m_drat.open(m_config.m_drat_file.bare_str(), m_config.m_drat_cnf_file.bare_str(), m_config.m_drat_binary);
+        else if (!m_config.m_drat)
+            m_drat.close();
         m_simplifier.updt_params(p);
         m_asymm_branch.updt_params(p);
         m_probing.updt_params(p);
@@ -1983,6 +2757,13 @@ namespace sat {
 
     void solver::set_cancel(bool f) {
         m_cancel = f;
+        if (m_par) {
+            #pragma omp critical (par_solver)
+            {
+                if (m_par)
+                    m_par->set_cancel(f);
+            }
+        }
     }
 
     void solver::collect_statistics(statistics & st) {
@@ -1992,10 +2773,18 @@ namespace sat {
         m_scc.collect_statistics(st);
         m_asymm_branch.collect_statistics(st);
         m_probing.collect_statistics(st);
+        m_cls_allocator.collect_statistics(st);
+        collect_inprocess_statistics(st);
+        if (m_config.m_drat)
+            m_drat.collect_statistics(st);
     }
 
     void solver::reset_statistics() {
         m_stats.reset();
+        m_cls_allocator.reset_statistics();
+        m_drat.reset_statistics();
+        for (unsigned k = 0; k < IP_NUM_KINDS; k++)
+            m_inprocess[k].reset_statistics();
         m_cleaner.reset_statistics();
         m_simplifier.reset_statistics();
         m_asymm_branch.reset_statistics();
@@ -2321,6 +3110,15 @@ namespace sat {
                 num_lits += c.size();
             }
         }
+        unsigned num_core  = 0;
+        unsigned num_tier2 = 0;
+        for (unsigned i = 0; i < m_learned.size(); i++) {
+            unsigned glue = m_learned[i]->glue();
+            if (glue <= m_config.m_gc_tier1_glue)
+                num_core++;
+            else if (glue <= m_config.m_gc_tier2_glue)
+                num_tier2++;
+        }
         unsigned total_cls = num_cls + num_ter + num_bin;
         double mem = static_cast<double>(memory::get_allocation_size())/static_cast<double>(1024*1024);
         out << "(sat-status\n";
@@ -2332,6 +3130,9 @@ namespace sat {
         out << "  :binary-clauses  " << num_bin << "\n";
         out << "  :ternary-clauses " << num_ter << "\n";
         out << "  :clauses         " << num_cls << "\n";
+        out << "  :core-lemmas     " << num_core << "\n";
+        out << "  :tier2-lemmas    " << num_tier2 << "\n";
+        out << "  :local-lemmas    " << (m_learned.size() - num_core - num_tier2) << "\n";
         out << "  :del-clause      " << m_stats.m_del_clause << "\n";
         out << "  :avg-clause-size " << (total_cls == 0 ? 0.0 : static_cast<double>(num_lits) / static_cast<double>(total_cls)) << "\n";
         out << "  :memory          " << std::fixed << std::setprecision(2) << mem << ")" << std::endl;
@@ -2352,6 +3153,9 @@ namespace sat {
         st.update("restarts", m_restart);
         st.update("minimized lits", m_minimized_lits);
         st.update("dyn subsumption resolution", m_dyn_sub_res);
+        st.update("par units", m_par_units);
+        st.update("par clauses", m_par_clauses);
+        st.update("blocked restarts", m_restart_blocked);
     }
 
     void stats::reset() {
@@ -2369,6 +3173,9 @@ namespace sat {
         m_del_clause = 0;
         m_minimized_lits = 0;
         m_dyn_sub_res = 0;
+        m_par_units = 0;
+        m_par_clauses = 0;
+        m_restart_blocked = 0;
     }
 
     void mk_stat::display(std::ostream & out) const {
@@ -32,6 +32,7 @@ Revision History:
 #include"sat_asymm_branch.h"
 #include"sat_iff3_finder.h"
 #include"sat_probing.h"
+#include"sat_drat.h"
 #include"params.h"
 #include"statistics.h"
 #include"stopwatch.h"
@@ -57,11 +58,37 @@ namespace sat {
         unsigned m_del_clause;
         unsigned m_minimized_lits;
         unsigned m_dyn_sub_res;
+        unsigned m_par_units;
+        unsigned m_par_clauses;
+        unsigned m_restart_blocked;
         stats() { reset(); }
         void reset();
         void collect_statistics(statistics & st) const;
     };
     
+    class parallel;
+
+    /**
+       \brief Exponential moving average. While fewer than 1/alpha values were
+       observed, it is the plain average, so it does not depend on the initial value.
+    */
+    class ema {
+        double   m_alpha;
+        double   m_value;
+        unsigned m_count;
+    public:
+        ema(double alpha = 0.0):m_alpha(alpha), m_value(0.0), m_count(0) {}
+        void set_alpha(double alpha) { m_alpha = alpha; }
+        void reset() { m_value = 0.0; m_count = 0; }
+        void update(double x) {
+            if (m_count < UINT_MAX)
+                m_count++;
+            double alpha = std::max(m_alpha, 1.0 / static_cast<double>(m_count));
+            m_value += alpha * (x - m_value);
+        }
+        double value() const { return m_value; }
+    };
+
     class solver {
     public:
         struct abort_solver {};
@@ -72,6 +99,7 @@ namespace sat {
         extension *             m_ext;
         random_gen              m_rand;
         clause_allocator        m_cls_allocator;
+        drat                    m_drat; // used only if m_config.m_drat
         cleaner                 m_cleaner;
         model                   m_model;
         model_converter         m_mc;
@@ -118,6 +146,17 @@ namespace sat {
         stopwatch               m_stopwatch;
         params_ref              m_params;
         scoped_ptr<solver>      m_clone; // for debugging purposes
+        parallel *              m_par;
+        unsigned                m_par_id;
+        unsigned                m_par_limit_in;
+        unsigned                m_par_num_units_out;
+        literal_vector          m_par_units;
+        literal_vector          m_par_lits;
+        literal_vector          m_assumptions;
+        literal_set             m_assumption_set;
+        literal_vector          m_core;
+        literal_vector          m_user_scope_literals;
+        literal_vector          m_aux_literals;
 
         void del_clauses(clause * const * begin, clause * const * end);
 
@@ -129,6 +168,7 @@ namespace sat {
         friend class asymm_branch;
         friend class probing;
         friend class iff3_finder;
+        friend class parallel;
         friend struct mk_stat;
     public:
         solver(params_ref const & p, extension * ext);
@@ -148,10 +188,11 @@ namespace sat {
         void display_status(std::ostream & out) const;
         
         /**
-           \brief Copy (non learned) clauses from src to this solver.
+           \brief Copy (non learned) clauses and units from src to this solver.
            Create missing variables if needed.
-           
-           \pre the model converter of src and this must be empty
+           The model converter of src is also copied.
+
+           \pre src is at base level, and the model converter of this must be empty
         */
         void copy(solver const & src);
         
@@ -164,9 +205,26 @@ namespace sat {
         void mk_clause(unsigned num_lits, literal * lits);
         void mk_clause(literal l1, literal l2);
         void mk_clause(literal l1, literal l2, literal l3);
+        /**
+           \brief Add a clause that is not removed by user_pop. It must only be used for
+           definitions of fresh variables (e.g., gates), which are consistent with any set of clauses.
+        */
+        void mk_def_clause(unsigned num_lits, literal * lits);
+        void mk_def_clause(literal l1, literal l2);
+        void mk_def_clause(literal l1, literal l2, literal l3);
 
     protected:
-        void del_clause(clause & c) { m_cls_allocator.del_clause(&c); m_stats.m_del_clause++; }
+        /**
+           \brief Release the given clause. Clause deletions are logged in the DRAT proof only here.
+           A clause object with less than 3 literals was shrunk into a unit or binary clause, which
+           is still used by the solver, and must remain in the proof.
+        */
+        void del_clause(clause & c) {
+            if (m_config.m_drat && c.size() > 2)
+                m_drat.del(c);
+            m_cls_allocator.del_clause(&c);
+            m_stats.m_del_clause++;
+        }
         clause * mk_clause_core(unsigned num_lits, literal * lits, bool learned);
         void mk_bin_clause(literal l1, literal l2, bool learned);
         bool propagate_bin_clause(literal l1, literal l2);
@@ -198,6 +256,10 @@ namespace sat {
         bool inconsistent() const { return m_inconsistent; }
         unsigned num_vars() const { return m_level.size(); }
         bool is_external(bool_var v) const { return m_external[v] != 0; }
+        bool is_assumption(literal l) const { return m_assumption_set.contains(l); }
+        bool is_assumption(bool_var v) const { return is_assumption(literal(v, false)) || is_assumption(literal(v, true)); }
+        bool tracking_assumptions() const { return !m_assumptions.empty(); }
+        unsigned search_lvl() const { return tracking_assumptions() ? 1 : 0; }
         bool was_eliminated(bool_var v) const { return m_eliminated[v] != 0; }
         unsigned scope_lvl() const { return m_scope_lvl; }
         lbool value(literal l) const { return m_assignment[l.index()]; }
@@ -250,8 +312,17 @@ namespace sat {
         //
         // -----------------------
     public:
-        lbool check();
+        /**
+           \brief Check satisfiability of the clauses assuming the given literals.
+           If the result is l_false, then get_core() returns a subset of the
+           assumptions that is inconsistent with the clauses.
+
+           \remark Variables used in assumptions should be created as external,
+           otherwise they may be eliminated by the simplifier in previous calls.
+        */
+        lbool check(unsigned num_lits = 0, literal const * lits = 0);
         model const & get_model() const { return m_model; }
+        literal_vector const & get_core() const { return m_core; }
         model_converter const & get_model_converter() const { return m_mc; }
 
     protected:
@@ -259,6 +330,9 @@ namespace sat {
         unsigned m_conflicts_since_restart;
         unsigned m_restart_threshold;
         unsigned m_luby_idx;
+        ema      m_fast_glue;  // averages of the glue of learned clauses and of the size of the trail (restart ema)
+        ema      m_slow_glue;
+        ema      m_trail_avg;
         unsigned m_conflicts_since_gc;
         unsigned m_gc_threshold;
         double   m_min_d_tk;
@@ -266,13 +340,57 @@ namespace sat {
         bool decide();
         bool_var next_var();
         lbool bounded_search();
+        lbool check_par();
+        lbool check_core(unsigned num_lits, literal const * lits);
+#ifdef SAT_DRAT_TASKS
+        lbool check_drat(unsigned num_lits, literal const * lits);
+#endif
+        void exchange_par();
+        void import_par_clause(unsigned glue);
+        void init_assumptions(unsigned num_lits, literal const * lits);
+        void reinit_assumptions();
+        bool check_inconsistent();
+        void process_antecedent_for_unsat_core(literal antecedent);
+        void process_consequent_for_unsat_core(literal consequent, justification const & js);
+        void resolve_conflict_for_unsat_core();
         void init_search();
         void simplify_problem();
         void mk_model();
         bool check_model(model const & m) const;
         void restart();
+        bool should_restart() const;
+        void updt_restart_averages(unsigned glue);
         void sort_watch_lits();
 
+        // -----------------------
+        //
+        // Inprocessing
+        //
+        // -----------------------
+    protected:
+        enum inprocess_kind {
+            IP_SCC = 0, IP_SIMPLIFY, IP_SIMPLIFY_LEARNED, IP_PROBING, IP_ASYMM_BRANCH, IP_NUM_KINDS
+        };
+        struct inprocess_info {
+            unsigned m_calls;
+            unsigned m_skipped;
+            unsigned m_reductions;
+            double   m_time;
+            unsigned m_delay; // number of rounds to skip after an unproductive call
+            unsigned m_skip;  // number of rounds still to be skipped
+            inprocess_info():m_delay(0), m_skip(0) { reset_statistics(); }
+            void reset_statistics() { m_calls = 0; m_skipped = 0; m_reductions = 0; m_time = 0.0; }
+        };
+        inprocess_info          m_inprocess[IP_NUM_KINDS];
+        unsigned                m_inprocess_propagations; // number of propagations in the previous simplification round
+        unsigned                m_inprocess_old_reductions;
+        stopwatch               m_inprocess_watch;
+        void init_inprocess_round();
+        bool begin_inprocess(inprocess_kind k);
+        void end_inprocess(inprocess_kind k);
+        unsigned num_reductions(inprocess_kind k) const;
+        void collect_inprocess_statistics(statistics & st) const;
+
         // -----------------------
         //
         // GC
@@ -287,6 +405,9 @@ namespace sat {
         void save_psm();
         void gc_half(char const * st_name);
         void gc_dyn_psm();
+        void gc_tiers();
+        void defrag_clauses();
+        void relocate_clauses(clause_vector & cs);
         bool activate_frozen_clause(clause & c);
         unsigned psm(clause const & c) const;
         bool can_delete(clause const & c) const {
@@ -343,6 +464,14 @@ namespace sat {
         void push();
         void pop(unsigned num_scopes);
 
+        /**
+           \brief User level scopes. Clauses added after user_push are
+           removed by the matching user_pop.
+        */
+        void user_push();
+        void user_pop(unsigned num_scopes);
+        unsigned num_user_scopes() const { return m_user_scope_literals.size(); }
+
     protected:
         void unassign_vars(unsigned old_sz);
         void reinit_clauses(unsigned old_sz);
@@ -0,0 +1,215 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    inc_sat_solver.cpp
+
+Abstract:
+
+    Incremental solver for propositional and bit-vector formulas
+    based on sat::solver.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Notes:
+
+    Every variable created by the bit-blaster is external, so the
+    SAT simplifier never eliminates a variable that may be used by
+    future assertions. The gate definitions are not removed by pop,
+    only the assertions are. Thus, terms bit-blasted in a popped scope
+    can be reused.
+
+--*/
+#include"solver_na2as.h"
+#include"inc_sat_solver.h"
+#include"sat_solver.h"
+#include"sat_bit_blaster.h"
+#include"th_rewriter.h"
+#include"tactic_exception.h"
+#include"ast_smt2_pp.h"
+#include"model_v2_pp.h"
+
+class inc_sat_solver : public solver_na2as {
+    ast_manager &       m;
+    params_ref          m_params;
+    sat::solver         m_solver;
+    sat_bit_blaster     m_bb;
+    th_rewriter         m_rw;
+    expr_ref_vector     m_assertions;
+    unsigned_vector     m_scopes;
+    sat::literal_vector m_asms;
+    expr_ref_vector     m_core;
+    model_ref           m_model;
+    bool                m_produce_models;
+    std::string         m_unknown;
+    // reason for not supporting the current set of assertions,
+    // and the scope of the assertion that could not be bit-blasted.
+    std::string         m_unsupported;
+    unsigned            m_unsupported_lvl;
+
+    static params_ref rw_params(params_ref const & p) {
+        params_ref r(p);
+        r.set_bool("blast_distinct", true);
+        return r;
+    }
+
+public:
+    inc_sat_solver(ast_manager & _m, params_ref const & p):
+        solver_na2as(_m),
+        m(_m),
+        m_params(p),
+        m_solver(p, 0),
+        m_bb(_m, m_solver, true),
+        m_rw(_m, rw_params(p)),
+        m_assertions(_m),
+        m_core(_m),
+        m_produce_models(true),
+        m_unknown("unknown"),
+        m_unsupported_lvl(0) {
+    }
+
+    virtual ~inc_sat_solver() {}
+
+    virtual void updt_params(params_ref const & p) {
+        m_params = p;
+        m_solver.updt_params(p);
+        m_rw.updt_params(rw_params(p));
+    }
+
+    virtual void collect_param_descrs(param_descrs & r) {
+        sat::solver::collect_param_descrs(r);
+    }
+
+    virtual void set_produce_models(bool f) { m_produce_models = f; }
+
+    virtual void assert_expr(expr * t) {
+        m_assertions.push_back(t);
+        if (!m_unsupported.empty())
+            return;
+        try {
+            expr_ref r(m);
+            m_rw(t, r);
+            m_solver.pop(m_solver.scope_lvl());
+            m_bb.assert_expr(r);
+        }
+        catch (z3_exception & ex) {
+            // the assertion was not added to the SAT solver, so the
+            // queries can only return unknown until it is popped.
+            m_unsupported     = ex.msg();
+            m_unsupported_lvl = m_scopes.size();
+        }
+    }
+
+    virtual void push_core() {
+        m_scopes.push_back(m_assertions.size());
+        m_solver.user_push();
+    }
+
+    virtual void pop_core(unsigned n) {
+        SASSERT(n <= m_scopes.size());
+        unsigned new_lvl = m_scopes.size() - n;
+        m_assertions.shrink(m_scopes[new_lvl]);
+        m_scopes.shrink(new_lvl);
+        m_solver.user_pop(n);
+        if (!m_unsupported.empty() && m_unsupported_lvl > new_lvl)
+            m_unsupported.clear();
+    }
+
+    virtual lbool check_sat_core(unsigned num_assumptions, expr * const * assumptions) {
+        m_core.reset();
+        m_model = 0;
+        m_unknown = "unknown";
+        if (!m_unsupported.empty()) {
+            m_unknown = m_unsupported;
+            return l_undef;
+        }
+        m_asms.reset();
+        try {
+            for (unsigned i = 0; i < num_assumptions; i++) {
+                expr_ref r(m);
+                m_rw(assumptions[i], r);
+                m_solver.pop(m_solver.scope_lvl());
+                m_asms.push_back(m_bb.mk_literal(r));
+            }
+        }
+        catch (z3_exception & ex) {
+            m_unknown = ex.msg();
+            return l_undef;
+        }
+        lbool r = m_solver.check(m_asms.size(), m_asms.c_ptr());
+        switch (r) {
+        case l_true:
+            if (m_produce_models) {
+                m_model = alloc(model, m);
+                m_bb.mk_model(*(m_model.get()));
+                TRACE("inc_sat_solver", model_v2_pp(tout, *(m_model.get())););
+            }
+            break;
+        case l_false: {
+            sat::literal_vector const & core = m_solver.get_core();
+            for (unsigned i = 0; i < num_assumptions; i++) {
+                if (core.contains(m_asms[i]))
+                    m_core.push_back(assumptions[i]);
+            }
+            break;
+        }
+        default:
+            m_unknown = "sat solver was canceled or reached a resource limit";
+            break;
+        }
+        return r;
+    }
+
+    virtual void set_cancel(bool f) {
+        m_solver.set_cancel(f);
+        m_bb.set_cancel(f);
+        m_rw.set_cancel(f);
+    }
+
+    virtual void collect_statistics(statistics & st) const {
+        const_cast<sat::solver&>(m_solver).collect_statistics(st);
+        m_bb.collect_statistics(st);
+    }
+
+    virtual void get_unsat_core(ptr_vector<expr> & r) {
+        r.append(m_core.size(), m_core.c_ptr());
+    }
+
+    virtual void get_model(model_ref & md) {
+        md = m_model;
+    }
+
+    virtual proof * get_proof() {
+        return 0;
+    }
+
+    virtual std::string reason_unknown() const {
+        return m_unknown;
+    }
+
+    virtual void get_labels(svector<symbol> & r) {}
+
+    virtual void set_progress_callback(progress_callback * callback) {}
+
+    virtual unsigned get_num_assertions() const {
+        return m_assertions.size();
+    }
+
+    virtual expr * get_assertion(unsigned idx) const {
+        return m_assertions.get(idx);
+    }
+
+    virtual void display(std::ostream & out) const {
+        out << "(solver";
+        for (unsigned i = 0; i < m_assertions.size(); i++)
+            out << "\n  " << mk_ismt2_pp(m_assertions.get(i), m, 2);
+        out << ")";
+    }
+};
+
+solver * mk_inc_sat_solver(ast_manager & m, params_ref const & p) {
+    return alloc(inc_sat_solver, m, p);
+}
@@ -0,0 +1,31 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    inc_sat_solver.h
+
+Abstract:
+
+    Incremental solver for propositional and bit-vector formulas
+    based on sat::solver.
+
+    Assertions are bit-blasted directly into a sat::solver that is
+    kept alive between queries. Scopes are mapped to the user scopes of
+    the SAT solver, and assumptions to SAT assumptions.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Notes:
+
+--*/
+#ifndef _INC_SAT_SOLVER_H_
+#define _INC_SAT_SOLVER_H_
+
+#include"solver.h"
+
+solver * mk_inc_sat_solver(ast_manager & m, params_ref const & p);
+
+#endif
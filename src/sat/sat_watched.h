@@ -32,6 +32,10 @@ namespace sat {
        4) A external constraint-idx: for external constraints.
 
        For binary clauses: we use a bit to store whether the binary clause was learned or not.
+
+       Binary clauses are kept at the beginning of the watch list (see insert_bin_watch),
+       so they can be propagated without touching clause memory. Watched clauses store a
+       blocked literal: if it is true, the clause is satisfied and does not need to be visited.
        
        Remark: there is not Clause object for binary clauses.
     */
@@ -126,6 +130,27 @@ namespace sat {
 
     typedef vector<watched> watch_list;
 
+    /**
+       \brief Add the binary watch w to wlist, keeping the binary watches before the other ones.
+       The position is found using binary search, and the first non-binary watch is moved to the end of the list.
+    */
+    inline void insert_bin_watch(watch_list & wlist, watched const & w) {
+        SASSERT(w.is_binary_clause());
+        wlist.push_back(w);
+        unsigned last = wlist.size() - 1;
+        unsigned lo   = 0;
+        unsigned hi   = last;
+        while (lo < hi) {
+            unsigned mid = lo + (hi - lo) / 2;
+            if (wlist[mid].is_binary_clause())
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo != last)
+            std::swap(wlist[lo], wlist[last]);
+    }
+
     bool erase_clause_watch(watch_list & wlist, clause_offset c);
     inline void erase_ternary_watch(watch_list & wlist, literal l1, literal l2) { wlist.erase(watched(l1, l2)); }
 
@@ -52,15 +52,19 @@ struct goal2sat::imp {
     obj_hashtable<expr>         m_interface_vars;
     sat::solver &               m_solver;
     atom2bool_var &             m_map;
+    dep2asm_map *               m_dep2asm;
+    ptr_vector<expr>            m_deps;
+    sat::literal_vector         m_dep_lits;
     sat::bool_var               m_true;
     bool                        m_ite_extra;
     unsigned long long          m_max_memory;
     volatile bool               m_cancel;
     
-    imp(ast_manager & _m, params_ref const & p, sat::solver & s, atom2bool_var & map):
+    imp(ast_manager & _m, params_ref const & p, sat::solver & s, atom2bool_var & map, dep2asm_map * dep2asm):
         m(_m),
         m_solver(s),
-        m_map(map) {
+        m_map(map),
+        m_dep2asm(dep2asm) {
         updt_params(p);
         m_cancel = false;
         m_true = sat::null_bool_var;
@@ -313,10 +317,10 @@ struct goal2sat::imp {
         }
     }
     
-    void process(expr * n) {
+    void process(expr * n, bool root = true) {
         TRACE("goal2sat", tout << "converting: " << mk_ismt2_pp(n, m) << "\n";);
-        if (visit(n, true, false)) {
-            SASSERT(m_result_stack.empty());
+        if (visit(n, root, false)) {
+            SASSERT(m_result_stack.size() == (root ? 0 : 1));
             return;
         }
         while (!m_frame_stack.empty()) {
@@ -357,7 +361,36 @@ struct goal2sat::imp {
             convert(t, root, sign);
             m_frame_stack.pop_back();
         }
-        SASSERT(m_result_stack.empty());
+        SASSERT(m_result_stack.size() == (root ? 0 : 1));
+    }
+
+    /**
+       \brief Return the assumption literal tracking the dependency leaf d.
+       The literal uses a fresh external variable, so it is never eliminated by the SAT simplifier.
+    */
+    sat::literal dep2asm(expr * d) {
+        sat::literal l;
+        if (!m_dep2asm->find(d, l)) {
+            l = sat::literal(m_solver.mk_var(true), false);
+            m_dep2asm->insert(d, l);
+        }
+        return l;
+    }
+
+    /**
+       \brief Assert f guarded by the assumption literals of the leaves of dep,
+       that is, the clause (l_f or ~a_1 or ... or ~a_n).
+    */
+    void process(expr * f, expr_dependency * dep) {
+        m_deps.reset();
+        m.linearize(dep, m_deps);
+        m_dep_lits.reset();
+        for (unsigned i = 0; i < m_deps.size(); i++)
+            m_dep_lits.push_back(~dep2asm(m_deps[i]));
+        process(f, false);
+        m_dep_lits.push_back(m_result_stack.back());
+        m_result_stack.reset();
+        mk_clause(m_dep_lits.size(), m_dep_lits.c_ptr());
     }
 
 
@@ -368,7 +401,11 @@ struct goal2sat::imp {
         unsigned size = g.size();
         for (unsigned idx = 0; idx < size; idx++) {
             expr * f = g.form(idx);
-            process(f);
+            expr_dependency * d = g.dep(idx);
+            if (m_dep2asm != 0 && d != 0)
+                process(f, d);
+            else
+                process(f);
         }
     }
 
@@ -440,7 +477,13 @@ struct goal2sat::scoped_set_imp {
 };
 
 void goal2sat::operator()(goal const & g, params_ref const & p, sat::solver & t, atom2bool_var & m) {
-    imp proc(g.m(), p, t, m);
+    imp proc(g.m(), p, t, m, 0);
+    scoped_set_imp set(this, &proc);
+    proc(g);
+}
+
+void goal2sat::operator()(goal const & g, params_ref const & p, sat::solver & t, atom2bool_var & m, dep2asm_map & dep2asm) {
+    imp proc(g.m(), p, t, m, &dep2asm);
     scoped_set_imp set(this, &proc);
     proc(g);
 }
@@ -57,6 +57,16 @@ public:
     */
     void operator()(goal const & g, params_ref const & p, sat::solver & t, atom2bool_var & m);
 
+    typedef obj_map<expr, sat::literal> dep2asm_map;
+
+    /**
+       \brief Similar to the previous method, but each formula with a non-empty dependency
+       is guarded by assumption literals, one for each leaf of the dependency.
+       The mapping from leaves to assumption literals is stored in dep2asm.
+       An unsat core of the SAT solver over these literals is then an unsat core of the goal.
+    */
+    void operator()(goal const & g, params_ref const & p, sat::solver & t, atom2bool_var & m, dep2asm_map & dep2asm);
+
     void set_cancel(bool f);
 };
 
@@ -46,13 +46,18 @@ class sat_tactic : public tactic {
                         expr_dependency_ref & core) {
             mc = 0; pc = 0; core = 0;
             fail_if_proof_generation("sat", g);
-            fail_if_unsat_core_generation("sat", g);
             bool produce_models = g->models_enabled();
+            bool produce_core   = g->unsat_core_enabled();
             TRACE("before_sat_solver", g->display(tout););
             g->elim_redundancies();
 
             atom2bool_var map(m);
-            m_goal2sat(*g, m_params, m_solver, map);
+            // dependencies are tracked using assumption literals.
+            goal2sat::dep2asm_map dep2asm;
+            if (produce_core)
+                m_goal2sat(*g, m_params, m_solver, map, dep2asm);
+            else
+                m_goal2sat(*g, m_params, m_solver, map);
             TRACE("sat_solver_unknown", tout << "interpreted_atoms: " << map.interpreted_atoms() << "\n";
                   atom2bool_var::iterator it  = map.begin();
                   atom2bool_var::iterator end = map.end();
@@ -67,9 +72,22 @@ class sat_tactic : public tactic {
             IF_VERBOSE(TACTIC_VERBOSITY_LVL, m_solver.display_status(verbose_stream()););
             TRACE("sat_dimacs", m_solver.display_dimacs(tout););
             
-            lbool r = m_solver.check();
+            sat::literal_vector asms;
+            goal2sat::dep2asm_map::iterator it  = dep2asm.begin();
+            goal2sat::dep2asm_map::iterator end = dep2asm.end();
+            for (; it != end; ++it)
+                asms.push_back(it->m_value);
+            lbool r = m_solver.check(asms.size(), asms.c_ptr());
             if (r == l_false) {
-                g->assert_expr(m.mk_false(), 0, 0);
+                expr_dependency * lcore = 0;
+                if (produce_core) {
+                    sat::literal_vector const & ucore = m_solver.get_core();
+                    for (it = dep2asm.begin(); it != end; ++it) {
+                        if (ucore.contains(it->m_value))
+                            lcore = m.mk_join(lcore, m.mk_leaf(it->m_key));
+                    }
+                }
+                g->assert_expr(m.mk_false(), 0, lcore);
             }
             else if (r == l_true && !map.interpreted_atoms()) {
                 // register model
@@ -99,6 +117,8 @@ class sat_tactic : public tactic {
                 }
             }
             else {
+                if (!dep2asm.empty())
+                    throw tactic_exception("sat tactic does not support unsat cores for goals containing interpreted atoms");
                 // get simplified problem.
 #if 0
                 IF_VERBOSE(TACTIC_VERBOSITY_LVL, verbose_stream() << "\"formula constains interpreted atoms, recovering formula from sat solver...\"\n";);
@@ -24,6 +24,7 @@ Revision History:
 #include"trail.h"
 #include"stopwatch.h"
 #include"ast_smt2_pp.h"
+#include"obj_pair_hashtable.h"
 #include<algorithm>
 
 // #define _PROFILE_MAM
@@ -3093,6 +3094,77 @@ namespace smt {
         bool                        m_check_missing_instances;
 #endif
 
+        struct stats {
+            unsigned m_num_executions;     // number of times a code tree was executed on a candidate
+            unsigned m_num_matches;
+            unsigned m_num_instances;      // matches that produced new instances
+            unsigned m_num_path_tree_visits;
+            unsigned m_num_parent_visits;  // parents inspected while traversing the inverted path index
+            unsigned m_num_rematches;
+            void reset() { memset(this, 0, sizeof(*this)); }
+            stats() { reset(); }
+        };
+        stats                       m_stats;
+
+        // Profiling information, it is only collected if qi.profile == true.
+        struct pattern_stat {
+            quantifier * m_qa;
+            app *        m_mp;
+            unsigned     m_num_matches;
+            unsigned     m_num_instances;
+            pattern_stat(quantifier * qa, app * mp):m_qa(qa), m_mp(mp), m_num_matches(0), m_num_instances(0) {}
+        };
+        bool                                     m_profile;
+        svector<pattern_stat>                    m_pattern_stats;
+        obj_pair_map<quantifier, app, unsigned>  m_pattern2stat;
+        obj_map<func_decl, double>               m_lbl2time;   // matching time of the code tree of each label
+        double                                   m_index_time; // time spent traversing the inverted path index
+        stopwatch                                m_watch;
+
+        pattern_stat & get_pattern_stat(quantifier * qa, app * mp) {
+            unsigned idx;
+            if (!m_pattern2stat.find(qa, mp, idx)) {
+                idx = m_pattern_stats.size();
+                m_pattern_stats.push_back(pattern_stat(qa, mp));
+                m_pattern2stat.insert(qa, mp, idx);
+                m_ast_manager.inc_ref(qa);
+                m_ast_manager.inc_ref(mp);
+            }
+            return m_pattern_stats[idx];
+        }
+
+        void reset_profile() {
+            for (unsigned i = 0; i < m_pattern_stats.size(); i++) {
+                m_ast_manager.dec_ref(m_pattern_stats[i].m_qa);
+                m_ast_manager.dec_ref(m_pattern_stats[i].m_mp);
+            }
+            m_pattern_stats.reset();
+            m_pattern2stat.reset();
+            m_lbl2time.reset();
+            m_index_time = 0.0;
+        }
+
+        void start_watch() {
+            if (m_profile) {
+                m_watch.reset();
+                m_watch.start();
+            }
+        }
+
+        void stop_watch(func_decl * lbl) {
+            if (m_profile) {
+                m_watch.stop();
+                obj_map<func_decl, double>::obj_map_entry * e = m_lbl2time.insert_if_not_there2(lbl, 0.0);
+                e->get_data().m_value += m_watch.get_seconds();
+            }
+        }
+
+        double get_lbl_time(func_decl * lbl) const {
+            double r = 0.0;
+            m_lbl2time.find(lbl, r);
+            return r;
+        }
+
         enode_vector * mk_tmp_vector() {
             enode_vector * r = m_pool.mk();
             r->reset();
@@ -3494,6 +3566,7 @@ namespace smt {
             unsigned head = 0;
             while (head < m_todo.size()) {
                 path_tree    * t    = m_todo[head];
+                m_stats.m_num_path_tree_visits++;
 #ifdef _PROFILE_PATH_TREE
                 t->m_counter++;
 #endif
@@ -3547,6 +3620,7 @@ namespace smt {
                     TRACE("mam_path_tree", tout << "processing: #" << curr_child->get_owner_id() << "\n";); 
                     enode_vector::const_iterator it2  = curr_child->begin_parents();
                     enode_vector::const_iterator end2 = curr_child->end_parents();
+                    m_stats.m_num_parent_visits += curr_child->get_num_parents();
                     for (; it2 != end2; ++it2) {
                         enode * curr_parent        = *it2;
 #ifdef _PROFILE_PATH_TREE
@@ -3732,14 +3806,18 @@ namespace smt {
                 code_tree * tmp_tree = m_tmp_trees[lbl_id];
                 SASSERT(tmp_tree != 0);
                 SASSERT(m_context.get_num_enodes_of(lbl) > 0);
+                start_watch();
                 m_interpreter.init(tmp_tree);
                 enode_vector::const_iterator it3  = m_context.begin_enodes_of(lbl);
                 enode_vector::const_iterator end3 = m_context.end_enodes_of(lbl);
                 for (; it3 != end3; ++it3) {
                     enode * app = *it3;
-                    if (m_context.is_relevant(app)) 
+                    if (m_context.is_relevant(app)) {
+                        m_stats.m_num_executions++;
                         m_interpreter.execute_core(tmp_tree, app);
+                    }
                 }
+                stop_watch(lbl);
                 m_tmp_trees[lbl_id] = 0;
                 dealloc(tmp_tree);
             }
@@ -3786,7 +3864,9 @@ namespace smt {
             m_trees(m_ast_manager, m_compiler, m_trail_stack),
             m_region(m_trail_stack.get_region()),
             m_r1(0),
-            m_r2(0) {
+            m_r2(0),
+            m_profile(ctx.get_fparams().m_qi_profile),
+            m_index_time(0.0) {
             DEBUG_CODE(m_trees.set_context(&ctx););
             DEBUG_CODE(m_check_missing_instances = false;);
             reset_pp_pc();
@@ -3794,6 +3874,7 @@ namespace smt {
         
         virtual ~mam_impl() {
             m_trail_stack.reset();
+            reset_profile();
         }
 
         virtual void add_pattern(quantifier * qa, app * mp) {
@@ -3866,7 +3947,10 @@ namespace smt {
             for (; it != end; ++it) {
                 code_tree * t = *it;
                 SASSERT(t->has_candidates());
+                m_stats.m_num_executions += t->get_candidates().size();
+                start_watch();
                 m_interpreter.execute(t);
+                stop_watch(t->get_root_lbl());
                 t->reset_candidates();
             }
             m_to_match.reset();
@@ -3877,21 +3961,26 @@ namespace smt {
         }
 
         virtual void rematch(bool use_irrelevant) {
+            m_stats.m_num_rematches++;
             ptr_vector<code_tree>::iterator it  = m_trees.begin_code_trees();
             ptr_vector<code_tree>::iterator end = m_trees.end_code_trees();
             unsigned lbl = 0;
             for (; it != end; ++it, ++lbl) {
                 code_tree * t = *it;
                 if (t) {
+                    start_watch();
                     m_interpreter.init(t);
                     func_decl * lbl = t->get_root_lbl();
                     enode_vector::const_iterator it2  = m_context.begin_enodes_of(lbl);
                     enode_vector::const_iterator end2 = m_context.end_enodes_of(lbl);
                     for (; it2 != end2; ++it2) {
                         enode * curr = *it2;
-                        if (use_irrelevant || m_context.is_relevant(curr)) 
+                        if (use_irrelevant || m_context.is_relevant(curr)) {
+                            m_stats.m_num_executions++;
                             m_interpreter.execute_core(t, curr);
+                        }
                     }
+                    stop_watch(lbl);
                 }
             }
         }
@@ -3923,12 +4012,57 @@ namespace smt {
                 SASSERT(bindings[i]->get_generation() <= max_generation);
             }
 #endif
-            m_context.add_instance(qa, pat, num_bindings, bindings, max_generation, m_interpreter.get_min_top_generation(), m_interpreter.get_max_top_generation(), used_enodes);
+            m_stats.m_num_matches++;
+            bool is_new = m_context.add_instance(qa, pat, num_bindings, bindings, max_generation, m_interpreter.get_min_top_generation(), m_interpreter.get_max_top_generation(), used_enodes);
+            if (is_new)
+                m_stats.m_num_instances++;
+            if (m_profile) {
+                pattern_stat & s = get_pattern_stat(qa, pat);
+                s.m_num_matches++;
+                if (is_new)
+                    s.m_num_instances++;
+            }
         }
 
         virtual bool is_shared(enode * n) const {
             return m_shared_enodes.contains(n);
         }
+
+        virtual void collect_statistics(::statistics & st) const {
+            st.update("mam executions", m_stats.m_num_executions);
+            st.update("mam matches", m_stats.m_num_matches);
+            st.update("mam new instances", m_stats.m_num_instances);
+            st.update("mam path tree visits", m_stats.m_num_path_tree_visits);
+            st.update("mam parent visits", m_stats.m_num_parent_visits);
+            st.update("mam rematches", m_stats.m_num_rematches);
+        }
+
+        virtual void reset_statistics() {
+            m_stats.reset();
+            reset_profile();
+        }
+
+        virtual void display_profile(std::ostream & out) const {
+            if (m_pattern_stats.empty())
+                return;
+            // Remark: the code tree of a label f is shared by all patterns whose top-level symbol is f.
+            // Thus, the matching time of a pattern is the time of the code trees of its sub-patterns.
+            out << "[pattern_profile] index time: " << m_index_time << " secs\n";
+            svector<pattern_stat>::const_iterator it  = m_pattern_stats.begin();
+            svector<pattern_stat>::const_iterator end = m_pattern_stats.end();
+            for (; it != end; ++it) {
+                double time = 0.0;
+                for (unsigned i = 0; i < it->m_mp->get_num_args(); i++)
+                    time += get_lbl_time(to_app(it->m_mp->get_arg(i))->get_decl());
+                out << "[pattern_profile] ";
+                out.width(10);
+                out << it->m_qa->get_qid().str().c_str() << " : ";
+                out.width(6);
+                out << it->m_num_matches << " : ";
+                out.width(6);
+                out << it->m_num_instances << " : " << time << " : " << mk_ismt2_pp(it->m_mp, m_ast_manager) << "\n";
+            }
+        }
         
         // This method is invoked when n becomes relevant.
         // If lazy == true, then n is not added to the list of candidate enodes for matching. That is, the method just updates the lbls.
@@ -3972,9 +4106,17 @@ namespace smt {
                   tout << "r1.plbls: " << r1->get_plbls() << "\n";
                   tout << "r2.plbls: " << r2->get_plbls() << "\n";);
             
+            if (m_profile) {
+                m_watch.reset();
+                m_watch.start();
+            }
             process_pc(r1, r2);
             process_pc(r2, r1);
             process_pp(r1, r2);
+            if (m_profile) {
+                m_watch.stop();
+                m_index_time += m_watch.get_seconds();
+            }
             
             approx_set   r1_plbls = r1->get_plbls();
             approx_set & r2_plbls = r2->get_plbls();
@@ -21,6 +21,7 @@ Revision History:
 
 #include"ast.h"
 #include"smt_types.h"
+#include"statistics.h"
 
 namespace smt {
     /**
@@ -61,6 +62,17 @@ namespace smt {
         
         virtual bool is_shared(enode * n) const = 0;
 
+        virtual void collect_statistics(::statistics & st) const = 0;
+
+        virtual void reset_statistics() = 0;
+
+        /**
+           \brief Display the number of matches, the number of new instances, and the
+           matching time of each pattern. The information is only collected when
+           qi.profile is true.
+        */
+        virtual void display_profile(std::ostream & out) const = 0;
+
 #ifdef Z3DEBUG
         virtual bool check_missing_instances() = 0;
 #endif
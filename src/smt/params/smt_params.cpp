@@ -31,10 +31,15 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_restart_strategy = static_cast<restart_strategy>(p.restart_strategy());
     m_restart_factor = p.restart_factor();
     m_case_split_strategy = static_cast<case_split_strategy>(p.case_split());
+    m_rephase_base = p.rephase_base();
     m_delay_units = p.delay_units();
+    m_max_retained_lemmas = p.max_retained_lemmas();
     m_delay_units_threshold = p.delay_units_threshold();
     m_preprocess = _p.get_bool("preprocess", true); // hidden parameter
     m_soft_timeout = p.soft_timeout();
+    m_threads = p.threads();
+    m_cube_depth = p.cube_depth();
+    m_cube_probe_conflicts = p.cube_probe_conflicts();
     model_params mp(_p);
     m_model_compact = mp.compact();
     if (_p.get_bool("arith.greatest_error_pivot", false))
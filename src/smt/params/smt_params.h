@@ -66,6 +66,8 @@ enum case_split_strategy {
     CS_RELEVANCY, // case split based on relevancy
     CS_RELEVANCY_ACTIVITY, // case split based on relevancy and activity
     CS_RELEVANCY_GOAL, // based on relevancy and the current goal
+    CS_LEARNING_RATE, // learning rate based branching (LRB)
+    CS_CONFLICT_HISTORY, // conflict history based branching (CHB)
 };
 
 struct smt_params : public preprocessor_params, 
@@ -107,6 +109,7 @@ struct smt_params : public preprocessor_params,
     case_split_strategy m_case_split_strategy;
     unsigned            m_rel_case_split_order;
     bool                m_lookahead_diseq;
+    unsigned            m_rephase_base;
 
     // -----------------------------------
     //
@@ -151,6 +154,7 @@ struct smt_params : public preprocessor_params,
     unsigned          m_new_clause_relevancy; //!< Max. number of unassigned literals to be considered relevant.
     unsigned          m_old_clause_relevancy; //!< Max. number of unassigned literals to be considered relevant.
     double            m_inv_clause_decay;     //!< clause activity decay
+    unsigned          m_max_retained_lemmas;  //!< Max. number of learned clauses kept when a user scope is popped (0 - disabled).
     
     // -----------------------------------
     //
@@ -187,6 +191,15 @@ struct smt_params : public preprocessor_params,
     // -----------------------------------
     unsigned         m_progress_sampling_freq;
 
+    // -----------------------------------
+    //
+    // Cube and conquer
+    //
+    // -----------------------------------
+    unsigned         m_threads;             //!< number of workers, cube and conquer is used if > 1
+    unsigned         m_cube_depth;          //!< number of atoms used to build cubes, 0 means automatic
+    unsigned         m_cube_probe_conflicts; //!< conflicts of the sequential search used to select the atoms
+
     // -----------------------------------
     //
     // Debugging goodies
@@ -235,6 +248,7 @@ struct smt_params : public preprocessor_params,
         m_case_split_strategy(CS_ACTIVITY_DELAY_NEW),
         m_rel_case_split_order(0),
         m_lookahead_diseq(false),
+        m_rephase_base(1000),
         m_delay_units(false),
         m_delay_units_threshold(32),
         m_theory_resolve(false),
@@ -255,6 +269,7 @@ struct smt_params : public preprocessor_params,
         m_new_clause_relevancy(45), 
         m_old_clause_relevancy(6),
         m_inv_clause_decay(1),
+        m_max_retained_lemmas(0),
         m_smtlib_dump_lemmas(false),
         m_smtlib_logic("AUFLIA"),
         m_profile_res_sub(false),
@@ -266,6 +281,9 @@ struct smt_params : public preprocessor_params,
         m_model_on_timeout(false),
         m_model_on_final_check(false),
         m_progress_sampling_freq(0),
+        m_threads(1),
+        m_cube_depth(0),
+        m_cube_probe_conflicts(2000),
         m_display_installed_theories(false),
         m_preprocess(true), // temporary hack for disabling all preprocessing..
         m_user_theory_preprocess_axioms(false),
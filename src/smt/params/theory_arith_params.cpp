@@ -34,6 +34,9 @@ void theory_arith_params::updt_params(params_ref const & _p) {
     m_arith_int_eq_branching = p.arith_int_eq_branch();
     m_arith_ignore_int = p.arith_ignore_int();
     m_arith_bound_prop = static_cast<bound_prop_mode>(p.arith_propagation_mode());
+    m_arith_simplex_backend = static_cast<arith_simplex_backend>(p.arith_simplex_backend());
+    m_arith_lu_threshold = p.arith_lu_threshold();
+    m_arith_lu_max_iterations = p.arith_lu_max_iterations();
 }
 
 
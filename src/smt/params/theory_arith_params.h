@@ -47,6 +47,12 @@ enum arith_pivot_strategy {
     ARITH_PIVOT_LEAST_ERROR
 };
 
+enum arith_simplex_backend {
+    ARITH_SIMPLEX_TABLEAU,   // exact simplex on the tableau
+    ARITH_SIMPLEX_SPARSE_LU, // find a basis using a revised simplex in double precision, then repair it with the exact one
+    ARITH_SIMPLEX_FP_FILTERED // use the assignment found in double precision, and pivot the exact tableau only if it is not validated
+};
+
 struct theory_arith_params {
     arith_solver_id         m_arith_mode;
     bool                    m_arith_auto_config_simplex; //!< force simplex solver in auto_config
@@ -80,6 +86,10 @@ struct theory_arith_params {
 
     arith_pivot_strategy    m_arith_pivot_strategy;
 
+    arith_simplex_backend   m_arith_simplex_backend;
+    unsigned                m_arith_lu_threshold;       //!< minimal number of infeasible base variables for using the sparse LU backend
+    unsigned                m_arith_lu_max_iterations;
+
     // used in diff-logic
     bool                    m_arith_add_binary_bounds;
     arith_prop_strategy     m_arith_propagation_strategy;
@@ -136,6 +146,9 @@ struct theory_arith_params {
         m_arith_adaptive_gcd(false),
         m_arith_propagation_threshold(UINT_MAX),
         m_arith_pivot_strategy(ARITH_PIVOT_SMALLEST),
+        m_arith_simplex_backend(ARITH_SIMPLEX_TABLEAU),
+        m_arith_lu_threshold(8),
+        m_arith_lu_max_iterations(10000),
         m_arith_add_binary_bounds(false),
         m_arith_propagation_strategy(ARITH_PROP_PROPORTIONAL),
         m_arith_eq_bounds(false),
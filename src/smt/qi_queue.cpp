@@ -23,6 +23,10 @@ Revision History:
 #include"ast_ll_pp.h"
 #include"var_subst.h"
 #include"stats.h"
+#include<algorithm>
+#include<sstream>
+#include<float.h>
+#include<math.h>
 
 namespace smt {
 
@@ -37,12 +41,14 @@ namespace smt {
         m_parser(m_manager),
         m_evaluator(m_manager),
         m_subst(m_manager),
-        m_instances(m_manager) {
+        m_instances(m_manager),
+        m_profile(false) {
         init_parser_vars();
         m_vals.resize(15, 0.0f);
     }
     
     qi_queue::~qi_queue() {
+        reset_profile();
     }
 
     void qi_queue::setup() {
@@ -63,6 +69,7 @@ namespace smt {
             VERIFY(m_parser.parse_string("cost", m_new_gen_function));
         }
         m_eager_cost_threshold = m_params.m_qi_eager_threshold;
+        m_profile              = m_params.m_qi_profile || !m_params.m_qi_profile_json.empty();
     }
 
     void qi_queue::init_parser_vars() {
@@ -167,6 +174,8 @@ namespace smt {
             else {
                 TRACE("qi_queue", tout << "delaying quantifier instantiation... " << f << "\n" << mk_pp(qa, m_manager) << "\ncost: " << curr.m_cost << "\n";);
                 m_delayed_entries.push_back(curr);
+                if (m_profile)
+                    get_profile(qa).m_num_delayed++;
             }
 
             // Periodically check if we didn't run out of time/memory.
@@ -202,7 +211,24 @@ namespace smt {
         }
     }
 
-    void qi_queue::instantiate(entry & ent) {
+    void qi_queue::instantiate(entry & ent, bool lazy) {
+        unsigned new_gen = 0;
+        if (!m_profile) {
+            instantiate_core(ent, new_gen);
+            return;
+        }
+        m_profile_watch.reset();
+        m_profile_watch.start();
+        bool created = instantiate_core(ent, new_gen);
+        m_profile_watch.stop();
+        update_profile(ent, lazy, created, new_gen);
+    }
+
+    /**
+       \brief Create the instance of the quantifier in ent. Return false if the instance is
+       already satisfied. Otherwise, store in new_gen the generation of the new terms.
+    */
+    bool qi_queue::instantiate_core(entry & ent, unsigned & new_gen) {
         fingerprint * f          = ent.m_qb;
         quantifier * q           = static_cast<quantifier*>(f->get_data());
         unsigned generation      = ent.m_generation;
@@ -218,7 +244,7 @@ namespace smt {
 
         if (m_checker.is_sat(q->get_expr(), num_bindings, bindings)) {
             TRACE("checker", tout << "instance already satisfied\n";);
-            return;
+            return false;
         }
         expr_ref instance(m_manager);
         m_subst(q, num_bindings, bindings, instance);
@@ -236,7 +262,7 @@ namespace smt {
             if (m_manager.has_trace_stream()) 
                 m_manager.trace_stream() << "[end-of-instance]\n";
 
-            return;
+            return false;
         }
         quantifier_stat * stat = m_qm.get_stat(q);
         stat->inc_num_instances();
@@ -290,6 +316,7 @@ namespace smt {
         TRACE("qi_queue", tout << mk_pp(lemma, m_manager) << "\n#" << lemma->get_id() << ":=\n" << mk_ll_pp(lemma, m_manager););
         m_stats.m_num_instances++;
         unsigned gen = get_new_gen(q, generation, ent.m_cost);
+        new_gen      = gen;
         display_instance_profile(f, q, num_bindings, bindings, proof_id, gen);
         m_context.internalize_instance(lemma, pr1, gen);
         TRACE_CODE({
@@ -319,7 +346,7 @@ namespace smt {
 
         if (m_manager.has_trace_stream())
             m_manager.trace_stream() << "[end-of-instance]\n";
-
+        return true;
     }
 
     void qi_queue::push_scope() {
@@ -387,7 +414,7 @@ namespace smt {
                     result             = false;
                     m_instantiated_trail.push_back(i);
                     m_stats.m_num_lazy_instances++;
-                    instantiate(e);
+                    instantiate(e, true);
                 }
             }
             return result;
@@ -405,7 +432,7 @@ namespace smt {
                 result             = false;
                 m_instantiated_trail.push_back(i);
                 m_stats.m_num_lazy_instances++;
-                instantiate(e);
+                instantiate(e, true);
             }
         }
         return result;
@@ -488,5 +515,148 @@ namespace smt {
 #endif
     }
     
-};
+    qi_queue::qa_profile & qi_queue::get_profile(quantifier * q) {
+        qa_profile * p = 0;
+        if (!m_qa2profile.find(q, p)) {
+            p = alloc(qa_profile, q);
+            m_manager.inc_ref(q);
+            m_profiles.push_back(p);
+            m_qa2profile.insert(q, p);
+        }
+        return *p;
+    }
+
+#define MAX_PROFILE_GENERATION 64
+
+    void qi_queue::update_profile(entry const & ent, bool lazy, bool created, unsigned new_gen) {
+        qa_profile & p = get_profile(static_cast<quantifier*>(ent.m_qb->get_data()));
+        p.m_time += m_profile_watch.get_seconds();
+        if (!created) {
+            p.m_num_redundant++;
+            return;
+        }
+        p.m_num_instances++;
+        if (lazy)
+            p.m_num_lazy_instances++;
+        p.m_sum_cost += ent.m_cost;
+        if (p.m_num_instances == 1 || ent.m_cost > p.m_max_cost)
+            p.m_max_cost = ent.m_cost;
+        unsigned g = std::min(static_cast<unsigned>(ent.m_generation), static_cast<unsigned>(MAX_PROFILE_GENERATION - 1));
+        if (g >= p.m_generations.size())
+            p.m_generations.resize(g + 1, 0);
+        p.m_generations[g]++;
+        unsigned len = 1;
+        if (p.m_chains.find(ent.m_generation, len))
+            len++;
+        unsigned old_len = 0;
+        if (!p.m_chains.find(new_gen, old_len) || old_len < len)
+            p.m_chains.insert(new_gen, len);
+        if (len > p.m_max_chain)
+            p.m_max_chain = len;
+        fingerprint * f = ent.m_qb;
+        unsigned h = f->get_num_args();
+        for (unsigned i = 0; i < f->get_num_args(); i++)
+            h = hash_u_u(h, f->get_arg(i)->get_owner()->get_decl()->get_id());
+        unsigned gen = 0, rep = 1;
+        if (p.m_shape2gen.find(h, gen) && gen <= ent.m_generation && p.m_shape2len.find(h, rep))
+            rep++;
+        p.m_shape2gen.insert(h, new_gen);
+        p.m_shape2len.insert(h, rep);
+        if (rep > p.m_max_repeated)
+            p.m_max_repeated = rep;
+    }
+
+    void qi_queue::reset_profile() {
+        ptr_vector<qa_profile>::iterator it  = m_profiles.begin();
+        ptr_vector<qa_profile>::iterator end = m_profiles.end();
+        for (; it != end; ++it) {
+            m_manager.dec_ref((*it)->m_qa);
+            dealloc(*it);
+        }
+        m_profiles.reset();
+        m_qa2profile.reset();
+    }
+
+    static void display_json_string(std::ostream & out, char const * s) {
+        out << "\"";
+        for (; *s; ++s) {
+            switch (*s) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*s) < 0x20)
+                    out << "?";
+                else
+                    out << *s;
+            }
+        }
+        out << "\"";
+    }
+
+    /**
+       \brief JSON has no infinity or NaN, they are displayed as null.
+    */
+    static void display_json_double(std::ostream & out, double v) {
+        if (fabs(v) <= DBL_MAX)
+            out << v;
+        else
+            out << "null";
+    }
+
+    struct qa_profile_lt {
+        template<typename T>
+        bool operator()(T const * p1, T const * p2) const { 
+            return p1->m_num_instances > p2->m_num_instances || (p1->m_num_instances == p2->m_num_instances && p1->m_qa->get_id() < p2->m_qa->get_id());
+        }
+    };
 
+    void qi_queue::display_profile_json(std::ostream & out) const {
+        ptr_vector<qa_profile> profiles(m_profiles);
+        std::sort(profiles.begin(), profiles.end(), qa_profile_lt());
+        double total_time = 0.0;
+        for (unsigned i = 0; i < profiles.size(); i++)
+            total_time += profiles[i]->m_time;
+        out << "{\n";
+        out << "  \"cost\": ";
+        display_json_string(out, m_params.m_qi_cost.c_str());
+        out << ",\n  \"new_gen\": ";
+        display_json_string(out, m_params.m_qi_new_gen.c_str());
+        out << ",\n  \"eager_threshold\": ";
+        display_json_double(out, m_params.m_qi_eager_threshold);
+        out << ",\n  \"lazy_threshold\": ";
+        display_json_double(out, m_params.m_qi_lazy_threshold);
+        out << ",\n  \"instances\": " << m_stats.m_num_instances;
+        out << ",\n  \"lazy_instances\": " << m_stats.m_num_lazy_instances;
+        out << ",\n  \"time\": " << total_time;
+        out << ",\n  \"quantifiers\": [";
+        for (unsigned i = 0; i < profiles.size(); i++) {
+            qa_profile const & p = *(profiles[i]);
+            out << (i == 0 ? "\n" : ",\n");
+            out << "    {\"qid\": ";
+            std::ostringstream qid;
+            qid << p.m_qa->get_qid();
+            display_json_string(out, qid.str().c_str());
+            out << ", \"id\": " << p.m_qa->get_id()
+                << ", \"weight\": " << p.m_qa->get_weight()
+                << ", \"instances\": " << p.m_num_instances
+                << ", \"lazy_instances\": " << p.m_num_lazy_instances
+                << ", \"redundant\": " << p.m_num_redundant
+                << ", \"delayed\": " << p.m_num_delayed
+                << ", \"time\": " << p.m_time
+                << ", \"avg_cost\": ";
+            display_json_double(out, p.m_num_instances == 0 ? 0.0 : p.m_sum_cost / p.m_num_instances);
+            out << ", \"max_cost\": ";
+            display_json_double(out, p.m_max_cost);
+            out << ", \"max_chain\": " << p.m_max_chain
+                << ", \"max_repeated_fingerprints\": " << p.m_max_repeated
+                << ", \"generations\": [";
+            for (unsigned g = 0; g < p.m_generations.size(); g++) 
+                out << (g == 0 ? "" : ", ") << p.m_generations[g];
+            out << "]}";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+};
@@ -29,6 +29,8 @@ Revision History:
 #include"cost_evaluator.h"
 #include"cached_var_subst.h"
 #include"statistics.h"
+#include"stopwatch.h"
+#include"map.h"
 
 namespace smt {
     class context;
@@ -71,11 +73,47 @@ namespace smt {
         };
         svector<scope>                m_scopes;
 
+        // Instantiation profile, it is only collected if qi.profile or qi.profile_json are set.
+        struct qa_profile {
+            quantifier *    m_qa;
+            unsigned        m_num_instances;
+            unsigned        m_num_lazy_instances;
+            unsigned        m_num_redundant;   // instances that were already satisfied or were simplified to true
+            unsigned        m_num_delayed;
+            double          m_time;
+            double          m_sum_cost;
+            float           m_max_cost;
+            unsigned_vector m_generations;     // m_generations[g] is the number of instances of generation g
+            // Matching loop detection: m_chains[g] is the length of the longest chain of instances of m_qa 
+            // producing terms of generation g, where an instance extends a chain if its bindings have the 
+            // generation produced by the previous instance.
+            u_map<unsigned> m_chains;
+            unsigned        m_max_chain;
+            // Repeated fingerprints: the shape of a fingerprint is the function symbols of its bindings.
+            // m_shape2gen[h] is the generation of the terms produced by the last instance of shape h, and
+            // m_shape2len[h] the number of consecutive instances of shape h, where each one uses bindings
+            // produced after the previous one.
+            u_map<unsigned> m_shape2gen;
+            u_map<unsigned> m_shape2len;
+            unsigned        m_max_repeated;
+            qa_profile(quantifier * q):m_qa(q), m_num_instances(0), m_num_lazy_instances(0), m_num_redundant(0), m_num_delayed(0), 
+                                       m_time(0.0), m_sum_cost(0.0), m_max_cost(0.0f), m_max_chain(0), m_max_repeated(0) {}
+        };
+        bool                              m_profile;
+        ptr_vector<qa_profile>            m_profiles;
+        obj_map<quantifier, qa_profile *> m_qa2profile;
+        stopwatch                         m_profile_watch;
+
+        qa_profile & get_profile(quantifier * q);
+        void update_profile(entry const & ent, bool lazy, bool created, unsigned new_gen);
+        void reset_profile();
+
         void init_parser_vars();
         quantifier_stat * set_values(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation, float cost);
         float get_cost(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation);
         unsigned get_new_gen(quantifier * q, unsigned generation, float cost);
-        void instantiate(entry & ent);
+        void instantiate(entry & ent, bool lazy = false);
+        bool instantiate_core(entry & ent, unsigned & new_gen);
         void get_min_max_costs(float & min, float & max) const;
         void display_instance_profile(fingerprint * f, quantifier * q, unsigned num_bindings, enode * const * bindings, unsigned proof_id, unsigned generation);
 
@@ -97,6 +135,11 @@ namespace smt {
         void reset();
         void display_delayed_instances_stats(std::ostream & out) const;
         void collect_statistics(::statistics & st) const;
+        /**
+           \brief Display the instantiation profile in JSON format. 
+           See qi.profile_json.
+        */
+        void display_profile_json(std::ostream & out) const;
     };
 };
 
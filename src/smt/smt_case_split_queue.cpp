@@ -1088,6 +1088,266 @@ namespace smt {
     };
    
 
+    /**
+       \brief Case split queue based on learning rate (LRB) or conflict history (CHB).
+
+       The variables are ordered by their own scores instead of their activity. The score
+       is an exponential moving average of a reward, the step size starts at 0.4 and 
+       is decreased by 1e-6 at every conflict until it reaches 0.06.
+       
+       - LRB: when a variable is unassigned, the reward is the number of conflicts
+         it participated in while it was assigned, divided by the number of conflicts
+         since it was assigned.
+
+       - CHB: when a variable is assigned, the reward is 0.9/(c+1), where c is the number
+         of conflicts since the last conflict it participated in. When it participates in 
+         a conflict the reward is 1.
+
+       The phase of a decision is the target phase, i.e., its value in the largest
+       conflict free prefix of the trail, or the saved phase of the variable.
+       Every rephase_base*k conflicts, the target is cleared, and the saved phases 
+       are reset to the best assignment, the default phases, the best assignment, 
+       or the flipped best assignment (in this order).
+    */
+    class lr_case_split_queue : public case_split_queue {
+        context &          m_context;
+        smt_params &       m_params;
+        bool               m_chb;
+        svector<double>    m_scores;
+        bool_var_act_queue m_queue;
+        double             m_step;
+        unsigned           m_num_conflicts;
+        unsigned_vector    m_assigned_at;   // LRB: conflict counter when the variable was assigned
+        unsigned_vector    m_participated;  // LRB: number of conflicts the variable participated in since it was assigned
+        unsigned_vector    m_last_conflict; // CHB: last conflict the variable participated in
+        svector<lbool>     m_phase;         // saved phases, l_undef means default phase
+        svector<lbool>     m_target;
+        svector<lbool>     m_best;
+        unsigned           m_target_size;
+        unsigned           m_best_size;
+        unsigned           m_num_rephases;
+        unsigned           m_next_rephase;
+
+        void set_score(bool_var v, double s) {
+            double old   = m_scores[v];
+            m_scores[v]  = s;
+            if (!m_queue.contains(v))
+                return;
+            if (s > old)
+                m_queue.decreased(v);
+            else if (s < old)
+                m_queue.increased(v);
+        }
+
+        void update_score(bool_var v, double reward) {
+            set_score(v, (1.0 - m_step) * m_scores[v] + m_step * reward);
+        }
+
+        void chb_reward(bool_var v, double multiplier) {
+            update_score(v, multiplier / static_cast<double>(m_num_conflicts - m_last_conflict[v] + 1));
+        }
+
+        static lbool to_lbool(literal l) {
+            return l.sign() ? l_false : l_true;
+        }
+
+        /**
+           \brief Save the phases of the conflict free prefix of the trail if it is the largest one.
+        */
+        void update_target() {
+            unsigned lvl = m_context.get_scope_level();
+            if (lvl <= m_context.get_base_level())
+                return;
+            unsigned sz = m_context.get_decision_literal_pos(lvl);
+            literal_vector const & lits = m_context.assigned_literals();
+            if (sz > m_target_size) {
+                m_target_size = sz;
+                for (unsigned i = 0; i < sz; i++)
+                    m_target[lits[i].var()] = to_lbool(lits[i]);
+            }
+            if (sz > m_best_size) {
+                m_best_size = sz;
+                for (unsigned i = 0; i < sz; i++)
+                    m_best[lits[i].var()] = to_lbool(lits[i]);
+            }
+        }
+
+        void rephase() {
+            unsigned num_vars = m_phase.size();
+            switch (m_num_rephases % 4) {
+            case 0:
+            case 2:
+                for (bool_var v = 0; v < static_cast<bool_var>(num_vars); v++) 
+                    if (m_best[v] != l_undef)
+                        m_phase[v] = m_best[v];
+                m_best_size = 0;
+                break;
+            case 1:
+                for (bool_var v = 0; v < static_cast<bool_var>(num_vars); v++) 
+                    m_phase[v] = l_undef;
+                break;
+            default:
+                for (bool_var v = 0; v < static_cast<bool_var>(num_vars); v++) 
+                    if (m_best[v] != l_undef)
+                        m_phase[v] = m_best[v] == l_true ? l_false : l_true;
+                break;
+            }
+            for (bool_var v = 0; v < static_cast<bool_var>(num_vars); v++) 
+                m_target[v] = l_undef;
+            m_target_size = 0;
+            m_num_rephases++;
+            m_next_rephase = m_num_conflicts + m_params.m_rephase_base * (m_num_rephases + 1);
+            TRACE("rephase", tout << "rephase: " << m_num_rephases << ", next: " << m_next_rephase << "\n";);
+        }
+
+        lbool get_phase(bool_var v) {
+            if (m_context.get_bdata(v).try_true_first())
+                return l_undef;
+            if (m_target[v] != l_undef)
+                return m_target[v];
+            return m_phase[v];
+        }
+
+    public:
+        lr_case_split_queue(context & ctx, smt_params & p, bool chb):
+            m_context(ctx),
+            m_params(p),
+            m_chb(chb),
+            m_queue(1024, bool_var_act_lt(m_scores)),
+            m_step(0.4),
+            m_num_conflicts(0),
+            m_target_size(0),
+            m_best_size(0),
+            m_num_rephases(0),
+            m_next_rephase(p.m_rephase_base) {
+        }
+
+        virtual void activity_increased_eh(bool_var v) {
+            // v participates in the current conflict
+            if (m_chb) {
+                m_last_conflict[v] = m_num_conflicts;
+                chb_reward(v, 1.0);
+            }
+            else {
+                m_participated[v]++;
+            }
+        }
+
+        virtual void mk_var_eh(bool_var v) {
+            if (static_cast<unsigned>(v) >= m_scores.size()) {
+                unsigned sz = v + 1;
+                m_scores.resize(sz, 0.0);
+                m_assigned_at.resize(sz, 0);
+                m_participated.resize(sz, 0);
+                m_last_conflict.resize(sz, 0);
+                m_phase.resize(sz, l_undef);
+                m_target.resize(sz, l_undef);
+                m_best.resize(sz, l_undef);
+            }
+            m_scores[v]        = 0.0;
+            m_assigned_at[v]   = m_num_conflicts;
+            m_participated[v]  = 0;
+            m_last_conflict[v] = m_num_conflicts;
+            m_phase[v]         = l_undef;
+            m_target[v]        = l_undef;
+            m_best[v]          = l_undef;
+            m_queue.reserve(v+1);
+            if (!m_queue.contains(v))
+                m_queue.insert(v);
+        }
+
+        virtual void del_var_eh(bool_var v) {
+            if (m_queue.contains(v))
+                m_queue.erase(v);
+        }
+
+        virtual void assign_lit_eh(literal l) {
+            bool_var v = l.var();
+            m_phase[v] = to_lbool(l);
+            if (m_chb) {
+                chb_reward(v, 0.9);
+            }
+            else {
+                m_assigned_at[v]  = m_num_conflicts;
+                m_participated[v] = 0;
+            }
+        }
+
+        virtual void unassign_var_eh(bool_var v) {
+            if (!m_chb) {
+                unsigned interval = m_num_conflicts - m_assigned_at[v];
+                if (interval > 0)
+                    update_score(v, static_cast<double>(m_participated[v]) / static_cast<double>(interval));
+            }
+            if (!m_queue.contains(v))
+                m_queue.insert(v);
+        }
+
+        virtual void conflict_eh() {
+            m_num_conflicts++;
+            if (m_step > 0.06)
+                m_step -= 1e-6;
+            update_target();
+            if (m_num_conflicts >= m_next_rephase)
+                rephase();
+        }
+
+        virtual void relevant_eh(expr * n) {}
+
+        virtual void init_search_eh() {}
+
+        virtual void end_search_eh() {}
+
+        virtual void reset() {
+            m_queue.reset();
+        }
+
+        virtual void push_scope() {}
+
+        virtual void pop_scope(unsigned num_scopes) {}
+
+        virtual void next_case_split(bool_var & next, lbool & phase) {
+            phase = l_undef;
+            
+            if (m_context.get_random_value() < static_cast<int>(m_params.m_random_var_freq * random_gen::max_value())) {
+                next = m_context.get_random_value() % m_context.get_num_b_internalized(); 
+                TRACE("random_split", tout << "next: " << next << " get_assignment(next): " << m_context.get_assignment(next) << "\n";);
+                if (m_context.get_assignment(next) == l_undef) {
+                    phase = get_phase(next);
+                    return;
+                }
+            }
+            
+            while (!m_queue.empty()) {
+                next = m_queue.erase_min();
+                if (m_context.get_assignment(next) == l_undef) {
+                    phase = get_phase(next);
+                    return;
+                }
+            }
+            
+            next = null_bool_var;
+        }
+
+        virtual void display(std::ostream & out) {
+            bool first = true;
+            bool_var_act_queue::const_iterator it  = m_queue.begin();
+            bool_var_act_queue::const_iterator end = m_queue.end();
+            for (; it != end ; ++it) {
+                unsigned v = *it;
+                if (m_context.get_assignment(v) == l_undef) {
+                    if (first) {
+                        out << "remaining case-splits:\n";
+                        first = false;
+                    }
+                    out << "#" << m_context.bool_var2expr(v)->get_id() << ":" << m_scores[v] << " ";
+                }
+            }
+            if (!first)
+                out << "\n";
+        }
+    };
+
     case_split_queue * mk_case_split_queue(context & ctx, smt_params & p) {
         if (p.m_relevancy_lvl < 2 && (p.m_case_split_strategy == CS_RELEVANCY || p.m_case_split_strategy == CS_RELEVANCY_ACTIVITY || 
                                       p.m_case_split_strategy == CS_RELEVANCY_GOAL)) {
@@ -1110,6 +1370,10 @@ namespace smt {
             return alloc(rel_act_case_split_queue, ctx, p);
         case CS_RELEVANCY_GOAL:
             return alloc(rel_goal_case_split_queue, ctx, p);
+        case CS_LEARNING_RATE:
+            return alloc(lr_case_split_queue, ctx, p, false);
+        case CS_CONFLICT_HISTORY:
+            return alloc(lr_case_split_queue, ctx, p, true);
         default:
             return alloc(act_case_split_queue, ctx, p);
         }
@@ -36,6 +36,10 @@ namespace smt {
         virtual void del_var_eh(bool_var v) = 0;
         virtual void assign_lit_eh(literal l) {}
         virtual void unassign_var_eh(bool_var v) = 0;
+        /**
+           \brief Invoked when a conflict is detected, before conflict resolution.
+        */
+        virtual void conflict_eh() {}
         virtual void relevant_eh(expr * n) = 0;
         virtual void init_search_eh() = 0;
         virtual void end_search_eh() = 0;
@@ -7,7 +7,7 @@ Module Name:
 
 Abstract:
 
-    <abstract>
+    Congruence table.
 
 Author:
 
@@ -20,99 +20,26 @@ Revision History:
 #include"ast_pp.h"
 #include"ast_ll_pp.h"
 
-namespace smt {
-
-#if 0
-    unsigned cg_table::cg_hash::operator()(enode * n) const {
-        if (n->is_commutative()) {
-            return  combine_hash(n->get_decl_id(), 
-                                 n->get_arg(0)->get_root()->hash() *
-                                 n->get_arg(1)->get_root()->hash());
-        }
-        else {
-            unsigned num = n->get_num_args();
-            switch (num) {
-            case 0: UNREACHABLE(); return 0;
-            case 1: 
-                return combine_hash(n->get_decl_id(), n->get_arg(0)->get_root()->hash());
-            case 2: {
-                unsigned a = n->get_decl_id();
-                unsigned b = n->get_arg(0)->get_root()->hash();
-                unsigned c = n->get_arg(1)->get_root()->hash();
-                mix(a,b,c);
-                return c;
-            }
-            default:
-                return get_composite_hash<enode *, cg_khasher, cg_chasher>(n, n->get_num_args(), m_khasher, m_chasher);
-            }
-        }
-    }
+#define CG_TABLE_INITIAL_CAPACITY 1024
 
-    bool cg_table::cg_eq::operator()(enode * n1, enode * n2) const {
-#if 0
-        static unsigned counter = 0;
-        static unsigned failed  = 0;
-        bool r = congruent(n1, n2, m_commutativity);
-        if (!r) 
-            failed++;
-        counter++;
-        if (counter % 100000 == 0) 
-            std::cout << "cg_eq: " << counter << " " << failed << "\n";
-        return r;
-#else
-        return congruent(n1, n2, m_commutativity);
-#endif
-    }
-    
-    cg_table::cg_table(ast_manager & m):
-        m_manager(m),
-        m_table(DEFAULT_HASHTABLE_INITIAL_CAPACITY, cg_hash(), cg_eq(m_commutativity)) {
-    }
-    
-    void cg_table::display(std::ostream & out) const {
-        out << "congruence table:\n";
-        table::iterator it  = m_table.begin();
-        table::iterator end = m_table.end();
-        for (; it != end; ++it) {
-            enode * n = *it;
-            out << mk_pp(n->get_owner(), m_manager) << "\n";
-        }
-    }
+namespace smt {
 
-    void cg_table::display_compact(std::ostream & out) const {
-        if (!m_table.empty()) {
-            out << "congruence table:\n";
-            table::iterator it  = m_table.begin();
-            table::iterator end = m_table.end();
-            for (; it != end; ++it) {
-                enode * n = *it;
-                out << "#" << n->get_owner()->get_id() << " ";
-            }
-            out << "\n";
-        }
-    }
+    unsigned cg_table::sig_hash(enode * n) {
+        unsigned a, b, c;
+        a = b = 0x9e3779b9;
+        c = n->get_decl_id();
 
-#ifdef Z3DEBUG
-    bool cg_table::check_invariant() const {
-        table::iterator it  = m_table.begin();
-        table::iterator end = m_table.end();
-        for (; it != end; ++it) {
-            enode * n = *it;
-            CTRACE("cg_table", !contains_ptr(n), tout << "#" << n->get_owner_id() << "\n";);
-            SASSERT(contains_ptr(n));
+        if (n->is_commutative()) {
+            unsigned h1 = n->get_arg(0)->get_root()->hash();
+            unsigned h2 = n->get_arg(1)->get_root()->hash();
+            if (h1 > h2)
+                std::swap(h1, h2);
+            a += h1;
+            b += h2;
+            mix(a, b, c);
+            return c;
         }
-        return true;
-    }
-#endif
 
-#else
-    // one table per func_decl implementation
-    unsigned cg_table::cg_hash::operator()(enode * n) const {
-        SASSERT(n->get_decl()->is_flat_associative() || n->get_num_args() >= 3);
-        unsigned a, b, c;
-        a = b = 0x9e3779b9;
-        c = 11;    
-        
         unsigned i = n->get_num_args();
         while (i >= 3) {
             i--;
@@ -129,122 +56,187 @@ namespace smt {
             b += n->get_arg(1)->get_root()->hash();
             __fallthrough;
         case 1:
-            c += n->get_arg(0)->get_root()->hash();
+            a += n->get_arg(0)->get_root()->hash();
         }
         mix(a, b, c);
         return c;
     }
 
-    bool cg_table::cg_eq::operator()(enode * n1, enode * n2) const {
-        SASSERT(n1->get_num_args() == n2->get_num_args());
-        SASSERT(n1->get_decl() == n2->get_decl());
-        unsigned num = n1->get_num_args();
-        for (unsigned i = 0; i < num; i++) 
-            if (n1->get_arg(i)->get_root() != n2->get_arg(i)->get_root())
-                return false;
-        return true;
-    }
-
     cg_table::cg_table(ast_manager & m):
         m_manager(m) {
+        init(CG_TABLE_INITIAL_CAPACITY);
+    }
+
+    void cg_table::init(unsigned capacity) {
+        SASSERT((capacity & (capacity - 1)) == 0);
+        m_cells.reset();
+        m_cells.resize(capacity, cell());
+        m_mask = capacity - 1;
+        m_size = 0;
+    }
+
+    /**
+       \brief Double the capacity of the table. The hash codes stored in the cells are
+       reused, so the enodes are not accessed.
+    */
+    void cg_table::expand() {
+        svector<cell> old_cells;
+        old_cells.swap(m_cells);
+        unsigned new_capacity = old_cells.size() * 2;
+        m_cells.resize(new_capacity, cell());
+        m_mask = new_capacity - 1;
+        svector<cell>::const_iterator it  = old_cells.begin();
+        svector<cell>::const_iterator end = old_cells.end();
+        for (; it != end; ++it) {
+            if (it->m_enode == 0)
+                continue;
+            unsigned idx = it->m_hash & m_mask;
+            while (m_cells[idx].m_enode != 0)
+                idx = (idx + 1) & m_mask;
+            m_cells[idx] = *it;
+        }
+        m_stats.m_num_resizes++;
     }
 
-    cg_table::~cg_table() {
-        reset();
+    enode * cg_table::find_core(enode * n, unsigned h) const {
+        unsigned idx = h & m_mask;
+        unsigned len = 1;
+        while (true) {
+            cell const & c = m_cells[idx];
+            if (c.m_enode == 0) {
+                record_probe(len);
+                return 0;
+            }
+            if (c.m_hash == h) {
+                m_stats.m_num_eq_checks++;
+                if (congruent(c.m_enode, n)) {
+                    record_probe(len);
+                    return c.m_enode;
+                }
+            }
+            idx = (idx + 1) & m_mask;
+            len++;
+        }
     }
 
-    void * cg_table::mk_table_for(func_decl * d) {
-        void * r;
-        SASSERT(d->get_arity() >= 1);
-        switch (d->get_arity()) {
-        case 1:
-            r = TAG(void*, alloc(unary_table), UNARY);
-            SASSERT(GET_TAG(r) == UNARY);
-            return r;
-        case 2:
-            if (d->is_flat_associative()) {
-                // applications of declarations that are flat-assoc (e.g., +) may have many arguments.
-                r = TAG(void*, alloc(table), NARY);
-                SASSERT(GET_TAG(r) == NARY);
-                return r;
-            }
-            else if (d->is_commutative()) {
-                r = TAG(void*, alloc(comm_table, cg_comm_hash(), cg_comm_eq(m_commutativity)), BINARY_COMM);
-                SASSERT(GET_TAG(r) == BINARY_COMM);
-                return r;
+    enode_bool_pair cg_table::insert_core(enode * n) {
+        // keep the load factor below 3/4
+        if (4 * (m_size + 1) > 3 * m_cells.size())
+            expand();
+        unsigned h   = n->get_cg_hash();
+        unsigned idx = h & m_mask;
+        unsigned len = 1;
+        while (true) {
+            cell & c = m_cells[idx];
+            if (c.m_enode == 0) {
+                c.m_hash  = h;
+                c.m_enode = n;
+                m_size++;
+                record_probe(len);
+                return enode_bool_pair(n, false);
             }
-            else {
-                r = TAG(void*, alloc(binary_table), BINARY);
-                SASSERT(GET_TAG(r) == BINARY);
-                return r;
+            if (c.m_hash == h) {
+                bool comm;
+                m_stats.m_num_eq_checks++;
+                if (congruent(c.m_enode, n, comm)) {
+                    record_probe(len);
+                    return enode_bool_pair(c.m_enode, comm);
+                }
             }
-        default: 
-            r = TAG(void*, alloc(table), NARY);
-            SASSERT(GET_TAG(r) == NARY);
-            return r;
+            idx = (idx + 1) & m_mask;
+            len++;
         }
     }
 
-    unsigned cg_table::set_func_decl_id(enode * n) {
-        func_decl * f = n->get_decl();
-        unsigned tid;
-        if (!m_func_decl2id.find(f, tid)) {
-            tid = m_tables.size();
-            m_func_decl2id.insert(f, tid);
-            m_manager.inc_ref(f);
-            SASSERT(tid <= m_tables.size());
-            m_tables.push_back(mk_table_for(f));
+    void cg_table::erase(enode * n) {
+        SASSERT(n->get_num_args() > 0);
+        SASSERT(contains_ptr(n));
+        unsigned idx = n->get_cg_hash() & m_mask;
+        unsigned len = 1;
+        while (m_cells[idx].m_enode != n) {
+            if (m_cells[idx].m_enode == 0) {
+                // n is not in the table
+                record_probe(len);
+                return;
+            }
+            idx = (idx + 1) & m_mask;
+            len++;
         }
-        SASSERT(tid < m_tables.size());
-        n->set_func_decl_id(tid);
-        DEBUG_CODE({
-            unsigned tid_prime;
-            SASSERT(m_func_decl2id.find(n->get_decl(), tid_prime) && tid == tid_prime);
-        });
-        return tid;
-    }
-    
-    void cg_table::reset() {
-        ptr_vector<void>::iterator it  = m_tables.begin();
-        ptr_vector<void>::iterator end = m_tables.end();
-        for (; it != end; ++it) {
-            void * t = *it;
-            switch (GET_TAG(t)) {
-            case UNARY:
-                dealloc(UNTAG(unary_table*, t));
-                break;
-            case BINARY:
-                dealloc(UNTAG(binary_table*, t));
-                break;
-            case BINARY_COMM:
-                dealloc(UNTAG(comm_table*, t));
-                break;
-            case NARY:
-                dealloc(UNTAG(table*, t));
+        record_probe(len);
+        m_size--;
+        // Move back the cells of the cluster that would not be reachable from their
+        // home position after idx becomes empty.
+        unsigned hole = idx;
+        unsigned j    = idx;
+        while (true) {
+            j = (j + 1) & m_mask;
+            cell const & c = m_cells[j];
+            if (c.m_enode == 0)
                 break;
+            unsigned home = c.m_hash & m_mask;
+            // c can stay at j iff its home is in the cyclic interval (hole, j]
+            bool stays = hole <= j ? (hole < home && home <= j) : (hole < home || home <= j);
+            if (!stays) {
+                m_cells[hole] = c;
+                hole = j;
             }
         }
-        m_tables.reset();
-        obj_map<func_decl, unsigned>::iterator it2  = m_func_decl2id.begin();
-        obj_map<func_decl, unsigned>::iterator end2 = m_func_decl2id.end();
-        for (; it2 != end2; ++it2) 
-            m_manager.dec_ref(it2->m_key);
-        m_func_decl2id.reset();
+        m_cells[hole] = cell();
+    }
+
+    void cg_table::reset() {
+        init(CG_TABLE_INITIAL_CAPACITY);
+    }
+
+    void cg_table::collect_statistics(::statistics & st) const {
+        st.update("cg table lookups", m_stats.m_num_lookups);
+        st.update("cg table probes", m_stats.m_num_probes);
+        st.update("cg table max probe", m_stats.m_max_probe);
+        st.update("cg table eq checks", m_stats.m_num_eq_checks);
+        st.update("cg table resizes", m_stats.m_num_resizes);
     }
 
     void cg_table::display(std::ostream & out) const {
+        out << "congruence table:\n";
+        svector<cell>::const_iterator it  = m_cells.begin();
+        svector<cell>::const_iterator end = m_cells.end();
+        for (; it != end; ++it) {
+            if (it->m_enode != 0)
+                out << mk_pp(it->m_enode->get_owner(), m_manager) << "\n";
+        }
     }
 
     void cg_table::display_compact(std::ostream & out) const {
+        if (m_size > 0) {
+            out << "congruence table:\n";
+            svector<cell>::const_iterator it  = m_cells.begin();
+            svector<cell>::const_iterator end = m_cells.end();
+            for (; it != end; ++it) {
+                if (it->m_enode != 0)
+                    out << "#" << it->m_enode->get_owner_id() << " ";
+            }
+            out << "\n";
+        }
     }
 
 #ifdef Z3DEBUG
     bool cg_table::check_invariant() const {
+        unsigned num = 0;
+        svector<cell>::const_iterator it  = m_cells.begin();
+        svector<cell>::const_iterator end = m_cells.end();
+        for (; it != end; ++it) {
+            enode * n = it->m_enode;
+            if (n == 0)
+                continue;
+            num++;
+            CTRACE("cg_table", it->m_hash != sig_hash(n) || !contains_ptr(n), tout << "#" << n->get_owner_id() << "\n";);
+            SASSERT(it->m_hash == sig_hash(n));
+            SASSERT(n->get_cg_hash() == it->m_hash);
+            SASSERT(contains_ptr(n));
+        }
+        SASSERT(num == m_size);
         return true;
     }
 #endif
 
-#endif
-
 };
-
@@ -41,6 +41,8 @@ namespace smt {
         cls->m_has_del_eh          = del_eh != 0;
         cls->m_has_justification   = js != 0;
         cls->m_deleted             = false;
+        cls->m_dep_lvl             = 0;
+        cls->m_retained            = false;
         SASSERT(!m.proofs_enabled() || js != 0);
         memcpy(cls->m_lits, lits, sizeof(literal) * num_lits);
         if (cls->is_lemma())
@@ -50,7 +50,9 @@ namespace smt {
        A clause has several optional fields, I store space for them only if they are actually used.
     */
     class clause {
-        unsigned m_num_literals;
+        unsigned m_num_literals:24;       //!< at most m_capacity
+        unsigned m_dep_lvl:7;             //!< highest user scope (base level) the clause depends on, saturated at MAX_DEP_LVL.
+        unsigned m_retained:1;            //!< true if the clause is a lemma that was kept when a user scope was popped.
         unsigned m_capacity:24;           //!< some of the clause literals can be simplified and removed, this field contains the original number of literals (used for GC).
         unsigned m_kind:2;                //!< kind
         unsigned m_reinit:1;              //!< true if the clause is in the reinit stack (only for learned clauses and aux_lemmas)
@@ -234,6 +236,39 @@ namespace smt {
 
         bool erase_atom(unsigned idx);
 
+        /**
+           \brief Levels greater than or equal to MAX_DEP_LVL are not distinguished, 
+           a clause with this level is never retained.
+        */
+        static const unsigned MAX_DEP_LVL = 127;
+
+        /**
+           \brief Return the highest base level of the assertions used to derive this clause.
+           The clause remains valid after the user scopes above this level are popped.
+        */
+        unsigned get_dep_lvl() const {
+            return m_dep_lvl;
+        }
+
+        void set_dep_lvl(unsigned lvl) {
+            m_dep_lvl = lvl < MAX_DEP_LVL ? lvl : MAX_DEP_LVL;
+        }
+
+        /**
+           \brief Return true if the clause remains valid after popping the user scopes above lvl.
+        */
+        bool survives_pop_to(unsigned lvl) const {
+            return m_dep_lvl <= lvl && m_dep_lvl < MAX_DEP_LVL;
+        }
+
+        bool is_retained() const {
+            return m_retained;
+        }
+
+        void set_retained(bool f) {
+            m_retained = f;
+        }
+
         void inc_clause_activity() {
             SASSERT(is_lemma());
             set_activity(get_activity() + 1);
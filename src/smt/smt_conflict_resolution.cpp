@@ -294,7 +294,11 @@ namespace smt {
         unsigned lvl = m_ctx.get_assign_level(var);
         SASSERT(var < static_cast<int>(m_ctx.get_num_bool_vars()));
         
-        if (!m_ctx.is_marked(var) && lvl > m_ctx.get_base_level()) {
+        if (lvl <= m_ctx.get_base_level()) {
+            if (lvl > m_lemma_dep_lvl)
+                m_lemma_dep_lvl = lvl;
+        }
+        else if (!m_ctx.is_marked(var)) {
             m_ctx.set_mark(var);
             m_ctx.inc_bvar_activity(var);
             expr * n = m_ctx.bool_var2expr(var);
@@ -358,6 +362,7 @@ namespace smt {
         TRACE("conflict_detail", m_ctx.display(tout););
         m_lemma.reset();
         m_lemma_atoms.reset();
+        m_lemma_dep_lvl     = 0;
         SASSERT(m_ctx.get_search_level() >= m_ctx.get_base_level());
         js                  = conflict;
         consequent          = false_literal;
@@ -493,6 +498,10 @@ namespace smt {
                 clause * cls = js.get_clause();
                 if (cls->is_lemma())
                     cls->inc_clause_activity();
+                if (cls->get_dep_lvl() > m_lemma_dep_lvl)
+                    m_lemma_dep_lvl = cls->get_dep_lvl();
+                if (cls->is_retained())
+                    m_ctx.m_stats.m_num_retained_lemma_uses++;
                 unsigned num_lits = cls->get_num_literals();
                 unsigned i        = 0;
                 if (consequent != false_literal) {
@@ -609,7 +618,11 @@ namespace smt {
     bool conflict_resolution::process_antecedent_for_minimization(literal antecedent) {
         bool_var var = antecedent.var();
         unsigned lvl = m_ctx.get_assign_level(var);
-        if (!m_ctx.is_marked(var) && lvl > m_ctx.get_base_level()) {
+        if (lvl <= m_ctx.get_base_level()) {
+            if (lvl > m_lemma_dep_lvl)
+                m_lemma_dep_lvl = lvl;
+        }
+        else if (!m_ctx.is_marked(var)) {
             if (m_lvl_set.may_contain(lvl)) {
                 m_ctx.set_mark(var);                
                 m_unmark.push_back(var);
@@ -660,6 +673,8 @@ namespace smt {
                 clause * cls      = js.get_clause();
                 unsigned num_lits = cls->get_num_literals();
                 unsigned pos      = cls->get_literal(1).var() == var;
+                if (cls->get_dep_lvl() > m_lemma_dep_lvl)
+                    m_lemma_dep_lvl = cls->get_dep_lvl();
                 for (unsigned i = 0; i < num_lits; i++) {
                     if (pos != i) {
                         literal l = cls->get_literal(i);
@@ -57,6 +57,7 @@ namespace smt {
         expr_ref_vector                m_lemma_atoms;
         unsigned                       m_new_scope_lvl;
         unsigned                       m_lemma_iscope_lvl;
+        unsigned                       m_lemma_dep_lvl;  // highest base level of the clauses and base literals used to derive the lemma
         
         justification_vector           m_todo_js;
         unsigned                       m_todo_js_qhead;
@@ -229,6 +230,14 @@ namespace smt {
             return m_lemma_iscope_lvl;
         }
 
+        /**
+           \brief Return the highest user scope (base level) the last lemma depends on.
+           The lemma remains valid after the scopes above this level are popped.
+        */
+        unsigned get_lemma_dep_lvl() const {
+            return m_lemma_dep_lvl;
+        }
+
         unsigned get_lemma_num_literals() const {
             return m_lemma.size();
         }
@@ -538,6 +538,14 @@ namespace smt {
         enode_vector & r2_parents  = r2->m_parents;
         enode_vector::iterator it  = r1->begin_parents();
         enode_vector::iterator end = r1->end_parents();
+        // First pass: compute the signature hashes of the removed parents.
+        // The roots do not change until all of them are reinserted.
+        for (; it != end; ++it) {
+            enode * parent = *it;
+            if (parent->is_marked() && parent->is_cgc_enabled())
+                m_cg_table.prepare(parent);
+        }
+        it = r1->begin_parents();
         for (; it != end; ++it) {
             enode * parent = *it;
             if (!parent->is_marked())
@@ -564,7 +572,7 @@ namespace smt {
                 }
             }
             if (parent->is_cgc_enabled()) {
-                enode_bool_pair pair = m_cg_table.insert(parent);
+                enode_bool_pair pair = m_cg_table.insert_prepared(parent);
                 enode * parent_prime = pair.first;
                 if (parent_prime == parent) {
                     TRACE("add_eq_parents", tout << "add_eq reinserting: #" << parent->get_owner_id() << "\n";);
@@ -1035,7 +1043,6 @@ namespace smt {
             m_manager.dec_ref(m_is_diseq_tmp->get_owner());
             app * eq = m_manager.mk_eq(n1->get_owner(), n2->get_owner());
             m_manager.inc_ref(eq);
-            m_is_diseq_tmp->m_func_decl_id = UINT_MAX;
             m_is_diseq_tmp->m_owner = eq;
         }
         m_is_diseq_tmp->m_args[0] = n1;
@@ -2355,6 +2362,8 @@ namespace smt {
             case l_false: 
                 if (m_manager.proofs_enabled()) 
                     simp_lits.push_back(~l);
+                if (get_assign_level(l) > cls->get_dep_lvl())
+                    cls->set_dep_lvl(get_assign_level(l));
                 if (lit_occs_enabled()) 
                     m_lit_occs[l.index()].erase(cls);
                 break;
@@ -2740,7 +2749,98 @@ namespace smt {
     void context::pop(unsigned num_scopes) {
         SASSERT (num_scopes > 0);
         pop_to_base_lvl();
+        if (m_fparams.m_max_retained_lemmas == 0 || m_manager.proofs_enabled()) {
+            pop_scope(num_scopes);
+            return;
+        }
+        SASSERT(num_scopes <= m_base_lvl);
+        expr_ref_vector         atoms(m_manager);
+        svector<bool>           signs;
+        svector<retained_lemma> lemmas;
+        save_retained_lemmas(m_base_lvl - num_scopes, atoms, signs, lemmas);
         pop_scope(num_scopes);
+        restore_retained_lemmas(atoms, signs, lemmas);
+    }
+
+    /**
+       \brief Store the learned clauses created in the base levels above new_lvl that
+       only depend on assertions of levels <= new_lvl. At most m_max_retained_lemmas
+       clauses are stored, the most active ones are preferred.
+
+       The clauses are stored as atoms because the boolean variables created above
+       new_lvl are deleted when the scopes are popped.
+    */
+    void context::save_retained_lemmas(unsigned new_lvl, expr_ref_vector & atoms, svector<bool> & signs, svector<retained_lemma> & lemmas) {
+        SASSERT(new_lvl < m_base_lvl);
+        SASSERT(m_scope_lvl == m_base_lvl);
+        ptr_buffer<clause> candidates;
+        unsigned sz = m_lemmas.size();
+        for (unsigned i = m_base_scopes[new_lvl].m_lemmas_lim; i < sz; i++) {
+            clause * cls = m_lemmas[i];
+            if (cls->is_learned() && !cls->deleted() && cls->survives_pop_to(new_lvl))
+                candidates.push_back(cls);
+        }
+        if (candidates.size() > m_fparams.m_max_retained_lemmas) {
+            std::stable_sort(candidates.begin(), candidates.end(), clause_lt());
+            candidates.shrink(m_fparams.m_max_retained_lemmas);
+        }
+        ptr_buffer<clause>::iterator it  = candidates.begin();
+        ptr_buffer<clause>::iterator end = candidates.end();
+        for (; it != end; ++it) {
+            clause * cls = *it;
+            retained_lemma l;
+            l.m_begin    = atoms.size();
+            l.m_num_lits = cls->get_num_literals();
+            l.m_dep_lvl  = cls->get_dep_lvl();
+            l.m_activity = cls->get_activity();
+            for (unsigned j = 0; j < l.m_num_lits; j++) {
+                literal lit = cls->get_literal(j);
+                atoms.push_back(bool_var2expr(lit.var()));
+                signs.push_back(lit.sign());
+            }
+            lemmas.push_back(l);
+        }
+        TRACE("retained_lemmas", tout << "retaining " << lemmas.size() << " of " << (sz - m_base_scopes[new_lvl].m_lemmas_lim) << " lemmas\n";);
+    }
+
+    /**
+       \brief Recreate the clauses stored by save_retained_lemmas at the current base level.
+    */
+    void context::restore_retained_lemmas(expr_ref_vector const & atoms, svector<bool> const & signs, svector<retained_lemma> const & lemmas) {
+        SASSERT(m_scope_lvl == m_base_lvl);
+        literal_vector lits;
+        svector<retained_lemma>::const_iterator it  = lemmas.begin();
+        svector<retained_lemma>::const_iterator end = lemmas.end();
+        for (; it != end && !inconsistent(); ++it) {
+            lits.reset();
+            for (unsigned j = it->m_begin; j < it->m_begin + it->m_num_lits; j++) {
+                expr * atom   = atoms.get(j);
+                // See reinit_clauses: (NOT foo) atoms must be reinternalized with gate_ctx == false.
+                bool gate_ctx = !m_manager.is_not(atom);
+                internalize(atom, gate_ctx);
+                SASSERT(b_internalized(atom));
+                lits.push_back(literal(get_bool_var(atom), signs[j]));
+            }
+            unsigned num_lits = lits.size();
+            if (!simplify_aux_lemma_literals(num_lits, lits.c_ptr()))
+                continue; // clause is already satisfied at the base level
+            // move the literals that are not assigned to false to the beginning,
+            // then mk_clause selects watch literals that are not false.
+            unsigned k = 0;
+            for (unsigned j = 0; j < num_lits; j++) {
+                if (get_assignment(lits[j]) != l_false) {
+                    std::swap(lits[j], lits[k]);
+                    k++;
+                }
+            }
+            clause * cls = mk_clause(num_lits, lits.c_ptr(), 0, CLS_LEARNED);
+            m_stats.m_num_retained_lemmas++;
+            if (cls) {
+                cls->set_dep_lvl(it->m_dep_lvl);
+                cls->set_activity(it->m_activity);
+                cls->set_retained(true);
+            }
+        }
     }
 
     /**
@@ -3488,6 +3588,7 @@ namespace smt {
         default:
             break;
         }
+        m_case_split_queue->conflict_eh();
         if (m_fparams.m_phase_selection == PS_CACHING_CONSERVATIVE || m_fparams.m_phase_selection == PS_CACHING_CONSERVATIVE2)
             forget_phase_of_vars_in_current_level();
         m_atom_propagation_queue.reset();
@@ -612,6 +612,21 @@ namespace smt {
 
         void reassert_units(unsigned units_to_reassert_lim);
 
+        /**
+           \brief Learned clause that is kept when user scopes are popped.
+           Its literals are stored as atoms and signs in the range [m_begin, m_begin + m_num_lits).
+        */
+        struct retained_lemma {
+            unsigned                m_begin;
+            unsigned                m_num_lits;
+            unsigned                m_dep_lvl;
+            unsigned                m_activity;
+        };
+
+        void save_retained_lemmas(unsigned new_lvl, expr_ref_vector & atoms, svector<bool> & signs, svector<retained_lemma> & lemmas);
+
+        void restore_retained_lemmas(expr_ref_vector const & atoms, svector<bool> const & signs, svector<retained_lemma> const & lemmas);
+
         // -----------------------------------
         //
         // Internalization 
@@ -654,6 +669,10 @@ namespace smt {
             return m_scopes[scope_lvl - 1].m_assigned_literals_lim;
         }
 
+        literal_vector const & assigned_literals() const {
+            return m_assigned_literals;
+        }
+
     protected:
         unsigned m_generation; //!< temporary variable used during internalization
 
@@ -380,6 +380,10 @@ namespace smt {
         st.update("max generation", m_stats.m_max_generation);
         st.update("minimized lits", m_stats.m_num_minimized_lits);
         st.update("num checks", m_stats.m_num_checks);
+        if (m_stats.m_num_retained_lemmas > 0) {
+            st.update("retained lemmas", m_stats.m_num_retained_lemmas);
+            st.update("retained lemma uses", m_stats.m_num_retained_lemma_uses);
+        }
 #if 0
         // missing?
         st.update("sat conflicts", m_stats.m_num_sat_conflicts);
@@ -393,6 +397,7 @@ namespace smt {
         st.update("backwd subs res", m_stats.m_num_bsr);
         st.update("frwrd subs res", m_stats.m_num_fsr);
 #endif
+        m_cg_table.collect_statistics(st);
         m_qmanager->collect_statistics(st);
         m_asserted_formulas.collect_statistics(st);
         ptr_vector<theory>::const_iterator it  = m_theory_set.begin();
@@ -16,8 +16,10 @@ Author:
 Revision History:
 
 --*/
+#include<fstream>
 #include"smt_context.h"
 #include"ast_pp.h"
+#include"warning.h"
 
 namespace smt {
 
@@ -155,5 +157,12 @@ namespace smt {
     void context::display_profile(std::ostream & out) const {
         if (m_fparams.m_profile_res_sub)
             display_profile_res_sub(out);
+        if (!m_fparams.m_qi_profile_json.empty()) {
+            std::ofstream json(m_fparams.m_qi_profile_json.c_str());
+            if (json)
+                m_qmanager->display_profile_json(json);
+            else
+                warning_msg("failed to open '%s' for the quantifier instantiation profile", m_fparams.m_qi_profile_json.c_str());
+        }
     }
 };
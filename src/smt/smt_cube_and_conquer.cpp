@@ -0,0 +1,622 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    smt_cube_and_conquer.cpp
+
+Abstract:
+
+    Parallel cube and conquer driver for smt::kernel.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Revision History:
+
+--*/
+#include<algorithm>
+#include"smt_cube_and_conquer.h"
+#include"smt_kernel.h"
+#include"smt_context.h"
+#include"smt_params.h"
+#include"ast_translation.h"
+#include"decl_collector.h"
+#include"for_each_expr.h"
+#include"scoped_ptr_vector.h"
+#include"stopwatch.h"
+#include"z3_omp.h"
+
+namespace smt {
+
+    struct cube_and_conquer::imp {
+
+        struct worker_stats {
+            unsigned m_cubes;
+            unsigned m_steals;
+            unsigned m_exported;
+            unsigned m_imported;
+            unsigned m_conflicts;
+            double   m_time;
+            worker_stats():m_cubes(0), m_steals(0), m_exported(0), m_imported(0), m_conflicts(0), m_time(0.0) {}
+        };
+
+        /**
+           \brief Data owned by a worker. The ast_manager of a worker is only used by its thread.
+        */
+        struct worker {
+            ast_manager &            m_manager;
+            smt_params               m_params;
+            kernel                   m_kernel;
+            expr_ref_vector          m_lits;      // m_lits[2*i] is the i-th atom, and m_lits[2*i+1] its negation
+            obj_map<expr, unsigned>  m_lit2idx;
+            obj_hashtable<func_decl> m_input_decls;
+            svector<bool>            m_exported;  // bool vars already inspected by export_units
+            unsigned                 m_imported;  // prefix of imp::m_units already asserted
+            worker(ast_manager & m, smt_params const & fp, params_ref const & p):
+                m_manager(m),
+                m_params(fp),
+                m_kernel(m, m_params, p),
+                m_lits(m),
+                m_imported(0) {
+            }
+        };
+
+        ast_manager &            m;
+        smt_params &             m_params;
+        params_ref               m_p;
+        symbol                   m_logic;
+        expr_ref_vector          m_formulas;
+        obj_hashtable<func_decl> m_input_decls;
+        volatile bool            m_cancel;
+        kernel *                 m_probe;
+        ptr_vector<worker>       m_workers;
+
+        // cubes
+        expr_ref_vector          m_atoms;
+        vector<unsigned_vector>  m_queues;    // cubes assigned to each worker
+        svector<std::pair<unsigned, unsigned> > m_cores; // (atoms, signs) of unsat cores found so far
+
+        // shared units, they are stored in m
+        expr_ref_vector          m_units;
+        obj_hashtable<expr>      m_unit_set;
+
+        // result
+        bool                     m_done;
+        lbool                    m_result;
+        bool                     m_incomplete;
+        model_ref                m_model;
+        std::string              m_failure;
+
+        // statistics
+        svector<worker_stats>    m_worker_stats;
+        unsigned                 m_num_cubes;
+        unsigned                 m_num_pruned;
+        unsigned                 m_probe_conflicts;
+        ::statistics             m_stats;
+
+        imp(ast_manager & _m, smt_params & fp, params_ref const & p):
+            m(_m),
+            m_params(fp),
+            m_p(p),
+            m_formulas(_m),
+            m_cancel(false),
+            m_probe(0),
+            m_atoms(_m),
+            m_units(_m),
+            m_done(false),
+            m_result(l_undef),
+            m_incomplete(false),
+            m_num_cubes(0),
+            m_num_pruned(0),
+            m_probe_conflicts(0) {
+        }
+
+        struct not_shareable {};
+
+        struct shareable_proc {
+            obj_hashtable<func_decl> const & m_decls;
+            shareable_proc(obj_hashtable<func_decl> const & d):m_decls(d) {}
+            void operator()(var * n) { throw not_shareable(); }
+            void operator()(quantifier * n) { throw not_shareable(); }
+            void operator()(app * n) {
+                func_decl * d = n->get_decl();
+                if (d->get_family_id() == null_family_id && !m_decls.contains(d))
+                    throw not_shareable();
+            }
+        };
+
+        /**
+           \brief Return true if e only contains uninterpreted symbols from the input.
+           Auxiliary constants (e.g., Skolem constants) are created independently
+           by each kernel, so literals containing them cannot be shared.
+        */
+        static bool is_shareable(obj_hashtable<func_decl> const & decls, expr * e) {
+            shareable_proc proc(decls);
+            try {
+                for_each_expr(proc, e);
+            }
+            catch (not_shareable) {
+                return false;
+            }
+            return true;
+        }
+
+        void collect_input_decls() {
+            m_input_decls.reset();
+            decl_collector dc(m, false);
+            for (unsigned i = 0; i < m_formulas.size(); i++)
+                dc.visit(m_formulas.get(i));
+            for (unsigned i = 0; i < dc.get_num_decls(); i++)
+                m_input_decls.insert(dc.get_func_decls()[i]);
+        }
+
+        static unsigned get_conflicts(kernel & k) {
+            return k.get_context().m_stats.m_num_conflicts;
+        }
+
+        struct scoped_probe {
+            imp & m_owner;
+            scoped_probe(imp & o, kernel & k):m_owner(o) {
+                #pragma omp critical (cube_and_conquer)
+                {
+                    m_owner.m_probe = &k;
+                    if (m_owner.m_cancel)
+                        k.set_cancel(true);
+                }
+            }
+            ~scoped_probe() {
+                #pragma omp critical (cube_and_conquer)
+                {
+                    m_owner.m_probe = 0;
+                }
+            }
+        };
+
+        struct atom_lt {
+            context & m_ctx;
+            atom_lt(context & ctx):m_ctx(ctx) {}
+            bool operator()(bool_var v1, bool_var v2) const { return m_ctx.get_activity(v1) > m_ctx.get_activity(v2); }
+        };
+
+        unsigned get_depth() const {
+            if (m_params.m_cube_depth > 0)
+                return std::min(m_params.m_cube_depth, 16u);
+            unsigned d = 3; // at least 8 cubes per worker
+            while ((1u << d) < 8 * m_params.m_threads && d < 16)
+                d++;
+            return d;
+        }
+
+        /**
+           \brief Run a sequential search with a small conflict budget.
+           If the search is inconclusive, then select the atoms used to build the cubes,
+           and collect the units learned during the search.
+        */
+        lbool probe() {
+            smt_params fp(m_params);
+            fp.m_max_conflicts = m_params.m_cube_probe_conflicts;
+            kernel k(m, fp, m_p);
+            k.set_logic(m_logic);
+            for (unsigned i = 0; i < m_formulas.size(); i++)
+                k.assert_expr(m_formulas.get(i));
+            lbool r;
+            {
+                scoped_probe _p(*this, k);
+                r = k.setup_and_check();
+            }
+            m_probe_conflicts = get_conflicts(k);
+            k.collect_statistics(m_stats);
+            if (r == l_true)
+                k.get_model(m_model);
+            if (r != l_undef)
+                return r;
+            if (k.last_failure() != NUM_CONFLICTS) {
+                m_failure = k.last_failure_as_string();
+                return l_undef;
+            }
+            context & ctx = k.get_context();
+            svector<bool_var> candidates;
+            expr_ref lit(m);
+            unsigned num = ctx.get_num_bool_vars();
+            for (bool_var v = 0; v < static_cast<bool_var>(num); v++) {
+                expr * e = ctx.bool_var2expr(v);
+                if (e == 0 || !is_shareable(m_input_decls, e))
+                    continue;
+                if (ctx.get_assignment(v) != l_undef && ctx.get_assign_level(v) <= ctx.get_base_level()) {
+                    lit = ctx.get_assignment(v) == l_true ? e : m.mk_not(e);
+                    add_unit(lit);
+                    continue;
+                }
+                candidates.push_back(v);
+            }
+            std::stable_sort(candidates.begin(), candidates.end(), atom_lt(ctx));
+            unsigned depth = std::min(get_depth(), candidates.size());
+            for (unsigned i = 0; i < depth; i++)
+                m_atoms.push_back(ctx.bool_var2expr(candidates[i]));
+            TRACE("cube_and_conquer", tout << "atoms:\n"; for (unsigned i = 0; i < m_atoms.size(); i++) tout << mk_pp(m_atoms.get(i), m) << "\n";);
+            return l_undef;
+        }
+
+        void add_unit(expr * e) {
+            if (!m_unit_set.contains(e)) {
+                m_units.push_back(e);
+                m_unit_set.insert(e);
+            }
+        }
+
+        /**
+           \brief Return true if the cube contains the unsat core (atoms, signs).
+        */
+        static bool subsumed(unsigned cube, unsigned atoms, unsigned signs) {
+            return (cube & atoms) == signs;
+        }
+
+        bool is_pruned(unsigned cube) const {
+            for (unsigned i = 0; i < m_cores.size(); i++) {
+                if (subsumed(cube, m_cores[i].first, m_cores[i].second))
+                    return true;
+            }
+            return false;
+        }
+
+        /**
+           \brief Select the next cube for worker id. If its own queue is empty,
+           then a cube is stolen from the worker with the longest queue.
+           Return false if there are no cubes left.
+        */
+        bool next_cube(unsigned id, unsigned & cube) {
+            bool found = false;
+            #pragma omp critical (cube_and_conquer)
+            {
+                while (!found && !m_done && !m_cancel) {
+                    unsigned_vector * q = &(m_queues[id]);
+                    bool stolen = false;
+                    if (q->empty()) {
+                        unsigned best = id;
+                        for (unsigned j = 0; j < m_queues.size(); j++) {
+                            if (m_queues[j].size() > m_queues[best].size())
+                                best = j;
+                        }
+                        if (best == id)
+                            break;
+                        q      = &(m_queues[best]);
+                        stolen = true;
+                    }
+                    if (stolen) {
+                        // take the oldest cube of the victim
+                        cube = (*q)[0];
+                        q->erase(q->begin());
+                    }
+                    else {
+                        cube = q->back();
+                        q->pop_back();
+                    }
+                    if (is_pruned(cube)) {
+                        m_num_pruned++;
+                        continue;
+                    }
+                    if (stolen)
+                        m_worker_stats[id].m_steals++;
+                    found = true;
+                }
+            }
+            return found;
+        }
+
+        void import_units(unsigned id) {
+            worker & w = *(m_workers[id]);
+            expr_ref_vector new_units(w.m_manager);
+            #pragma omp critical (cube_and_conquer)
+            {
+                ast_translation tr(m, w.m_manager, false);
+                for (; w.m_imported < m_units.size(); w.m_imported++)
+                    new_units.push_back(tr(m_units.get(w.m_imported)));
+            }
+            for (unsigned i = 0; i < new_units.size(); i++)
+                w.m_kernel.assert_expr(new_units.get(i));
+            m_worker_stats[id].m_imported += new_units.size();
+        }
+
+        /**
+           \brief Send the literals assigned at the base level of the worker to the other workers.
+        */
+        void export_units(unsigned id) {
+            worker & w    = *(m_workers[id]);
+            context & ctx = w.m_kernel.get_context();
+            expr_ref_vector units(w.m_manager);
+            unsigned num = ctx.get_num_bool_vars();
+            w.m_exported.resize(num, false);
+            for (bool_var v = 0; v < static_cast<bool_var>(num); v++) {
+                if (w.m_exported[v] || ctx.get_assignment(v) == l_undef || ctx.get_assign_level(v) > ctx.get_base_level())
+                    continue;
+                w.m_exported[v] = true;
+                expr * e = ctx.bool_var2expr(v);
+                if (e == 0 || !is_shareable(w.m_input_decls, e))
+                    continue;
+                units.push_back(ctx.get_assignment(v) == l_true ? e : w.m_manager.mk_not(e));
+            }
+            if (units.empty())
+                return;
+            #pragma omp critical (cube_and_conquer)
+            {
+                ast_translation tr(w.m_manager, m, false);
+                for (unsigned i = 0; i < units.size(); i++)
+                    add_unit(tr(units.get(i)));
+            }
+            m_worker_stats[id].m_exported += units.size();
+        }
+
+        void cancel_others(unsigned id) {
+            #pragma omp critical (cube_and_conquer)
+            {
+                for (unsigned j = 0; j < m_workers.size(); j++) {
+                    if (j != id)
+                        m_workers[j]->m_kernel.set_cancel(true);
+                }
+            }
+        }
+
+        void set_result(unsigned id, lbool r) {
+            bool first = false;
+            #pragma omp critical (cube_and_conquer)
+            {
+                if (!m_done) {
+                    m_done   = true;
+                    m_result = r;
+                    first    = true;
+                    if (r == l_true) {
+                        worker & w = *(m_workers[id]);
+                        model_ref md;
+                        w.m_kernel.get_model(md);
+                        if (md) {
+                            ast_translation tr(w.m_manager, m, false);
+                            m_model = md->translate(tr);
+                        }
+                    }
+                }
+            }
+            if (first)
+                cancel_others(id);
+        }
+
+        void run_worker(unsigned id) {
+            worker & w = *(m_workers[id]);
+            ast_manager & wm = w.m_manager;
+            stopwatch sw;
+            sw.start();
+            expr_ref_vector assumptions(wm);
+            unsigned cube;
+            while (next_cube(id, cube)) {
+                m_worker_stats[id].m_cubes++;
+                import_units(id);
+                assumptions.reset();
+                for (unsigned i = 0; 2*i < w.m_lits.size(); i++)
+                    assumptions.push_back(w.m_lits.get(2*i + ((cube & (1u << i)) ? 0 : 1)));
+                lbool r = w.m_kernel.check(assumptions.size(), assumptions.c_ptr());
+                TRACE("cube_and_conquer", tout << "worker " << id << " cube " << cube << " " << r << "\n";);
+                if (r == l_true) {
+                    set_result(id, l_true);
+                    break;
+                }
+                else if (r == l_false) {
+                    unsigned atoms = 0, signs = 0;
+                    unsigned sz = w.m_kernel.get_unsat_core_size();
+                    for (unsigned i = 0; i < sz; i++) {
+                        unsigned idx;
+                        if (w.m_lit2idx.find(w.m_kernel.get_unsat_core_expr(i), idx)) {
+                            atoms |= 1u << (idx / 2);
+                            if (idx % 2 == 0)
+                                signs |= 1u << (idx / 2);
+                        }
+                    }
+                    if (atoms == 0) {
+                        // the problem is unsat independently of the cube
+                        set_result(id, l_false);
+                        break;
+                    }
+                    #pragma omp critical (cube_and_conquer)
+                    {
+                        m_cores.push_back(std::make_pair(atoms, signs));
+                    }
+                    export_units(id);
+                }
+                else {
+                    if (m_cancel || m_done)
+                        break;
+                    #pragma omp critical (cube_and_conquer)
+                    {
+                        m_incomplete = true;
+                        m_failure    = w.m_kernel.last_failure_as_string();
+                    }
+                }
+            }
+            sw.stop();
+            m_worker_stats[id].m_time      = sw.get_seconds();
+            m_worker_stats[id].m_conflicts = get_conflicts(w.m_kernel);
+            IF_VERBOSE(1, verbose_stream() << "(smt.cube-and-conquer :worker " << id
+                       << " :cubes " << m_worker_stats[id].m_cubes
+                       << " :steals " << m_worker_stats[id].m_steals
+                       << " :conflicts " << m_worker_stats[id].m_conflicts
+                       << " :time " << m_worker_stats[id].m_time << ")\n";);
+        }
+
+        lbool conquer() {
+            unsigned depth        = m_atoms.size();
+            unsigned num_cubes    = 1u << depth;
+            unsigned num_workers  = std::min(m_params.m_threads, num_cubes);
+            m_num_cubes           = num_cubes;
+            IF_VERBOSE(2, verbose_stream() << "(smt.cube-and-conquer :atoms " << depth << " :workers " << num_workers << ")\n";);
+
+            scoped_ptr_vector<ast_manager> managers;
+            for (unsigned id = 0; id < num_workers; id++) {
+                ast_manager * wm = alloc(ast_manager, m, true);
+                managers.push_back(wm);
+                smt_params fp(m_params);
+                fp.m_threads = 1;
+                worker * w = alloc(worker, *wm, fp, m_p);
+                w->m_kernel.set_logic(m_logic);
+                ast_translation tr(m, *wm);
+                for (unsigned i = 0; i < m_formulas.size(); i++)
+                    w->m_kernel.assert_expr(tr(m_formulas.get(i)));
+                for (unsigned i = 0; i < depth; i++) {
+                    expr * a = tr(m_atoms.get(i));
+                    w->m_lits.push_back(a);
+                    w->m_lits.push_back(wm->mk_not(a));
+                    w->m_lit2idx.insert(w->m_lits.get(2*i), 2*i);
+                    w->m_lit2idx.insert(w->m_lits.get(2*i + 1), 2*i + 1);
+                }
+                obj_hashtable<func_decl>::iterator it  = m_input_decls.begin();
+                obj_hashtable<func_decl>::iterator end = m_input_decls.end();
+                for (; it != end; ++it)
+                    w->m_input_decls.insert(tr(*it));
+                #pragma omp critical (cube_and_conquer)
+                {
+                    m_workers.push_back(w);
+                    if (m_cancel)
+                        w->m_kernel.set_cancel(true);
+                }
+            }
+            m_queues.reset();
+            m_queues.resize(num_workers, unsigned_vector());
+            for (unsigned c = 0; c < num_cubes; c++)
+                m_queues[c % num_workers].push_back(c);
+            m_worker_stats.reset();
+            m_worker_stats.resize(num_workers, worker_stats());
+
+            std::string ex_msg;
+            bool        failed = false;
+            #pragma omp parallel for num_threads(num_workers)
+            for (int id = 0; id < static_cast<int>(num_workers); id++) {
+                try {
+                    run_worker(id);
+                }
+                catch (z3_exception & ex) {
+                    #pragma omp critical (cube_and_conquer)
+                    {
+                        failed = true;
+                        ex_msg = ex.msg();
+                    }
+                    cancel_others(id);
+                }
+            }
+
+            for (unsigned id = 0; id < num_workers; id++)
+                m_workers[id]->m_kernel.collect_statistics(m_stats);
+            #pragma omp critical (cube_and_conquer)
+            {
+                for (unsigned id = 0; id < num_workers; id++)
+                    dealloc(m_workers[id]);
+                m_workers.reset();
+            }
+            if (failed)
+                throw default_exception(ex_msg.c_str());
+            if (m_done)
+                return m_result;
+            if (m_cancel) {
+                m_failure = "canceled";
+                return l_undef;
+            }
+            return m_incomplete ? l_undef : l_false;
+        }
+
+        lbool check() {
+            m_done       = false;
+            m_result     = l_undef;
+            m_incomplete = false;
+            m_model      = 0;
+            m_failure.clear();
+            m_atoms.reset();
+            m_cores.reset();
+            m_units.reset();
+            m_unit_set.reset();
+            m_stats.reset();
+            m_worker_stats.reset();
+            m_num_cubes  = 0;
+            m_num_pruned = 0;
+            collect_input_decls();
+            lbool r = probe();
+            if (r != l_undef || m_cancel || !m_failure.empty())
+                return r;
+            return conquer();
+        }
+
+        void set_cancel(bool f) {
+            #pragma omp critical (cube_and_conquer)
+            {
+                m_cancel = f;
+                if (m_probe)
+                    m_probe->set_cancel(f);
+                for (unsigned i = 0; i < m_workers.size(); i++)
+                    m_workers[i]->m_kernel.set_cancel(f);
+            }
+        }
+
+        static char const * mk_key(unsigned id, char const * name) {
+            std::ostringstream buffer;
+            buffer << "cc worker " << id << " " << name;
+            // symbols are never deleted, so the string can be used as a statistics key.
+            return symbol(buffer.str().c_str()).bare_str();
+        }
+
+        void collect_statistics(::statistics & st) const {
+            st.copy(m_stats);
+            unsigned steals = 0, exported = 0;
+            for (unsigned id = 0; id < m_worker_stats.size(); id++) {
+                worker_stats const & s = m_worker_stats[id];
+                steals   += s.m_steals;
+                exported += s.m_exported;
+                st.update(mk_key(id, "cubes"), s.m_cubes);
+                st.update(mk_key(id, "steals"), s.m_steals);
+                st.update(mk_key(id, "imported units"), s.m_imported);
+                st.update(mk_key(id, "exported units"), s.m_exported);
+                st.update(mk_key(id, "conflicts"), s.m_conflicts);
+                st.update(mk_key(id, "time"), s.m_time);
+            }
+            st.update("cc probe conflicts", m_probe_conflicts);
+            st.update("cc cubes", m_num_cubes);
+            st.update("cc pruned cubes", m_num_pruned);
+            st.update("cc steals", steals);
+            st.update("cc exported units", exported);
+            st.update("cc shared units", m_units.size());
+        }
+    };
+
+    cube_and_conquer::cube_and_conquer(ast_manager & m, smt_params & fp, params_ref const & p) {
+        m_imp = alloc(imp, m, fp, p);
+    }
+
+    cube_and_conquer::~cube_and_conquer() {
+        dealloc(m_imp);
+    }
+
+    void cube_and_conquer::set_logic(symbol const & logic) {
+        m_imp->m_logic = logic;
+    }
+
+    void cube_and_conquer::assert_expr(expr * e) {
+        m_imp->m_formulas.push_back(e);
+    }
+
+    lbool cube_and_conquer::check() {
+        return m_imp->check();
+    }
+
+    void cube_and_conquer::get_model(model_ref & md) const {
+        md = m_imp->m_model;
+    }
+
+    std::string cube_and_conquer::last_failure_as_string() const {
+        return m_imp->m_failure;
+    }
+
+    void cube_and_conquer::set_cancel(bool f) {
+        m_imp->set_cancel(f);
+    }
+
+    void cube_and_conquer::collect_statistics(::statistics & st) const {
+        m_imp->collect_statistics(st);
+    }
+
+};
@@ -0,0 +1,74 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    smt_cube_and_conquer.h
+
+Abstract:
+
+    Parallel cube and conquer driver for smt::kernel.
+
+    A sequential search with a small conflict budget is used to select
+    the most active Boolean atoms. The problem is then split into cubes
+    (conjunctions of these atoms or their negations), and the cubes are
+    solved by a pool of workers. Each worker has its own ast_manager and
+    smt::kernel. Workers steal cubes from each other, share the unit
+    literals they learn, and use unsat cores to prune the remaining cubes.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Revision History:
+
+--*/
+#ifndef _SMT_CUBE_AND_CONQUER_H_
+#define _SMT_CUBE_AND_CONQUER_H_
+
+#include"ast.h"
+#include"params.h"
+#include"model.h"
+#include"lbool.h"
+#include"statistics.h"
+
+struct smt_params;
+
+namespace smt {
+
+    class cube_and_conquer {
+        struct imp;
+        imp *  m_imp;
+    public:
+        /**
+           \brief The number of workers is fp.m_threads.
+        */
+        cube_and_conquer(ast_manager & m, smt_params & fp, params_ref const & p = params_ref());
+
+        ~cube_and_conquer();
+
+        void set_logic(symbol const & logic);
+
+        void assert_expr(expr * e);
+
+        lbool check();
+
+        /**
+           \brief Return the model produced by the worker that found a satisfiable cube.
+        */
+        void get_model(model_ref & md) const;
+
+        std::string last_failure_as_string() const;
+
+        void set_cancel(bool f = true);
+
+        /**
+           \brief Collect the statistics of the last call to check.
+           The statistics of each worker are reported using keys of the form "cc worker <i> ...".
+        */
+        void collect_statistics(::statistics & st) const;
+    };
+
+};
+
+#endif
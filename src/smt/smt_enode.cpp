@@ -35,7 +35,7 @@ namespace smt {
         n->m_cg               = 0;
         n->m_class_size       = 1;
         n->m_generation       = generation;
-        n->m_func_decl_id     = UINT_MAX;
+        n->m_cg_hash          = 0;
         n->m_mark             = false;
         n->m_mark2            = false;
         n->m_interpreted      = false;
@@ -428,16 +428,13 @@ namespace smt {
         n->m_next          = n;
         n->m_class_size    = 1;
         n->m_cgc_enabled   = true;
-        n->m_func_decl_id  = UINT_MAX;
+        n->m_cg_hash       = 0;
     }
 
     enode * tmp_enode::set(func_decl * f, unsigned num_args, enode * const * args) {
         if (num_args > m_capacity)
             set_capacity(num_args * 2);
         enode * r = get_enode();
-        if (m_app.get_app()->get_decl() != f) {
-            r->m_func_decl_id = UINT_MAX;
-        }
         m_app.set_decl(f);
         m_app.set_num_args(num_args);
         r->m_commutative  = num_args == 2 && f->is_commutative();
@@ -446,7 +443,7 @@ namespace smt {
     }
 
     void tmp_enode::reset() {
-        get_enode()->m_func_decl_id = UINT_MAX;
+        get_enode()->m_cg_hash = 0;
     }
 
 };
@@ -75,7 +75,7 @@ namespace smt {
         unsigned            m_class_size;    //!< Size of the equivalence class if the enode is the root.
         unsigned            m_generation; //!< Tracks how many quantifier instantiation rounds were needed to generate this enode.
 
-        unsigned            m_func_decl_id; //!< Id generated by the congruence table for fast indexing.
+        unsigned            m_cg_hash;  //!< Signature hash cached by the congruence table.
 
         unsigned            m_mark:1;        //!< Multi-purpose auxiliary mark. 
         unsigned            m_mark2:1;       //!< Multi-purpose auxiliary mark. 
@@ -155,12 +155,12 @@ namespace smt {
         
         static void del_dummy(enode * n) { dealloc_svect(reinterpret_cast<char*>(n)); }
 
-        unsigned get_func_decl_id() const {
-            return m_func_decl_id;
+        unsigned get_cg_hash() const {
+            return m_cg_hash;
         }
 
-        void set_func_decl_id(unsigned id) {
-            m_func_decl_id = id;
+        void set_cg_hash(unsigned h) {
+            m_cg_hash = h;
         }
 
         void mark_as_interpreted() {
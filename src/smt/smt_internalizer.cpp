@@ -1336,6 +1336,7 @@ namespace smt {
             bool reinit         = save_atoms;
             SASSERT(!lemma || j == 0 || !j->in_region());
             clause * cls = clause::mk(m_manager, num_lits, lits, k, j, del_eh, save_atoms, m_bool_var2expr.c_ptr());
+            cls->set_dep_lvl(k == CLS_LEARNED ? m_conflict_resolution->get_lemma_dep_lvl() : m_base_lvl);
             if (lemma) {
                 cls->set_activity(activity);
                 if (k == CLS_LEARNED) {
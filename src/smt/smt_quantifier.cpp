@@ -379,15 +379,21 @@ namespace smt {
 
     void quantifier_manager::collect_statistics(::statistics & st) const {
         m_imp->m_qi_queue.collect_statistics(st);
+        m_imp->m_plugin->collect_statistics(st);
     }
 
     void quantifier_manager::reset_statistics() {
+        m_imp->m_plugin->reset_statistics();
     }
 
     void quantifier_manager::display_stats(std::ostream & out, quantifier * q) const {
         m_imp->display_stats(out, q);
     }
 
+    void quantifier_manager::display_profile_json(std::ostream & out) const {
+        m_imp->m_qi_queue.display_profile_json(out);
+    }
+
     ptr_vector<quantifier>::const_iterator quantifier_manager::begin_quantifiers() const { 
         return m_imp->m_quantifiers.begin(); 
     }
@@ -410,12 +416,17 @@ namespace smt {
     public:
         default_qm_plugin():
             m_qm(0), 
+            m_fparams(0),
             m_context(0), 
             m_new_enode_qhead(0), 
             m_lazy_matching_idx(0) {
         }
         
         virtual ~default_qm_plugin() {
+            if (m_fparams && m_fparams->m_qi_profile) {
+                m_mam->display_profile(verbose_stream());
+                m_lazy_mam->display_profile(verbose_stream());
+            }
         }
 
         virtual void set_manager(quantifier_manager & qm) {
@@ -595,6 +606,20 @@ namespace smt {
             // TODO: interrupt MAM and MBQI
         }
 
+        virtual void collect_statistics(::statistics & st) const {
+            if (m_mam)
+                m_mam->collect_statistics(st);
+            if (m_lazy_mam)
+                m_lazy_mam->collect_statistics(st);
+        }
+
+        virtual void reset_statistics() {
+            if (m_mam)
+                m_mam->reset_statistics();
+            if (m_lazy_mam)
+                m_lazy_mam->reset_statistics();
+        }
+
         virtual final_check_status final_check_eh(bool full) {
             if (!full) {
                 if (m_fparams->m_qi_lazy_instantiation)
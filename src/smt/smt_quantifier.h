@@ -86,6 +86,7 @@ namespace smt {
         void set_cancel(bool f);
         void display(std::ostream & out) const;
         void display_stats(std::ostream & out, quantifier * q) const;
+        void display_profile_json(std::ostream & out) const;
 
         void collect_statistics(::statistics & st) const;
         void reset_statistics();
@@ -167,6 +168,9 @@ namespace smt {
         virtual void pop(unsigned num_scopes) = 0;
         
         virtual void set_cancel(bool f) = 0;
+
+        virtual void collect_statistics(::statistics & st) const = 0;
+        virtual void reset_statistics() = 0;
     };
 };
 
@@ -46,6 +46,8 @@ namespace smt {
         unsigned m_max_generation;
         unsigned m_num_minimized_lits;
         unsigned m_num_checks;
+        unsigned m_num_retained_lemmas;
+        unsigned m_num_retained_lemma_uses;
         statistics() {
             reset();
         }
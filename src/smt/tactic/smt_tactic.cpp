@@ -19,9 +19,11 @@ Notes:
 #include"tactic.h"
 #include"tactical.h"
 #include"smt_kernel.h"
+#include"smt_cube_and_conquer.h"
 #include"smt_params.h"
 #include"smt_params_helper.hpp"
 #include"rewriter_types.h"
+#include"z3_omp.h"
 
 class smt_tactic : public tactic {
     smt_params                   m_params;
@@ -29,26 +31,32 @@ class smt_tactic : public tactic {
     statistics                   m_stats;
     std::string                  m_failure;
     smt::kernel *                m_ctx;
+    smt::cube_and_conquer *      m_cc;
     symbol                       m_logic;
     progress_callback *          m_callback;
     bool                         m_candidate_models;
     bool                         m_fail_if_inconclusive;
+    bool                         m_parallel;  // use all processors unless the number of threads is given
 
 public:
-    smt_tactic(params_ref const & p):
+    smt_tactic(params_ref const & p, bool parallel = false):
         m_params_ref(p),
         m_ctx(0), 
-        m_callback(0) {
+        m_cc(0),
+        m_callback(0),
+        m_parallel(parallel) {
         updt_params_core(p);
+        updt_threads(p);
         TRACE("smt_tactic", tout << this << "\np: " << p << "\n";);
     }
 
     virtual tactic * translate(ast_manager & m) {
-        return alloc(smt_tactic, m_params_ref);
+        return alloc(smt_tactic, m_params_ref, m_parallel);
     }
 
     virtual ~smt_tactic() {
         SASSERT(m_ctx == 0);
+        SASSERT(m_cc == 0);
     }
 
     smt_params & fparams() {
@@ -60,10 +68,16 @@ public:
         m_fail_if_inconclusive = p.get_bool("fail_if_inconclusive", true);
     }
     
+    void updt_threads(params_ref const & p) {
+        if (m_parallel && !p.contains("threads") && fparams().m_threads <= 1)
+            fparams().m_threads = omp_get_num_procs();
+    }
+
     virtual void updt_params(params_ref const & p) {
         TRACE("smt_tactic", tout << this << "\nupdt_params: " << p << "\n";);
         updt_params_core(p);
         fparams().updt_params(p);
+        updt_threads(p);
         SASSERT(p.get_bool("auto_config", fparams().m_auto_config) == fparams().m_auto_config);
     }
     
@@ -76,11 +90,15 @@ public:
     virtual void set_cancel(bool f) {
         if (m_ctx)
             m_ctx->set_cancel(f);
+        if (m_cc)
+            m_cc->set_cancel(f);
     }
 
     virtual void collect_statistics(statistics & st) const {
         if (m_ctx)
             m_ctx->collect_statistics(st); // ctx is still running...
+        else if (m_cc)
+            m_cc->collect_statistics(st);
         else
             st.copy(m_stats);
     }
@@ -127,6 +145,78 @@ public:
         }
     };
 
+    struct scoped_init_cc {
+        smt_tactic & m_owner;
+
+        scoped_init_cc(smt_tactic & o, ast_manager & m):m_owner(o) {
+            smt::cube_and_conquer * new_cc = alloc(smt::cube_and_conquer, m, o.fparams(), o.m_params_ref);
+            new_cc->set_logic(o.m_logic);
+            #pragma omp critical (as_st_solver) 
+            {
+                o.m_cc = new_cc;
+            }
+        }
+
+        ~scoped_init_cc() {
+            smt::cube_and_conquer * d = m_owner.m_cc;
+            #pragma omp critical (as_st_cancel)
+            {
+                m_owner.m_cc = 0;
+            }
+            if (d)
+                dealloc(d);
+        }
+    };
+
+    /**
+       \brief Solve the goal using cube and conquer (smt.threads > 1).
+       Proofs and unsat cores are not supported in this mode.
+    */
+    void parallel_check(goal_ref const & in, 
+                        goal_ref_buffer & result, 
+                        model_converter_ref & mc, 
+                        proof_converter_ref & pc,
+                        expr_dependency_ref & core) {
+        ast_manager & m = in->m();
+        scoped_init_cc init(*this, m);
+        unsigned sz = in->size();
+        for (unsigned i = 0; i < sz; i++) 
+            m_cc->assert_expr(in->form(i));
+        lbool r = m_cc->check();
+        m_cc->collect_statistics(m_stats);
+        switch (r) {
+        case l_true: 
+            if (m_fail_if_inconclusive && !in->sat_preserved())
+                throw tactic_exception("over-approximated goal found to be sat");
+            in->reset();
+            result.push_back(in.get());
+            if (in->models_enabled()) {
+                model_ref md;
+                m_cc->get_model(md);
+                mc = model2model_converter(md.get());
+            }
+            pc   = 0;
+            core = 0;
+            return;
+        case l_false:
+            if (m_fail_if_inconclusive && !in->unsat_preserved())
+                throw tactic_exception("under-approximated goal found to be unsat");
+            in->reset();
+            in->assert_expr(m.mk_false());
+            result.push_back(in.get());
+            mc   = 0;
+            pc   = 0;
+            core = 0;
+            return;
+        case l_undef:
+            if (m_fail_if_inconclusive)
+                throw tactic_exception("smt tactic failed to show goal to be sat/unsat");
+            result.push_back(in.get());
+            m_failure = m_cc->last_failure_as_string();
+            throw tactic_exception(m_failure.c_str());
+        }
+    }
+
     typedef obj_map<expr, expr *> expr2expr_map;
 
     virtual void operator()(goal_ref const & in, 
@@ -144,6 +234,10 @@ public:
                   tout << "params_ref: " << m_params_ref << "\n";);
             TRACE("smt_tactic_detail", in->display(tout););
             TRACE("smt_tactic_memory", tout << "wasted_size: " << m.get_allocator().get_wasted_size() << "\n";);        
+            if (fparams().m_threads > 1 && !in->proofs_enabled() && !in->unsat_core_enabled()) {
+                parallel_check(in, result, mc, pc, core);
+                return;
+            }
             scoped_init_ctx  init(*this, m);
             SASSERT(m_ctx != 0);
             
@@ -301,6 +395,10 @@ tactic * mk_smt_tactic(params_ref const & p) {
     return alloc(smt_tactic, p);
 }
 
+tactic * mk_parallel_smt_tactic(params_ref const & p) {
+    return alloc(smt_tactic, p, true);
+}
+
 tactic * mk_smt_tactic_using(bool auto_config, params_ref const & _p) {
     params_ref p = _p;    
     p.set_bool("auto_config", auto_config);
@@ -27,8 +27,12 @@ tactic * mk_smt_tactic(params_ref const & p = params_ref());
 // syntax sugar for using_params(mk_smt_tactic(), p) where p = (:auto_config, auto_config)
 tactic * mk_smt_tactic_using(bool auto_config = true, params_ref const & p = params_ref());
 
+// smt tactic using cube and conquer, by default the number of threads is the number of processors.
+tactic * mk_parallel_smt_tactic(params_ref const & p = params_ref());
+
 /*
   ADD_TACTIC("smt", "apply a SAT based SMT solver.", "mk_smt_tactic(p)") 
+  ADD_TACTIC("psmt", "apply a SAT based SMT solver using cube and conquer on multiple threads.", "mk_parallel_smt_tactic(p)") 
 */
 
 #endif
@@ -36,6 +36,7 @@ Revision History:
 #include"grobner.h"
 #include"arith_simplifier_plugin.h"
 #include"arith_eq_solver.h"
+#include"lu_simplex.h"
 
 namespace smt {
     
@@ -46,6 +47,7 @@ namespace smt {
         unsigned m_max_min; 
         unsigned m_gb_simplify, m_gb_superpose, m_gb_compute_basis, m_gb_num_processed;
         unsigned m_nl_branching, m_nl_linear, m_nl_bounds, m_nl_cross_nested;
+        unsigned m_lu_calls, m_lu_iterations, m_lu_repair_pivots, m_lu_exact_models, m_lu_rebuilds;
 
         void reset() { memset(this, 0, sizeof(theory_arith_stats)); }
         theory_arith_stats() { reset(); }
@@ -433,6 +435,14 @@ namespace smt {
         bool                    m_eager_gcd; // true if gcd should be applied at every add_row
         unsigned                m_final_check_idx;
 
+        // Double precision mirror of the tableau, used when m_arith_simplex_backend != ARITH_SIMPLEX_TABLEAU.
+        // New rows are added to it by init_row. It is rebuilt from scratch only when
+        // m_lu_stale is true: after rows are deleted (e.g., by pop), or after lu_simplex failed.
+        lu_simplex              m_lu_simplex;
+        bool                    m_lu_stale;
+        unsigned_vector         m_lu_xs;
+        svector<double>         m_lu_coeffs;
+
         // backtracking
         svector<bound_trail>    m_bound_trail;
         svector<unsigned>       m_unassigned_atoms_trail;
@@ -714,6 +724,9 @@ namespace smt {
         theory_var select_greatest_error_var() { return select_lg_error_var(false); }
         theory_var select_least_error_var() { return select_lg_error_var(true); }
         theory_var select_smallest_var();
+        void lu_add_row(unsigned r_id);
+        void lu_rebuild();
+        void lu_make_feasible();
         bool make_feasible();
         void sign_row_conflict(theory_var x_i, bool is_below);
 
@@ -1055,6 +1068,30 @@ namespace smt {
 #endif
     };
     
+    /**
+       \brief Approximations used by the double precision simplex (lu_simplex).
+       Infinitesimals are ignored.
+    */
+    inline double to_double(rational const & n) { return n.get_double(); }
+    inline double to_double(inf_rational const & n) { return n.get_rational().get_double(); }
+    inline double to_double(s_integer const & n) { return n.get_int(); }
+    inline double to_double(inf_s_integer const & n) { return n.get_rational().get_int(); }
+    inline bool from_double(double v, rational & r) {
+        int num, den;
+        if (!lu_simplex::to_fraction(v, 1 << 20, num, den))
+            return false;
+        r = rational(num, den);
+        return true;
+    }
+    inline bool from_double(double v, s_integer & r) {
+        // s_integer numerals are integers: accept v only if it is an integer modulo the tolerance.
+        int num, den;
+        if (!lu_simplex::to_fraction(v, 1, num, den))
+            return false;
+        r = s_integer(num);
+        return true;
+    }
+
     class mi_ext {
     public:
         typedef rational     numeral;
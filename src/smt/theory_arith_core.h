@@ -19,6 +19,7 @@ Revision History:
 #ifndef _THEORY_ARITH_CORE_H_
 #define _THEORY_ARITH_CORE_H_
 
+#include<math.h>
 #include"smt_context.h"
 #include"theory_arith.h"
 #include"ast_pp.h"
@@ -678,6 +679,8 @@ namespace smt {
         theory_var s = r[r.size() - 1].m_var;
         r.m_base_var = s;
         set_var_row(s, r_id);
+        if (m_params.m_arith_simplex_backend != ARITH_SIMPLEX_TABLEAU && !m_lu_stale)
+            lu_add_row(r_id);
         TRACE("init_row_bug", tout << "before:\n"; display_row_info(tout, r););
         if (lazy_pivoting_lvl() > 2) {
             set_var_kind(s, QUASI_BASE);
@@ -1430,6 +1433,8 @@ namespace smt {
         m_nl_rounds              = 0;
         m_nl_gb_exhausted        = false;
         m_nl_strategy_idx        = 0;
+        m_lu_simplex             .reset();
+        m_lu_stale               = true;
         theory::reset_eh();
     }
 
@@ -1519,7 +1524,8 @@ namespace smt {
         m_assume_eq_head(0),
         m_nl_rounds(0),
         m_nl_gb_exhausted(false),
-        m_nl_new_exprs(m) {
+        m_nl_new_exprs(m),
+        m_lu_stale(true) {
     }
 
     template<typename Ext>
@@ -2090,6 +2096,163 @@ namespace smt {
         }
     }
 
+    /**
+       \brief Add the row r_id to the double precision mirror of the tableau.
+       The rows of lu_simplex are not kept in solved form: it only needs
+       a basis and a set of rows spanning the same space as the tableau.
+    */
+    template<typename Ext>
+    void theory_arith<Ext>::lu_add_row(unsigned r_id) {
+        row const & r     = m_rows[r_id];
+        theory_var s      = r.get_base_var();
+        lu_simplex & lu   = m_lu_simplex;
+        while (lu.get_num_vars() < static_cast<unsigned>(get_num_vars()))
+            lu.mk_var(0.0);
+        // s is the basic variable of the new row in lu. This keeps the basis
+        // of lu nonsingular only if s does not occur in other rows.
+        if (lu.is_basic(s) || m_columns[s].size() != 1) {
+            m_lu_stale = true;
+            return;
+        }
+        m_lu_xs.reset();
+        m_lu_coeffs.reset();
+        typename vector<row_entry>::const_iterator it  = r.begin_entries();
+        typename vector<row_entry>::const_iterator end = r.end_entries();
+        for (; it != end; ++it) {
+            if (!it->is_dead()) {
+                m_lu_xs.push_back(it->m_var);
+                m_lu_coeffs.push_back(to_double(it->m_coeff));
+            }
+        }
+        lu.add_row(s, m_lu_xs.size(), m_lu_xs.c_ptr(), m_lu_coeffs.c_ptr());
+    }
+
+    /**
+       \brief Copy the current tableau to lu_simplex.
+    */
+    template<typename Ext>
+    void theory_arith<Ext>::lu_rebuild() {
+        m_stats.m_lu_rebuilds++;
+        m_lu_simplex.reset();
+        m_lu_stale = false;
+        int num_vars = get_num_vars();
+        for (theory_var v = 0; v < num_vars; v++)
+            m_lu_simplex.mk_var(0.0);
+        unsigned num_rows = m_rows.size();
+        for (unsigned r_id = 0; r_id < num_rows; r_id++) {
+            if (m_rows[r_id].get_base_var() != null_theory_var)
+                lu_add_row(r_id);
+        }
+    }
+
+    /**
+       \brief Use the double precision simplex (lu_simplex) to find a basis that is
+       (hopefully) feasible, and move the tableau to this basis and assignment.
+
+       The result is only used as a starting point: make_feasible checks
+       it using exact arithmetic, and is responsible for building explanations.
+    */
+    template<typename Ext>
+    void theory_arith<Ext>::lu_make_feasible() {
+        unsigned num_infeasible = 0;
+        typename var_heap::iterator it  = m_to_patch.begin();
+        typename var_heap::iterator end = m_to_patch.end();
+        for (; it != end && num_infeasible < m_params.m_arith_lu_threshold; ++it)
+            num_infeasible++;
+        if (num_infeasible < m_params.m_arith_lu_threshold)
+            return;
+        int num_vars = get_num_vars();
+        for (theory_var v = 0; v < num_vars; v++) {
+            if (is_quasi_base(v))
+                return;
+        }
+        m_stats.m_lu_calls++;
+        lu_simplex & lu = m_lu_simplex;
+        if (m_lu_stale)
+            lu_rebuild();
+        while (lu.get_num_vars() < static_cast<unsigned>(num_vars))
+            lu.mk_var(0.0);
+        // the rows are already in lu, only the bounds and values must be copied.
+        for (theory_var v = 0; v < num_vars; v++) {
+            lu.reset_bounds(v);
+            if (lower(v))
+                lu.set_lower(v, to_double(lower_bound(v)));
+            if (upper(v))
+                lu.set_upper(v, to_double(upper_bound(v)));
+            lu.set_value(v, to_double(m_value[v]));
+        }
+        lu_simplex::status st = lu.make_feasible(m_params.m_arith_lu_max_iterations);
+        m_stats.m_lu_iterations += lu.get_num_iterations();
+        TRACE("arith_lu", tout << "lu_simplex status: " << st << ", iterations: " << lu.get_num_iterations() << "\n";);
+        if (st == lu_simplex::UNKNOWN) {
+            // the basis of lu may be numerically unstable.
+            m_lu_stale = true;
+            return;
+        }
+        // In the filtered mode, a feasible assignment found by lu_simplex is only
+        // copied to the non-base variables, and checked using the current tableau.
+        bool move_basis = st == lu_simplex::INFEASIBLE || m_params.m_arith_simplex_backend != ARITH_SIMPLEX_FP_FILTERED;
+        // move the tableau to the basis found by lu_simplex
+        numeral a;
+        for (theory_var v = 0; move_basis && v < num_vars; v++) {
+            if (!lu.is_basic(v) || is_base(v))
+                continue;
+            column const & c = m_columns[v];
+            typename svector<col_entry>::const_iterator it4  = c.begin_entries();
+            typename svector<col_entry>::const_iterator end4 = c.end_entries();
+            for (; it4 != end4; ++it4) {
+                if (it4->is_dead())
+                    continue;
+                row const & r = m_rows[it4->m_row_id];
+                theory_var b  = r.get_base_var();
+                if (b == null_theory_var || lu.is_basic(b))
+                    continue;
+                a = r[it4->m_row_idx].m_coeff;
+                pivot<true>(b, v, a, m_eager_gcd);
+                m_stats.m_lu_repair_pivots++;
+                break;
+            }
+        }
+        // move non-base variables to the bounds (values) selected by lu_simplex
+        inf_numeral new_val;
+        for (theory_var v = 0; v < num_vars; v++) {
+            if (!is_non_base(v))
+                continue;
+            double val = lu.get_value(v);
+            if (lower(v) && fabs(val - to_double(lower_bound(v))) <= 1e-9 * (1.0 + fabs(val))) {
+                if (m_value[v] != lower_bound(v))
+                    set_value(v, lower_bound(v));
+            }
+            else if (upper(v) && fabs(val - to_double(upper_bound(v))) <= 1e-9 * (1.0 + fabs(val))) {
+                if (m_value[v] != upper_bound(v))
+                    set_value(v, upper_bound(v));
+            }
+            else if (!move_basis && from_double(val, a)) {
+                new_val = inf_numeral(a);
+                if (lower(v) && new_val < lower_bound(v))
+                    new_val = lower_bound(v);
+                else if (upper(v) && new_val > upper_bound(v))
+                    new_val = upper_bound(v);
+                if (m_value[v] != new_val)
+                    set_value(v, new_val);
+            }
+            // non-base variables must satisfy their bounds
+            else if (below_lower(v)) {
+                set_value(v, lower_bound(v));
+            }
+            else if (above_upper(v)) {
+                set_value(v, upper_bound(v));
+            }
+        }
+        m_to_patch.reset();
+        for (theory_var v = 0; v < num_vars; v++) {
+            if (is_base(v) && (below_lower(v) || above_upper(v)))
+                m_to_patch.insert(v);
+        }
+        if (!move_basis && m_to_patch.empty())
+            m_stats.m_lu_exact_models++;
+    }
+
     /**
        \brief Return true if it was possible to patch all variables in m_to_patch.
     */
@@ -2100,6 +2263,9 @@ namespace smt {
         CASSERT("arith", wf_columns());
         CASSERT("arith", valid_row_assignment());
 
+        if (m_params.m_arith_simplex_backend != ARITH_SIMPLEX_TABLEAU)
+            lu_make_feasible();
+
         m_left_basis.reset();
         m_blands_rule    = false;
         unsigned num_repeated = 0;
@@ -3252,6 +3418,8 @@ namespace smt {
             m_var_pos         .shrink(old_num_vars);
             m_bounds[0]       .shrink(old_num_vars);
             m_bounds[1]       .shrink(old_num_vars);
+            // lu_simplex cannot delete variables.
+            m_lu_stale = true;
             SASSERT(check_vector_sizes());
         }
     }
@@ -3268,6 +3436,8 @@ namespace smt {
                 c.del_col_entry(it->m_col_idx);
             }
         }
+        if (r.m_base_var != null_theory_var)
+            m_lu_stale = true;
         r.m_base_var = null_theory_var;
         r.reset();
         m_dead_rows.push_back(r_id);
@@ -43,6 +43,11 @@ namespace smt {
         st.update("pseudo nonlinear", m_stats.m_nl_linear);
         st.update("nonlinear bounds", m_stats.m_nl_bounds);
         st.update("nonlinear horner", m_stats.m_nl_cross_nested);
+        st.update("lu simplex calls", m_stats.m_lu_calls);
+        st.update("lu simplex iterations", m_stats.m_lu_iterations);
+        st.update("lu simplex repair pivots", m_stats.m_lu_repair_pivots);
+        st.update("lu simplex exact models", m_stats.m_lu_exact_models);
+        st.update("lu simplex rebuilds", m_stats.m_lu_rebuilds);
         m_arith_eq_adapter.collect_statistics(st);
     }
 
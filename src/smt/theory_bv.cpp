@@ -810,6 +810,10 @@ namespace smt {
         if (approximate_term(term)) {
             return false;
         }
+        if (is_lazy_op(term)) {
+            internalize_lazy_op(term);
+            return true;
+        }
         switch (term->get_decl_kind()) {
         case OP_BV_NUM:         internalize_num(term); return true;
         case OP_BADD:           internalize_add(term); return true;
@@ -1044,6 +1048,165 @@ namespace smt {
 
     }
 
+    /**
+       \brief Return true if n is an expensive operator that should only be bit-blasted
+       on demand: multiplications of at least two non-numerals, unsigned division and remainder, 
+       and shifts by a non-numeral.
+    */
+    bool theory_bv::is_lazy_op(app * n) const {
+        if (!m_params.m_bv_lazy_blast) 
+            return false;
+        switch (n->get_decl_kind()) {
+        case OP_BMUL: {
+            unsigned num_vars = 0;
+            for (unsigned i = 0; i < n->get_num_args(); i++) {
+                if (!m_util.is_numeral(n->get_arg(i)))
+                    num_vars++;
+            }
+            return num_vars > 1;
+        }
+        case OP_BUDIV_I:
+        case OP_BUREM_I:
+            return true;
+        case OP_BSHL:
+        case OP_BLSHR:
+        case OP_BASHR:
+            return !m_util.is_numeral(n->get_arg(1));
+        default:
+            return false;
+        }
+    }
+
+    void theory_bv::internalize_lazy_op(app * n) {
+        SASSERT(!get_context().e_internalized(n));
+        process_args(n);
+        enode * e    = mk_enode(n);
+        theory_var v = e->get_th_var(get_id());
+        // the bits of n are unconstrained until the operator is blasted.
+        mk_bits(v);
+        m_lazy_ops.push_back(lazy_op(e));
+        m_trail_stack.push(push_back_vector<theory_bv, svector<lazy_op> >(m_lazy_ops));
+        m_stats.m_num_lazy_ops++;
+    }
+
+    /**
+       \brief Return true if the values assigned to the bits of e and its arguments 
+       are consistent with the semantics of the operator.
+    */
+    bool theory_bv::is_lazy_op_satisfied(enode * e) {
+        app * n      = e->get_owner();
+        unsigned sz  = get_bv_size(e);
+        numeral r, a, b;
+        if (!get_fixed_value(e->get_th_var(get_id()), r) || !get_fixed_value(get_arg_var(e, 0), a))
+            return false;
+        numeral p    = rational::power_of_two(sz);
+        if (m_util.is_bv_mul(n)) {
+            for (unsigned i = 1; i < n->get_num_args(); i++) {
+                if (!get_fixed_value(get_arg_var(e, i), b))
+                    return false;
+                a = mod(a * b, p);
+            }
+            return a == r;
+        }
+        if (!get_fixed_value(get_arg_var(e, 1), b))
+            return false;
+        bool big_shift = b >= numeral(sz);
+        switch (n->get_decl_kind()) {
+        case OP_BUDIV_I:
+            // the value of division by zero is fixed by the circuit.
+            return !b.is_zero() && r == div(a, b);
+        case OP_BUREM_I:
+            return !b.is_zero() && r == mod(a, b);
+        case OP_BSHL:
+            return r == (big_shift ? numeral(0) : mod(a * rational::power_of_two(b.get_unsigned()), p));
+        case OP_BLSHR:
+            return r == (big_shift ? numeral(0) : div(a, rational::power_of_two(b.get_unsigned())));
+        case OP_BASHR: {
+            bool neg = a >= rational::power_of_two(sz - 1);
+            if (big_shift)
+                return r == (neg ? p - numeral(1) : numeral(0));
+            unsigned k = b.get_unsigned();
+            numeral expected = div(a, rational::power_of_two(k));
+            if (neg)
+                expected += p - rational::power_of_two(sz - k);
+            return r == expected;
+        }
+        default:
+            UNREACHABLE();
+            return true;
+        }
+    }
+
+    /**
+       \brief Create the circuit for the lazy operator m_lazy_ops[idx], and 
+       assert that its outputs are equal to the bits of the operator.
+    */
+    void theory_bv::blast_lazy_op(unsigned idx) {
+        context & ctx   = get_context();
+        ast_manager & m = get_manager();
+        enode * e       = m_lazy_ops[idx].m_node;
+        app * n         = e->get_owner();
+        expr_ref_vector arg1_bits(m), arg2_bits(m), bits(m);
+        unsigned i      = n->get_num_args() - 1;
+        get_arg_bits(e, i, arg2_bits);
+        if (m_util.is_bv_mul(n)) {
+            while (i > 0) {
+                --i;
+                arg1_bits.reset();
+                bits.reset();
+                get_arg_bits(e, i, arg1_bits);
+                m_bb.mk_multiplier(arg1_bits.size(), arg1_bits.c_ptr(), arg2_bits.c_ptr(), bits);
+                arg2_bits.swap(bits);
+            }
+            bits.swap(arg2_bits);
+        }
+        else {
+            get_arg_bits(e, 0, arg1_bits);
+            unsigned sz = arg1_bits.size();
+            switch (n->get_decl_kind()) {
+            case OP_BUDIV_I: m_bb.mk_udiv(sz, arg1_bits.c_ptr(), arg2_bits.c_ptr(), bits); break;
+            case OP_BUREM_I: m_bb.mk_urem(sz, arg1_bits.c_ptr(), arg2_bits.c_ptr(), bits); break;
+            case OP_BSHL:    m_bb.mk_shl(sz, arg1_bits.c_ptr(), arg2_bits.c_ptr(), bits); break;
+            case OP_BLSHR:   m_bb.mk_lshr(sz, arg1_bits.c_ptr(), arg2_bits.c_ptr(), bits); break;
+            case OP_BASHR:   m_bb.mk_ashr(sz, arg1_bits.c_ptr(), arg2_bits.c_ptr(), bits); break;
+            default: UNREACHABLE();
+            }
+        }
+        TRACE("bv_lazy", tout << "blasting #" << n->get_id() << "\n" << mk_bounded_pp(n, m) << "\n";);
+        theory_var v = e->get_th_var(get_id());
+        SASSERT(bits.size() == m_bits[v].size());
+        for (unsigned j = 0; j < bits.size(); j++) {
+            expr_ref s_bit(m);
+            simplify_bit(bits.get(j), s_bit);
+            ctx.internalize(s_bit, true);
+            literal l = ctx.get_literal(s_bit);
+            literal b = m_bits[v][j];
+            ctx.mark_as_relevant(l);
+            ctx.mk_th_axiom(get_id(), ~l, b);
+            ctx.mk_th_axiom(get_id(), l, ~b);
+        }
+        m_lazy_ops[idx].m_blast_lvl = m_trail_stack.get_num_scopes();
+        m_lazy_blasted.push_back(idx);
+    }
+
+    /**
+       \brief Blast the relevant lazy operators whose semantics is violated by the current assignment.
+       Return true if a circuit was asserted.
+    */
+    bool theory_bv::check_lazy_ops() {
+        context & ctx = get_context();
+        bool blasted  = false;
+        for (unsigned i = 0; i < m_lazy_ops.size(); i++) {
+            lazy_op const & op = m_lazy_ops[i];
+            if (op.m_blast_lvl != UINT_MAX || !ctx.is_relevant(op.m_node) || is_lazy_op_satisfied(op.m_node))
+                continue;
+            blast_lazy_op(i);
+            m_stats.m_num_lazy_blasted++;
+            blasted = true;
+        }
+        return blasted;
+    }
+
     void theory_bv::apply_sort_cnstr(enode * n, sort * s) {
         if (!is_attached_to_var(n) && !approximate_term(n->get_owner())) {
             theory_var v = mk_var(n);
@@ -1265,11 +1428,48 @@ namespace smt {
         m_bits.shrink(num_old_vars);
         m_wpos.shrink(num_old_vars);
         m_zero_one_bits.shrink(num_old_vars);
+        if (!m_lazy_blasted.empty()) {
+            // circuits asserted above the new scope level were removed, they are re-asserted in propagate.
+            unsigned lvl = m_trail_stack.get_num_scopes();
+            unsigned j   = 0;
+            for (unsigned i = 0; i < m_lazy_blasted.size(); i++) {
+                unsigned idx = m_lazy_blasted[i];
+                if (idx >= m_lazy_ops.size())
+                    continue;
+                if (m_lazy_ops[idx].m_blast_lvl <= lvl) {
+                    m_lazy_blasted[j++] = idx;
+                }
+                else {
+                    m_lazy_ops[idx].m_blast_lvl = UINT_MAX;
+                    m_lazy_reblast.push_back(idx);
+                }
+            }
+            m_lazy_blasted.shrink(j);
+        }
         theory::pop_scope_eh(num_scopes);
     }
 
+    bool theory_bv::can_propagate() {
+        return !m_lazy_reblast.empty();
+    }
+
+    void theory_bv::propagate() {
+        unsigned_vector todo;
+        todo.swap(m_lazy_reblast);
+        for (unsigned i = 0; i < todo.size(); i++) {
+            unsigned idx = todo[i];
+            if (idx < m_lazy_ops.size() && m_lazy_ops[idx].m_blast_lvl == UINT_MAX) {
+                blast_lazy_op(idx);
+                m_stats.m_num_lazy_reblasted++;
+            }
+        }
+    }
+
     final_check_status theory_bv::final_check_eh() {
         SASSERT(check_invariant());
+        if (check_lazy_ops()) {
+            return FC_CONTINUE;
+        }
         if (m_approximates_large_bvs) {
             return FC_GIVEUP;
         }
@@ -1278,6 +1478,9 @@ namespace smt {
 
     void theory_bv::reset_eh() {
         pop_scope_eh(m_trail_stack.get_num_scopes());
+        m_lazy_ops.reset();
+        m_lazy_blasted.reset();
+        m_lazy_reblast.reset();
         m_bool_var2atom.reset();
         m_fixed_var_table.reset();
         theory::reset_eh();
@@ -1580,6 +1783,11 @@ namespace smt {
         st.update("bv dynamic diseqs", m_stats.m_num_diseq_dynamic);
         st.update("bv bit2core", m_stats.m_num_bit2core);
         st.update("bv->core eq", m_stats.m_num_th2core_eq);
+        if (m_stats.m_num_lazy_ops > 0) {
+            st.update("bv lazy ops", m_stats.m_num_lazy_ops);
+            st.update("bv lazy blasted", m_stats.m_num_lazy_blasted);
+            st.update("bv lazy reblasted", m_stats.m_num_lazy_reblasted);
+        }
     }
 
 #ifdef Z3DEBUG
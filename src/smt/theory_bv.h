@@ -34,6 +34,7 @@ namespace smt {
     
     struct theory_bv_stats {
         unsigned   m_num_diseq_static, m_num_diseq_dynamic, m_num_bit2core, m_num_th2core_eq, m_num_conflicts;
+        unsigned   m_num_lazy_ops, m_num_lazy_blasted, m_num_lazy_reblasted;
         void reset() { memset(this, 0, sizeof(theory_bv_stats)); }
         theory_bv_stats() { reset(); }
     };
@@ -130,6 +131,21 @@ namespace smt {
         svector<var_pos>         m_prop_queue;
         bool                     m_approximates_large_bvs;
 
+        /**
+           \brief Operator that is not bit-blasted when it is internalized (see m_bv_lazy_blast).
+           Its bits are fresh bit2bool atoms, and the circuit is only created if a candidate
+           model violates the semantics of the operator. m_blast_lvl is the scope level where
+           the circuit was asserted, or UINT_MAX if it was not asserted yet.
+        */
+        struct lazy_op {
+            enode *  m_node;
+            unsigned m_blast_lvl;
+            lazy_op(enode * n = 0):m_node(n), m_blast_lvl(UINT_MAX) {}
+        };
+        svector<lazy_op>         m_lazy_ops;
+        unsigned_vector          m_lazy_blasted; // indices of lazy operators whose circuit was asserted.
+        unsigned_vector          m_lazy_reblast; // indices of lazy operators whose circuit was removed by backtracking.
+
         theory_var find(theory_var v) const { return m_find.find(v); }
         theory_var next(theory_var v) const { return m_find.next(v); }
         bool is_root(theory_var v) const { return m_find.is_root(v); }
@@ -205,6 +221,12 @@ namespace smt {
 
         bool approximate_term(app* n);
 
+        bool is_lazy_op(app * n) const;
+        void internalize_lazy_op(app * n);
+        bool is_lazy_op_satisfied(enode * e);
+        void blast_lazy_op(unsigned idx);
+        bool check_lazy_ops();
+
         template<bool Signed>
         void internalize_le(app * atom);
         bool internalize_xor3(app * n, bool gate_ctx);
@@ -234,6 +256,8 @@ namespace smt {
         virtual void relevant_eh(app * n);
         virtual void push_scope_eh();
         virtual void pop_scope_eh(unsigned num_scopes);
+        virtual bool can_propagate();
+        virtual void propagate();
         virtual final_check_status final_check_eh();
         virtual void reset_eh();
         svector<theory_var>   m_merge_aux[2]; //!< auxiliary vector used in merge_zero_one_bits
@@ -20,6 +20,8 @@ Notes:
 #include"goal.h"
 #include"ast_smt2_pp.h"
 #include"cooperate.h"
+#include"sat_solver.h"
+#include"statistics.h"
 
 #define USE_TWO_LEVEL_RULES
 #define FIRST_NODE_ID (UINT_MAX/2)
@@ -121,6 +123,15 @@ struct aig_manager::imp {
     unsigned long long       m_max_memory;
     volatile bool            m_cancel;
 
+    struct stats {
+        unsigned m_num_rewrites;
+        unsigned m_num_fraig_merges;
+        unsigned m_num_sat_calls;
+        stats() { reset(); }
+        void reset() { memset(this, 0, sizeof(*this)); }
+    };
+    stats                    m_stats;
+
     void dec_ref_core(aig * n) {
         SASSERT(n->m_ref_count > 0);
         n->m_ref_count--;
@@ -1302,6 +1313,698 @@ struct aig_manager::imp {
         }
     };
 
+    /**
+       \brief Store in nodes the AIGs reachable from r, children before parents.
+    */
+    void collect_nodes(aig_lit const & r, ptr_vector<aig> & nodes) {
+        ptr_vector<aig> todo;
+        todo.push_back(r.ptr());
+        while (!todo.empty()) {
+            aig * n = todo.back();
+            if (n->m_mark) {
+                todo.pop_back();
+                continue;
+            }
+            bool visited = true;
+            if (!is_var(n)) {
+                for (unsigned i = 0; i < 2; i++) {
+                    aig * c = n->m_children[i].ptr();
+                    if (!c->m_mark) {
+                        todo.push_back(c);
+                        visited = false;
+                    }
+                }
+            }
+            if (visited) {
+                n->m_mark = true;
+                nodes.push_back(n);
+                todo.pop_back();
+            }
+        }
+        unmark(nodes.size(), nodes.c_ptr());
+    }
+
+    /**
+       \brief Base class for procedures that rebuild the AIG reachable from a literal
+       visiting its nodes in topological order.
+    */
+    struct sweep_proc {
+        imp &            m;
+        ptr_vector<aig>  m_nodes;    // nodes in topological order
+        unsigned_vector  m_var2idx;
+        unsigned_vector  m_node2idx;
+        svector<aig_lit> m_new;      // new literal for each node, the references are owned by this object.
+
+        sweep_proc(imp & _m):m(_m) {}
+
+        ~sweep_proc() {
+            reset();
+        }
+
+        void reset() {
+            for (unsigned i = 0; i < m_new.size(); i++) {
+                if (!m_new[i].is_null())
+                    m.dec_ref(m_new[i]);
+            }
+            m_new.finalize();
+        }
+
+        void init(aig_lit const & r) {
+            m.collect_nodes(r, m_nodes);
+            unsigned sz = m_nodes.size();
+            for (unsigned i = 0; i < sz; i++) {
+                aig * n = m_nodes[i];
+                unsigned_vector & v = is_var(n) ? m_var2idx : m_node2idx;
+                unsigned id         = is_var(n) ? n->m_id : to_idx(n);
+                v.reserve(id+1, UINT_MAX);
+                v[id] = i;
+            }
+            m_new.resize(sz, aig_lit::null);
+        }
+
+        unsigned idx(aig * n) const { return is_var(n) ? m_var2idx[n->m_id] : m_node2idx[to_idx(n)]; }
+        unsigned idx(aig_lit const & l) const { return idx(l.ptr()); }
+
+        aig_lit get_new(aig_lit const & l) const {
+            aig_lit r = m_new[idx(l)];
+            SASSERT(!r.is_null());
+            if (l.is_inverted())
+                r.invert();
+            return r;
+        }
+
+        void set_new(unsigned i, aig_lit l) {
+            m.inc_ref(l);
+            m_new[i] = l;
+        }
+
+        void mk_default(unsigned i) {
+            aig * n = m_nodes[i];
+            if (is_var(n))
+                set_new(i, aig_lit(n));
+            else
+                set_new(i, m.mk_and(get_new(left(n)), get_new(right(n))));
+        }
+
+        aig_lit mk_result(aig_lit const & r) {
+            aig_lit n = get_new(r);
+            m.inc_ref(n);
+            reset();
+            m.dec_ref_result(n);
+            return n;
+        }
+    };
+
+    /**
+       \brief Cut based rewriting. 
+       
+       The 4-feasible cuts of every node are enumerated together with their truth tables.
+       A node is replaced with a new implementation of one of its cuts when the new implementation 
+       is smaller than the nodes that become dead (the maximum fanout free cone of the node w.r.t. the cut).
+       
+       New implementations are obtained by decomposing the truth table (AND/OR/XOR decompositions and
+       Shannon expansion). The costs are memoized by truth table: there are only 2^16 functions of 
+       4 inputs, so all members of a NPN class share the table instead of a precomputed library.
+    */
+    struct rewrite_proc : public sweep_proc {
+        struct cut {
+            unsigned m_size;
+            aig *    m_leaves[4];
+            unsigned m_tt;
+        };
+
+        enum decomposition {
+            DEC_CONST, DEC_LIT, DEC_AND_LIT, DEC_OR_LIT, DEC_XOR, DEC_ITE, DEC_AND, DEC_OR
+        };
+
+        static const unsigned max_cuts = 8;
+        static const unsigned full     = 0xFFFF;
+
+        vector<svector<cut> > m_cuts;
+        unsigned_vector       m_fanouts;
+        svector<bool>         m_replaced;
+        svector<cut>          m_chosen;    // cut used to implement a replaced node.
+        unsigned_vector       m_cost;      // cost of the implementation of a replaced node.
+        unsigned_vector       m_trail;
+        ptr_vector<aig>       m_todo;
+        svector<unsigned char> m_tt_cost;
+
+        rewrite_proc(imp & _m):sweep_proc(_m) {}
+
+        static unsigned var_tt(unsigned i) {
+            static unsigned const tts[4] = { 0xAAAA, 0xCCCC, 0xF0F0, 0xFF00 };
+            return tts[i];
+        }
+
+        static unsigned cofactor0(unsigned tt, unsigned i) { 
+            unsigned s = 1 << i;
+            unsigned r = tt & ~var_tt(i) & full;
+            return r | (r << s);
+        }
+
+        static unsigned cofactor1(unsigned tt, unsigned i) {
+            unsigned s = 1 << i;
+            unsigned r = tt & var_tt(i);
+            return r | (r >> s);
+        }
+
+        static bool depends_on(unsigned tt, unsigned i) { return cofactor0(tt, i) != cofactor1(tt, i); }
+
+        /**
+           \brief Existentially (universally if forall) quantify the variables in vars.
+        */
+        static unsigned quantify(unsigned tt, unsigned vars, bool forall) {
+            for (unsigned i = 0; i < 4; i++) {
+                if (vars & (1 << i)) 
+                    tt = forall ? (cofactor0(tt, i) & cofactor1(tt, i)) : (cofactor0(tt, i) | cofactor1(tt, i));
+            }
+            return tt;
+        }
+
+        /**
+           \brief Return the best decomposition for tt and its cost in AND nodes. 
+           kind and arg describe the decomposition.
+        */
+        unsigned decompose(unsigned tt, unsigned & kind, unsigned & arg) {
+            kind = DEC_CONST;
+            arg  = 0;
+            if (tt == 0 || tt == full)
+                return 0;
+            unsigned support = 0;
+            for (unsigned i = 0; i < 4; i++) {
+                if (depends_on(tt, i))
+                    support |= (1 << i);
+                if (tt == var_tt(i) || tt == (~var_tt(i) & full)) {
+                    kind = DEC_LIT;
+                    arg  = i;
+                    return 0;
+                }
+            }
+            unsigned best = UINT_MAX;
+            for (unsigned i = 0; i < 4; i++) {
+                if (!(support & (1 << i)))
+                    continue;
+                unsigned f0 = cofactor0(tt, i);
+                unsigned f1 = cofactor1(tt, i);
+                unsigned c, k;
+                if (f0 == 0 || f1 == full) {
+                    c = 1 + cost(f1 == full ? f0 : f1);
+                    k = f0 == 0 ? DEC_AND_LIT : DEC_OR_LIT;
+                }
+                else if (f1 == 0 || f0 == full) {
+                    c = 1 + cost(f1 == 0 ? f0 : f1);
+                    k = f1 == 0 ? DEC_AND_LIT : DEC_OR_LIT;
+                }
+                else if (f0 == (~f1 & full)) {
+                    c = 3 + cost(f0);
+                    k = DEC_XOR;
+                }
+                else {
+                    c = 3 + cost(f0) + cost(f1);
+                    k = DEC_ITE;
+                }
+                if (c < best) {
+                    best = c;
+                    kind = k;
+                    arg  = i;
+                }
+            }
+            // disjoint support AND/OR decompositions.
+            for (unsigned s = 1; s < support; s++) {
+                if ((s & support) != s || s > (support & ~s))
+                    continue;
+                unsigned t = support & ~s;
+                unsigned g = quantify(tt, t, false);
+                unsigned h = quantify(tt, s, false);
+                if ((g & h) == tt) {
+                    unsigned c = 1 + cost(g) + cost(h);
+                    if (c < best) {
+                        best = c;
+                        kind = DEC_AND;
+                        arg  = s;
+                    }
+                }
+                g = quantify(tt, t, true);
+                h = quantify(tt, s, true);
+                if ((g | h) == tt) {
+                    unsigned c = 1 + cost(g) + cost(h);
+                    if (c < best) {
+                        best = c;
+                        kind = DEC_OR;
+                        arg  = s;
+                    }
+                }
+            }
+            SASSERT(best != UINT_MAX);
+            return best;
+        }
+
+        unsigned cost(unsigned tt) {
+            if (m_tt_cost.empty())
+                m_tt_cost.resize(full + 1, UCHAR_MAX);
+            if (m_tt_cost[tt] == UCHAR_MAX) {
+                unsigned kind, arg;
+                m_tt_cost[tt] = static_cast<unsigned char>(decompose(tt, kind, arg));
+            }
+            return m_tt_cost[tt];
+        }
+
+        /**
+           \brief Create an implementation of tt using the given leaves. 
+           The result is returned with an extra reference.
+        */
+        aig_lit mk_tt(unsigned tt, aig_lit const * leaves) {
+            unsigned kind, arg;
+            decompose(tt, kind, arg);
+            aig_lit r, x, g, h;
+            unsigned f0 = 0, f1 = 0;
+            if (kind != DEC_CONST && kind != DEC_AND && kind != DEC_OR) {
+                x  = leaves[arg];
+                f0 = cofactor0(tt, arg);
+                f1 = cofactor1(tt, arg);
+            }
+            switch (kind) {
+            case DEC_CONST:
+                r = tt == 0 ? m.m_false : m.m_true;
+                m.inc_ref(r);
+                return r;
+            case DEC_LIT:
+                r = x;
+                if (tt != var_tt(arg))
+                    r.invert();
+                m.inc_ref(r);
+                return r;
+            case DEC_AND_LIT:
+                // x and f1 or (not x) and f0
+                if (f0 != 0) {
+                    x.invert();
+                    f1 = f0;
+                }
+                g = mk_tt(f1, leaves);
+                r = m.mk_and(x, g);
+                break;
+            case DEC_OR_LIT:
+                // x or f0 or (not x) or f1
+                if (f1 != full) {
+                    x.invert();
+                    f0 = f1;
+                }
+                g = mk_tt(f0, leaves);
+                r = m.mk_or(x, g);
+                break;
+            case DEC_XOR:
+                g = mk_tt(f0, leaves);
+                r = m.mk_xor(x, g);
+                break;
+            case DEC_ITE:
+                g = mk_tt(f1, leaves);
+                h = mk_tt(f0, leaves);
+                r = m.mk_ite(x, g, h);
+                break;
+            case DEC_AND:
+            case DEC_OR: {
+                unsigned t = 0;
+                for (unsigned i = 0; i < 4; i++)
+                    if (depends_on(tt, i) && !(arg & (1 << i)))
+                        t |= (1 << i);
+                bool is_and = kind == DEC_AND;
+                g = mk_tt(quantify(tt, t, !is_and), leaves);
+                h = mk_tt(quantify(tt, arg, !is_and), leaves);
+                r = is_and ? m.mk_and(g, h) : m.mk_or(g, h);
+                break;
+            }
+            default:
+                UNREACHABLE();
+            }
+            m.inc_ref(r);
+            if (!g.is_null()) m.dec_ref(g);
+            if (!h.is_null()) m.dec_ref(h);
+            return r;
+        }
+
+        /**
+           \brief Return the truth table of c with respect to the leaves of the cut s (c's leaves are a subset of s's leaves).
+        */
+        static unsigned expand(cut const & c, cut const & s) {
+            unsigned pos[4];
+            for (unsigned j = 0, k = 0; j < c.m_size; j++) {
+                while (s.m_leaves[k] != c.m_leaves[j])
+                    k++;
+                pos[j] = k;
+            }
+            unsigned r = 0;
+            for (unsigned b = 0; b <= 15; b++) {
+                unsigned s_idx = 0;
+                for (unsigned j = 0; j < c.m_size; j++) 
+                    if (b & (1 << pos[j]))
+                        s_idx |= (1 << j);
+                if (c.m_tt & (1 << s_idx))
+                    r |= (1 << b);
+            }
+            return r;
+        }
+
+        static bool merge(cut const & c1, cut const & c2, cut & r) {
+            unsigned i = 0, j = 0;
+            r.m_size = 0;
+            while (i < c1.m_size || j < c2.m_size) {
+                aig * n;
+                if (j == c2.m_size || (i < c1.m_size && c1.m_leaves[i]->m_id < c2.m_leaves[j]->m_id)) 
+                    n = c1.m_leaves[i++];
+                else if (i == c1.m_size || c2.m_leaves[j]->m_id < c1.m_leaves[i]->m_id)
+                    n = c2.m_leaves[j++];
+                else {
+                    n = c1.m_leaves[i++];
+                    j++;
+                }
+                if (r.m_size == 4)
+                    return false;
+                r.m_leaves[r.m_size++] = n;
+            }
+            return true;
+        }
+
+        static bool same_leaves(cut const & c1, cut const & c2) {
+            if (c1.m_size != c2.m_size)
+                return false;
+            for (unsigned i = 0; i < c1.m_size; i++)
+                if (c1.m_leaves[i] != c2.m_leaves[i])
+                    return false;
+            return true;
+        }
+
+        void mk_trivial_cut(aig * n, svector<cut> & cs) {
+            cut c;
+            c.m_size      = 1;
+            c.m_leaves[0] = n;
+            c.m_tt        = var_tt(0);
+            cs.push_back(c);
+        }
+
+        void mk_cuts(unsigned i) {
+            aig * n          = m_nodes[i];
+            svector<cut> & cs = m_cuts[i];
+            mk_trivial_cut(n, cs);
+            if (is_var(n))
+                return;
+            aig_lit l = left(n), r = right(n);
+            svector<cut> const & cs1 = m_cuts[idx(l)];
+            svector<cut> const & cs2 = m_cuts[idx(r)];
+            for (unsigned j = 0; j < cs1.size() && cs.size() <= max_cuts; j++) {
+                for (unsigned k = 0; k < cs2.size() && cs.size() <= max_cuts; k++) {
+                    cut c;
+                    if (!merge(cs1[j], cs2[k], c))
+                        continue;
+                    bool found = false;
+                    for (unsigned u = 1; !found && u < cs.size(); u++)
+                        found = same_leaves(cs[u], c);
+                    if (found)
+                        continue;
+                    unsigned tt1 = expand(cs1[j], c);
+                    unsigned tt2 = expand(cs2[k], c);
+                    if (l.is_inverted()) tt1 = ~tt1 & full;
+                    if (r.is_inverted()) tt2 = ~tt2 & full;
+                    c.m_tt = tt1 & tt2;
+                    cs.push_back(c);
+                }
+            }
+        }
+
+        static bool is_leaf(aig * n, cut const & c) {
+            for (unsigned i = 0; i < c.m_size; i++)
+                if (c.m_leaves[i] == n)
+                    return true;
+            return false;
+        }
+
+        /**
+           \brief Decrement the fanouts of the cone of n above the cut c, and 
+           return the number of nodes that become dead (including n). 
+           The decremented nodes are stored in m_trail.
+        */
+        unsigned deref(aig * n, cut const & c) {
+            unsigned num = 1;
+            m_todo.push_back(left(n).ptr());
+            m_todo.push_back(right(n).ptr());
+            while (!m_todo.empty()) {
+                aig * p = m_todo.back();
+                m_todo.pop_back();
+                if (is_var(p) || is_leaf(p, c))
+                    continue;
+                unsigned i = idx(p);
+                SASSERT(m_fanouts[i] > 0);
+                m_fanouts[i]--;
+                m_trail.push_back(i);
+                if (m_fanouts[i] > 0)
+                    continue;
+                if (m_replaced[i]) {
+                    num += m_cost[i];
+                }
+                else {
+                    num++;
+                    m_todo.push_back(left(p).ptr());
+                    m_todo.push_back(right(p).ptr());
+                }
+            }
+            return num;
+        }
+
+        void restore_fanouts() {
+            for (unsigned i = 0; i < m_trail.size(); i++)
+                m_fanouts[m_trail[i]]++;
+            m_trail.reset();
+        }
+
+        void process(unsigned i) {
+            aig * n          = m_nodes[i];
+            svector<cut> & cs = m_cuts[i];
+            unsigned best_gain = 0;
+            unsigned best_cut  = 0;
+            for (unsigned j = 1; j < cs.size(); j++) {
+                unsigned c = cost(cs[j].m_tt);
+                unsigned num_dead = deref(n, cs[j]);
+                restore_fanouts();
+                if (num_dead > c && num_dead - c > best_gain) {
+                    best_gain = num_dead - c;
+                    best_cut  = j;
+                }
+            }
+            if (best_gain == 0)
+                return;
+            deref(n, cs[best_cut]);
+            m_trail.reset();
+            m_replaced[i] = true;
+            m_chosen[i]   = cs[best_cut];
+            m_cost[i]     = cost(cs[best_cut].m_tt);
+            // the cones below the other cuts may be dead now.
+            cs[1] = cs[best_cut];
+            cs.shrink(2);
+            m.m_stats.m_num_rewrites++;
+        }
+
+        aig_lit operator()(aig_lit r) {
+            init(r);
+            unsigned sz = m_nodes.size();
+            m_cuts.resize(sz);
+            m_fanouts.resize(sz, 0);
+            m_replaced.resize(sz, false);
+            m_cost.resize(sz, 0);
+            m_chosen.resize(sz);
+            m_fanouts[idx(r)]++;
+            for (unsigned i = 0; i < sz; i++) {
+                aig * n = m_nodes[i];
+                if (!is_var(n)) {
+                    m_fanouts[idx(left(n))]++;
+                    m_fanouts[idx(right(n))]++;
+                }
+            }
+            for (unsigned i = 0; i < sz; i++) {
+                m.checkpoint();
+                mk_cuts(i);
+                if (!is_var(m_nodes[i]) && m_fanouts[i] > 0)
+                    process(i);
+            }
+            m_cuts.finalize();
+            for (unsigned i = 0; i < sz; i++) {
+                aig * n = m_nodes[i];
+                if (!is_var(n) && m_fanouts[i] == 0)
+                    continue; 
+                if (!m_replaced[i]) {
+                    mk_default(i);
+                    continue;
+                }
+                m.checkpoint();
+                cut const & c = m_chosen[i];
+                aig_lit leaves[4];
+                for (unsigned j = 0; j < c.m_size; j++)
+                    leaves[j] = m_new[idx(c.m_leaves[j])];
+                m_new[i] = mk_tt(c.m_tt, leaves);
+            }
+            return mk_result(r);
+        }
+    };
+
+    /**
+       \brief FRAIG sweeping: nodes are grouped by their values on random input patterns, 
+       and nodes in the same group are merged when a SAT solver proves them equivalent 
+       (modulo negation).
+    */
+    struct fraig_proc : public sweep_proc {
+        static const unsigned num_words = 4; // 256 random patterns
+
+        unsigned         m_max_conflicts;
+        sat::solver      m_solver;
+        svector<uint64>  m_sim;
+        svector<sat::bool_var> m_vars;
+        u_map<unsigned>  m_class2head;       // hash of normalized simulation vector -> last node
+        unsigned_vector  m_class_next;       // next node in the same hash class
+        random_gen       m_rand;
+
+        static params_ref mk_sat_params(unsigned max_conflicts) {
+            params_ref p;
+            p.set_uint("max_conflicts", max_conflicts);
+            p.set_uint("burst_search", max_conflicts);
+            return p;
+        }
+
+        fraig_proc(imp & _m, unsigned max_conflicts):
+            sweep_proc(_m),
+            m_max_conflicts(max_conflicts),
+            m_solver(mk_sat_params(max_conflicts), 0) {
+        }
+
+        uint64 mk_random_word() {
+            uint64 r = 0;
+            for (unsigned i = 0; i < 5; i++)
+                r = (r << 15) | static_cast<uint64>(m_rand());
+            return r;
+        }
+
+        uint64 * sim(unsigned i) { return m_sim.c_ptr() + i * num_words; }
+
+        bool phase(unsigned i) { return (sim(i)[0] & 1) != 0; }
+
+        unsigned sim_hash(unsigned i) {
+            uint64 mask = phase(i) ? ~static_cast<uint64>(0) : 0;
+            unsigned h  = 0;
+            for (unsigned w = 0; w < num_words; w++) {
+                uint64 v = sim(i)[w] ^ mask;
+                h = hash_u_u(h, hash_u_u(static_cast<unsigned>(v), static_cast<unsigned>(v >> 32)));
+            }
+            return h;
+        }
+
+        bool same_sim(unsigned i, unsigned j) {
+            uint64 mask = phase(i) != phase(j) ? ~static_cast<uint64>(0) : 0;
+            for (unsigned w = 0; w < num_words; w++)
+                if (sim(i)[w] != (sim(j)[w] ^ mask))
+                    return false;
+            return true;
+        }
+
+        sat::literal mk_lit(aig_lit const & l) {
+            return sat::literal(m_vars[idx(l)], l.is_inverted());
+        }
+
+        void simulate(unsigned i) {
+            aig * n   = m_nodes[i];
+            uint64 * s = sim(i);
+            if (is_var(n)) {
+                for (unsigned w = 0; w < num_words; w++) 
+                    s[w] = n->m_id == 0 ? ~static_cast<uint64>(0) : mk_random_word();
+                return;
+            }
+            aig_lit l = left(n), r = right(n);
+            uint64 mask1 = l.is_inverted() ? ~static_cast<uint64>(0) : 0;
+            uint64 mask2 = r.is_inverted() ? ~static_cast<uint64>(0) : 0;
+            uint64 * s1  = sim(idx(l));
+            uint64 * s2  = sim(idx(r));
+            for (unsigned w = 0; w < num_words; w++)
+                s[w] = (s1[w] ^ mask1) & (s2[w] ^ mask2);
+        }
+
+        void encode(unsigned i) {
+            aig * n          = m_nodes[i];
+            sat::bool_var v  = m_solver.mk_var(true, true);
+            m_vars[i]        = v;
+            sat::literal lit(v, false);
+            if (is_var(n)) {
+                if (n->m_id == 0)
+                    m_solver.mk_clause(1, &lit);
+                return;
+            }
+            sat::literal l1 = mk_lit(left(n));
+            sat::literal l2 = mk_lit(right(n));
+            m_solver.mk_clause(~lit, l1);
+            m_solver.mk_clause(~lit, l2);
+            m_solver.mk_clause(lit, ~l1, ~l2);
+        }
+
+        /**
+           \brief Return true if l1 and l2 are proved to be equivalent.
+        */
+        bool is_equiv(sat::literal l1, sat::literal l2) {
+            sat::literal assumptions[2] = { l1, ~l2 };
+            for (unsigned k = 0; k < 2; k++) {
+                m.m_stats.m_num_sat_calls++;
+                lbool r = m_solver.check(2, assumptions);
+                if (r != l_false)
+                    return false;
+                assumptions[0].neg();
+                assumptions[1].neg();
+            }
+            m_solver.mk_clause(~l1, l2);
+            m_solver.mk_clause(l1, ~l2);
+            return true;
+        }
+
+        void process(unsigned i) {
+            simulate(i);
+            encode(i);
+            unsigned h = sim_hash(i);
+            unsigned head = UINT_MAX;
+            m_class2head.find(h, head);
+            if (!is_var(m_nodes[i])) {
+                unsigned num_candidates = 0;
+                for (unsigned j = head; j != UINT_MAX && num_candidates < 4; j = m_class_next[j]) {
+                    if (!same_sim(i, j))
+                        continue;
+                    num_candidates++;
+                    bool neg = phase(i) != phase(j);
+                    sat::literal l1(m_vars[i], false);
+                    sat::literal l2(m_vars[j], neg);
+                    if (is_equiv(l1, l2)) {
+                        aig_lit r = m_new[j];
+                        if (neg)
+                            r.invert();
+                        set_new(i, r);
+                        m.m_stats.m_num_fraig_merges++;
+                        return;
+                    }
+                }
+                mk_default(i);
+            }
+            else {
+                mk_default(i);
+            }
+            m_class_next[i] = head;
+            m_class2head.insert(h, i);
+        }
+
+        aig_lit operator()(aig_lit r) {
+            init(r);
+            unsigned sz = m_nodes.size();
+            m_sim.resize(sz * num_words, 0);
+            m_vars.resize(sz, sat::null_bool_var);
+            m_class_next.resize(sz, UINT_MAX);
+            for (unsigned i = 0; i < sz; i++) {
+                m.checkpoint();
+                process(i);
+            }
+            return mk_result(r);
+        }
+    };
+
 public:
     imp(ast_manager & m, unsigned long long max_memory, bool default_gate_encoding):
         m_var_id_gen(0),
@@ -1551,6 +2254,22 @@ public:
         return p(l);
     }
 
+    aig_lit rewrite(aig_lit l) {
+        rewrite_proc p(*this);
+        return p(l);
+    }
+
+    aig_lit fraig(aig_lit l, unsigned max_conflicts) {
+        fraig_proc p(*this, max_conflicts);
+        return p(l);
+    }
+
+    void collect_statistics(statistics & st) const {
+        st.update("aig rewrites", m_stats.m_num_rewrites);
+        st.update("aig fraig merges", m_stats.m_num_fraig_merges);
+        st.update("aig fraig sat calls", m_stats.m_num_sat_calls);
+    }
+
     void display_ref(std::ostream & out, aig * r) const {
         if (is_var(r)) 
             out << "#" << r->m_id;
@@ -1732,6 +2451,14 @@ void aig_manager::max_sharing(aig_ref & r) {
     r = aig_ref(*this, m_imp->max_sharing(aig_lit(r)));
 }
 
+void aig_manager::rewrite(aig_ref & r) {
+    r = aig_ref(*this, m_imp->rewrite(aig_lit(r)));
+}
+
+void aig_manager::fraig(aig_ref & r, unsigned max_conflicts) {
+    r = aig_ref(*this, m_imp->fraig(aig_lit(r), max_conflicts));
+}
+
 void aig_manager::to_formula(aig_ref const & r, goal & g) {
     SASSERT(!g.proofs_enabled());
     SASSERT(!g.unsat_core_enabled());
@@ -1754,6 +2481,14 @@ unsigned aig_manager::get_num_aigs() const {
     return m_imp->get_num_aigs();
 }
 
+void aig_manager::collect_statistics(statistics & st) const {
+    m_imp->collect_statistics(st);
+}
+
+void aig_manager::reset_statistics() {
+    m_imp->m_stats.reset();
+}
+
 void aig_manager::set_cancel(bool f) {
     m_imp->set_cancel(f);
 }
@@ -23,6 +23,7 @@ Notes:
 #include"tactic_exception.h"
 
 class goal;
+class statistics;
 class aig_lit;
 class aig_manager;
 
@@ -68,11 +69,18 @@ public:
     aig_ref mk_iff(aig_ref const & r1, aig_ref const & r2);
     aig_ref mk_ite(aig_ref const & r1, aig_ref const & r2, aig_ref const & r3);
     void max_sharing(aig_ref & r);
+    // Replace nodes with smaller implementations of their 4-input cuts.
+    void rewrite(aig_ref & r);
+    // Merge nodes that are equivalent modulo negation (random simulation + SAT).
+    // max_conflicts is the conflict budget of each SAT query.
+    void fraig(aig_ref & r, unsigned max_conflicts);
     void to_formula(aig_ref const & r, expr_ref & result);
     void to_formula(aig_ref const & r, goal & result);
     void display(std::ostream & out, aig_ref const & r) const;
     void display_smt2(std::ostream & out, aig_ref const & r) const;
     unsigned get_num_aigs() const;
+    void collect_statistics(statistics & st) const;
+    void reset_statistics();
     void set_cancel(bool f);
 };
 
@@ -25,7 +25,11 @@ class aig_tactic : public tactic {
     unsigned long long m_max_memory;
     bool               m_aig_gate_encoding;
     bool               m_aig_per_assertion;
+    bool               m_aig_rewrite;
+    bool               m_aig_fraig;
+    unsigned           m_aig_fraig_max_conflicts;
     aig_manager *      m_aig_manager;
+    statistics         m_stats;
 
     struct mk_aig_manager {
         aig_tactic & m_owner;
@@ -40,6 +44,7 @@ class aig_tactic : public tactic {
         
         ~mk_aig_manager() {
             aig_manager * mng = m_owner.m_aig_manager;
+            mng->collect_statistics(m_owner.m_stats);
             #pragma omp critical (aig_tactic)
             {
                 m_owner.m_aig_manager = 0;
@@ -58,6 +63,9 @@ public:
         t->m_max_memory = m_max_memory;
         t->m_aig_gate_encoding = m_aig_gate_encoding;
         t->m_aig_per_assertion = m_aig_per_assertion;
+        t->m_aig_rewrite = m_aig_rewrite;
+        t->m_aig_fraig = m_aig_fraig;
+        t->m_aig_fraig_max_conflicts = m_aig_fraig_max_conflicts;
         return t;
     }
 
@@ -65,11 +73,25 @@ public:
         m_max_memory        = megabytes_to_bytes(p.get_uint("max_memory", UINT_MAX));
         m_aig_gate_encoding = p.get_bool("aig_default_gate_encoding", true);
         m_aig_per_assertion = p.get_bool("aig_per_assertion", true); 
+        m_aig_rewrite       = p.get_bool("aig_rewrite", false);
+        m_aig_fraig         = p.get_bool("aig_fraig", false);
+        m_aig_fraig_max_conflicts = p.get_uint("aig_fraig_max_conflicts", 100);
     }
 
     virtual void collect_param_descrs(param_descrs & r) { 
         insert_max_memory(r);
         r.insert("aig_per_assertion", CPK_BOOL, "(default: true) process one assertion at a time.");
+        r.insert("aig_rewrite", CPK_BOOL, "(default: false) replace nodes with smaller implementations of their 4-input cuts.");
+        r.insert("aig_fraig", CPK_BOOL, "(default: false) merge functionally equivalent nodes using random simulation and SAT.");
+        r.insert("aig_fraig_max_conflicts", CPK_UINT, "(default: 100) maximum number of conflicts for each SAT query in aig_fraig.");
+    }
+
+    void simplify(aig_ref & r) {
+        if (m_aig_fraig)
+            m_aig_manager->fraig(r, m_aig_fraig_max_conflicts);
+        if (m_aig_rewrite)
+            m_aig_manager->rewrite(r);
+        m_aig_manager->max_sharing(r);
     }
 
     void operator()(goal_ref const & g) {
@@ -81,7 +103,7 @@ public:
             unsigned size = g->size();
             for (unsigned i = 0; i < size; i++) {
                 aig_ref r = m_aig_manager->mk_aig(g->form(i));
-                m_aig_manager->max_sharing(r);
+                simplify(r);
                 expr_ref new_f(g->m());
                 m_aig_manager->to_formula(r, new_f);
                 g->update(i, new_f, 0, g->dep(i));
@@ -91,7 +113,7 @@ public:
             fail_if_unsat_core_generation("aig", g);
             aig_ref r = m_aig_manager->mk_aig(*(g.get()));
             g->reset(); // save memory
-            m_aig_manager->max_sharing(r);
+            simplify(r);
             m_aig_manager->to_formula(r, *(g.get()));
         }
         SASSERT(g->is_well_sorted());
@@ -111,6 +133,14 @@ public:
 
     virtual void cleanup() {}
 
+    virtual void collect_statistics(statistics & st) const {
+        st.copy(m_stats);
+    }
+
+    virtual void reset_statistics() {
+        m_stats.reset();
+    }
+
 protected:
     virtual void set_cancel(bool f) {
         #pragma omp critical (aig_tactic)
@@ -0,0 +1,777 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_bit_blaster.cpp
+
+Abstract:
+
+    Bit-blaster that produces clauses for sat::solver directly.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Revision History:
+
+--*/
+#include<sstream>
+#include"sat_bit_blaster.h"
+#include"bv_decl_plugin.h"
+#include"bit_blaster_tpl_def.h"
+#include"hashtable.h"
+#include"hash.h"
+#include"tactic_exception.h"
+#include"common_msgs.h"
+#include"model.h"
+
+/**
+   \brief Gates and bits created by the sat bit-blaster. They are owned by
+   sat_bit_blaster::imp, and shared by the copies of sat_blaster_cfg.
+*/
+struct sat_blaster_state {
+    enum gate_kind {
+        AND_GATE,
+        XOR_GATE,
+        ITE_GATE,
+        MAJ_GATE
+    };
+
+    /**
+       \brief A gate is stored in m_gates at some offset o:
+       m_gates[o] is the kind, m_gates[o+1] is the number of arguments n,
+       m_gates[o+2 .. o+n+1] are the arguments, and m_gates[o+n+2] is the output literal.
+    */
+    struct gate_hash_proc {
+        unsigned_vector const & m_gates;
+        gate_hash_proc(unsigned_vector const & g):m_gates(g) {}
+        unsigned operator()(unsigned o) const {
+            return string_hash(reinterpret_cast<char const *>(m_gates.c_ptr() + o + 2),
+                               sizeof(unsigned) * m_gates[o+1], m_gates[o]);
+        }
+    };
+
+    struct gate_eq_proc {
+        unsigned_vector const & m_gates;
+        gate_eq_proc(unsigned_vector const & g):m_gates(g) {}
+        bool operator()(unsigned o1, unsigned o2) const {
+            unsigned n = m_gates[o1+1];
+            if (m_gates[o1] != m_gates[o2] || n != m_gates[o2+1])
+                return false;
+            for (unsigned i = 2; i < n + 2; i++)
+                if (m_gates[o1+i] != m_gates[o2+i])
+                    return false;
+            return true;
+        }
+    };
+
+    typedef hashtable<unsigned, gate_hash_proc, gate_eq_proc> gate_table;
+
+    unsigned_vector  m_gates;
+    gate_table       m_table;
+    expr_ref_vector  m_lit2bit;  // literal index -> var AST representing it, created on demand
+    unsigned         m_num_gates;
+    unsigned         m_num_shared_gates;
+
+    sat_blaster_state(ast_manager & m):
+        m_table(DEFAULT_HASHTABLE_INITIAL_CAPACITY, gate_hash_proc(m_gates), gate_eq_proc(m_gates)),
+        m_lit2bit(m),
+        m_num_gates(0),
+        m_num_shared_gates(0) {
+    }
+};
+
+/**
+   \brief Configuration for bit_blaster_tpl. A bit is true, false, or a var AST
+   whose index is the index of a SAT literal. The negation of a literal is
+   obtained by flipping the least significant bit of the index.
+   The configuration is copied by bit_blaster_tpl, so the gates live in a sat_blaster_state.
+*/
+struct sat_blaster_cfg {
+    typedef rational numeral;
+    typedef sat_blaster_state::gate_kind gate_kind;
+
+    ast_manager &       m_manager;
+    sat::solver &       m_solver;
+    sat_blaster_state & m_state;
+    bool                m_incremental;
+    sort *              m_bool;
+    unsigned_vector     m_args;
+
+    sat_blaster_cfg(ast_manager & m, sat::solver & s, sat_blaster_state & st, bool incremental):
+        m_manager(m),
+        m_solver(s),
+        m_state(st),
+        m_incremental(incremental),
+        m_bool(m.mk_bool_sort()) {
+    }
+
+    ast_manager & m() const { return m_manager; }
+    numeral power(unsigned n) const { return rational::power_of_two(n); }
+
+    /**
+       \brief Return the var AST of l. It is created once per literal, and then
+       retrieved from m_lit2bit without a lookup in the AST table.
+    */
+    expr * mk_bit(sat::literal l) {
+        expr_ref_vector & bits = m_state.m_lit2bit;
+        unsigned idx = l.index();
+        if (idx >= bits.size())
+            bits.resize(idx + 1);
+        expr * b = bits.get(idx);
+        if (b == 0) {
+            b = m_manager.mk_var(idx, m_bool);
+            bits.set(idx, b);
+        }
+        return b;
+    }
+
+    sat::literal get_literal(expr * a) const {
+        SASSERT(is_var(a));
+        return sat::to_literal(to_var(a)->get_idx());
+    }
+
+    sat::literal mk_fresh_literal() { return sat::literal(m_solver.mk_var(m_incremental), false); }
+
+    /**
+       \brief Return the output of the gate stored in m_args, create it if it does not exist.
+    */
+    sat::literal mk_gate(gate_kind k) {
+        unsigned_vector & gates = m_state.m_gates;
+        unsigned o = gates.size();
+        gates.push_back(k);
+        gates.push_back(m_args.size());
+        gates.append(m_args);
+        unsigned r;
+        if (m_state.m_table.find(o, r)) {
+            gates.shrink(o);
+            m_state.m_num_shared_gates++;
+            return sat::to_literal(gates[r + m_args.size() + 2]);
+        }
+        sat::literal out = mk_fresh_literal();
+        gates.push_back(out.index());
+        m_state.m_table.insert(o);
+        m_state.m_num_gates++;
+        mk_clauses(k, out);
+        return out;
+    }
+
+    /**
+       \brief Add the clauses defining the gate output o. They are not removed by user_pop,
+       since the gates are shared by all assertions.
+    */
+    void mk_clauses(gate_kind k, sat::literal o) {
+        unsigned n = m_args.size();
+        sat::literal_vector ls;
+        for (unsigned i = 0; i < n; i++)
+            ls.push_back(sat::to_literal(m_args[i]));
+        switch (k) {
+        case sat_blaster_state::AND_GATE: {
+            sat::literal_vector cls;
+            for (unsigned i = 0; i < n; i++) {
+                m_solver.mk_def_clause(~o, ls[i]);
+                cls.push_back(~ls[i]);
+            }
+            cls.push_back(o);
+            m_solver.mk_def_clause(cls.size(), cls.c_ptr());
+            break;
+        }
+        case sat_blaster_state::XOR_GATE:
+            m_solver.mk_def_clause(~ls[0], ~ls[1], ~o);
+            m_solver.mk_def_clause(ls[0], ls[1], ~o);
+            m_solver.mk_def_clause(~ls[0], ls[1], o);
+            m_solver.mk_def_clause(ls[0], ~ls[1], o);
+            break;
+        case sat_blaster_state::ITE_GATE:
+            m_solver.mk_def_clause(~ls[0], ~ls[1], o);
+            m_solver.mk_def_clause(~ls[0], ls[1], ~o);
+            m_solver.mk_def_clause(ls[0], ~ls[2], o);
+            m_solver.mk_def_clause(ls[0], ls[2], ~o);
+            // redundant, but they improve propagation
+            m_solver.mk_def_clause(~ls[1], ~ls[2], o);
+            m_solver.mk_def_clause(ls[1], ls[2], ~o);
+            break;
+        case sat_blaster_state::MAJ_GATE:
+            m_solver.mk_def_clause(~ls[0], ~ls[1], o);
+            m_solver.mk_def_clause(~ls[0], ~ls[2], o);
+            m_solver.mk_def_clause(~ls[1], ~ls[2], o);
+            m_solver.mk_def_clause(ls[0], ls[1], ~o);
+            m_solver.mk_def_clause(ls[0], ls[2], ~o);
+            m_solver.mk_def_clause(ls[1], ls[2], ~o);
+            break;
+        }
+    }
+
+    void mk_not(expr * a, expr_ref & r) {
+        if (m_manager.is_true(a))
+            r = m_manager.mk_false();
+        else if (m_manager.is_false(a))
+            r = m_manager.mk_true();
+        else
+            r = mk_bit(~get_literal(a));
+    }
+
+    void mk_and(unsigned sz, expr * const * args, expr_ref & r) {
+        m_args.reset();
+        for (unsigned i = 0; i < sz; i++) {
+            if (m_manager.is_false(args[i])) {
+                r = m_manager.mk_false();
+                return;
+            }
+            if (!m_manager.is_true(args[i]))
+                m_args.push_back(get_literal(args[i]).index());
+        }
+        std::sort(m_args.begin(), m_args.end());
+        // remove duplicates, and detect complementary literals (they are adjacent after sorting).
+        unsigned j = 0;
+        for (unsigned i = 0; i < m_args.size(); i++) {
+            if (j > 0 && m_args[j-1] == m_args[i])
+                continue;
+            if (j > 0 && m_args[j-1] == (m_args[i] ^ 1)) {
+                r = m_manager.mk_false();
+                return;
+            }
+            m_args[j++] = m_args[i];
+        }
+        m_args.shrink(j);
+        if (j == 0)
+            r = m_manager.mk_true();
+        else if (j == 1)
+            r = mk_bit(sat::to_literal(m_args[0]));
+        else
+            r = mk_bit(mk_gate(sat_blaster_state::AND_GATE));
+    }
+
+    void mk_and(expr * a, expr * b, expr_ref & r) {
+        expr * args[2] = { a, b };
+        mk_and(2, args, r);
+    }
+
+    void mk_and(expr * a, expr * b, expr * c, expr_ref & r) {
+        expr * args[3] = { a, b, c };
+        mk_and(3, args, r);
+    }
+
+    void mk_or(unsigned sz, expr * const * args, expr_ref & r) {
+        expr_ref_vector new_args(m_manager);
+        expr_ref tmp(m_manager);
+        for (unsigned i = 0; i < sz; i++) {
+            mk_not(args[i], tmp);
+            new_args.push_back(tmp);
+        }
+        mk_and(new_args.size(), new_args.c_ptr(), tmp);
+        mk_not(tmp, r);
+    }
+
+    void mk_or(expr * a, expr * b, expr_ref & r) {
+        expr * args[2] = { a, b };
+        mk_or(2, args, r);
+    }
+
+    void mk_or(expr * a, expr * b, expr * c, expr_ref & r) {
+        expr * args[3] = { a, b, c };
+        mk_or(3, args, r);
+    }
+
+    void mk_nand(expr * a, expr * b, expr_ref & r) {
+        expr_ref tmp(m_manager);
+        mk_and(a, b, tmp);
+        mk_not(tmp, r);
+    }
+
+    void mk_nor(expr * a, expr * b, expr_ref & r) {
+        expr_ref tmp(m_manager);
+        mk_or(a, b, tmp);
+        mk_not(tmp, r);
+    }
+
+    void mk_xor(expr * a, expr * b, expr_ref & r) {
+        if (m_manager.is_false(a)) { r = b; return; }
+        if (m_manager.is_false(b)) { r = a; return; }
+        if (m_manager.is_true(a))  { mk_not(b, r); return; }
+        if (m_manager.is_true(b))  { mk_not(a, r); return; }
+        sat::literal la = get_literal(a);
+        sat::literal lb = get_literal(b);
+        // xor(~a, b) = ~xor(a, b)
+        bool sign       = la.sign() != lb.sign();
+        if (la.var() == lb.var()) {
+            r = sign ? m_manager.mk_true() : m_manager.mk_false();
+            return;
+        }
+        la = sat::literal(la.var(), false);
+        lb = sat::literal(lb.var(), false);
+        if (lb.index() < la.index())
+            std::swap(la, lb);
+        m_args.reset();
+        m_args.push_back(la.index());
+        m_args.push_back(lb.index());
+        sat::literal o = mk_gate(sat_blaster_state::XOR_GATE);
+        r = mk_bit(sign ? ~o : o);
+    }
+
+    void mk_xor3(expr * a, expr * b, expr * c, expr_ref & r) {
+        expr_ref tmp(m_manager);
+        mk_xor(b, c, tmp);
+        mk_xor(a, tmp, r);
+    }
+
+    void mk_iff(expr * a, expr * b, expr_ref & r) {
+        expr_ref tmp(m_manager);
+        mk_xor(a, b, tmp);
+        mk_not(tmp, r);
+    }
+
+    void mk_ite(expr * c, expr * t, expr * e, expr_ref & r) {
+        if (m_manager.is_true(c))  { r = t; return; }
+        if (m_manager.is_false(c)) { r = e; return; }
+        if (t == e)                { r = t; return; }
+        expr_ref not_c(m_manager);
+        mk_not(c, not_c);
+        if (m_manager.is_true(t))  { mk_or(c, e, r); return; }
+        if (m_manager.is_false(t)) { mk_and(not_c, e, r); return; }
+        if (m_manager.is_true(e))  { mk_or(not_c, t, r); return; }
+        if (m_manager.is_false(e)) { mk_and(c, t, r); return; }
+        sat::literal lc = get_literal(c);
+        sat::literal lt = get_literal(t);
+        sat::literal le = get_literal(e);
+        if (lt == ~le) { mk_iff(c, t, r); return; }
+        if (lt == lc)  { mk_or(c, e, r); return; }
+        if (lt == ~lc) { mk_and(not_c, e, r); return; }
+        if (le == lc)  { mk_and(c, t, r); return; }
+        if (le == ~lc) { mk_or(not_c, t, r); return; }
+        if (lc.sign()) {
+            // ite(~c, t, e) = ite(c, e, t)
+            lc = ~lc;
+            std::swap(lt, le);
+        }
+        m_args.reset();
+        m_args.push_back(lc.index());
+        m_args.push_back(lt.index());
+        m_args.push_back(le.index());
+        r = mk_bit(mk_gate(sat_blaster_state::ITE_GATE));
+    }
+
+    void mk_carry(expr * a, expr * b, expr * c, expr_ref & r) {
+        expr * args[3] = { a, b, c };
+        for (unsigned i = 0; i < 3; i++) {
+            expr * x = args[(i+1)%3];
+            expr * y = args[(i+2)%3];
+            if (m_manager.is_true(args[i]))  { mk_or(x, y, r); return; }
+            if (m_manager.is_false(args[i])) { mk_and(x, y, r); return; }
+        }
+        m_args.reset();
+        for (unsigned i = 0; i < 3; i++)
+            m_args.push_back(get_literal(args[i]).index());
+        std::sort(m_args.begin(), m_args.end());
+        for (unsigned i = 0; i < 2; i++) {
+            if (m_args[i] == m_args[i+1]) { r = mk_bit(sat::to_literal(m_args[i])); return; }
+            if (m_args[i] == (m_args[i+1] ^ 1)) { r = mk_bit(sat::to_literal(m_args[2 - 2*i])); return; }
+        }
+        r = mk_bit(mk_gate(sat_blaster_state::MAJ_GATE));
+    }
+};
+
+class sat_blaster : public bit_blaster_tpl<sat_blaster_cfg> {
+public:
+    typedef void (bit_blaster_tpl<sat_blaster_cfg>::*bin_op)(unsigned, expr * const *, expr * const *, expr_ref_vector &);
+
+    sat_blaster(ast_manager & m, sat::solver & s, sat_blaster_state & st, bool incremental):
+        bit_blaster_tpl<sat_blaster_cfg>(sat_blaster_cfg(m, s, st, incremental)) {
+    }
+
+    unsigned get_num_gates() const { return m_state.m_num_gates; }
+    unsigned get_num_shared_gates() const { return m_state.m_num_shared_gates; }
+};
+
+struct sat_bit_blaster::imp {
+    ast_manager &      m;
+    sat::solver &      m_solver;
+    bv_util            m_util;
+    sat_blaster_state  m_state;
+    sat_blaster        m_blaster;
+    obj_map<expr, unsigned> m_cache; // term -> position of its bits in m_bits
+    expr_ref_vector    m_bits;
+    expr_ref_vector    m_trail;      // keep the keys of m_cache alive
+    expr_ref_vector    m_in1;
+    expr_ref_vector    m_in2;
+    expr_ref_vector    m_out;
+    ptr_vector<expr>   m_todo;
+    sat::literal       m_true;       // literal used to represent the constant true in mk_literal
+    volatile bool      m_cancel;
+
+    imp(ast_manager & _m, sat::solver & s, bool incremental):
+        m(_m),
+        m_solver(s),
+        m_util(_m),
+        m_state(_m),
+        m_blaster(_m, s, m_state, incremental),
+        m_bits(_m),
+        m_trail(_m),
+        m_in1(_m),
+        m_in2(_m),
+        m_out(_m),
+        m_true(sat::null_literal),
+        m_cancel(false) {
+    }
+
+    void set_cancel(bool f) {
+        m_cancel = f;
+        m_blaster.set_cancel(f);
+    }
+
+    void throw_unsupported(app * t) {
+        std::ostringstream buffer;
+        buffer << "operator is not supported by the sat bit-blaster: " << t->get_decl()->get_name();
+        throw tactic_exception(buffer.str().c_str());
+    }
+
+    unsigned get_num_bits(expr * t) {
+        return m.is_bool(t) ? 1 : m_util.get_bv_size(t);
+    }
+
+    void get_bits(expr * t, expr_ref_vector & out) {
+        unsigned pos = 0;
+        VERIFY(m_cache.find(t, pos));
+        out.reset();
+        unsigned sz = get_num_bits(t);
+        for (unsigned i = 0; i < sz; i++)
+            out.push_back(m_bits.get(pos + i));
+    }
+
+    expr * get_bit(expr * t) {
+        unsigned pos = 0;
+        VERIFY(m_cache.find(t, pos));
+        return m_bits.get(pos);
+    }
+
+    void mk_fresh_bits(unsigned sz) {
+        for (unsigned i = 0; i < sz; i++)
+            m_out.push_back(m_blaster.mk_bit(m_blaster.mk_fresh_literal()));
+    }
+
+    /**
+       \brief Apply a binary bit-blaster operation to the arguments of t from left to right.
+    */
+    void fold(app * t, sat_blaster::bin_op op) {
+        get_bits(t->get_arg(0), m_out);
+        for (unsigned i = 1; i < t->get_num_args(); i++) {
+            m_in1.reset();
+            m_in1.append(m_out);
+            get_bits(t->get_arg(i), m_in2);
+            m_out.reset();
+            (m_blaster.*op)(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), m_out);
+        }
+    }
+
+    void get_bin_args(app * t) {
+        SASSERT(t->get_num_args() == 2);
+        get_bits(t->get_arg(0), m_in1);
+        get_bits(t->get_arg(1), m_in2);
+    }
+
+    void blast_bool(app * t) {
+        expr_ref r(m);
+        unsigned num = t->get_num_args();
+        ptr_buffer<expr> args;
+        for (unsigned i = 0; i < num; i++)
+            if (m.is_bool(t->get_arg(i)))
+                args.push_back(get_bit(t->get_arg(i)));
+        if (t->get_family_id() == m.get_basic_family_id()) {
+            switch (t->get_decl_kind()) {
+            case OP_TRUE:    r = m.mk_true(); break;
+            case OP_FALSE:   r = m.mk_false(); break;
+            case OP_NOT:     m_blaster.mk_not(args[0], r); break;
+            case OP_AND:     m_blaster.mk_and(num, args.c_ptr(), r); break;
+            case OP_OR:      m_blaster.mk_or(num, args.c_ptr(), r); break;
+            case OP_IFF:     m_blaster.mk_iff(args[0], args[1], r); break;
+            case OP_XOR:     m_blaster.mk_xor(args[0], args[1], r); break;
+            case OP_IMPLIES: {
+                expr_ref not_a(m);
+                m_blaster.mk_not(args[0], not_a);
+                m_blaster.mk_or(not_a, args[1], r);
+                break;
+            }
+            case OP_ITE:
+                if (!m.is_bool(t->get_arg(1)))
+                    throw_unsupported(t);
+                m_blaster.mk_ite(args[0], args[1], args[2], r);
+                break;
+            case OP_EQ:
+                if (m.is_bool(t->get_arg(0))) {
+                    m_blaster.mk_iff(args[0], args[1], r);
+                }
+                else {
+                    get_bin_args(t);
+                    m_blaster.mk_eq(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), r);
+                }
+                break;
+            default:
+                throw_unsupported(t);
+            }
+        }
+        else if (t->get_family_id() == m_util.get_family_id()) {
+            switch (t->get_decl_kind()) {
+            case OP_ULEQ: get_bin_args(t); m_blaster.mk_ule(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), r); break;
+            case OP_SLEQ: get_bin_args(t); m_blaster.mk_sle(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), r); break;
+            case OP_UGEQ: get_bin_args(t); m_blaster.mk_ule(m_in1.size(), m_in2.c_ptr(), m_in1.c_ptr(), r); break;
+            case OP_SGEQ: get_bin_args(t); m_blaster.mk_sle(m_in1.size(), m_in2.c_ptr(), m_in1.c_ptr(), r); break;
+            case OP_ULT:  get_bin_args(t); m_blaster.mk_ule(m_in1.size(), m_in2.c_ptr(), m_in1.c_ptr(), r); m_blaster.mk_not(r, r); break;
+            case OP_SLT:  get_bin_args(t); m_blaster.mk_sle(m_in1.size(), m_in2.c_ptr(), m_in1.c_ptr(), r); m_blaster.mk_not(r, r); break;
+            case OP_UGT:  get_bin_args(t); m_blaster.mk_ule(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), r); m_blaster.mk_not(r, r); break;
+            case OP_SGT:  get_bin_args(t); m_blaster.mk_sle(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), r); m_blaster.mk_not(r, r); break;
+            case OP_BUMUL_NO_OVFL: get_bin_args(t); m_blaster.mk_umul_no_overflow(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), r); break;
+            case OP_BSMUL_NO_OVFL: get_bin_args(t); m_blaster.mk_smul_no_overflow(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), r); break;
+            case OP_BSMUL_NO_UDFL: get_bin_args(t); m_blaster.mk_smul_no_underflow(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), r); break;
+            default:
+                throw_unsupported(t);
+            }
+        }
+        else if (num == 0 && t->get_family_id() == null_family_id) {
+            r = m_blaster.mk_bit(m_blaster.mk_fresh_literal());
+        }
+        else {
+            throw_unsupported(t);
+        }
+        m_out.reset();
+        m_out.push_back(r);
+    }
+
+    void blast_bv(app * t) {
+        m_out.reset();
+        if (t->get_num_args() == 0 && t->get_family_id() == null_family_id) {
+            mk_fresh_bits(m_util.get_bv_size(t));
+            return;
+        }
+        if (m.is_ite(t)) {
+            get_bits(t->get_arg(1), m_in1);
+            get_bits(t->get_arg(2), m_in2);
+            m_blaster.mk_multiplexer(get_bit(t->get_arg(0)), m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), m_out);
+            return;
+        }
+        if (t->get_family_id() != m_util.get_family_id())
+            throw_unsupported(t);
+        rational val;
+        unsigned sz;
+        switch (t->get_decl_kind()) {
+        case OP_BV_NUM:
+            VERIFY(m_util.is_numeral(t, val, sz));
+            m_blaster.num2bits(val, sz, m_out);
+            break;
+        case OP_BADD: fold(t, &bit_blaster_tpl<sat_blaster_cfg>::mk_adder); break;
+        case OP_BMUL: fold(t, &bit_blaster_tpl<sat_blaster_cfg>::mk_multiplier); break;
+        case OP_BAND: fold(t, &bit_blaster_tpl<sat_blaster_cfg>::mk_and); break;
+        case OP_BOR:  fold(t, &bit_blaster_tpl<sat_blaster_cfg>::mk_or); break;
+        case OP_BXOR: fold(t, &bit_blaster_tpl<sat_blaster_cfg>::mk_xor); break;
+        case OP_BSUB: {
+            expr_ref cout(m);
+            get_bin_args(t);
+            m_blaster.mk_subtracter(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), m_out, cout);
+            break;
+        }
+        case OP_BNEG:
+            get_bits(t->get_arg(0), m_in1);
+            m_blaster.mk_neg(m_in1.size(), m_in1.c_ptr(), m_out);
+            break;
+        case OP_BNOT:
+            get_bits(t->get_arg(0), m_in1);
+            m_blaster.mk_not(m_in1.size(), m_in1.c_ptr(), m_out);
+            break;
+        case OP_BUDIV_I: get_bin_args(t); m_blaster.mk_udiv(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), m_out); break;
+        case OP_BUREM_I: get_bin_args(t); m_blaster.mk_urem(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), m_out); break;
+        case OP_BSDIV_I: get_bin_args(t); m_blaster.mk_sdiv(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), m_out); break;
+        case OP_BSREM_I: get_bin_args(t); m_blaster.mk_srem(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), m_out); break;
+        case OP_BSMOD_I: get_bin_args(t); m_blaster.mk_smod(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), m_out); break;
+        case OP_BSHL:    get_bin_args(t); m_blaster.mk_shl(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), m_out); break;
+        case OP_BLSHR:   get_bin_args(t); m_blaster.mk_lshr(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), m_out); break;
+        case OP_BASHR:   get_bin_args(t); m_blaster.mk_ashr(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), m_out); break;
+        case OP_EXT_ROTATE_LEFT:  get_bin_args(t); m_blaster.mk_ext_rotate_left(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), m_out); break;
+        case OP_EXT_ROTATE_RIGHT: get_bin_args(t); m_blaster.mk_ext_rotate_right(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), m_out); break;
+        case OP_BCOMP:   get_bin_args(t); m_blaster.mk_comp(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), m_out); break;
+        case OP_BREDOR:
+            get_bits(t->get_arg(0), m_in1);
+            m_blaster.mk_redor(m_in1.size(), m_in1.c_ptr(), m_out);
+            break;
+        case OP_BREDAND:
+            get_bits(t->get_arg(0), m_in1);
+            m_blaster.mk_redand(m_in1.size(), m_in1.c_ptr(), m_out);
+            break;
+        case OP_CONCAT: {
+            // the first argument contains the most significant bits
+            unsigned i = t->get_num_args();
+            while (i > 0) {
+                --i;
+                get_bits(t->get_arg(i), m_in1);
+                m_out.append(m_in1);
+            }
+            break;
+        }
+        case OP_EXTRACT: {
+            unsigned high = m_util.get_extract_high(t);
+            unsigned low  = m_util.get_extract_low(t);
+            get_bits(t->get_arg(0), m_in1);
+            for (unsigned i = low; i <= high; i++)
+                m_out.push_back(m_in1.get(i));
+            break;
+        }
+        case OP_ZERO_EXT:
+            get_bits(t->get_arg(0), m_in1);
+            m_blaster.mk_zero_extend(m_in1.size(), m_in1.c_ptr(), t->get_decl()->get_parameter(0).get_int(), m_out);
+            break;
+        case OP_SIGN_EXT:
+            get_bits(t->get_arg(0), m_in1);
+            m_blaster.mk_sign_extend(m_in1.size(), m_in1.c_ptr(), t->get_decl()->get_parameter(0).get_int(), m_out);
+            break;
+        case OP_ROTATE_LEFT:
+            get_bits(t->get_arg(0), m_in1);
+            m_blaster.mk_rotate_left(m_in1.size(), m_in1.c_ptr(), t->get_decl()->get_parameter(0).get_int(), m_out);
+            break;
+        case OP_ROTATE_RIGHT:
+            get_bits(t->get_arg(0), m_in1);
+            m_blaster.mk_rotate_right(m_in1.size(), m_in1.c_ptr(), t->get_decl()->get_parameter(0).get_int(), m_out);
+            break;
+        default:
+            // bvudiv, bvsdiv, ... must be simplified into the *_i variants
+            throw_unsupported(t);
+        }
+    }
+
+    void blast(app * t) {
+        if (m.is_bool(t))
+            blast_bool(t);
+        else if (m_util.is_bv(t))
+            blast_bv(t);
+        else
+            throw_unsupported(t);
+        SASSERT(m_out.size() == get_num_bits(t));
+        m_cache.insert(t, m_bits.size());
+        m_trail.push_back(t);
+        m_bits.append(m_out);
+    }
+
+    void visit(expr * root) {
+        m_todo.reset();
+        m_todo.push_back(root);
+        while (!m_todo.empty()) {
+            if (m_cancel)
+                throw tactic_exception(TACTIC_CANCELED_MSG);
+            expr * t = m_todo.back();
+            if (m_cache.contains(t)) {
+                m_todo.pop_back();
+                continue;
+            }
+            if (!is_app(t))
+                throw tactic_exception("quantifiers and free variables are not supported by the sat bit-blaster");
+            bool visited = true;
+            unsigned num = to_app(t)->get_num_args();
+            for (unsigned i = 0; i < num; i++) {
+                expr * arg = to_app(t)->get_arg(i);
+                if (!m_cache.contains(arg)) {
+                    m_todo.push_back(arg);
+                    visited = false;
+                }
+            }
+            if (visited) {
+                m_todo.pop_back();
+                blast(to_app(t));
+            }
+        }
+    }
+
+    void assert_expr(expr * f) {
+        visit(f);
+        expr * b = get_bit(f);
+        if (m.is_true(b))
+            return;
+        if (m.is_false(b)) {
+            m_solver.mk_clause(0, 0);
+            return;
+        }
+        sat::literal l = m_blaster.get_literal(b);
+        m_solver.mk_clause(1, &l);
+    }
+
+    sat::literal mk_true() {
+        if (m_true == sat::null_literal) {
+            m_true = m_blaster.mk_fresh_literal();
+            sat::literal l = m_true;
+            m_solver.mk_def_clause(1, &l);
+        }
+        return m_true;
+    }
+
+    sat::literal mk_literal(expr * f) {
+        visit(f);
+        expr * b = get_bit(f);
+        if (m.is_true(b))
+            return mk_true();
+        if (m.is_false(b))
+            return ~mk_true();
+        return m_blaster.get_literal(b);
+    }
+
+    bool eval(expr * t, rational & r) {
+        unsigned pos = 0;
+        if (!m_cache.find(t, pos))
+            return false;
+        r.reset();
+        unsigned sz = get_num_bits(t);
+        for (unsigned i = 0; i < sz; i++) {
+            expr * b = m_bits.get(pos + i);
+            if (m.is_true(b) || (is_var(b) && sat::value_at(m_blaster.get_literal(b), m_solver.get_model()) == l_true))
+                r += rational::power_of_two(i);
+        }
+        return true;
+    }
+
+    void mk_model(model & md) {
+        rational val;
+        for (unsigned i = 0; i < m_trail.size(); i++) {
+            app * t = to_app(m_trail.get(i));
+            if (t->get_num_args() != 0 || t->get_family_id() != null_family_id)
+                continue;
+            VERIFY(eval(t, val));
+            if (m.is_bool(t))
+                md.register_decl(t->get_decl(), val.is_zero() ? m.mk_false() : m.mk_true());
+            else
+                md.register_decl(t->get_decl(), m_util.mk_numeral(val, m_util.get_bv_size(t)));
+        }
+    }
+
+    void collect_statistics(statistics & st) const {
+        st.update("sat bb gates", m_blaster.get_num_gates());
+        st.update("sat bb shared gates", m_blaster.get_num_shared_gates());
+    }
+};
+
+sat_bit_blaster::sat_bit_blaster(ast_manager & m, sat::solver & s, bool incremental) {
+    m_imp = alloc(imp, m, s, incremental);
+}
+
+sat_bit_blaster::~sat_bit_blaster() {
+    dealloc(m_imp);
+}
+
+void sat_bit_blaster::assert_expr(expr * f) {
+    m_imp->assert_expr(f);
+}
+
+sat::literal sat_bit_blaster::mk_literal(expr * f) {
+    return m_imp->mk_literal(f);
+}
+
+void sat_bit_blaster::mk_model(model & md) const {
+    m_imp->mk_model(md);
+}
+
+bool sat_bit_blaster::eval(expr * t, rational & r) const {
+    return m_imp->eval(t, r);
+}
+
+void sat_bit_blaster::set_cancel(bool f) {
+    m_imp->set_cancel(f);
+}
+
+void sat_bit_blaster::collect_statistics(statistics & st) const {
+    m_imp->collect_statistics(st);
+}
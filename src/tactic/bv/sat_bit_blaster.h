@@ -0,0 +1,89 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_bit_blaster.h
+
+Abstract:
+
+    Bit-blaster that produces clauses for sat::solver directly.
+
+    The gates created by bit_blaster_tpl are not represented as Boolean
+    ASTs. Each gate is a SAT variable, and gates are shared using a
+    structural hash table. The bits manipulated by bit_blaster_tpl are
+    the constants true and false, and de Bruijn variables (var ASTs)
+    whose index is the index of a SAT literal.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Revision History:
+
+--*/
+#ifndef _SAT_BIT_BLASTER_H_
+#define _SAT_BIT_BLASTER_H_
+
+#include"ast.h"
+#include"sat_solver.h"
+#include"statistics.h"
+
+class model;
+
+class sat_bit_blaster {
+    struct imp;
+    imp *  m_imp;
+public:
+    /**
+       \brief If \c incremental is true, all variables created by the bit-blaster
+       are external. So, formulas can be asserted and literals created after
+       the SAT solver was invoked.
+    */
+    sat_bit_blaster(ast_manager & m, sat::solver & s, bool incremental = false);
+
+    ~sat_bit_blaster();
+
+    /**
+       \brief Bit-blast the Boolean formula \c f and assert it in the SAT solver.
+
+       \c f must be a quantifier free formula over Booleans and bit-vectors.
+       As in bit_blaster_rewriter, the bit-vector operators must be simplified
+       (e.g., bvudiv must be replaced with bvudiv_i).
+
+       \warning Throws a tactic_exception if an unsupported operator is found,
+       or the bit-blaster is interrupted using set_cancel.
+
+       The assertion is scoped by the user scopes of the SAT solver. The clauses
+       defining the gates are not, so they can be shared by later assertions.
+
+       \warning In non incremental mode, the gate variables are not external, so formulas
+       must not be asserted after the SAT solver was invoked (it may eliminate them).
+    */
+    void assert_expr(expr * f);
+
+    /**
+       \brief Bit-blast the Boolean formula \c f, and return a literal equivalent to it.
+       The literal can be used as an assumption.
+    */
+    sat::literal mk_literal(expr * f);
+
+    /**
+       \brief Store in \c md the values of the Boolean and bit-vector constants
+       bit-blasted so far in the model produced by the SAT solver.
+    */
+    void mk_model(model & md) const;
+
+    /**
+       \brief Store in \c r the value of the bit-vector (or Boolean) term \c t
+       in the model produced by the SAT solver. Return false if \c t was not
+       bit-blasted.
+    */
+    bool eval(expr * t, rational & r) const;
+
+    void set_cancel(bool f);
+
+    void collect_statistics(statistics & st) const;
+};
+
+#endif
@@ -19,16 +19,29 @@ Notes:
 #include"simplify_tactic.h"
 #include"th_rewriter.h"
 #include"ast_smt2_pp.h"
+#include"rewriter_cache.h"
+#include"rewriter_params.hpp"
 
 struct simplify_tactic::imp {
     ast_manager &   m_manager;
     th_rewriter     m_r;
     unsigned        m_num_steps;
+    unsigned        m_shared_cache_size;
+    unsigned        m_num_cache_hits;
+    unsigned        m_num_cache_misses;
 
     imp(ast_manager & m, params_ref const & p):
         m_manager(m),
         m_r(m, p),
-        m_num_steps(0) {
+        m_num_steps(0),
+        m_num_cache_hits(0),
+        m_num_cache_misses(0) {
+        updt_params(p);
+    }
+
+    void updt_params(params_ref const & p) {
+        m_r.updt_params(p);
+        m_shared_cache_size = rewriter_params(p).shared_cache_size();
     }
 
     ast_manager & m() const { return m_manager; }
@@ -49,6 +62,13 @@ struct simplify_tactic::imp {
         m_num_steps = 0;
         if (g.inconsistent())
             return;
+        rewriter_cache * c = 0;
+        if (m_shared_cache_size > 0 && !g.proofs_enabled()) {
+            if (g.rw_cache() == 0)
+                g.set_rw_cache(alloc(rewriter_cache, m(), m_shared_cache_size));
+            c = g.rw_cache();
+        }
+        scoped_shared_cache s(*this, c);
         expr_ref   new_curr(m());
         proof_ref  new_pr(m());
         unsigned size = g.size();
@@ -72,10 +92,37 @@ struct simplify_tactic::imp {
     }
 
     unsigned get_num_steps() const { return m_num_steps; }
+
+    /**
+       \brief Attach the shared cache of a goal to m_r, and record how many hits
+       and misses happened while it was attached.
+    */
+    struct scoped_shared_cache {
+        imp &            m_owner;
+        rewriter_cache * m_cache;
+        unsigned         m_old_hits;
+        unsigned         m_old_misses;
+        scoped_shared_cache(imp & o, rewriter_cache * c):m_owner(o), m_cache(c) {
+            if (c) {
+                m_old_hits   = c->hits();
+                m_old_misses = c->misses();
+                o.m_r.set_shared_cache(c);
+            }
+        }
+        ~scoped_shared_cache() {
+            if (m_cache) {
+                m_owner.m_r.set_shared_cache(0);
+                m_owner.m_num_cache_hits   += m_cache->hits() - m_old_hits;
+                m_owner.m_num_cache_misses += m_cache->misses() - m_old_misses;
+            }
+        }
+    };
 };
 
 simplify_tactic::simplify_tactic(ast_manager & m, params_ref const & p):
-    m_params(p) {
+    m_params(p),
+    m_num_cache_hits(0),
+    m_num_cache_misses(0) {
     m_imp = alloc(imp, m, p);
 }
 
@@ -85,7 +132,7 @@ simplify_tactic::~simplify_tactic() {
 
 void simplify_tactic::updt_params(params_ref const & p) {
     m_params = p;
-    m_imp->m_r.updt_params(p);
+    m_imp->updt_params(p);
 }
 
 void simplify_tactic::get_param_descrs(param_descrs & r) {
@@ -99,15 +146,36 @@ void simplify_tactic::operator()(goal_ref const & in,
                                  expr_dependency_ref & core) {
     try {
         (*m_imp)(*(in.get()));
+        collect_cache_statistics();
         in->inc_depth();
         result.push_back(in.get());
         mc = 0; pc = 0; core = 0;
     }
     catch (rewriter_exception & ex) {
+        collect_cache_statistics();
         throw tactic_exception(ex.msg());
     }
 }
 
+void simplify_tactic::collect_cache_statistics() {
+    m_num_cache_hits   += m_imp->m_num_cache_hits;
+    m_num_cache_misses += m_imp->m_num_cache_misses;
+    m_imp->m_num_cache_hits   = 0;
+    m_imp->m_num_cache_misses = 0;
+}
+
+void simplify_tactic::collect_statistics(statistics & st) const {
+    if (m_num_cache_hits + m_num_cache_misses > 0) {
+        st.update("simplifier cache hits", m_num_cache_hits);
+        st.update("simplifier cache misses", m_num_cache_misses);
+    }
+}
+
+void simplify_tactic::reset_statistics() {
+    m_num_cache_hits   = 0;
+    m_num_cache_misses = 0;
+}
+
 void simplify_tactic::set_cancel(bool f) {
     if (m_imp)
         m_imp->set_cancel(f);
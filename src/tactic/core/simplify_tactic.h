@@ -26,6 +26,9 @@ class simplify_tactic : public tactic {
     struct     imp;
     imp *      m_imp;
     params_ref m_params;
+    unsigned   m_num_cache_hits;
+    unsigned   m_num_cache_misses;
+    void collect_cache_statistics();
 public:
     simplify_tactic(ast_manager & m, params_ref const & ref = params_ref());
     virtual ~simplify_tactic();
@@ -41,6 +44,8 @@ public:
                             expr_dependency_ref & core);
     
     virtual void cleanup();
+    virtual void collect_statistics(statistics & st) const;
+    virtual void reset_statistics();
 
     unsigned get_num_steps() const;
 
@@ -70,7 +70,8 @@ goal::goal(goal const & src):
     m_proofs_enabled(src.proofs_enabled()), 
     m_core_enabled(src.unsat_core_enabled()), 
     m_inconsistent(false), 
-    m_precision(PRECISE) {
+    m_precision(PRECISE),
+    m_rw_cache(src.m_rw_cache) {
     copy_from(src);
     }
 
@@ -84,7 +85,8 @@ goal::goal(goal const & src, bool):
     m_proofs_enabled(src.proofs_enabled()), 
     m_core_enabled(src.unsat_core_enabled()), 
     m_inconsistent(false), 
-    m_precision(src.m_precision) {
+    m_precision(src.m_precision),
+    m_rw_cache(src.m_rw_cache) {
 }
     
 goal::~goal() { 
@@ -35,6 +35,7 @@ Revision History:
 #include"ref.h"
 #include"ref_vector.h"
 #include"ref_buffer.h"
+#include"rewriter_cache.h"
 
 class goal {
 public:
@@ -60,6 +61,8 @@ protected:
     unsigned              m_core_enabled:1;    // unsat core extraction is enabled.
     unsigned              m_inconsistent:1;    // true if the goal is known to be inconsistent. 
     unsigned              m_precision:2;       // PRECISE, UNDER, OVER.
+    // rewriting cache shared by the tactics processing this goal and the goals derived from it.
+    ref<rewriter_cache>   m_rw_cache;
 
     void push_back(expr * f, proof * pr, expr_dependency * d);
     void quick_process(bool save_first, expr * & f, expr_dependency * d);
@@ -98,6 +101,9 @@ public:
     void set_prec(precision d) { m_precision = d; }
     void updt_prec(precision d) { m_precision = mk_union(prec(), d); }
 
+    rewriter_cache * rw_cache() const { return m_rw_cache.get(); }
+    void set_rw_cache(rewriter_cache * c) { m_rw_cache = c; }
+
     void reset_all(); // reset goal and precision and depth attributes.
     void reset(); // reset goal but preserve precision and depth attributes.
 
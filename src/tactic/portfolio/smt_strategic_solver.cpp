@@ -36,6 +36,8 @@ Notes:
 #include"qffpa_tactic.h"
 #include"horn_tactic.h"
 #include"smt_solver.h"
+#include"inc_sat_solver.h"
+#include"combined_solver_params.hpp"
 
 tactic * mk_tactic_for_logic(ast_manager & m, params_ref const & p, symbol const & logic) {
     if (logic=="QF_UF")
@@ -88,6 +90,13 @@ tactic * mk_tactic_for_logic(ast_manager & m, params_ref const & p, symbol const
         return mk_default_tactic(m, p);
 }
 
+static solver * mk_solver_for_logic(ast_manager & m, params_ref const & p, symbol const & logic, bool proofs_enabled) {
+    // the SAT solver does not produce proofs.
+    if (logic == "QF_BV" && !proofs_enabled && combined_solver_params(p).solver2_sat())
+        return mk_inc_sat_solver(m, p);
+    return mk_smt_solver(m, p, logic);
+}
+
 class smt_strategic_solver_factory : public solver_factory {
     symbol m_logic;
 public:
@@ -102,7 +111,7 @@ public:
             l = logic;
         tactic * t = mk_tactic_for_logic(m, p, l);
         return mk_combined_solver(mk_tactic2solver(m, t, p, proofs_enabled, models_enabled, unsat_core_enabled, l),
-                                  mk_smt_solver(m, p, l),
+                                  mk_solver_for_logic(m, p, l, proofs_enabled),
                                   p);
     }
 };
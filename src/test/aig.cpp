@@ -0,0 +1,95 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    aig.cpp
+
+Abstract:
+
+    Test cut based rewriting and FRAIG sweeping in aig_manager.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Revision History:
+
+--*/
+#include<iostream>
+#include"aig.h"
+#include"smt_context.h"
+#include"reg_decl_plugins.h"
+#include"statistics.h"
+#include"util.h"
+#include"test_util.h"
+
+static expr * mk_random_formula(ast_manager & m, app_ref_vector const & vars, random_gen & r, unsigned depth) {
+    if (depth == 0 || r(5) == 0) {
+        expr * v = vars.get(r(vars.size()));
+        return r(2) == 0 ? m.mk_not(v) : v;
+    }
+    expr * a = mk_random_formula(m, vars, r, depth - 1);
+    expr * b = mk_random_formula(m, vars, r, depth - 1);
+    switch (r(6)) {
+    case 0:  return m.mk_and(a, b);
+    case 1:  return m.mk_or(a, b);
+    case 2:  return m.mk_iff(a, b);
+    case 3:  return m.mk_ite(mk_random_formula(m, vars, r, depth - 1), a, b);
+    case 4:  {
+        // (a and b) or (a and c): redundant structure for rewriting
+        expr * c = mk_random_formula(m, vars, r, depth - 1);
+        return m.mk_or(m.mk_and(a, b), m.mk_and(a, c));
+    }
+    default: {
+        // equivalent sub-circuits encoded differently for fraig
+        return m.mk_and(m.mk_or(a, b), m.mk_not(m.mk_and(m.mk_not(a), m.mk_not(b))));
+    }
+    }
+}
+
+static bool is_equiv(ast_manager & m, expr * f1, expr * f2) {
+    smt_params p;
+    smt::context ctx(m, p);
+    ctx.assert_expr(m.mk_not(m.mk_iff(f1, f2)));
+    return ctx.check() == l_false;
+}
+
+static void tst_simplify(unsigned seed, bool rewrite, bool fraig, statistics & st) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    random_gen r(seed);
+    app_ref_vector vars(m);
+    for (unsigned i = 0; i < 6; i++)
+        vars.push_back(m.mk_fresh_const("p", m.mk_bool_sort()));
+    expr_ref f(mk_random_formula(m, vars, r, 7), m);
+    expr_ref g(m);
+    unsigned before, after;
+    {
+        aig_manager am(m);
+        aig_ref a = am.mk_aig(f);
+        am.max_sharing(a);
+        before = am.get_num_aigs();
+        if (fraig)
+            am.fraig(a, 100);
+        if (rewrite)
+            am.rewrite(a);
+        am.max_sharing(a);
+        am.to_formula(a, g);
+        after = am.get_num_aigs();
+        am.collect_statistics(st);
+    }
+    ENSURE(is_equiv(m, f, g));
+    std::cout << "seed: " << seed << " rewrite: " << rewrite << " fraig: " << fraig 
+              << " aigs: " << before << " -> " << after << "\n";
+}
+
+void tst_aig() {
+    statistics st;
+    for (unsigned seed = 0; seed < 10; seed++) {
+        tst_simplify(seed, true, false, st);
+        tst_simplify(seed, false, true, st);
+        tst_simplify(seed, true, true, st);
+    }
+    st.display(std::cout);
+}
@@ -17,6 +17,10 @@ Revision History:
 
 --*/
 #include "ast.h"
+#include "arith_decl_plugin.h"
+#include "reg_decl_plugins.h"
+#include "z3_omp.h"
+#include "test_util.h"
 
 static void tst1() {
     ast_manager m;
@@ -141,6 +145,93 @@ struct foo {
     bool           m_val2:1;
 };
 
+// Several threads build the same terms in a manager in concurrent mode.
+static void tst6() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    sort_ref int_s(a.mk_int(), m);
+    func_decl_ref f(m.mk_func_decl(symbol("f"), int_s, int_s, int_s), m);
+    unsigned num_asts = m.get_num_asts();
+    unsigned const num_threads = 4;
+    unsigned const num_terms   = 2000;
+    ptr_vector<expr> results;
+    results.resize(num_threads, 0);
+    m.enable_concurrency(true);
+    #pragma omp parallel for num_threads(num_threads)
+    for (int t = 0; t < static_cast<int>(num_threads); t++) {
+        expr_ref r(m);
+        r = a.mk_numeral(rational(0), true);
+        for (unsigned i = 0; i < num_terms; i++) {
+            expr_ref x(m.mk_const(symbol(i), int_s), m);
+            r = m.mk_app(f.get(), r.get(), a.mk_add(x, a.mk_numeral(rational(i), true)));
+        }
+        m.inc_ref(r);
+        results[t] = r;
+    }
+    for (unsigned t = 1; t < num_threads; t++) {
+        ENSURE(results[t] == results[0]);
+    }
+    for (unsigned t = 0; t < num_threads; t++) 
+        m.dec_ref(results[t]);
+    m.enable_concurrency(false);
+    // the numerals are cached by the arith plugin.
+    ENSURE(m.get_num_asts() <= num_asts + num_terms);
+}
+
+// Nodes whose reference counter reaches zero in concurrent mode may be resurrected,
+// possibly as children of other dead nodes, before they are reclaimed.
+static void tst7() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    sort_ref int_s(a.mk_int(), m);
+    func_decl_ref f(m.mk_func_decl(symbol("f"), int_s, int_s, int_s), m);
+    expr_ref x(m.mk_const(symbol("x"), int_s), m);
+    unsigned num_asts = m.get_num_asts();
+    m.enable_concurrency(true);
+    expr_ref kept(m);
+    for (unsigned i = 0; i < 100; i++) {
+        expr * b = m.mk_app(f.get(), x.get(), x.get());
+        m.inc_ref(b);
+        m.dec_ref(b); // b is dead
+        m.inc_ref(b);
+        m.dec_ref(b); // b is dead again
+        // b is resurrected as a child of c, and c dies
+        expr * c = m.mk_app(f.get(), b, x.get());
+        m.inc_ref(c);
+        m.dec_ref(c);
+        // chain of dead nodes, each one resurrected by the next one
+        expr * d = c;
+        for (unsigned j = 0; j < i; j++) {
+            d = m.mk_app(f.get(), d, x.get());
+            m.inc_ref(d);
+            m.dec_ref(d);
+        }
+        if (i == 50)
+            kept = m.mk_app(f.get(), d, b);
+    }
+    m.enable_concurrency(false);
+    // kept and its subterms are alive, all other nodes were reclaimed
+    ENSURE(m.contains(kept));
+    ENSURE(kept->get_ref_count() == 1);
+    ENSURE(m.get_num_asts() == num_asts + 53);
+    kept = 0;
+    ENSURE(m.get_num_asts() == num_asts);
+    // the manager can be used in concurrent mode again
+    m.enable_concurrency(true);
+    expr_ref e(m.mk_app(f.get(), x.get(), x.get()), m);
+    e = 0;
+    ENSURE(m.get_num_asts() == num_asts + 1);
+    // dead nodes can be reclaimed without leaving concurrent mode (e.g., between two parallel rounds)
+    m.collect_zombies();
+    ENSURE(m.get_num_asts() == num_asts);
+    e = m.mk_app(f.get(), x.get(), x.get());
+    e = 0;
+    m.enable_concurrency(false);
+    ENSURE(m.get_num_asts() == num_asts);
+}
+
 void tst_ast() {
     TRACE("ast", 
           tout << "sizeof(ast):  " << sizeof(ast) << "\n";
@@ -153,5 +244,7 @@ void tst_ast() {
     tst3();
     tst4();
     tst5();
+    tst6();
+    tst7();
 }
 
@@ -0,0 +1,167 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    cg_table.cpp
+
+Abstract:
+
+    Test and benchmark for the open addressing congruence table.
+    The enodes are created by an smt::context, and then inserted
+    into a separate cg_table.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Revision History:
+
+--*/
+#include<iostream>
+#include"smt_context.h"
+#include"smt_cg_table.h"
+#include"arith_decl_plugin.h"
+#include"reg_decl_plugins.h"
+#include"stopwatch.h"
+#include"util.h"
+#include"test_util.h"
+
+/**
+   \brief Create the terms f(c_i), g(c_i, c_j) and c_i + c_j, and make c_0 = c_1.
+*/
+static void mk_terms(ast_manager & m, smt::context & ctx, unsigned n, random_gen & r, ptr_vector<smt::enode> & nodes) {
+    arith_util a(m);
+    sort * s = a.mk_int();
+    sort * ss[2] = { s, s };
+    func_decl_ref f(m.mk_func_decl(symbol("f"), 1, ss, s), m);
+    func_decl_ref g(m.mk_func_decl(symbol("g"), 2, ss, s), m);
+    app_ref_vector cs(m);
+    for (unsigned i = 0; i < n; i++)
+        cs.push_back(m.mk_fresh_const("c", s));
+    expr_ref_vector terms(m);
+    for (unsigned i = 0; i < n; i++) {
+        terms.push_back(m.mk_app(f, cs.get(i)));
+        terms.push_back(m.mk_app(g, cs.get(i), cs.get(r(n))));
+        terms.push_back(a.mk_add(cs.get(i), cs.get(r(n))));
+    }
+    // the terms are shared by the context and the table below.
+    expr_ref t(m);
+    for (unsigned i = 0; i < terms.size(); i++) {
+        t = m.mk_eq(terms.get(i), terms.get(i));
+        ctx.internalize(t, false);
+    }
+    ctx.assert_expr(m.mk_eq(cs.get(0), cs.get(1)));
+    ENSURE(ctx.check() == l_true);
+    for (unsigned i = 0; i < terms.size(); i++)
+        nodes.push_back(ctx.get_enode(terms.get(i)));
+}
+
+static void tst_insert_erase(unsigned n, unsigned seed) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    smt_params p;
+    smt::context ctx(m, p);
+    random_gen r(seed);
+    ptr_vector<smt::enode> nodes;
+    mk_terms(m, ctx, n, r, nodes);
+    smt::cg_table tbl(m);
+    // f(c_0) and f(c_1) are congruent, and inserted first.
+    smt::enode * f0 = nodes[0];
+    smt::enode * f1 = nodes[3];
+    ENSURE(tbl.insert(f0).first == f0);
+    ENSURE(tbl.insert(f1).first == f0);
+    ENSURE(tbl.find(f1) == f0);
+    ENSURE(!tbl.contains_ptr(f1));
+    // the other terms are inserted unless they are congruent to a term in the table.
+    ptr_vector<smt::enode> in_table;
+    in_table.push_back(f0);
+    for (unsigned i = 1; i < nodes.size(); i++) {
+        smt::enode * e = nodes[i];
+        if (e == f1)
+            continue;
+        smt::enode * c = tbl.find(e);
+        smt::enode_bool_pair res = tbl.insert(e);
+        if (c == 0) {
+            ENSURE(res.first == e);
+            in_table.push_back(e);
+        }
+        else {
+            ENSURE(res.first == c);
+        }
+    }
+    SASSERT(tbl.check_invariant());
+    for (unsigned i = 0; i < in_table.size(); i++)
+        ENSURE(tbl.contains_ptr(in_table[i]));
+    // erase every other term, this moves back the following cells of the clusters.
+    for (unsigned i = 0; i < in_table.size(); i += 2)
+        tbl.erase(in_table[i]);
+    SASSERT(tbl.check_invariant());
+    for (unsigned i = 0; i < in_table.size(); i++) {
+        if (i % 2 == 0) {
+            ENSURE(!tbl.contains(in_table[i]));
+        }
+        else {
+            ENSURE(tbl.contains_ptr(in_table[i]));
+        }
+    }
+    // f(c_0) was erased, so f(c_1) can now be inserted.
+    ENSURE(tbl.insert(f1).first == f1);
+    ENSURE(tbl.find(f0) == f1);
+    tbl.erase(f1);
+    for (unsigned i = 0; i < in_table.size(); i += 2)
+        ENSURE(tbl.insert(in_table[i]).first == in_table[i]);
+    for (unsigned i = 0; i < in_table.size(); i++)
+        ENSURE(tbl.contains_ptr(in_table[i]));
+    SASSERT(tbl.check_invariant());
+    tbl.reset();
+    for (unsigned i = 0; i < in_table.size(); i++)
+        ENSURE(!tbl.contains(in_table[i]));
+}
+
+static void bench_cg_table(unsigned n, unsigned rounds) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    smt_params p;
+    smt::context ctx(m, p);
+    random_gen r(0);
+    ptr_vector<smt::enode> nodes;
+    mk_terms(m, ctx, n, r, nodes);
+    smt::cg_table tbl(m);
+    stopwatch sw;
+    sw.start();
+    unsigned num_found = 0;
+    for (unsigned k = 0; k < rounds; k++) {
+        for (unsigned i = 0; i < nodes.size(); i++)
+            tbl.insert(nodes[i]);
+        for (unsigned i = 0; i < nodes.size(); i++) {
+            if (tbl.find(nodes[i]) != 0)
+                num_found++;
+        }
+        for (unsigned i = 0; i < nodes.size(); i++) {
+            if (tbl.contains_ptr(nodes[i]))
+                tbl.erase(nodes[i]);
+        }
+    }
+    sw.stop();
+    ENSURE(num_found == rounds * nodes.size());
+    statistics st;
+    tbl.collect_statistics(st);
+    std::cout << "enodes: " << nodes.size() << ", rounds: " << rounds << ", time: " << sw.get_seconds() << " secs\n";
+    st.display(std::cout);
+}
+
+void tst_cg_table() {
+    tst_insert_erase(10, 0);
+    tst_insert_erase(100, 1);
+    tst_insert_erase(2000, 2);
+}
+
+void tst_cg_table_bench(char ** argv, int argc, int & i) {
+    unsigned n = 20000;
+    if (i + 1 < argc) {
+        n = atol(argv[i+1]);
+        i += 1;
+    }
+    bench_cg_table(n, 20);
+}
@@ -0,0 +1,154 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    concurrent_ast_table.cpp
+
+Abstract:
+
+    Test hash-consing in ast_manager concurrent mode, and
+    benchmark mk_app throughput.
+
+Author:
+
+    agent (agent) 2026-10-16.
+
+Revision History:
+
+--*/
+#include<iostream>
+#include"ast.h"
+#include"z3_omp.h"
+#include"uint_set.h"
+#include"test_util.h"
+
+struct mk_app_bench {
+    ast_manager       m;
+    sort_ref          m_s;
+    func_decl_ref     m_f;
+    func_decl_ref     m_g;
+    expr_ref_vector   m_consts;
+
+    mk_app_bench(unsigned num_consts):
+        m_s(m),
+        m_f(m),
+        m_g(m),
+        m_consts(m) {
+        m_s = m.mk_uninterpreted_sort(symbol("S"));
+        m_f = m.mk_func_decl(symbol("f"), m_s, m_s, m_s);
+        m_g = m.mk_func_decl(symbol("g"), m_s, m_s);
+        for (unsigned i = 0; i < num_consts; i++)
+            m_consts.push_back(m.mk_const(symbol(i), m_s));
+    }
+
+    // Create num_terms applications. Threads using the same seed create the same terms.
+    expr * mk_terms(unsigned seed, unsigned num_terms) {
+        expr_ref r(m_consts.get(seed % m_consts.size()), m);
+        unsigned num_consts = m_consts.size();
+        for (unsigned i = 0; i < num_terms; i += 2) {
+            expr * c = m_consts.get((i * 31 + seed) % num_consts);
+            r = m.mk_app(m_f, r.get(), m.mk_app(m_g, c));
+        }
+        m.inc_ref(r);
+        return r;
+    }
+
+    // Return the number of created terms per second (wall clock).
+    double run(unsigned num_threads, unsigned num_terms, bool shared) {
+        ptr_vector<expr> results;
+        results.resize(num_threads, 0);
+        if (num_threads > 1)
+            m.enable_concurrency(true);
+        double start = omp_get_wtime();
+        #pragma omp parallel for num_threads(num_threads)
+        for (int t = 0; t < static_cast<int>(num_threads); t++) {
+            results[t] = mk_terms(shared ? 0 : t, num_terms);
+        }
+        double elapsed = omp_get_wtime() - start;
+        for (unsigned t = 0; t < num_threads; t++) {
+            ENSURE(!shared || results[t] == results[0]);
+            ENSURE(shared || t == 0 || results[t] != results[0]);
+            m.dec_ref(results[t]);
+        }
+        m.enable_concurrency(false);
+        return static_cast<double>(num_threads) * num_terms / elapsed;
+    }
+};
+
+// Threads create the same terms at the same time, and use them right away.
+// A thread that finds a term created by another thread must see its id, flags and children.
+static void tst_same_terms(unsigned num_threads, unsigned num_terms) {
+    mk_app_bench b(100);
+    ast_manager & m = b.m;
+    unsigned num_asts = m.get_num_asts();
+    svector<unsigned> depth;
+    depth.push_back(1);
+    for (unsigned k = 1; k < num_terms; k++)
+        depth.push_back(std::max(depth[k/2], 2u) + 1);
+    vector<ptr_vector<expr> > results;
+    results.resize(num_threads);
+    m.enable_concurrency(true);
+    #pragma omp parallel for num_threads(num_threads)
+    for (int t = 0; t < static_cast<int>(num_threads); t++) {
+        ptr_vector<expr> & ts = results[t];
+        ts.push_back(b.m_consts.get(0));
+        for (unsigned k = 1; k < num_terms; k++) {
+            expr * c = b.m_consts.get(k % b.m_consts.size());
+            app * r  = m.mk_app(b.m_f, ts[k/2], m.mk_app(b.m_g, c));
+            m.inc_ref(r);
+            ENSURE(r->get_id() != UINT_MAX);
+            ENSURE(r->get_depth() == depth[k]);
+            ENSURE(r->is_ground());
+            ENSURE(r->get_arg(0) == ts[k/2]);
+            ENSURE(to_app(r->get_arg(1))->get_arg(0) == c);
+            ENSURE(r->get_ref_count() > 0);
+            ts.push_back(r);
+        }
+    }
+    uint_set ids;
+    for (unsigned k = 1; k < num_terms; k++) {
+        for (unsigned t = 1; t < num_threads; t++)
+            ENSURE(results[t][k] == results[0][k]);
+        ENSURE(!ids.contains(results[0][k]->get_id()));
+        ids.insert(results[0][k]->get_id());
+        ENSURE(results[0][k]->get_ref_count() >= num_threads);
+    }
+    for (unsigned t = 0; t < num_threads; t++)
+        for (unsigned k = 1; k < num_terms; k++)
+            m.dec_ref(results[t][k]);
+    m.enable_concurrency(false);
+    ENSURE(m.get_num_asts() == num_asts);
+}
+
+void tst_concurrent_ast_table() {
+    tst_same_terms(4, 20000);
+    tst_same_terms(16, 2000);
+    mk_app_bench b(100);
+    unsigned num_asts = b.m.get_num_asts();
+    b.run(4, 10000, true);
+    ENSURE(b.m.get_num_asts() == num_asts);
+    b.run(4, 10000, false);
+    ENSURE(b.m.get_num_asts() == num_asts);
+    b.run(16, 1000, true);
+    ENSURE(b.m.get_num_asts() == num_asts);
+}
+
+void tst_mk_app_bench(char ** argv, int argc, int & i) {
+#ifndef _NO_OMP_
+    unsigned num_terms = 1000000;
+    if (i + 1 < argc) {
+        num_terms = atol(argv[i+1]);
+        i += 1;
+    }
+    mk_app_bench b(1000);
+    std::cout << "terms per thread: " << num_terms << ", processors: " << omp_get_num_procs() << "\n";
+    unsigned threads[3] = { 1, 4, 16 };
+    for (unsigned j = 0; j < 3; j++) {
+        unsigned n = threads[j];
+        std::cout << "threads: " << n
+                  << " distinct terms/s: " << b.run(n, num_terms, false)
+                  << " shared terms/s: " << b.run(n, num_terms, true) << std::endl;
+    }
+#endif
+}
@@ -0,0 +1,118 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    cube_and_conquer.cpp
+
+Abstract:
+
+    Test the parallel cube and conquer driver.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Revision History:
+
+--*/
+#include<iostream>
+#include"smt_cube_and_conquer.h"
+#include"smt_params.h"
+#include"reg_decl_plugins.h"
+#include"arith_decl_plugin.h"
+#include"model_evaluator.h"
+#include"ast_pp.h"
+#include"test_util.h"
+
+/**
+   \brief Pigeon hole problem: num_p pigeons and num_h holes.
+*/
+static void mk_php(ast_manager & m, unsigned num_p, unsigned num_h, expr_ref_vector & fmls) {
+    vector<expr_ref_vector> p;
+    for (unsigned i = 0; i < num_p; i++) {
+        p.push_back(expr_ref_vector(m));
+        for (unsigned j = 0; j < num_h; j++) {
+            std::ostringstream buffer;
+            buffer << "p_" << i << "_" << j;
+            p[i].push_back(m.mk_const(symbol(buffer.str().c_str()), m.mk_bool_sort()));
+        }
+        fmls.push_back(m.mk_or(num_h, p[i].c_ptr()));
+    }
+    for (unsigned j = 0; j < num_h; j++)
+        for (unsigned i1 = 0; i1 < num_p; i1++)
+            for (unsigned i2 = i1 + 1; i2 < num_p; i2++)
+                fmls.push_back(m.mk_or(m.mk_not(p[i1].get(j)), m.mk_not(p[i2].get(j))));
+}
+
+static void check_model(ast_manager & m, model_ref & md, expr_ref_vector const & fmls) {
+    SASSERT(md);
+    model_evaluator ev(*md.get());
+    for (unsigned i = 0; i < fmls.size(); i++) {
+        expr_ref val(m);
+        ev(fmls[i], val);
+        ENSURE(m.is_true(val));
+    }
+}
+
+static lbool solve(ast_manager & m, expr_ref_vector const & fmls, unsigned threads, unsigned depth) {
+    smt_params fp;
+    fp.m_threads              = threads;
+    fp.m_cube_depth           = depth;
+    fp.m_cube_probe_conflicts = 10;
+    smt::cube_and_conquer cc(m, fp);
+    for (unsigned i = 0; i < fmls.size(); i++)
+        cc.assert_expr(fmls[i]);
+    lbool r = cc.check();
+    if (r == l_true) {
+        model_ref md;
+        cc.get_model(md);
+        check_model(m, md, fmls);
+    }
+    statistics st;
+    cc.collect_statistics(st);
+    st.display_smt2(std::cout);
+    return r;
+}
+
+static void tst_php(unsigned num_p, unsigned num_h, lbool expected) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref_vector fmls(m);
+    mk_php(m, num_p, num_h, fmls);
+    ENSURE(solve(m, fmls, 4, 0) == expected);
+    ENSURE(solve(m, fmls, 3, 5) == expected);
+}
+
+static void tst_arith(unsigned n, bool sat) {
+    // x_0 < x_1 < ... < x_{n-1},  b_i => x_i >= i, 
+    // if unsat, then x_{n-1} <= n-2 and b_{n-1}
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref_vector fmls(m), xs(m);
+    for (unsigned i = 0; i < n; i++) {
+        std::ostringstream buffer;
+        buffer << "x_" << i;
+        xs.push_back(m.mk_const(symbol(buffer.str().c_str()), a.mk_int()));
+    }
+    for (unsigned i = 0; i + 1 < n; i++) {
+        std::ostringstream buffer;
+        buffer << "b_" << i;
+        expr * b = m.mk_const(symbol(buffer.str().c_str()), m.mk_bool_sort());
+        fmls.push_back(a.mk_lt(xs.get(i), xs.get(i+1)));
+        fmls.push_back(m.mk_or(b, a.mk_ge(xs.get(i), a.mk_numeral(rational(i), true))));
+        fmls.push_back(m.mk_or(m.mk_not(b), a.mk_le(xs.get(i), a.mk_numeral(rational(-static_cast<int>(i)), true))));
+    }
+    fmls.push_back(a.mk_ge(xs.get(0), a.mk_numeral(rational(0), true)));
+    if (!sat)
+        fmls.push_back(a.mk_le(xs.get(n-1), a.mk_numeral(rational(n-2), true)));
+    ENSURE(solve(m, fmls, 4, 4) == (sat ? l_true : l_false));
+}
+
+void tst_cube_and_conquer() {
+    tst_php(6, 6, l_true);
+    tst_php(7, 6, l_false);
+    tst_arith(10, true);
+    tst_arith(10, false);
+}
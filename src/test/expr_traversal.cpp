@@ -0,0 +1,172 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    expr_traversal.cpp
+
+Abstract:
+
+    Test the iterative DAG traversal and the utilities based on it.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Revision History:
+
+--*/
+#include<iostream>
+#include"expr_traversal.h"
+#include"for_each_expr.h"
+#include"recurse_expr_def.h"
+#include"num_occurs.h"
+#include"occurs.h"
+#include"has_free_vars.h"
+#include"expr_abstract.h"
+#include"arith_decl_plugin.h"
+#include"reg_decl_plugins.h"
+
+struct counter_proc {
+    unsigned m_num_apps;
+    unsigned m_num_vars;
+    unsigned m_num_qs;
+    counter_proc():m_num_apps(0), m_num_vars(0), m_num_qs(0) {}
+    void operator()(var * n)        { m_num_vars++; }
+    void operator()(app * n)        { m_num_apps++; }
+    void operator()(quantifier * n) { m_num_qs++; }
+};
+
+struct depth_visitor {
+    unsigned visit(app * n, unsigned const * args) {
+        unsigned r = 0;
+        for (unsigned i = 0; i < n->get_num_args(); i++)
+            r = std::max(r, args[i]);
+        return r + 1;
+    }
+    unsigned visit(var * n) { return 1; }
+    unsigned visit(quantifier * q, unsigned body, unsigned const *, unsigned const *) { return body + 1; }
+};
+
+static void tst_epoch_mark() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref x(m.mk_const(symbol("x"), a.mk_int()), m);
+    expr_ref y(m.mk_const(symbol("y"), a.mk_int()), m);
+    expr_epoch_mark mark;
+    mark.mark(x);
+    SASSERT(mark.is_marked(x) && !mark.is_marked(y));
+    mark.reset();
+    SASSERT(!mark.is_marked(x));
+    mark.mark(y);
+    mark.mark(y, false);
+    SASSERT(!mark.is_marked(y));
+    expr_epoch_map<unsigned> map;
+    map.insert(x, 10);
+    unsigned v = 0;
+    SASSERT(map.find(x, v) && v == 10);
+    SASSERT(!map.contains(y));
+    map.reset();
+    SASSERT(!map.contains(x));
+}
+
+// f(...f(f(x, y), y)..., y), depth n
+static void tst_deep(unsigned n) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    sort * i = a.mk_int();
+    sort * dom[2] = { i, i };
+    func_decl_ref f(m.mk_func_decl(symbol("f"), 2, dom, i), m);
+    func_decl_ref g(m.mk_func_decl(symbol("g"), 2, dom, i), m);
+    expr_ref x(m.mk_const(symbol("x"), i), m);
+    expr_ref y(m.mk_const(symbol("y"), i), m);
+    expr_ref z(m.mk_const(symbol("z"), i), m);
+    expr_ref t(x, m);
+    for (unsigned k = 0; k < n; k++)
+        t = m.mk_app(f.get(), t.get(), y.get());
+
+    counter_proc c1;
+    for_each_expr(c1, t);
+    SASSERT(c1.m_num_apps == n + 2 && c1.m_num_vars == 0);
+    SASSERT(get_num_exprs(t) == n + 2);
+
+    // reusable traversal
+    expr_traversal tr;
+    counter_proc c2;
+    for_each_expr(c2, tr, t);
+    SASSERT(c2.m_num_apps == n + 2);
+    for_each_expr(c2, tr, t);
+    SASSERT(c2.m_num_apps == n + 2); // nodes were already visited
+    tr.reset();
+    for_each_expr(c2, tr, t);
+    SASSERT(c2.m_num_apps == 2*(n + 2));
+
+    SASSERT(occurs(x, t));
+    SASSERT(!occurs(z, t));
+    SASSERT(occurs(f, t));
+    SASSERT(!occurs(g, t));
+
+    num_occurs occs;
+    occs(t);
+    SASSERT(occs.get_num_occs(y) == n);
+    SASSERT(occs.get_num_occs(x) == 1);
+    SASSERT(occs.get_num_occs(t) == 1);
+
+    recurse_expr<unsigned, depth_visitor> depth;
+    SASSERT(depth(t) == n + 1);
+    depth.reset();
+    SASSERT(depth(t) == n + 1);
+
+    SASSERT(!has_free_vars(t));
+    expr * bound[1] = { x.get() };
+    expr_ref r(m);
+    expr_abstract(m, 0, 1, bound, t, r);
+    SASSERT(has_free_vars(r));
+    SASSERT(!occurs(x, r));
+    counter_proc c3;
+    for_each_expr(c3, r);
+    SASSERT(c3.m_num_vars == 1 && c3.m_num_apps == n + 1);
+    std::cout << "depth " << n << ": apps " << c1.m_num_apps << ", y occurrences " << occs.get_num_occs(y) << "\n";
+}
+
+static void tst_quantifiers() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    sort * i = a.mk_int();
+    expr_ref x(m.mk_const(symbol("x"), i), m);
+    expr_ref v0(m.mk_var(0, i), m);
+    expr_ref v1(m.mk_var(1, i), m);
+    symbol n("n");
+    // (forall (n Int) (<= (+ x (:var 0)) (:var 1)))  --- (:var 1) is free
+    expr_ref q1(m.mk_forall(1, &i, &n, a.mk_le(a.mk_add(x, v0), v1)), m);
+    // (forall (n Int) (<= (+ x (:var 0)) 0))
+    expr_ref q2(m.mk_forall(1, &i, &n, a.mk_le(a.mk_add(x, v0), a.mk_numeral(rational(0), true))), m);
+    SASSERT(has_free_vars(q1));
+    SASSERT(!has_free_vars(q2));
+    // the same body is shared with different quantifier depths
+    expr_ref body(a.mk_le(v0, x), m);
+    expr_ref q3(m.mk_forall(1, &i, &n, body), m);
+    SASSERT(!has_free_vars(q3));
+    SASSERT(has_free_vars(m.mk_and(q3, body)));
+
+    expr * bound[1] = { x.get() };
+    expr_ref r(m);
+    expr_abstract(m, 0, 1, bound, q2, r);
+    SASSERT(is_quantifier(r));
+    SASSERT(has_free_vars(r));
+    SASSERT(!occurs(x, r));
+
+    counter_proc c;
+    for_each_expr(c, q1);
+    SASSERT(c.m_num_qs == 1 && c.m_num_vars == 2);
+}
+
+void tst_expr_traversal() {
+    tst_epoch_mark();
+    tst_quantifiers();
+    tst_deep(10);
+    tst_deep(1000000);
+}
@@ -0,0 +1,165 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    inc_sat_solver.cpp
+
+Abstract:
+
+    Test assumptions, unsat cores and scopes of the SAT based solvers:
+    inc_sat_solver, the QF_BV combined solver, and tactic2solver
+    using the sat tactic.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Revision History:
+
+--*/
+#include<iostream>
+#include"inc_sat_solver.h"
+#include"tactic2solver.h"
+#include"qfbv_tactic.h"
+#include"simplify_tactic.h"
+#include"bit_blaster_tactic.h"
+#include"sat_tactic.h"
+#include"tactical.h"
+#include"smt_strategic_solver.h"
+#include"bv_decl_plugin.h"
+#include"reg_decl_plugins.h"
+#include"ast_pp.h"
+#include"test_util.h"
+
+static rational get_value(model_ref & md, expr * t) {
+    bv_util bv(md->get_manager());
+    expr_ref r(md->get_manager());
+    rational val;
+    unsigned sz;
+    ENSURE(md->eval(t, r, true));
+    ENSURE(bv.is_numeral(r, val, sz));
+    return val;
+}
+
+static void tst_scopes(solver & s, ast_manager & m) {
+    bv_util bv(m);
+    expr_ref x(m.mk_const(symbol("x"), bv.mk_sort(8)), m);
+    expr_ref y(m.mk_const(symbol("y"), bv.mk_sort(8)), m);
+    s.assert_expr(m.mk_not(bv.mk_ule(y, x)));
+    s.push();
+    s.assert_expr(m.mk_eq(x, bv.mk_numeral(rational(255), 8)));
+    ENSURE(s.check_sat(0, 0) == l_false);
+    s.pop(1);
+    ENSURE(s.check_sat(0, 0) == l_true);
+    // the gates of x + y were created in a popped scope, and are reused here.
+    s.push();
+    s.assert_expr(m.mk_eq(bv.mk_bv_add(x, y), bv.mk_numeral(rational(7), 8)));
+    s.assert_expr(m.mk_eq(x, bv.mk_numeral(rational(3), 8)));
+    ENSURE(s.check_sat(0, 0) == l_true);
+    model_ref md;
+    s.get_model(md);
+    ENSURE(get_value(md, x) == rational(3));
+    ENSURE(get_value(md, y) == rational(4));
+    s.pop(1);
+    s.push();
+    s.assert_expr(m.mk_eq(bv.mk_bv_add(x, y), bv.mk_numeral(rational(7), 8)));
+    s.assert_expr(m.mk_eq(x, bv.mk_numeral(rational(5), 8)));
+    ENSURE(s.check_sat(0, 0) == l_false);
+    s.pop(1);
+    ENSURE(s.check_sat(0, 0) == l_true);
+}
+
+/**
+   \brief (x <= 10) and (y <= 10) and (x * y = 143) is unsat over 16 bits, and
+   the three constraints are needed to prove it.
+*/
+static void tst_core(solver & s, ast_manager & m) {
+    bv_util bv(m);
+    sort * bv16 = bv.mk_sort(16);
+    expr_ref x(m.mk_const(symbol("x"), bv16), m);
+    expr_ref y(m.mk_const(symbol("y"), bv16), m);
+    expr_ref a(m.mk_const(symbol("a"), m.mk_bool_sort()), m);
+    expr_ref b(m.mk_const(symbol("b"), m.mk_bool_sort()), m);
+    expr_ref c(m.mk_const(symbol("c"), m.mk_bool_sort()), m);
+    expr_ref d(m.mk_const(symbol("d"), m.mk_bool_sort()), m);
+    s.assert_expr(m.mk_implies(a, bv.mk_ule(x, bv.mk_numeral(rational(10), 16))));
+    s.assert_expr(m.mk_implies(b, bv.mk_ule(y, bv.mk_numeral(rational(10), 16))));
+    s.assert_expr(m.mk_implies(c, m.mk_eq(bv.mk_bv_mul(x, y), bv.mk_numeral(rational(143), 16))));
+    s.assert_expr(m.mk_implies(d, m.mk_eq(x, bv.mk_numeral(rational(2), 16))));
+    expr * asms[4] = { a, b, c, d };
+    ENSURE(s.check_sat(3, asms) == l_false);
+    ptr_vector<expr> core;
+    s.get_unsat_core(core);
+    std::cout << "core:";
+    for (unsigned i = 0; i < core.size(); i++)
+        std::cout << " " << mk_pp(core[i], m);
+    std::cout << "\n";
+    ENSURE(core.size() == 3);
+    ENSURE(core.contains(a) && core.contains(b) && core.contains(c));
+    expr * asms2[2] = { c, b };
+    ENSURE(s.check_sat(2, asms2) == l_true);
+    model_ref md;
+    s.get_model(md);
+    ENSURE((get_value(md, x) * get_value(md, y)) % rational(65536) == rational(143));
+    ENSURE(get_value(md, y) < rational(11));
+    // 2 * y = 143 has no solution, since 143 is odd.
+    expr * asms3[3] = { d, a, c };
+    ENSURE(s.check_sat(3, asms3) == l_false);
+    core.reset();
+    s.get_unsat_core(core);
+    ENSURE(core.contains(d) && core.contains(c));
+    ENSURE(s.check_sat(0, 0) == l_true);
+}
+
+static void tst_inc_sat_solver_core() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    params_ref p;
+    ref<solver> s = mk_inc_sat_solver(m, p);
+    tst_core(*s, m);
+}
+
+static void tst_inc_sat_solver_scopes() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    params_ref p;
+    ref<solver> s = mk_inc_sat_solver(m, p);
+    tst_scopes(*s, m);
+}
+
+// solver2_sat selects inc_sat_solver as the incremental solver, the default is the smt solver.
+static void tst_combined_solver(bool solver2_sat) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    params_ref p;
+    p.set_bool("solver2_sat", solver2_sat);
+    scoped_ptr<solver_factory> f = mk_smt_strategic_solver_factory(symbol("QF_BV"));
+    ref<solver> s = (*f)(m, p, false, true, true, symbol("QF_BV"));
+    tst_core(*s, m);
+    ref<solver> s2 = (*f)(m, p, false, true, true, symbol("QF_BV"));
+    tst_scopes(*s2, m);
+}
+
+static void tst_tactic2solver() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    params_ref p;
+    // the qfbv tactic uses the smt tactic when unsat cores are requested.
+    ref<solver> s = mk_tactic2solver(m, mk_qfbv_tactic(m, p), p, false, true, true, symbol("QF_BV"));
+    tst_core(*s, m);
+    // goal2sat does not handle and, as in the qfbv tactic the simplifier eliminates it.
+    params_ref simp_p;
+    simp_p.set_bool("elim_and", true);
+    tactic * t = using_params(and_then(mk_simplify_tactic(m), mk_bit_blaster_tactic(m), mk_sat_tactic(m)), simp_p);
+    ref<solver> s2 = mk_tactic2solver(m, t, p, false, true, true, symbol("QF_BV"));
+    tst_core(*s2, m);
+}
+
+void tst_inc_sat_solver() {
+    tst_inc_sat_solver_core();
+    tst_inc_sat_solver_scopes();
+    tst_combined_solver(false);
+    tst_combined_solver(true);
+    tst_tactic2solver();
+}
@@ -0,0 +1,354 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    lu_simplex.cpp
+
+Abstract:
+
+    Test sparse LU factorization and the double precision simplex.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Revision History:
+
+--*/
+#include<math.h>
+#include<iostream>
+#include"sparse_lu.h"
+#include"lu_simplex.h"
+#include"smt_context.h"
+#include"arith_decl_plugin.h"
+#include"reg_decl_plugins.h"
+#include"stopwatch.h"
+#include"util.h"
+#include"test_util.h"
+
+typedef sparse_lu::sparse_vector sparse_vector;
+typedef sparse_lu::dense_vector  dense_vector;
+
+static bool close(double a, double b) {
+    return fabs(a - b) <= 1e-6 * (1.0 + fabs(a) + fabs(b));
+}
+
+// b <- B x, where x is indexed by columns
+static void mul(vector<sparse_vector> const & B, dense_vector const & x, dense_vector & b) {
+    b.reset();
+    b.resize(B.size(), 0.0);
+    for (unsigned c = 0; c < B.size(); c++)
+        for (unsigned i = 0; i < B[c].size(); i++)
+            b[B[c][i].m_idx] += B[c][i].m_val * x[c];
+}
+
+static void check_solve(sparse_lu const & lu, vector<sparse_vector> const & B, random_gen & r) {
+    unsigned n = B.size();
+    dense_vector x, b;
+    for (unsigned i = 0; i < n; i++)
+        x.push_back(static_cast<double>(r(21)) - 10.0);
+    mul(B, x, b);
+    lu.ftran(b);
+    for (unsigned i = 0; i < n; i++) {
+        ENSURE(close(b[i], x[i]));
+    }
+    // y B = d, i.e., d[c] = y . B[c]
+    dense_vector y, d;
+    for (unsigned i = 0; i < n; i++)
+        y.push_back(static_cast<double>(r(21)) - 10.0);
+    for (unsigned c = 0; c < n; c++) {
+        double s = 0.0;
+        for (unsigned i = 0; i < B[c].size(); i++)
+            s += y[B[c][i].m_idx] * B[c][i].m_val;
+        d.push_back(s);
+    }
+    lu.btran(d);
+    for (unsigned i = 0; i < n; i++) {
+        ENSURE(close(d[i], y[i]));
+    }
+}
+
+static void mk_random_column(unsigned n, unsigned c, random_gen & r, sparse_vector & col) {
+    col.reset();
+    // diagonal entry, makes the matrix nonsingular
+    col.push_back(sparse_lu::entry(c, 10.0 + r(10)));
+    for (unsigned i = 0; i < 3; i++) {
+        unsigned row = r(n);
+        if (row != c)
+            col.push_back(sparse_lu::entry(row, static_cast<double>(r(7)) - 3.0));
+    }
+}
+
+static void tst_sparse_lu(unsigned n, unsigned seed) {
+    random_gen r(seed);
+    vector<sparse_vector> B;
+    for (unsigned c = 0; c < n; c++) {
+        B.push_back(sparse_vector());
+        mk_random_column(n, c, r, B.back());
+    }
+    sparse_lu lu;
+    ENSURE(lu.factorize(n, B));
+    check_solve(lu, B, r);
+    // replace some columns using product form updates
+    for (unsigned k = 0; k < 5; k++) {
+        unsigned c = r(n);
+        sparse_vector col;
+        mk_random_column(n, c, r, col);
+        dense_vector alpha;
+        alpha.resize(n, 0.0);
+        for (unsigned i = 0; i < col.size(); i++)
+            alpha[col[i].m_idx] += col[i].m_val;
+        lu.ftran(alpha);
+        if (lu.update(c, alpha))
+            B[c] = col;
+        check_solve(lu, B, r);
+    }
+    ENSURE(lu.num_updates() > 0);
+    // singular matrix: two equal columns
+    B[1] = B[0];
+    ENSURE(!lu.factorize(n, B));
+}
+
+static void tst_small_lp() {
+    lu_simplex s;
+    // s = x + y, 0 <= x <= 1, 0 <= y <= 2, s >= 2
+    lu_simplex::var x  = s.mk_var(0.0);
+    lu_simplex::var y  = s.mk_var(0.0);
+    lu_simplex::var sv = s.mk_var(0.0);
+    s.set_lower(x, 0.0); s.set_upper(x, 1.0);
+    s.set_lower(y, 0.0); s.set_upper(y, 2.0);
+    s.set_lower(sv, 2.0);
+    lu_simplex::var xs[3] = { x, y, sv };
+    double cs[3] = { 1.0, 1.0, -1.0 };
+    s.add_row(sv, 3, xs, cs);
+    ENSURE(s.make_feasible(100) == lu_simplex::FEASIBLE);
+    ENSURE(close(s.get_value(sv), s.get_value(x) + s.get_value(y)));
+    ENSURE(s.get_value(sv) >= 2.0 - 1e-9);
+
+    // with s >= 4 the problem is infeasible
+    s.reset();
+    x  = s.mk_var(0.0);
+    y  = s.mk_var(0.0);
+    sv = s.mk_var(0.0);
+    s.set_lower(x, 0.0); s.set_upper(x, 1.0);
+    s.set_lower(y, 0.0); s.set_upper(y, 2.0);
+    s.set_lower(sv, 4.0);
+    s.add_row(sv, 3, xs, cs);
+    ENSURE(s.make_feasible(100) == lu_simplex::INFEASIBLE);
+}
+
+/**
+   \brief Random problem with a known solution p: the bounds of every variable
+   contain p, and the rows are slacks s_i = sum a_ij x_j.
+*/
+static void tst_random_lp(unsigned num_vars, unsigned num_rows, unsigned seed) {
+    random_gen r(seed);
+    lu_simplex s;
+    dense_vector p;
+    for (unsigned j = 0; j < num_vars; j++) {
+        double v  = static_cast<double>(r(11)) - 5.0;
+        double lo = v - r(3);
+        p.push_back(v);
+        lu_simplex::var x = s.mk_var(lo);
+        s.set_lower(x, lo);
+        s.set_upper(x, v + r(3));
+    }
+    vector<unsigned_vector> rows;
+    vector<dense_vector>    coeffs;
+    for (unsigned i = 0; i < num_rows; i++) {
+        lu_simplex::var sv = s.mk_var(0.0);
+        unsigned_vector xs;
+        dense_vector    cs;
+        double val = 0.0;
+        for (unsigned k = 0; k < 4; k++) {
+            unsigned j = r(num_vars);
+            double   a = static_cast<double>(r(9)) - 4.0;
+            if (a == 0.0 || xs.contains(j))
+                continue;
+            xs.push_back(j);
+            cs.push_back(a);
+            val += a * p[j];
+        }
+        s.set_lower(sv, val - r(2));
+        s.set_upper(sv, val + r(2));
+        xs.push_back(sv);
+        cs.push_back(-1.0);
+        s.add_row(sv, xs.size(), xs.c_ptr(), cs.c_ptr());
+        rows.push_back(xs);
+        coeffs.push_back(cs);
+    }
+    ENSURE(s.make_feasible(10000) == lu_simplex::FEASIBLE);
+    for (unsigned i = 0; i < rows.size(); i++) {
+        double sum = 0.0;
+        for (unsigned k = 0; k < rows[i].size(); k++)
+            sum += coeffs[i][k] * s.get_value(rows[i][k]);
+        ENSURE(close(sum, 0.0));
+    }
+    statistics st;
+    s.collect_statistics(st);
+    std::cout << "vars: " << num_vars << ", rows: " << num_rows << ", iterations: " << s.get_num_iterations() << "\n";
+}
+
+/**
+   \brief Update bounds and add rows between calls to make_feasible, as
+   theory_arith does with its double precision mirror of the tableau.
+*/
+static void tst_incremental_lp() {
+    lu_simplex s;
+    // s1 = x + y, s2 = x - y
+    lu_simplex::var x  = s.mk_var(0.0);
+    lu_simplex::var y  = s.mk_var(0.0);
+    lu_simplex::var s1 = s.mk_var(0.0);
+    lu_simplex::var s2 = s.mk_var(0.0);
+    lu_simplex::var xs1[3] = { x, y, s1 };
+    double cs1[3] = { 1.0, 1.0, -1.0 };
+    s.add_row(s1, 3, xs1, cs1);
+    lu_simplex::var xs2[3] = { x, y, s2 };
+    double cs2[3] = { 1.0, -1.0, -1.0 };
+    s.add_row(s2, 3, xs2, cs2);
+    s.set_lower(s1, 4.0);
+    s.set_upper(s2, -2.0);
+    ENSURE(s.make_feasible(100) == lu_simplex::FEASIBLE);
+    ENSURE(s.get_value(s1) >= 4.0 - 1e-9);
+    ENSURE(s.get_value(s2) <= -2.0 + 1e-9);
+    ENSURE(close(s.get_value(s1), s.get_value(x) + s.get_value(y)));
+    // x + y = 4 and x - y = -2 force x = 1 and y = 3
+    s.set_upper(s1, 4.0);
+    s.set_lower(s2, -2.0);
+    ENSURE(s.make_feasible(100) == lu_simplex::FEASIBLE);
+    ENSURE(close(s.get_value(x), 1.0) && close(s.get_value(y), 3.0));
+    // a new variable and row after a solve: s3 = y - x, s3 >= 5 is infeasible
+    lu_simplex::var s3 = s.mk_var(0.0);
+    lu_simplex::var xs3[3] = { y, x, s3 };
+    double cs3[3] = { 1.0, -1.0, -1.0 };
+    s.add_row(s3, 3, xs3, cs3);
+    s.set_lower(s3, 5.0);
+    ENSURE(s.make_feasible(100) == lu_simplex::INFEASIBLE);
+    // relax the bounds of s1 and s2; values outside the bounds are moved inside.
+    s.reset_bounds(s1);
+    s.reset_bounds(s2);
+    s.set_lower(x, 0.0);
+    s.set_value(x, -10.0);
+    ENSURE(s.make_feasible(100) == lu_simplex::FEASIBLE);
+    ENSURE(s.get_value(x) >= -1e-9);
+    ENSURE(s.get_value(s3) >= 5.0 - 1e-9);
+    ENSURE(close(s.get_value(s3), s.get_value(y) - s.get_value(x)));
+    ENSURE(close(s.get_value(s2), s.get_value(x) - s.get_value(y)));
+    ENSURE(s.get_num_vars() == 5);
+}
+
+static void tst_to_fraction(double v, bool expected, int num = 0, int den = 1) {
+    int n, d;
+    bool r = lu_simplex::to_fraction(v, 1 << 20, n, d);
+    ENSURE(r == expected);
+    if (r) {
+        ENSURE(n == num && d == den);
+    }
+}
+
+static void tst_to_integer(double v, bool expected, int val = 0) {
+    int n, d;
+    bool r = lu_simplex::to_fraction(v, 1, n, d);
+    ENSURE(r == expected);
+    if (r) {
+        ENSURE(n == val && d == 1);
+    }
+}
+
+static void bench_to_fraction(unsigned n) {
+    random_gen r(0);
+    svector<double> vs;
+    for (unsigned i = 0; i < n; i++) {
+        int den = 1 + r(1000);
+        vs.push_back(static_cast<double>(static_cast<int>(r(2000000)) - 1000000) / den);
+    }
+    unsigned num_ok = 0;
+    int num, den;
+    stopwatch sw;
+    sw.start();
+    for (unsigned i = 0; i < n; i++) {
+        if (lu_simplex::to_fraction(vs[i], 1 << 20, num, den))
+            num_ok++;
+    }
+    sw.stop();
+    ENSURE(num_ok == n);
+    std::cout << "to_fraction: " << n << " values, " << sw.get_seconds() << " secs\n";
+}
+
+/**
+   \brief Random bounded LRA problem with num_vars variables and num_ineqs
+   inequalities with num_coeffs monomials each, solved with the given backend.
+*/
+static lbool bench_backend(unsigned backend, unsigned num_vars, unsigned num_ineqs, unsigned num_coeffs, unsigned seed) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    smt_params p;
+    p.m_arith_simplex_backend = static_cast<arith_simplex_backend>(backend);
+    smt::context ctx(m, p);
+    random_gen r(seed);
+    app_ref_vector xs(m);
+    for (unsigned i = 0; i < num_vars; i++) {
+        xs.push_back(m.mk_fresh_const("x", a.mk_real()));
+        ctx.assert_expr(a.mk_ge(xs.get(i), a.mk_numeral(rational(-100), false)));
+        ctx.assert_expr(a.mk_le(xs.get(i), a.mk_numeral(rational(100), false)));
+    }
+    expr_ref_vector args(m);
+    for (unsigned i = 0; i < num_ineqs; i++) {
+        args.reset();
+        for (unsigned j = 0; j < num_coeffs; j++)
+            args.push_back(a.mk_mul(a.mk_numeral(rational(static_cast<int>(r(21)) - 10), false), xs.get(r(num_vars))));
+        ctx.assert_expr(a.mk_ge(a.mk_add(args.size(), args.c_ptr()), a.mk_numeral(rational(static_cast<int>(r(41)) - 10), false)));
+    }
+    stopwatch sw;
+    sw.start();
+    lbool res = ctx.check();
+    sw.stop();
+    statistics st;
+    ctx.collect_statistics(st);
+    std::cout << "backend: " << backend << ", result: " << res << ", time: " << sw.get_seconds() << " secs";
+    for (unsigned i = 0; i < st.size(); i++) {
+        if (strncmp(st.get_key(i), "lu simplex", 10) == 0 || strcmp(st.get_key(i), "pivots") == 0)
+            std::cout << ", " << st.get_key(i) << ": " << st.get_uint_value(i);
+    }
+    std::cout << "\n";
+    return res;
+}
+
+void tst_lu_simplex_bench(char ** argv, int argc, int & i) {
+    unsigned n = 30;
+    if (i + 1 < argc) {
+        n = atol(argv[i+1]);
+        i += 1;
+    }
+    bench_to_fraction(1000000);
+    for (unsigned seed = 0; seed < 3; seed++) {
+        lbool r0 = bench_backend(0, n, n, 6, seed);
+        ENSURE(bench_backend(1, n, n, 6, seed) == r0);
+        ENSURE(bench_backend(2, n, n, 6, seed) == r0);
+    }
+}
+
+void tst_lu_simplex() {
+    tst_to_fraction(0.0, true, 0, 1);
+    tst_to_fraction(3.0, true, 3, 1);
+    tst_to_fraction(-2.5, true, -5, 2);
+    tst_to_fraction(1.0/3.0, true, 1, 3);
+    tst_to_fraction(-22.0/7.0 + 1e-12, true, -22, 7);
+    tst_to_fraction(3.14159265358979, true, 103993, 33102);
+    tst_to_fraction(1e20, false);
+    tst_to_integer(7.0, true, 7);
+    tst_to_integer(-3.0 + 1e-12, true, -3);
+    tst_to_integer(2.9999999999999, true, 3);
+    tst_to_integer(0.5, false);
+    tst_to_integer(-1e20, false);
+    tst_sparse_lu(4, 0);
+    tst_sparse_lu(50, 1);
+    tst_sparse_lu(200, 2);
+    tst_small_lp();
+    tst_incremental_lp();
+    tst_random_lp(10, 5, 0);
+    tst_random_lp(100, 60, 1);
+    tst_random_lp(400, 300, 2);
+}
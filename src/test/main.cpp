@@ -216,6 +216,25 @@ int main(int argc, char ** argv) {
     TST(polynorm);
     TST(qe_arith);
     TST(expr_substitution);
+    TST(sat_solver);
+    TST(concurrent_ast_table);
+    TST_ARGV(mk_app_bench);
+    TST(rational_threads);
+    TST_ARGV(rational_bench);
+    TST_ARGV(mpq_bench);
+    TST(lu_simplex);
+    TST_ARGV(lu_simplex_bench);
+    TST(cube_and_conquer);
+    TST(mam);
+    TST_ARGV(mam_bench);
+    TST(cg_table);
+    TST_ARGV(cg_table_bench);
+    TST(sat_bit_blaster);
+    TST(inc_sat_solver);
+    TST(aig);
+    TST(rewriter_cache);
+    TST(expr_traversal);
+    TST_ARGV(sat_bit_blaster_bench);
 }
 
 void initialize_mam() {}
@@ -0,0 +1,147 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    mam.cpp
+
+Abstract:
+
+    Test and benchmark for the matching abstract machine.
+    The benchmark uses axioms from src/smt/database.smt (select/store and 
+    the transitivity of ?PO), and a ground part of configurable size.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Revision History:
+
+--*/
+#include<iostream>
+#include<sstream>
+#include<fstream>
+#include<cstdio>
+#include<math.h>
+#include"smt_kernel.h"
+#include"smt_params.h"
+#include"cmd_context.h"
+#include"smt2parser.h"
+#include"reg_decl_plugins.h"
+#include"stopwatch.h"
+#include"test_util.h"
+
+static void mk_benchmark(unsigned n, std::ostream & out) {
+    out << "(declare-fun sel (Int Int) Int)\n"
+        << "(declare-fun upd (Int Int Int) Int)\n"
+        << "(declare-fun PO (Int Int) Int)\n"
+        << "(assert (forall ((a Int) (i Int) (e Int)) (! (= (sel (upd a i e) i) e) :pattern ((upd a i e)) :qid select1)))\n"
+        << "(assert (forall ((a Int) (i Int) (j Int) (e Int)) (! (or (= i j) (= (sel (upd a i e) j) (sel a j))) :pattern ((sel (upd a i e) j)) :qid select2)))\n"
+        << "(assert (forall ((t0 Int) (t1 Int) (t2 Int)) (! (or (not (= (PO t0 t1) 1)) (not (= (PO t1 t2) 1)) (= (PO t0 t2) 1)) :pattern ((PO t0 t1) (PO t1 t2)) :qid po_trans)))\n"
+        << "(assert (forall ((t0 Int) (t1 Int)) (! (or (not (= (PO t0 t1) 1)) (not (= (PO t1 t0) 1)) (= t0 t1)) :pattern ((PO t0 t1) (PO t1 t0)) :qid po_antisym)))\n";
+    for (unsigned i = 0; i <= n; i++)
+        out << "(declare-const a" << i << " Int)\n(declare-const c" << i << " Int)\n";
+    for (unsigned i = 0; i < n; i++) {
+        out << "(assert (= a" << (i+1) << " (upd a" << i << " " << (i+1) << " " << i << ")))\n";
+        out << "(assert (= (PO c" << i << " c" << (i+1) << ") 1))\n";
+    }
+    // sel(a_n, 0) must be equal to sel(a_0, 0), and c_0 <= c_n.
+    out << "(assert (or (not (= (sel a" << n << " 0) (sel a0 0))) (not (= (PO c0 c" << n << ") 1))))\n";
+}
+
+/**
+   \brief Solve the loop quantifier with the given cost function, and return
+   the instantiation profile in JSON.
+*/
+static std::string get_qi_profile(char const * cost, double eager_threshold) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    cmd_context ctx(false, &m);
+    ctx.set_ignore_check(true);
+    std::istringstream is("(declare-fun f (Int) Int)\n"
+                          "(declare-const a Int)\n"
+                          "(assert (forall ((x Int)) (! (> (f (f x)) (f x)) :pattern ((f x)) :qid loop)))\n"
+                          "(assert (> (f a) 0))\n");
+    ENSURE(parse_smt2_commands(ctx, is));
+    // the profile is written in the working directory of the test.
+    std::string file_name = "tst_qi_profile.json";
+    smt_params fp;
+    fp.m_mbqi               = false;
+    fp.m_qi_profile_json    = file_name;
+    fp.m_qi_max_instances   = 100;
+    fp.m_qi_cost            = cost;
+    fp.m_qi_eager_threshold = eager_threshold;
+    {
+        smt::kernel k(m, fp);
+        ptr_vector<expr>::const_iterator it  = ctx.begin_assertions();
+        ptr_vector<expr>::const_iterator end = ctx.end_assertions();
+        for (; it != end; ++it)
+            k.assert_expr(*it);
+        k.check();
+    }
+    std::ifstream in(file_name.c_str());
+    std::stringstream json;
+    json << in.rdbuf();
+    in.close();
+    remove(file_name.c_str());
+    std::cout << json.str();
+    return json.str();
+}
+
+static void tst_qi_profile() {
+    // The quantifier loop has a matching loop.
+    std::string json = get_qi_profile("(+ weight generation)", 10.0);
+    ENSURE(json.find("\"qid\": \"loop\"") != std::string::npos);
+    ENSURE(json.find("\"max_chain\": 1,") == std::string::npos);
+    ENSURE(json.find("\"max_repeated_fingerprints\": 1,") == std::string::npos);
+    ENSURE(json.find("\"max_repeated_fingerprints\": 0,") == std::string::npos);
+    // the cost overflows to infinity, it is not valid JSON.
+    json = get_qi_profile("(* 1000000000 (* 1000000000 (* 1000000000 (* 1000000000 1000000000))))", HUGE_VAL);
+    ENSURE(json.find("\"max_cost\": null") != std::string::npos);
+    ENSURE(json.find("inf") == std::string::npos && json.find("nan") == std::string::npos);
+}
+
+static void run_benchmark(unsigned n) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    cmd_context ctx(false, &m);
+    ctx.set_ignore_check(true);
+    std::ostringstream buffer;
+    mk_benchmark(n, buffer);
+    std::istringstream is(buffer.str());
+    ENSURE(parse_smt2_commands(ctx, is));
+    smt_params fp;
+    fp.m_mbqi = false;
+    smt::kernel k(m, fp);
+    ptr_vector<expr>::const_iterator it  = ctx.begin_assertions();
+    ptr_vector<expr>::const_iterator end = ctx.end_assertions();
+    for (; it != end; ++it)
+        k.assert_expr(*it);
+    stopwatch sw;
+    sw.start();
+    lbool r = k.check();
+    sw.stop();
+    ENSURE(r == l_false);
+    statistics st;
+    k.collect_statistics(st);
+    std::cout << "size: " << n << ", time: " << sw.get_seconds() << " secs\n";
+    for (unsigned i = 0; i < st.size(); i++) {
+        if (strncmp(st.get_key(i), "mam ", 4) == 0 || strcmp(st.get_key(i), "quant instantiations") == 0)
+            std::cout << "  " << st.get_key(i) << ": " << st.get_uint_value(i) << "\n";
+    }
+}
+
+void tst_mam_bench(char ** argv, int argc, int & i) {
+    unsigned n = 40;
+    if (i + 1 < argc) {
+        n = atol(argv[i+1]);
+        i += 1;
+    }
+    run_benchmark(n);
+}
+
+void tst_mam() {
+    run_benchmark(5);
+    run_benchmark(15);
+    tst_qi_profile();
+}
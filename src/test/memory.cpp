@@ -55,6 +55,47 @@ void tst_memory() {
 }
 
 #else
+#include <iostream>
+#include "util.h"
+#include "memory_manager.h"
+#include "z3_omp.h"
+#include "test_util.h"
+
+// Blocks are allocated by one thread, and deallocated by another one.
+// Thus, the free lists of each thread receive blocks of all size classes.
+// A block handed out twice by the free lists would be overwritten, and fail the check.
+static void tst_thread_cache(unsigned num_threads, unsigned num_blocks) {
+    unsigned ** blocks = alloc_svect(unsigned*, num_threads * num_blocks);
+    for (unsigned round = 0; round < 4; round++) {
+        #pragma omp parallel for num_threads(num_threads)
+        for (int t = 0; t < static_cast<int>(num_threads); t++) {
+            for (unsigned i = 0; i < num_blocks; i++) {
+                unsigned sz  = 1 + (i + round) % 200;
+                unsigned * b = alloc_svect(unsigned, sz);
+                for (unsigned j = 0; j < sz; j++)
+                    b[j] = t + i + j;
+                blocks[t * num_blocks + i] = b;
+            }
+        }
+        #pragma omp parallel for num_threads(num_threads)
+        for (int t = 0; t < static_cast<int>(num_threads); t++) {
+            unsigned owner = (t + 1) % num_threads;
+            for (unsigned i = 0; i < num_blocks; i++) {
+                unsigned sz  = 1 + (i + round) % 200;
+                unsigned * b = blocks[owner * num_blocks + i];
+                for (unsigned j = 0; j < sz; j++) 
+                    ENSURE(b[j] == owner + i + j);
+                dealloc_svect(b);
+            }
+        }
+    }
+    dealloc_svect(blocks);
+    std::cout << "max. memory: " << memory::get_max_used_memory() << "\n";
+}
+
 void tst_memory() {    
+    tst_thread_cache(1, 1000);
+    tst_thread_cache(4, 10000);
+    tst_thread_cache(8, 20000);
 }
 #endif
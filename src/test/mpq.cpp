@@ -20,6 +20,7 @@ Revision History:
 #include"mpq.h"
 #include"rational.h"
 #include"timeit.h"
+#include"z3_omp.h"
 
 static void tst0() {
     synch_mpq_manager m;
@@ -159,7 +160,130 @@ static void tst_prev_power_2() {
     tst_prev_power_2((1ll << 60), 3, 58);
 }
 
+// Rational operations whose intermediate results overflow int64.
+static void tst_small_overflow() {
+    unsynch_mpq_manager m;
+    scoped_mpq a(m), b(m), c(m), d(m);
+    m.set(a, INT64_MAX, static_cast<uint64>(3));
+    m.set(b, static_cast<int64>(1), static_cast<uint64>(3));
+    m.add(a, b, c);
+    SASSERT(m.to_string(c) == "9223372036854775808/3");
+    m.sub(c, b, d);
+    SASSERT(m.eq(d, a));
+    m.set(a, static_cast<int64>(1), static_cast<uint64>(INT64_MAX));
+    m.set(b, static_cast<int64>(1), static_cast<uint64>(INT64_MAX - 1));
+    m.add(a, b, c);
+    SASSERT(m.to_string(c) == "18446744073709551613/85070591730234615838173535747377725442");
+    m.sub(a, b, c);
+    SASSERT(m.to_string(c) == "-1/85070591730234615838173535747377725442");
+    // cross gcds are removed before the products
+    m.set(a, static_cast<int64>(1) << 40, static_cast<uint64>(3));
+    m.set(b, static_cast<int64>(9), static_cast<uint64>(1) << 41);
+    m.mul(a, b, c);
+    SASSERT(m.to_string(c) == "3/2");
+    m.set(a, INT64_MIN, static_cast<uint64>(3));
+    m.set(b, -3);
+    m.mul(a, b, c);
+    SASSERT(m.to_string(c) == "9223372036854775808");
+    m.mul(a, a, c);
+    SASSERT(m.to_string(c) == "85070591730234615865843651857942052864/9");
+    // aliasing
+    m.set(a, 2, 3);
+    m.set(b, 5, 7);
+    m.add(a, b, a);
+    SASSERT(m.eq(a, m.mk_q(29, 21)));
+    m.sub(b, a, b);
+    SASSERT(m.eq(b, m.mk_q(-14, 21)));
+    m.mul(b, b, b);
+    SASSERT(m.eq(b, m.mk_q(4, 9)));
+}
+
+/**
+   \brief Simplex style pivoting over a sparse tableau with small coefficients,
+   like the ones produced by QF_LRA and QF_LIA problems. Most of the entries 
+   and intermediate results fit in 64 bits.
+*/
+static double mpq_pivot_bench(unsigned num_rows, unsigned num_cols, unsigned num_pivots, unsigned seed, rational & checksum) {
+    typedef vector<rational> row;
+    vector<row> t;
+    for (unsigned i = 0; i < num_rows; i++) {
+        t.push_back(row());
+        t[i].resize(num_cols, rational());
+        for (unsigned k = 0; k < 3; k++) {
+            seed = seed * 1103515245 + 12345;
+            int v = static_cast<int>((seed >> 16) % 9) - 4;
+            t[i][(seed >> 8) % num_cols] = rational(v == 0 ? 1 : v);
+        }
+    }
+    double start = omp_get_wtime();
+    unsigned pivots = 0;
+    while (pivots < num_pivots) {
+        seed = seed * 1103515245 + 12345;
+        unsigned r = (seed >> 16) % num_rows;
+        unsigned c = (seed >> 4) % num_cols;
+        unsigned j = 0;
+        while (j < num_cols && t[r][(c + j) % num_cols].is_zero())
+            j++;
+        if (j == num_cols)
+            continue;
+        c = (c + j) % num_cols;
+        rational a = t[r][c];
+        for (unsigned k = 0; k < num_cols; k++) 
+            if (!t[r][k].is_zero())
+                t[r][k] /= a;
+        for (unsigned i = 0; i < num_rows; i++) {
+            if (i == r || t[i][c].is_zero())
+                continue;
+            rational b = -t[i][c];
+            for (unsigned k = 0; k < num_cols; k++)
+                if (!t[r][k].is_zero())
+                    t[i][k].addmul(b, t[r][k]);
+        }
+        pivots++;
+    }
+    double r = num_pivots / (omp_get_wtime() - start);
+    for (unsigned i = 0; i < num_rows; i++)
+        for (unsigned k = 0; k < num_cols; k++)
+            checksum += t[i][k];
+    return r;
+}
+
+/**
+   \brief Integer addmul with operands between 2^32 and 2^36, and results 
+   that fit in 64 bits (e.g., bounds and assignments of QF_LIA problems).
+*/
+static double mpq_addmul_bench(unsigned num_ops, rational & checksum) {
+    vector<rational> as;
+    unsigned seed = 0;
+    for (unsigned i = 0; i < 1024; i++) {
+        seed = seed * 1103515245 + 12345;
+        as.push_back(rational(seed) * rational(16));
+    }
+    rational acc;
+    double start = omp_get_wtime();
+    for (unsigned k = 0; k < num_ops; k++) {
+        rational b(static_cast<int>(k % 7) - 3);
+        acc.addmul(b, as[k % 1024]);
+    }
+    double r = num_ops / (omp_get_wtime() - start);
+    checksum += acc;
+    return r;
+}
+
+void tst_mpq_bench(char ** argv, int argc, int & i) {
+    unsigned num_pivots = 20000;
+    if (i + 1 < argc) {
+        num_pivots = atol(argv[i+1]);
+        i += 1;
+    }
+    rational checksum;
+    std::cout << "20x40 tableau, pivots/s: " << mpq_pivot_bench(20, 40, num_pivots, 0, checksum) << "\n";
+    std::cout << "35-bit addmul, ops/s: " << mpq_addmul_bench(100 * num_pivots, checksum) << "\n";
+    std::cout << "checksum: " << checksum << std::endl;
+}
+
 void tst_mpq() {
+    tst_small_overflow();
     tst_prev_power_2();
     set_str_bug();
     bug2();
@@ -274,6 +274,71 @@ static void tst_2k() {
     tst_mul2k(m, "-109298387475737181762639999000000231", 32);
 }
 
+// Operations on numbers close to the int64 boundaries, where the 
+// small number fast paths must fall back to big numbers.
+static void tst_int64_boundary() {
+    unsynch_mpz_manager m;
+    scoped_mpz a(m), b(m), c(m), d(m), e(m);
+    m.set(a, INT64_MAX);
+    m.set(b, 1);
+    m.add(a, b, c);
+    SASSERT(m.to_string(c) == "9223372036854775808");
+    SASSERT(!m.is_int64(c));
+    m.sub(c, b, d);
+    SASSERT(m.eq(d, a) && m.is_int64(d) && m.get_int64(d) == INT64_MAX);
+    SASSERT(m.hash(d) == m.hash(a));
+    m.set(a, INT64_MIN);
+    m.sub(a, b, c);
+    SASSERT(m.to_string(c) == "-9223372036854775809");
+    m.add(c, b, d);
+    SASSERT(m.eq(d, a) && m.get_int64(d) == INT64_MIN);
+    // -INT64_MIN and INT64_MIN / -1 are not int64
+    m.set(c, a);
+    m.neg(c);
+    SASSERT(m.to_string(c) == "9223372036854775808");
+    m.set(c, a);
+    m.abs(c);
+    SASSERT(m.to_string(c) == "9223372036854775808");
+    m.set(b, -1);
+    m.machine_div(a, b, c);
+    SASSERT(m.to_string(c) == "9223372036854775808");
+    m.rem(a, b, c);
+    SASSERT(m.is_zero(c));
+    m.mul(a, b, c);
+    SASSERT(m.to_string(c) == "9223372036854775808");
+    // products of 32-bit numbers stay small, bigger ones do not
+    m.set(a, UINT_MAX);
+    m.mul(a, a, c);
+    SASSERT(m.to_string(c) == "18446744065119617025");
+    m.set(a, INT_MIN);
+    m.mul(a, a, c);
+    SASSERT(m.to_string(c) == "4611686018427387904" && m.is_int64(c));
+    m.mul(c, a, d);
+    SASSERT(m.to_string(d) == "-9903520314283042199192993792");
+    m.div(d, a, e);
+    SASSERT(m.eq(e, c));
+    m.set(a, static_cast<int64>(3) << 40);
+    m.set(b, static_cast<int64>(5) << 33);
+    m.gcd(a, b, c);
+    SASSERT(m.get_int64(c) == static_cast<int64>(1) << 33);
+    m.set(a, INT64_MIN);
+    m.gcd(a, a, c);
+    SASSERT(m.to_string(c) == "9223372036854775808");
+    m.set(a, 3);
+    m.mul2k(a, 61, c);
+    SASSERT(m.to_string(c) == "6917529027641081856");
+    m.mul2k(a, 62, c);
+    SASSERT(m.to_string(c) == "13835058055282163712");
+    m.machine_div2k(c, 62, d);
+    SASSERT(m.get_int64(d) == 3);
+    m.set(a, -(static_cast<int64>(1) << 40));
+    SASSERT(m.power_of_two_multiple(a) == 40 && m.mlog2(a) == 40);
+    m.power(mpz(2), 62, c);
+    SASSERT(m.log2(c) == 62 && m.is_power_of_two(c));
+    m.power(mpz(2), 63, c);
+    SASSERT(m.to_string(c) == "9223372036854775808");
+}
+
 void tst_int_min_bug() {
     synch_mpz_manager m;
     mpz intmin(INT_MIN);
@@ -502,6 +567,7 @@ void tst_mpz() {
     // tst_gcd();
     tst_scoped();
     tst_int_min_bug();
+    tst_int64_boundary();
     bug4();
     bug3();
     bug1();
@@ -0,0 +1,130 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    rational_threads.cpp
+
+Abstract:
+
+    Test rational numbers used by multiple threads, and
+    benchmark rational arithmetic throughput.
+
+Author:
+
+    agent (agent) 2026-10-16.
+
+Revision History:
+
+--*/
+#include<iostream>
+#include"rational.h"
+#include"vector.h"
+#include"z3_omp.h"
+
+/**
+   \brief Gauss-Jordan elimination over the rationals.
+   This is the kind of work performed by the pivoting steps of theory_arith:
+   the entries grow into big numbers, and most of the time is spent in addmul.
+*/
+struct rational_pivot_bench {
+    typedef vector<rational> row;
+    unsigned     m_dim;
+    vector<row>  m_rows;
+
+    rational_pivot_bench(unsigned dim, unsigned seed):
+        m_dim(dim) {
+        for (unsigned i = 0; i < dim; i++) {
+            m_rows.push_back(row());
+            for (unsigned j = 0; j < dim; j++) {
+                seed = seed * 1103515245 + 12345;
+                m_rows[i].push_back(rational(static_cast<int>((seed >> 16) % 201) - 100));
+            }
+        }
+    }
+
+    // Return the product of the pivots (i.e., the determinant up to sign).
+    rational run() {
+        rational det(1);
+        for (unsigned k = 0; k < m_dim; k++) {
+            unsigned p = k;
+            while (p < m_dim && m_rows[p][k].is_zero())
+                p++;
+            if (p == m_dim)
+                return rational(0);
+            if (p != k)
+                m_rows[p].swap(m_rows[k]);
+            rational pivot = m_rows[k][k];
+            det *= pivot;
+            for (unsigned j = k; j < m_dim; j++)
+                m_rows[k][j] /= pivot;
+            for (unsigned i = 0; i < m_dim; i++) {
+                if (i == k || m_rows[i][k].is_zero())
+                    continue;
+                rational c = -m_rows[i][k];
+                for (unsigned j = k; j < m_dim; j++)
+                    m_rows[i][j].addmul(c, m_rows[k][j]);
+            }
+        }
+        return det;
+    }
+};
+
+// Execute num_tasks eliminations using num_threads threads.
+// Task t uses seed t % num_seeds. Return the number of tasks per second (wall clock).
+static double run_pivot_tasks(unsigned num_threads, unsigned num_tasks, unsigned num_seeds, unsigned dim, vector<rational> & results) {
+    results.reset();
+    results.resize(num_tasks, rational());
+    double start = omp_get_wtime();
+    #pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+    for (int t = 0; t < static_cast<int>(num_tasks); t++) {
+        rational_pivot_bench b(dim, t % num_seeds);
+        results[t] = b.run();
+    }
+    return num_tasks / (omp_get_wtime() - start);
+}
+
+void tst_rational_threads() {
+    vector<rational> expected;
+    for (unsigned s = 0; s < 4; s++) {
+        rational_pivot_bench b(12, s);
+        expected.push_back(b.run());
+        SASSERT(expected.back().is_int());
+    }
+    // the results are big numbers created by the worker threads, and deleted by this one.
+    vector<rational> results;
+    run_pivot_tasks(4, 64, 4, 12, results);
+    for (unsigned t = 0; t < results.size(); t++) {
+        SASSERT(results[t] == expected[t % 4]);
+    }
+    // numbers created by this thread are updated and deleted by the worker threads.
+    vector<rational> shared;
+    for (unsigned t = 0; t < 16; t++)
+        shared.push_back(expected[t % 4]);
+    #pragma omp parallel for num_threads(4)
+    for (int t = 0; t < 16; t++) {
+        shared[t] *= shared[t];
+        shared[t] = rational(t);
+    }
+    for (unsigned t = 0; t < 16; t++) {
+        SASSERT(shared[t] == rational(t));
+    }
+}
+
+void tst_rational_bench(char ** argv, int argc, int & i) {
+#ifndef _NO_OMP_
+    unsigned num_tasks = 400;
+    if (i + 1 < argc) {
+        num_tasks = atol(argv[i+1]);
+        i += 1;
+    }
+    std::cout << "30x30 eliminations: " << num_tasks << ", processors: " << omp_get_num_procs() << "\n";
+    vector<rational> results;
+    unsigned threads[4] = { 1, 2, 4, 16 };
+    for (unsigned j = 0; j < 4; j++) {
+        unsigned n = threads[j];
+        std::cout << "threads: " << n
+                  << " eliminations/s: " << run_pivot_tasks(n, num_tasks, num_tasks, 30, results) << std::endl;
+    }
+#endif
+}
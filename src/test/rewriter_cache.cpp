@@ -0,0 +1,227 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    rewriter_cache.cpp
+
+Abstract:
+
+    Test the rewriting cache shared by th_rewriter instances
+    and simplification tactics.
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Revision History:
+
+--*/
+#include<iostream>
+#include"rewriter_cache.h"
+#include"th_rewriter.h"
+#include"simplify_tactic.h"
+#include"arith_decl_plugin.h"
+#include"reg_decl_plugins.h"
+#include"statistics.h"
+#include"gparams.h"
+#include"util.h"
+#include"test_util.h"
+
+static void tst_eviction() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref_vector ts(m);
+    for (unsigned i = 0; i < 10; i++)
+        ts.push_back(a.mk_numeral(rational(i), true));
+    rewriter_cache c(m, 4);
+    for (unsigned i = 0; i < 4; i++)
+        c.insert(ts.get(i), 0, ts.get(i+1));
+    SASSERT(c.size() == 4);
+    // same key, different configuration
+    SASSERT(c.find(ts.get(0), 1) == 0);
+    SASSERT(c.find(ts.get(0), 0) == ts.get(1));
+    SASSERT(c.find(ts.get(2), 0) == ts.get(3));
+    // entries 1 and 3 were not used, so they are evicted first
+    c.insert(ts.get(5), 0, ts.get(6));
+    c.insert(ts.get(6), 0, ts.get(7));
+    SASSERT(c.size() == 4);
+    SASSERT(c.evictions() == 2);
+    SASSERT(c.find(ts.get(1), 0) == 0);
+    SASSERT(c.find(ts.get(3), 0) == 0);
+    SASSERT(c.find(ts.get(0), 0) == ts.get(1));
+    SASSERT(c.find(ts.get(5), 0) == ts.get(6));
+    statistics st;
+    c.collect_statistics(st);
+    st.display(std::cout);
+    c.reset();
+    SASSERT(c.size() == 0);
+}
+
+static void tst_config_id() {
+    ast_manager m;
+    rewriter_cache c(m, 4);
+    unsigned id1 = c.get_config_id(symbol("(:som true)"));
+    unsigned id2 = c.get_config_id(symbol("(:som false)"));
+    ENSURE(id1 != id2);
+    ENSURE(c.get_config_id(symbol("(:som true)")) == id1);
+    // ids survive reset, since rewriters keep them.
+    c.reset();
+    ENSURE(c.get_config_id(symbol("(:som false)")) == id2);
+    ENSURE(c.get_config_id(symbol("(:flat false)")) != id1);
+}
+
+static expr * mk_random_term(arith_util & a, expr_ref_vector & pool, random_gen & r) {
+    expr * t1 = pool.get(r(pool.size()));
+    expr * t2 = pool.get(r(pool.size()));
+    expr * t = 0;
+    switch (r(4)) {
+    case 0:  t = a.mk_add(t1, t2); break;
+    case 1:  t = a.mk_mul(t1, a.mk_numeral(rational(r(3)), true)); break;
+    case 2:  t = a.mk_sub(t1, t2); break;
+    default: t = a.mk_add(t1, a.mk_numeral(rational(r(5)), true), t2); break;
+    }
+    pool.push_back(t);
+    return t;
+}
+
+static void mk_random_formulas(ast_manager & m, random_gen & r, unsigned num, expr_ref_vector & result) {
+    arith_util a(m);
+    expr_ref_vector pool(m);
+    pool.push_back(m.mk_const(symbol("x"), a.mk_int()));
+    pool.push_back(m.mk_const(symbol("y"), a.mk_int()));
+    pool.push_back(m.mk_const(symbol("z"), a.mk_int()));
+    for (unsigned i = 0; i < num; i++) {
+        expr * t1 = mk_random_term(a, pool, r);
+        expr * t2 = mk_random_term(a, pool, r);
+        result.push_back(r(2) == 0 ? a.mk_le(t1, t2) : m.mk_not(m.mk_eq(t1, t2)));
+    }
+}
+
+static void tst_shared(unsigned seed) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    random_gen r(seed);
+    expr_ref_vector fs(m);
+    mk_random_formulas(m, r, 30, fs);
+
+    expr_ref_vector expected(m);
+    {
+        th_rewriter rw(m);
+        for (unsigned i = 0; i < fs.size(); i++) {
+            expr_ref tmp(m);
+            rw(fs.get(i), tmp);
+            expected.push_back(tmp);
+        }
+    }
+
+    ref<rewriter_cache> c = alloc(rewriter_cache, m, 1000);
+    for (unsigned round = 0; round < 2; round++) {
+        th_rewriter rw(m);
+        rw.set_shared_cache(c.get());
+        for (unsigned i = 0; i < fs.size(); i++) {
+            expr_ref tmp(m);
+            rw(fs.get(i), tmp);
+            SASSERT(tmp == expected.get(i));
+        }
+        rw.set_shared_cache(0);
+    }
+    std::cout << "hits: " << c->hits() << " misses: " << c->misses() << " size: " << c->size() << "\n";
+    SASSERT(c->hits() >= fs.size());
+
+    // rewriters with a different configuration do not reuse the cached results
+    unsigned old_hits = c->hits();
+    params_ref p;
+    p.set_bool("som", true);
+    th_rewriter rw(m, p);
+    rw.set_shared_cache(c.get());
+    for (unsigned i = 0; i < fs.size(); i++) {
+        expr_ref tmp(m);
+        rw(fs.get(i), tmp);
+    }
+    rw.set_shared_cache(0);
+    SASSERT(c->hits() == old_hits);
+
+    // the global parameters of the rewriter module are part of the configuration
+    gparams::set("rewriter.som", "true");
+    {
+        th_rewriter rw(m);
+        rw.set_shared_cache(c.get());
+        for (unsigned i = 0; i < fs.size(); i++) {
+            expr_ref tmp(m);
+            rw(fs.get(i), tmp);
+        }
+        rw.set_shared_cache(0);
+    }
+    gparams::reset();
+    ENSURE(c->hits() == old_hits);
+
+    // a tiny cache is still correct
+    ref<rewriter_cache> small = alloc(rewriter_cache, m, 3);
+    for (unsigned round = 0; round < 2; round++) {
+        th_rewriter rw(m);
+        rw.set_shared_cache(small.get());
+        for (unsigned i = 0; i < fs.size(); i++) {
+            expr_ref tmp(m);
+            rw(fs.get(i), tmp);
+            SASSERT(tmp == expected.get(i));
+        }
+        rw.set_shared_cache(0);
+    }
+    SASSERT(small->size() <= 3);
+    SASSERT(small->evictions() > 0);
+}
+
+static void tst_tactic(unsigned seed) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    random_gen r(seed);
+    expr_ref_vector fs(m);
+    mk_random_formulas(m, r, 20, fs);
+
+    params_ref p;
+    p.set_uint("shared_cache_size", 10000);
+    tactic_ref t1 = mk_simplify_tactic(m, p);
+    tactic_ref t2 = mk_simplify_tactic(m, p);
+    tactic_ref t3 = mk_simplify_tactic(m);
+
+    goal_ref g = alloc(goal, m);
+    for (unsigned i = 0; i < fs.size(); i++)
+        g->assert_expr(fs.get(i));
+    goal_ref g3 = alloc(goal, *g);
+    // goals derived from g share its cache
+    g->set_rw_cache(alloc(rewriter_cache, m, 10000));
+    goal_ref g1 = alloc(goal, *g);
+    goal_ref g2 = alloc(goal, *g);
+    SASSERT(g1->rw_cache() == g->rw_cache() && g2->rw_cache() == g->rw_cache());
+
+    goal_ref_buffer result;
+    model_converter_ref mc;
+    proof_converter_ref pc;
+    expr_dependency_ref core(m);
+    (*t1)(g1, result, mc, pc, core);
+    result.reset();
+    (*t2)(g2, result, mc, pc, core);
+    result.reset();
+    (*t3)(g3, result, mc, pc, core);
+    SASSERT(g3->rw_cache() == 0);
+    SASSERT(g1->size() == g3->size() && g2->size() == g3->size());
+    for (unsigned i = 0; i < g3->size(); i++) {
+        SASSERT(g1->form(i) == g3->form(i));
+        SASSERT(g2->form(i) == g3->form(i));
+    }
+    statistics st;
+    t2->collect_statistics(st);
+    st.display(std::cout);
+    SASSERT(g2->rw_cache()->hits() > 0);
+}
+
+void tst_rewriter_cache() {
+    tst_eviction();
+    tst_config_id();
+    for (unsigned i = 0; i < 10; i++) {
+        tst_shared(i);
+        tst_tactic(i);
+    }
+}
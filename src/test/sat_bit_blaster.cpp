@@ -0,0 +1,218 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_bit_blaster.cpp
+
+Abstract:
+
+    Test the bit-blaster that produces clauses for sat::solver directly,
+    and compare it with bit_blaster_rewriter + goal2sat (the path used by
+    bit_blaster_tactic and sat_tactic).
+
+Author:
+
+    agent (agent) 2026-10-17.
+
+Revision History:
+
+--*/
+#include<iostream>
+#include"sat_bit_blaster.h"
+#include"bit_blaster_rewriter.h"
+#include"goal2sat.h"
+#include"th_rewriter.h"
+#include"bv_decl_plugin.h"
+#include"reg_decl_plugins.h"
+#include"stopwatch.h"
+#include"util.h"
+#include"test_util.h"
+
+/**
+   \brief Check the value of op(a, b) computed by the SAT solver against the rewriter.
+*/
+static void tst_op(ast_manager & m, decl_kind k, unsigned sz, rational const & a, rational const & b) {
+    bv_util bv(m);
+    sort * s = bv.mk_sort(sz);
+    expr_ref x(m.mk_const(symbol("x"), s), m);
+    expr_ref y(m.mk_const(symbol("y"), s), m);
+    expr_ref t(m.mk_app(bv.get_fid(), k, x, y), m);
+    params_ref p;
+    sat::solver solver(p, 0);
+    sat_bit_blaster bb(m, solver);
+    bb.assert_expr(m.mk_eq(x, bv.mk_numeral(a, sz)));
+    bb.assert_expr(m.mk_eq(y, bv.mk_numeral(b, sz)));
+    expr_ref f(m);
+    if (m.is_bool(t))
+        f = m.mk_or(t, m.mk_not(t));
+    else
+        f = m.mk_eq(t, t);
+    bb.assert_expr(f);
+    ENSURE(solver.check() == l_true);
+    rational v;
+    ENSURE(bb.eval(t, v));
+    th_rewriter rw(m);
+    expr_ref expected(m.mk_app(bv.get_fid(), k, bv.mk_numeral(a, sz), bv.mk_numeral(b, sz)), m);
+    rw(expected);
+    rational ev;
+    unsigned ev_sz;
+    if (m.is_true(expected))
+        ev = rational(1);
+    else if (m.is_false(expected))
+        ev = rational(0);
+    else
+        ENSURE(bv.is_numeral(expected, ev, ev_sz));
+    if (v != ev) {
+        std::cout << "op: " << k << " " << a << " " << b << ", sat: " << v << ", expected: " << ev << "\n";
+        UNREACHABLE();
+    }
+}
+
+static void tst_ops() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    random_gen r(0);
+    decl_kind ops[] = { OP_BADD, OP_BSUB, OP_BMUL, OP_BUDIV_I, OP_BUREM_I, OP_BSDIV_I, OP_BSREM_I, OP_BSMOD_I,
+                        OP_BAND, OP_BOR, OP_BXOR, OP_BSHL, OP_BLSHR, OP_BASHR, OP_CONCAT,
+                        OP_ULEQ, OP_SLEQ, OP_ULT, OP_SGT };
+    for (unsigned i = 0; i < sizeof(ops)/sizeof(decl_kind); i++) {
+        for (unsigned j = 0; j < 20; j++) {
+            rational a(r(256)), b(r(256));
+            if ((ops[i] == OP_BUDIV_I || ops[i] == OP_BUREM_I || ops[i] == OP_BSDIV_I ||
+                 ops[i] == OP_BSREM_I || ops[i] == OP_BSMOD_I) && b.is_zero())
+                b = rational(3);
+            tst_op(m, ops[i], 8, a, b);
+        }
+    }
+}
+
+/**
+   \brief x * y = n, 1 < x < 2^(sz/2), 1 < y < 2^(sz/2)
+*/
+static expr * mk_factor(ast_manager & m, unsigned sz, rational const & n, expr_ref & x, expr_ref & y) {
+    bv_util bv(m);
+    sort * s = bv.mk_sort(sz);
+    x = m.mk_fresh_const("x", s);
+    y = m.mk_fresh_const("y", s);
+    expr * one = bv.mk_numeral(rational(1), sz);
+    expr * max = bv.mk_numeral(rational::power_of_two(sz/2), sz);
+    expr * args[5] = {
+        m.mk_eq(bv.mk_bv_mul(x, y), bv.mk_numeral(n, sz)),
+        m.mk_not(bv.mk_ule(x, one)),
+        m.mk_not(bv.mk_ule(y, one)),
+        m.mk_not(bv.mk_ule(max, x)),
+        m.mk_not(bv.mk_ule(max, y))
+    };
+    return m.mk_and(5, args);
+}
+
+static lbool solve_ast(ast_manager & m, expr * f) {
+    params_ref p;
+    bit_blaster_rewriter rw(m, p);
+    expr_ref r(m);
+    proof_ref pr(m);
+    rw(f, r, pr);
+    goal_ref g = alloc(goal, m);
+    g->assert_expr(r);
+    sat::solver solver(p, 0);
+    atom2bool_var map(m);
+    goal2sat g2s;
+    g2s(*g, p, solver, map);
+    return solver.check();
+}
+
+static void tst_factor(unsigned sz, unsigned n, lbool expected) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref x(m), y(m);
+    expr_ref f(mk_factor(m, sz, rational(n), x, y), m);
+    params_ref p;
+    sat::solver solver(p, 0);
+    sat_bit_blaster bb(m, solver);
+    bb.assert_expr(f);
+    lbool r = solver.check();
+    ENSURE(r == expected);
+    ENSURE(solve_ast(m, f) == expected);
+    if (r == l_true) {
+        rational vx, vy;
+        ENSURE(bb.eval(x, vx) && bb.eval(y, vy));
+        std::cout << n << " = " << vx << " * " << vy << "\n";
+        ENSURE(vx * vy == rational(n));
+    }
+}
+
+void tst_sat_bit_blaster() {
+    tst_ops();
+    tst_factor(16, 143, l_true);
+    tst_factor(16, 251, l_false);
+    tst_factor(24, 3901, l_true);
+}
+
+/**
+   \brief sum_i x_i * y_i = c where the x_i, y_i are bit-vectors of size sz.
+*/
+static expr * mk_mul_benchmark(ast_manager & m, unsigned sz, unsigned n) {
+    bv_util bv(m);
+    sort * s = bv.mk_sort(sz);
+    expr_ref sum(m);
+    for (unsigned i = 0; i < n; i++) {
+        expr * p = bv.mk_bv_mul(m.mk_fresh_const("x", s), m.mk_fresh_const("y", s));
+        sum = i == 0 ? p : bv.mk_bv_add(sum, p);
+    }
+    return m.mk_eq(sum, bv.mk_numeral(rational(12345), sz));
+}
+
+static void display_mem(char const * header, unsigned long long before, double secs, unsigned num_vars) {
+    unsigned long long after = memory::get_allocation_size();
+    std::cout << header << ": time: " << secs << " secs, memory: "
+              << static_cast<double>(after - before)/static_cast<double>(1024*1024) << " MB, sat vars: " << num_vars << "\n";
+}
+
+void tst_sat_bit_blaster_bench(char ** argv, int argc, int & i) {
+    unsigned sz = 64;
+    unsigned n  = 8;
+    if (i + 2 < argc) {
+        sz = atol(argv[i+1]);
+        n  = atol(argv[i+2]);
+        i += 2;
+    }
+    std::cout << "bit-vector size: " << sz << ", multiplications: " << n << "\n";
+    params_ref p;
+    {
+        ast_manager m;
+        reg_decl_plugins(m);
+        expr_ref f(mk_mul_benchmark(m, sz, n), m);
+        unsigned long long before = memory::get_allocation_size();
+        stopwatch sw;
+        sw.start();
+        bit_blaster_rewriter rw(m, p);
+        expr_ref r(m);
+        proof_ref pr(m);
+        rw(f, r, pr);
+        goal_ref g = alloc(goal, m);
+        g->assert_expr(r);
+        sat::solver solver(p, 0);
+        atom2bool_var map(m);
+        goal2sat g2s;
+        g2s(*g, p, solver, map);
+        sw.stop();
+        display_mem("bit_blaster_rewriter + goal2sat", before, sw.get_seconds(), solver.num_vars());
+    }
+    {
+        ast_manager m;
+        reg_decl_plugins(m);
+        expr_ref f(mk_mul_benchmark(m, sz, n), m);
+        unsigned long long before = memory::get_allocation_size();
+        stopwatch sw;
+        sw.start();
+        sat::solver solver(p, 0);
+        sat_bit_blaster bb(m, solver);
+        bb.assert_expr(f);
+        sw.stop();
+        display_mem("sat_bit_blaster", before, sw.get_seconds(), solver.num_vars());
+        statistics st;
+        bb.collect_statistics(st);
+        st.display(std::cout);
+    }
+}
@@ -0,0 +1,648 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_solver.cpp
+
+Abstract:
+
+    Test SAT solver: assumptions, unsat cores and user scopes.
+
+Author:
+
+    agent (agent) 2026-10-16.
+
+Revision History:
+
+--*/
+#include"sat_solver.h"
+#include"sat_parallel.h"
+#include"util.h"
+#include"test_util.h"
+#include<cstdio>
+#include<fstream>
+#include<algorithm>
+
+typedef vector<sat::literal_vector> clause_set;
+
+static void add_clauses(sat::solver & s, clause_set & cs) {
+    for (unsigned i = 0; i < cs.size(); i++)
+        s.mk_clause(cs[i].size(), cs[i].c_ptr());
+}
+
+static bool satisfies(sat::model const & m, clause_set const & cs) {
+    for (unsigned i = 0; i < cs.size(); i++) {
+        bool sat = false;
+        for (unsigned j = 0; !sat && j < cs[i].size(); j++)
+            sat = sat::value_at(cs[i][j], m) == l_true;
+        if (!sat)
+            return false;
+    }
+    return true;
+}
+
+// n+1 pigeons in n holes
+static void mk_pigeonhole(sat::solver & s, unsigned n, clause_set & cs) {
+    svector<sat::bool_var> p;
+    for (unsigned i = 0; i < (n + 1) * n; i++)
+        p.push_back(s.mk_var());
+    for (unsigned i = 0; i <= n; i++) {
+        sat::literal_vector c;
+        for (unsigned j = 0; j < n; j++)
+            c.push_back(sat::literal(p[i*n + j], false));
+        cs.push_back(c);
+    }
+    for (unsigned j = 0; j < n; j++) {
+        for (unsigned i1 = 0; i1 <= n; i1++) {
+            for (unsigned i2 = i1 + 1; i2 <= n; i2++) {
+                sat::literal_vector c;
+                c.push_back(sat::literal(p[i1*n + j], true));
+                c.push_back(sat::literal(p[i2*n + j], true));
+                cs.push_back(c);
+            }
+        }
+    }
+    add_clauses(s, cs);
+}
+
+static void mk_random_3sat(sat::solver & s, unsigned seed, unsigned num_vars, unsigned num_clauses, clause_set & cs) {
+    random_gen r(seed);
+    for (unsigned i = 0; i < num_vars; i++)
+        s.mk_var();
+    for (unsigned i = 0; i < num_clauses; i++) {
+        sat::literal_vector c;
+        for (unsigned j = 0; j < 3; j++)
+            c.push_back(sat::literal(r(num_vars), r(2) == 0));
+        cs.push_back(c);
+    }
+    add_clauses(s, cs);
+}
+
+static void tst_parallel_pool() {
+    params_ref p;
+    sat::solver s(p, 0);
+    sat::literal a(s.mk_var(), false);
+    sat::literal b(s.mk_var(), false);
+    sat::literal c(s.mk_var(), false);
+    s.mk_clause(a, b, c);
+    sat::parallel par;
+    par.init_solvers(s, 2);
+    ENSURE(par.num_extra_solvers() == 2);
+    sat::solver & s0 = par.get_solver(0);
+    sat::solver & s1 = par.get_solver(1);
+    ENSURE(s0.num_vars() == 3 && s1.num_vars() == 3);
+
+    // a clause is received by every solver but its producer
+    sat::literal lits[2] = { a, ~b };
+    par.share_clause(s0, 2, lits, 2);
+    unsigned glue = 0;
+    sat::literal_vector out;
+    ENSURE(!par.get_clause(s0, glue, out));
+    ENSURE(par.get_clause(s1, glue, out));
+    ENSURE(glue == 2 && out.size() == 2 && out[0] == a && out[1] == ~b);
+    ENSURE(!par.get_clause(s1, glue, out));
+    ENSURE(par.get_clause(s, glue, out));
+    ENSURE(!par.get_clause(s, glue, out));
+
+    // units are published once
+    sat::literal_vector in;
+    unsigned limit0 = 0, limit1 = 0;
+    in.push_back(c);
+    in.push_back(c);
+    par.exchange(in, limit0, out);
+    ENSURE(out.size() == 1 && out[0] == c && limit0 == 1);
+    in.reset();
+    in.push_back(~a);
+    par.exchange(in, limit1, out);
+    ENSURE(out.size() == 2 && out[0] == c && out[1] == ~a && limit1 == 2);
+    in.reset();
+    par.exchange(in, limit0, out);
+    ENSURE(out.size() == 1 && out[0] == ~a);
+}
+
+static void tst_parallel_check(unsigned threads) {
+    params_ref p;
+    p.set_uint("threads", threads);
+    {
+        sat::solver s(p, 0);
+        clause_set cs;
+        mk_pigeonhole(s, 6, cs);
+        ENSURE(s.check() == l_false);
+    }
+    for (unsigned seed = 0; seed < 10; seed++) {
+        params_ref p1;
+        sat::solver s1(p1, 0);
+        sat::solver s(p, 0);
+        clause_set cs;
+        mk_random_3sat(s1, seed, 80, 340, cs);
+        cs.reset();
+        mk_random_3sat(s, seed, 80, 340, cs);
+        lbool r = s.check();
+        ENSURE(r == s1.check());
+        if (r == l_true)
+            ENSURE(satisfies(s.get_model(), cs));
+        // the solver can be used again after a portfolio run
+        ENSURE(s.check() == r);
+        if (r == l_true)
+            ENSURE(satisfies(s.get_model(), cs));
+    }
+}
+
+// sum of the values of key in st (st may contain the statistics of several solvers).
+static unsigned get_uint_stat(statistics const & st, char const * key) {
+    unsigned r = 0;
+    for (unsigned i = 0; i < st.size(); i++) {
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+            r += st.get_uint_value(i);
+    }
+    return r;
+}
+
+static unsigned get_uint_stat(sat::solver & s, char const * key) {
+    statistics st;
+    s.collect_statistics(st);
+    return get_uint_stat(st, key);
+}
+
+/**
+   \brief Solve random 3-SAT instances near the threshold and a pigeonhole instance
+   using the configuration p, and compare the answers with the default configuration.
+   The statistics of all runs are accumulated in st.
+*/
+static void check_config(params_ref const & p, statistics & st) {
+    params_ref dp;
+    for (unsigned seed = 0; seed < 10; seed++) {
+        sat::solver s(p, 0);
+        sat::solver s1(dp, 0);
+        clause_set cs, cs1;
+        mk_random_3sat(s, seed, 120, 510, cs);
+        mk_random_3sat(s1, seed, 120, 510, cs1);
+        lbool r = s.check();
+        ENSURE(r == s1.check());
+        if (r == l_true)
+            ENSURE(satisfies(s.get_model(), cs));
+        s.collect_statistics(st);
+    }
+    sat::solver s(p, 0);
+    clause_set cs;
+    mk_pigeonhole(s, 7, cs);
+    ENSURE(s.check() == l_false);
+    s.collect_statistics(st);
+}
+
+static void tst_ema_restarts() {
+    params_ref p;
+    p.set_sym("restart", symbol("ema"));
+    p.set_uint("restart.min", 10);
+    statistics st;
+    check_config(p, st);
+    std::cout << "ema: restarts: " << get_uint_stat(st, "restarts") << " blocked: " << get_uint_stat(st, "blocked restarts") << "\n";
+    ENSURE(get_uint_stat(st, "restarts") > 0);
+}
+
+static void tst_tiers_gc() {
+    params_ref p;
+    p.set_sym("gc", symbol("tiers"));
+    p.set_uint("gc.initial", 100);
+    p.set_uint("gc.increment", 50);
+    statistics st;
+    check_config(p, st);
+    std::cout << "tiers: gc clauses: " << get_uint_stat(st, "gc clause") << "\n";
+    ENSURE(get_uint_stat(st, "gc clause") > 0);
+    // restarts and gc strategies can be combined
+    p.set_sym("restart", symbol("ema"));
+    check_config(p, st);
+}
+
+/**
+   \brief Fill the clause arena with clauses that are satisfied by a unit added afterwards.
+   They are deleted when the solver starts, so the first garbage collection finds a
+   fragmented arena (above c_min_compact_words) and compacts it.
+*/
+static void tst_compaction(unsigned seed) {
+    params_ref p;
+    p.set_uint("gc.initial", 20);
+    p.set_uint("gc.increment", 20);
+    sat::solver s(p, 0);
+    sat::solver s1(p, 0);
+    clause_set cs, cs1;
+    mk_random_3sat(s, seed, 150, 600, cs);
+    mk_random_3sat(s1, seed, 150, 600, cs1);
+    random_gen r(seed);
+    unsigned num_pad = 200;
+    sat::literal t(s.mk_var(), false);
+    unsigned first = s.num_vars();
+    for (unsigned i = 0; i < num_pad; i++)
+        s.mk_var();
+    for (unsigned i = 0; i < 30000; i++)
+        s.mk_clause(t, sat::literal(first + r(num_pad), r(2) == 0), sat::literal(first + r(num_pad), r(2) == 0));
+    s.mk_clause(1, &t);
+    lbool res = s.check();
+    std::cout << "compaction: " << res << " compactions: " << get_uint_stat(s, "clause arena compactions") << "\n";
+    ENSURE(get_uint_stat(s, "clause arena compactions") > 0);
+    ENSURE(s.check_invariant());
+    ENSURE(res == s1.check());
+    if (res == l_true)
+        ENSURE(satisfies(s.get_model(), cs));
+    // the relocated clauses are used by the following checks.
+    for (unsigned i = 0; i < 10; i++) {
+        sat::literal asms[2] = { sat::literal(r(150), r(2) == 0), sat::literal(r(150), r(2) == 0) };
+        // variables that are not external may have been eliminated.
+        if (s.was_eliminated(asms[0].var()) || s.was_eliminated(asms[1].var()) ||
+            s1.was_eliminated(asms[0].var()) || s1.was_eliminated(asms[1].var()))
+            continue;
+        res = s.check(2, asms);
+        ENSURE(res == s1.check(2, asms));
+        if (res == l_true)
+            ENSURE(satisfies(s.get_model(), cs));
+        ENSURE(s.check_invariant());
+    }
+}
+
+static void tst_inprocess() {
+    params_ref p;
+    p.set_bool("inprocess", true);
+    p.set_uint("gc.initial", 100);
+    statistics st;
+    check_config(p, st);
+    std::cout << "inprocess: simplifier calls: " << get_uint_stat(st, "simplifier calls")
+              << " skipped: " << get_uint_stat(st, "simplifier skipped")
+              << " probing calls: " << get_uint_stat(st, "probing calls")
+              << " skipped: " << get_uint_stat(st, "probing skipped") << "\n";
+    ENSURE(get_uint_stat(st, "simplifier calls") > 0);
+    ENSURE(get_uint_stat(st, "probing calls") > 0);
+}
+
+/**
+   \brief g_i occurs only in (g_i or a_i or c_i) and (~g_i or b_i or d_i), so it can be
+   eliminated, unless the occurrence lists are too small to contain these clauses.
+*/
+static unsigned num_elim_vars(params_ref const & p) {
+    sat::solver s(p, 0);
+    clause_set cs;
+    mk_random_3sat(s, 3, 60, 200, cs);
+    random_gen r(3);
+    for (unsigned i = 0; i < 20; i++) {
+        sat::literal g(s.mk_var(), false);
+        sat::literal a(r(60), r(2) == 0);
+        sat::literal b(r(60), r(2) == 0);
+        sat::literal c(r(60), r(2) == 0);
+        sat::literal d(r(60), r(2) == 0);
+        s.mk_clause(g, a, c);
+        s.mk_clause(~g, b, d);
+    }
+    ENSURE(s.check() == l_true);
+    ENSURE(satisfies(s.get_model(), cs));
+    return get_uint_stat(s, "elim bool vars");
+}
+
+static void tst_occ_limit() {
+    params_ref p;
+    // simplify before searching
+    p.set_uint("burst_search", 0);
+    unsigned n = num_elim_vars(p);
+    std::cout << "eliminated vars: " << n << "\n";
+    ENSURE(n >= 20);
+    p.set_uint("occ_limit", 0);
+    n = num_elim_vars(p);
+    std::cout << "eliminated vars with occ_limit = 0: " << n << "\n";
+    ENSURE(n == 0);
+}
+
+typedef svector<int> drat_clause;
+
+/**
+   \brief Read the records of a text or binary DRAT proof. The literals use the DIMACS numbering,
+   and deleted clauses are marked by a leading 0.
+*/
+static void read_drat(char const * file_name, bool binary, vector<drat_clause> & records) {
+    std::ifstream in(file_name, std::ios_base::in | std::ios_base::binary);
+    ENSURE(!in.fail());
+    if (binary) {
+        int ch;
+        while ((ch = in.get()) != EOF) {
+            ENSURE(ch == 'a' || ch == 'd');
+            drat_clause c;
+            c.push_back(ch == 'd' ? 0 : 1);
+            while (true) {
+                unsigned u = 0, shift = 0;
+                do {
+                    ch = in.get();
+                    ENSURE(ch != EOF);
+                    u |= (static_cast<unsigned>(ch) & 0x7f) << shift;
+                    shift += 7;
+                }
+                while (ch & 0x80);
+                if (u == 0)
+                    break;
+                c.push_back(u & 1 ? -static_cast<int>(u >> 1) : static_cast<int>(u >> 1));
+            }
+            records.push_back(c);
+        }
+    }
+    else {
+        std::string tok;
+        drat_clause c;
+        c.push_back(1);
+        while (in >> tok) {
+            if (tok == "d") {
+                ENSURE(c.size() == 1);
+                c[0] = 0;
+                continue;
+            }
+            int l = atoi(tok.c_str());
+            if (l == 0) {
+                records.push_back(c);
+                c.reset();
+                c.push_back(1);
+            }
+            else {
+                c.push_back(l);
+            }
+        }
+        ENSURE(c.size() == 1);
+    }
+}
+
+/**
+   \brief Read the input clauses dumped with a DRAT proof, and check the DIMACS header.
+*/
+static unsigned read_cnf(char const * file_name, vector<drat_clause> & clauses) {
+    std::ifstream in(file_name);
+    ENSURE(!in.fail());
+    std::string p, cnf;
+    unsigned num_vars = 0, num_clauses = 0;
+    in >> p >> cnf >> num_vars >> num_clauses;
+    ENSURE(p == "p" && cnf == "cnf");
+    drat_clause c;
+    c.push_back(1);
+    int l;
+    while (in >> l) {
+        if (l == 0) {
+            clauses.push_back(c);
+            c.reset();
+            c.push_back(1);
+        }
+        else {
+            ENSURE(static_cast<unsigned>(abs(l)) <= num_vars);
+            c.push_back(l);
+        }
+    }
+    ENSURE(c.size() == 1);
+    ENSURE(clauses.size() == num_clauses);
+    return num_vars;
+}
+
+static int drat_value(svector<int> const & assignment, int l) {
+    int v = assignment[l > 0 ? l : -l];
+    return l > 0 ? v : -v;
+}
+
+/**
+   \brief Return true if the lemma is a RUP clause: unit propagation on the active clauses
+   and the negation of the lemma yields a conflict.
+*/
+static bool is_rup(vector<drat_clause> const & active, unsigned num_vars, drat_clause const & lemma) {
+    svector<int> assignment(num_vars + 1, 0);
+    for (unsigned i = 1; i < lemma.size(); i++) {
+        if (drat_value(assignment, lemma[i]) > 0)
+            return true; // the lemma is a tautology
+        assignment[abs(lemma[i])] = lemma[i] > 0 ? -1 : 1;
+    }
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (unsigned i = 0; i < active.size(); i++) {
+            drat_clause const & c = active[i];
+            int unit = 0;
+            unsigned num_undef = 0;
+            bool sat = false;
+            for (unsigned j = 1; !sat && j < c.size(); j++) {
+                int val = drat_value(assignment, c[j]);
+                if (val > 0)
+                    sat = true;
+                else if (val == 0) {
+                    num_undef++;
+                    unit = c[j];
+                }
+            }
+            if (sat || num_undef > 1)
+                continue;
+            if (num_undef == 0)
+                return true;
+            assignment[abs(unit)] = unit > 0 ? 1 : -1;
+            progress = true;
+        }
+    }
+    return false;
+}
+
+static drat_clause sorted(drat_clause c) {
+    std::sort(c.begin() + 1, c.end());
+    return c;
+}
+
+/**
+   \brief Check a proof produced for the given input clauses: every lemma must be a RUP clause,
+   and the empty clause must be derived. As drat-trim, deletions of unit clauses are ignored.
+*/
+static void check_drat(vector<drat_clause> const & input, unsigned num_vars, vector<drat_clause> const & records) {
+    vector<drat_clause> active;
+    for (unsigned i = 0; i < input.size(); i++)
+        active.push_back(sorted(input[i]));
+    unsigned num_lemmas = 0, num_dels = 0;
+    bool empty = false;
+    for (unsigned i = 0; !empty && i < records.size(); i++) {
+        drat_clause c = sorted(records[i]);
+        for (unsigned j = 1; j < c.size(); j++)
+            ENSURE(c[j] != 0 && static_cast<unsigned>(abs(c[j])) <= num_vars);
+        if (c[0] == 0) {
+            if (c.size() <= 2)
+                continue;
+            c[0] = 1;
+            for (unsigned j = 0; j < active.size(); j++) {
+                if (active[j].size() == c.size() && std::equal(c.begin(), c.end(), active[j].begin())) {
+                    active[j] = active.back();
+                    active.pop_back();
+                    num_dels++;
+                    break;
+                }
+            }
+            continue;
+        }
+        ENSURE(is_rup(active, num_vars, c));
+        num_lemmas++;
+        empty = c.size() == 1;
+        active.push_back(c);
+    }
+    std::cout << "lemmas: " << num_lemmas << ", deletions: " << num_dels << ", records: " << records.size() << "\n";
+    ENSURE(empty);
+}
+
+static void tst_drat(bool binary, unsigned num_vars, unsigned num_clauses) {
+    // the files are created in the working directory of the test.
+    std::string file_name = "tst_drat.drat";
+    std::string cnf_file_name = file_name + ".cnf";
+    clause_set cs;
+    if (num_clauses == 0) {
+        sat::solver tmp(params_ref(), 0);
+        mk_pigeonhole(tmp, num_vars, cs);
+        num_vars = tmp.num_vars();
+    }
+    else {
+        random_gen r(1);
+        for (unsigned i = 0; i < num_clauses; i++) {
+            sat::literal_vector c;
+            for (unsigned j = 0; j < 3; j++)
+                c.push_back(sat::literal(r(num_vars), r(2) == 0));
+            cs.push_back(c);
+        }
+    }
+    // the solver simplifies the clauses of cs in place, the input clauses are the original ones,
+    // and the variable v is written as v+1.
+    vector<drat_clause> expected;
+    for (unsigned i = 0; i < cs.size(); i++) {
+        drat_clause c;
+        c.push_back(1);
+        for (unsigned j = 0; j < cs[i].size(); j++) {
+            int v = static_cast<int>(cs[i][j].var()) + 1;
+            c.push_back(cs[i][j].sign() ? -v : v);
+        }
+        expected.push_back(c);
+    }
+    {
+        params_ref p;
+        p.set_sym("drat.file", symbol(file_name.c_str()));
+        p.set_bool("drat.binary", binary);
+        p.set_uint("burst_search", 0);
+        p.set_uint("gc.initial", 100);
+        p.set_uint("gc.increment", 100);
+        sat::solver s(p, 0);
+        for (unsigned i = 0; i < num_vars; i++)
+            s.mk_var();
+        add_clauses(s, cs);
+        ENSURE(s.check() == l_false);
+        // the proof is closed when the solver is destroyed
+    }
+    vector<drat_clause> input;
+    unsigned n = read_cnf(cnf_file_name.c_str(), input);
+    ENSURE(input.size() == expected.size());
+    for (unsigned i = 0; i < expected.size(); i++)
+        ENSURE(input[i].size() == expected[i].size() && std::equal(input[i].begin(), input[i].end(), expected[i].begin()));
+    vector<drat_clause> records;
+    read_drat(file_name.c_str(), binary, records);
+    std::remove(file_name.c_str());
+    std::remove(cnf_file_name.c_str());
+    check_drat(input, n, records);
+}
+
+static void display_core(sat::solver const & s) {
+    std::cout << "core: " << s.get_core() << "\n";
+}
+
+static void tst_assumptions() {
+    params_ref p;
+    sat::solver s(p, 0);
+    sat::literal a(s.mk_var(true), false);
+    sat::literal b(s.mk_var(true), false);
+    sat::literal c(s.mk_var(true), false);
+    sat::literal d(s.mk_var(true), false);
+    // a => b, b => c
+    s.mk_clause(~a, b);
+    s.mk_clause(~b, c);
+    s.mk_clause(a, b, d);
+
+    sat::literal as1[2] = { a, ~c };
+    ENSURE(s.check(2, as1) == l_false);
+    display_core(s);
+    ENSURE(s.get_core().size() == 2);
+    ENSURE(s.get_core().contains(a) && s.get_core().contains(~c));
+
+    sat::literal as2[3] = { d, a, ~c };
+    ENSURE(s.check(3, as2) == l_false);
+    display_core(s);
+    ENSURE(!s.get_core().contains(d));
+
+    sat::literal as3[1] = { a };
+    ENSURE(s.check(1, as3) == l_true);
+    ENSURE(sat::value_at(c, s.get_model()) == l_true);
+
+    sat::literal as4[3] = { d, b, ~d };
+    ENSURE(s.check(3, as4) == l_false);
+    display_core(s);
+    ENSURE(s.get_core().contains(d) && s.get_core().contains(~d));
+    ENSURE(!s.get_core().contains(b));
+
+    // assumptions do not change the set of clauses.
+    ENSURE(s.check() == l_true);
+    ENSURE(s.check(1, as3) == l_true);
+}
+
+/**
+   \brief A variable used as an assumption must survive the simplifications
+   performed by later checks, even if it was not created as an external variable.
+*/
+static void tst_assumption_protected() {
+    params_ref p;
+    sat::solver s(p, 0);
+    sat::literal x(s.mk_var(), false);
+    sat::literal y(s.mk_var(), false);
+    sat::literal z(s.mk_var(), false);
+    s.mk_clause(x, y);
+    s.mk_clause(~x, z);
+    s.mk_clause(~y, ~z);
+    ENSURE(s.check(1, &x) == l_true);
+    ENSURE(s.is_external(x.var()));
+    // x is not an assumption of this check, but it may be used again in the next one.
+    ENSURE(s.check() == l_true);
+    ENSURE(!s.was_eliminated(x.var()));
+    ENSURE(s.check(1, &x) == l_true);
+    ENSURE(sat::value_at(x, s.get_model()) == l_true);
+    ENSURE(sat::value_at(z, s.get_model()) == l_true);
+    sat::literal as[2] = { x, y };
+    ENSURE(s.check(2, as) == l_false);
+}
+
+static void tst_user_scopes() {
+    params_ref p;
+    sat::solver s(p, 0);
+    sat::literal a(s.mk_var(true), false);
+    sat::literal b(s.mk_var(true), false);
+    s.mk_clause(a, b);
+    s.user_push();
+    s.mk_clause(~a, b);
+    s.user_push();
+    sat::literal nb = ~b;
+    s.mk_clause(1, &nb);
+    ENSURE(s.check() == l_false);
+    ENSURE(s.get_core().empty());
+    s.user_pop(1);
+    ENSURE(s.check() == l_true);
+    ENSURE(sat::value_at(b, s.get_model()) == l_true);
+    ENSURE(s.check(1, &nb) == l_false);
+    display_core(s);
+    ENSURE(s.get_core().size() == 1 && s.get_core()[0] == nb);
+    s.user_pop(1);
+    ENSURE(s.check(1, &nb) == l_true);
+    ENSURE(sat::value_at(a, s.get_model()) == l_true);
+    ENSURE(s.num_user_scopes() == 0);
+}
+
+void tst_sat_solver() {
+    tst_parallel_pool();
+    tst_parallel_check(1);
+    tst_parallel_check(4);
+    tst_compaction(1);
+    tst_compaction(2);
+    tst_ema_restarts();
+    tst_tiers_gc();
+    tst_inprocess();
+    tst_occ_limit();
+    tst_assumptions();
+    tst_assumption_protected();
+    tst_user_scopes();
+    tst_drat(false, 5, 0);
+    tst_drat(true, 5, 0);
+    tst_drat(false, 100, 520);
+}
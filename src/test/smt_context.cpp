@@ -1,5 +1,374 @@
 #include "smt_context.h"
+#include "bv_decl_plugin.h"
+#include "arith_decl_plugin.h"
 #include "reg_decl_plugins.h"
+#include "statistics.h"
+#include "stopwatch.h"
+#include "util.h"
+#include "test_util.h"
+
+static expr * mk_random_clause(ast_manager & m, app_ref_vector const & vars, random_gen & r) {
+    expr * lits[3];
+    for (unsigned i = 0; i < 3; i++) {
+        expr * v = vars.get(r(vars.size()));
+        lits[i]  = r(2) == 0 ? m.mk_not(v) : v;
+    }
+    return m.mk_or(3, lits);
+}
+
+/**
+   \brief Solve a sequence of push/assert/check/pop problems with and without
+   lemma retention, and compare the results.
+*/
+static void tst_retained_lemmas(unsigned num_vars, unsigned num_clauses, unsigned seed) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    smt_params p1, p2;
+    p2.m_max_retained_lemmas = 1000;
+    smt::context ctx1(m, p1);
+    smt::context ctx2(m, p2);
+    random_gen r(seed);
+    app_ref_vector vars(m);
+    for (unsigned i = 0; i < num_vars; i++)
+        vars.push_back(m.mk_fresh_const("p", m.mk_bool_sort()));
+    expr_ref c(m);
+    for (unsigned i = 0; i < num_clauses; i++) {
+        c = mk_random_clause(m, vars, r);
+        ctx1.assert_expr(c);
+        ctx2.assert_expr(c);
+    }
+    for (unsigned round = 0; round < 10; round++) {
+        unsigned num_scopes = 1 + r(2);
+        for (unsigned s = 0; s < num_scopes; s++) {
+            ctx1.push();
+            ctx2.push();
+            for (unsigned i = 0; i < num_vars / 4; i++) {
+                c = mk_random_clause(m, vars, r);
+                ctx1.assert_expr(c);
+                ctx2.assert_expr(c);
+            }
+            lbool r1 = ctx1.check();
+            lbool r2 = ctx2.check();
+            ENSURE(r1 == r2);
+        }
+        ctx1.pop(num_scopes);
+        ctx2.pop(num_scopes);
+        ENSURE(ctx1.check() == ctx2.check());
+    }
+    statistics st;
+    ctx2.collect_statistics(st);
+    st.display(std::cout);
+}
+
+static expr * mk_random_bv_term(ast_manager & m, app_ref_vector const & vars, random_gen & r, unsigned depth) {
+    bv_util bv(m);
+    if (depth == 0 || r(4) == 0)
+        return r(5) == 0 ? bv.mk_numeral(rational(r(256)), 8) : vars.get(r(vars.size()));
+    expr * a = mk_random_bv_term(m, vars, r, depth - 1);
+    expr * b = mk_random_bv_term(m, vars, r, depth - 1);
+    decl_kind ops[] = { OP_BADD, OP_BMUL, OP_BUDIV, OP_BUREM, OP_BSHL, OP_BLSHR, OP_BASHR, OP_BXOR };
+    return m.mk_app(bv.get_fid(), ops[r(sizeof(ops)/sizeof(decl_kind))], a, b);
+}
+
+/**
+   \brief Compare lazy and eager bit-blasting of multipliers, dividers and shifts
+   on random constraints over 8-bit vectors.
+*/
+static void tst_bv_lazy_blast(unsigned seed) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    bv_util bv(m);
+    random_gen r(seed);
+    app_ref_vector vars(m);
+    for (unsigned i = 0; i < 4; i++)
+        vars.push_back(m.mk_fresh_const("x", bv.mk_sort(8)));
+    statistics st;
+    for (unsigned round = 0; round < 20; round++) {
+        smt_params p1, p2;
+        p2.m_bv_lazy_blast = true;
+        smt::context ctx1(m, p1);
+        smt::context ctx2(m, p2);
+        expr_ref c(m);
+        for (unsigned i = 0; i < 3; i++) {
+            expr * t1 = mk_random_bv_term(m, vars, r, 3);
+            expr * t2 = mk_random_bv_term(m, vars, r, 3);
+            c = r(3) == 0 ? m.mk_not(m.mk_eq(t1, t2)) : (r(2) == 0 ? m.mk_eq(t1, t2) : bv.mk_ule(t1, t2));
+            ctx1.assert_expr(c);
+            ctx2.assert_expr(c);
+        }
+        ENSURE(ctx1.check() == ctx2.check());
+        ctx2.collect_statistics(st);
+    }
+    st.display(std::cout);
+}
+
+/**
+   \brief x * y = n, 1 < x, y < 2^(sz/2), with lazy bit-blasting.
+*/
+static void tst_bv_lazy_factor(unsigned sz, unsigned n, lbool expected) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    bv_util bv(m);
+    smt_params p;
+    p.m_bv_lazy_blast = true;
+    smt::context ctx(m, p);
+    sort * s = bv.mk_sort(sz);
+    app_ref x(m.mk_fresh_const("x", s), m), y(m.mk_fresh_const("y", s), m);
+    expr_ref one(bv.mk_numeral(rational(1), sz), m);
+    expr_ref max(bv.mk_numeral(rational::power_of_two(sz/2), sz), m);
+    ctx.assert_expr(m.mk_eq(bv.mk_bv_mul(x, y), bv.mk_numeral(rational(n), sz)));
+    ctx.assert_expr(m.mk_not(bv.mk_ule(x, one)));
+    ctx.assert_expr(m.mk_not(bv.mk_ule(y, one)));
+    ctx.assert_expr(m.mk_not(bv.mk_ule(max, x)));
+    ctx.assert_expr(m.mk_not(bv.mk_ule(max, y)));
+    ENSURE(ctx.check() == expected);
+    if (expected == l_true) {
+        model_ref mdl;
+        ctx.get_model(mdl);
+        expr_ref vx(m), vy(m);
+        rational rx, ry;
+        unsigned bv_sz;
+        ENSURE(mdl->eval(x, vx, true) && bv.is_numeral(vx, rx, bv_sz));
+        ENSURE(mdl->eval(y, vy, true) && bv.is_numeral(vy, ry, bv_sz));
+        std::cout << n << " = " << rx << " * " << ry << "\n";
+        ENSURE(rx * ry == rational(n));
+    }
+}
+
+/**
+   \brief Solve random 3-SAT problems with the given case split strategy, check the
+   models, and compare the results with the default strategy. A small rephase_base
+   makes sure that rephasing is exercised.
+*/
+static void tst_case_split(case_split_strategy cs, unsigned num_vars, unsigned num_clauses, unsigned num_seeds) {
+    double time = 0.0;
+    unsigned num_sat = 0;
+    for (unsigned seed = 0; seed < num_seeds; seed++) {
+        ast_manager m;
+        reg_decl_plugins(m);
+        smt_params p1, p2;
+        p2.m_case_split_strategy = cs;
+        p2.m_rephase_base        = 50;
+        smt::context ctx1(m, p1);
+        smt::context ctx2(m, p2);
+        random_gen r(seed);
+        app_ref_vector vars(m);
+        for (unsigned i = 0; i < num_vars; i++)
+            vars.push_back(m.mk_fresh_const("p", m.mk_bool_sort()));
+        expr_ref_vector clauses(m);
+        for (unsigned i = 0; i < num_clauses; i++) {
+            clauses.push_back(mk_random_clause(m, vars, r));
+            ctx1.assert_expr(clauses.back());
+            ctx2.assert_expr(clauses.back());
+        }
+        lbool r1 = ctx1.check();
+        stopwatch sw;
+        sw.start();
+        lbool r2 = ctx2.check();
+        sw.stop();
+        time += sw.get_seconds();
+        ENSURE(r1 == r2);
+        if (r2 == l_true) {
+            num_sat++;
+            model_ref mdl;
+            ctx2.get_model(mdl);
+            expr_ref val(m);
+            for (unsigned i = 0; i < clauses.size(); i++)
+                ENSURE(mdl->eval(clauses.get(i), val, true) && m.is_true(val));
+        }
+        // the queue is also used after push/pop.
+        ctx2.push();
+        ctx2.assert_expr(m.mk_not(vars.get(0)));
+        ctx2.check();
+        ctx2.pop(1);
+        ENSURE(ctx2.check() == r1);
+    }
+    std::cout << "case split: " << cs << ", sat: " << num_sat << "/" << num_seeds << ", time: " << time << " secs\n";
+}
+
+static unsigned get_uint_stat(statistics const & st, char const * key) {
+    unsigned r = 0;
+    for (unsigned i = 0; i < st.size(); i++) {
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+            r += st.get_uint_value(i);
+    }
+    return r;
+}
+
+static expr * mk_random_ineq(ast_manager & m, app_ref_vector const & vars, random_gen & r, bool is_int = false) {
+    arith_util a(m);
+    expr_ref_vector args(m);
+    for (unsigned i = 0; i < 3; i++)
+        args.push_back(a.mk_mul(a.mk_numeral(rational(static_cast<int>(r(9)) - 4), is_int), vars.get(r(vars.size()))));
+    expr * rhs = a.mk_numeral(rational(static_cast<int>(r(21)) - 10), is_int);
+    return r(2) == 0 ? a.mk_le(a.mk_add(args.size(), args.c_ptr()), rhs) : a.mk_ge(a.mk_add(args.size(), args.c_ptr()), rhs);
+}
+
+/**
+   \brief Solve a sequence of push/assert/check/pop problems over linear real
+   arithmetic using the exact simplex and the sparse LU based backends, and
+   compare the results. The double precision mirror of the tableau is only
+   rebuilt after pop.
+*/
+static void tst_lu_backend(unsigned backend, unsigned seed) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    smt_params p1, p2;
+    p2.m_arith_simplex_backend   = static_cast<arith_simplex_backend>(backend);
+    p2.m_arith_lu_threshold      = 1;
+    p2.m_arith_lu_max_iterations = 1000;
+    smt::context ctx1(m, p1);
+    smt::context ctx2(m, p2);
+    random_gen r(seed);
+    app_ref_vector vars(m);
+    for (unsigned i = 0; i < 12; i++)
+        vars.push_back(m.mk_fresh_const("x", a.mk_real()));
+    expr_ref c(m);
+    for (unsigned i = 0; i < 10; i++) {
+        c = mk_random_ineq(m, vars, r);
+        ctx1.assert_expr(c);
+        ctx2.assert_expr(c);
+    }
+    ENSURE(ctx1.check() == ctx2.check());
+    for (unsigned round = 0; round < 10; round++) {
+        ctx1.push();
+        ctx2.push();
+        for (unsigned i = 0; i < 4; i++) {
+            c = mk_random_ineq(m, vars, r);
+            ctx1.assert_expr(c);
+            ctx2.assert_expr(c);
+            ENSURE(ctx1.check() == ctx2.check());
+        }
+        ctx1.pop(1);
+        ctx2.pop(1);
+    }
+    ENSURE(ctx1.check() == ctx2.check());
+    statistics st;
+    ctx2.collect_statistics(st);
+    unsigned calls    = get_uint_stat(st, "lu simplex calls");
+    unsigned rebuilds = get_uint_stat(st, "lu simplex rebuilds");
+    std::cout << "backend: " << backend << ", lu calls: " << calls << ", rebuilds: " << rebuilds << "\n";
+    ENSURE(calls > 0);
+    ENSURE(rebuilds <= 11);
+}
+
+static void push(smt::context & ctx1, smt::context & ctx2) {
+    ctx1.push();
+    ctx2.push();
+}
+
+static void assert_expr(smt::context & ctx1, smt::context & ctx2, expr * e) {
+    ctx1.assert_expr(e);
+    ctx2.assert_expr(e);
+}
+
+static void check(smt::context & ctx1, smt::context & ctx2) {
+    lbool r1 = ctx1.check();
+    lbool r2 = ctx2.check();
+    ENSURE(r1 == r2);
+}
+
+static unsigned get_retained_lemmas(smt::context & ctx) {
+    statistics st;
+    ctx.collect_statistics(st);
+    return get_uint_stat(st, "retained lemmas");
+}
+
+/**
+   \brief Lemma retention with arithmetic lemmas (bound axioms, cuts and branches)
+   and with clauses created from quantifier instances. The instances created at
+   base level 0 can be used by retained lemmas.
+*/
+static unsigned tst_retained_lemmas_theory(bool quantifiers, unsigned seed) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    smt_params p1, p2;
+    p2.m_max_retained_lemmas = 1000;
+    smt::context ctx1(m, p1);
+    smt::context ctx2(m, p2);
+    random_gen r(seed);
+    app_ref_vector vars(m);
+    sort * int_s = a.mk_int();
+    for (unsigned i = 0; i < 8; i++)
+        vars.push_back(m.mk_fresh_const("x", int_s));
+    if (quantifiers) {
+        // forall y. f(y) >= y + 1, the terms f(x_i) are used instead of x_i.
+        func_decl_ref f(m.mk_func_decl(symbol("f"), 1, &int_s, int_s), m);
+        app_ref fy(m.mk_app(f, m.mk_var(0, int_s)), m);
+        expr_ref body(a.mk_ge(fy, a.mk_add(m.mk_var(0, int_s), a.mk_numeral(rational(1), true))), m);
+        expr * pats[1] = { m.mk_pattern(fy) };
+        symbol y("y");
+        expr_ref q(m.mk_forall(1, &int_s, &y, body, 0, symbol("fq"), symbol::null, 1, pats), m);
+        assert_expr(ctx1, ctx2, q);
+        for (unsigned i = 0; i < vars.size(); i++)
+            vars.set(i, m.mk_app(f, vars.get(i)));
+    }
+    expr_ref c(m);
+    // bounded variables keep the integer problems small.
+    for (unsigned i = 0; i < vars.size(); i++) {
+        c = m.mk_and(a.mk_ge(vars.get(i), a.mk_numeral(rational(-5), true)), a.mk_le(vars.get(i), a.mk_numeral(rational(5), true)));
+        assert_expr(ctx1, ctx2, c);
+    }
+    for (unsigned i = 0; i < 12; i++) {
+        c = m.mk_or(mk_random_ineq(m, vars, r, true), mk_random_ineq(m, vars, r, true));
+        assert_expr(ctx1, ctx2, c);
+    }
+    check(ctx1, ctx2);
+    for (unsigned round = 0; round < 8; round++) {
+        unsigned num_scopes = 1 + r(3);
+        for (unsigned s = 0; s < num_scopes; s++) {
+            push(ctx1, ctx2);
+            for (unsigned i = 0; i < 3; i++) {
+                c = m.mk_or(mk_random_ineq(m, vars, r, true), mk_random_ineq(m, vars, r, true));
+                assert_expr(ctx1, ctx2, c);
+            }
+            check(ctx1, ctx2);
+        }
+        unsigned num_pop = 1 + r(num_scopes);
+        ctx1.pop(num_pop);
+        ctx2.pop(num_pop);
+        check(ctx1, ctx2);
+        ctx1.pop(num_scopes - num_pop);
+        ctx2.pop(num_scopes - num_pop);
+    }
+    check(ctx1, ctx2);
+    return get_retained_lemmas(ctx2);
+}
+
+/**
+   \brief More user scopes than the dependency level of a clause can represent.
+   Clauses depending on levels >= clause::MAX_DEP_LVL are never retained.
+*/
+static void tst_retained_lemmas_deep(unsigned seed) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    smt_params p1, p2;
+    p2.m_max_retained_lemmas = 1000;
+    smt::context ctx1(m, p1);
+    smt::context ctx2(m, p2);
+    random_gen r(seed);
+    app_ref_vector vars(m);
+    for (unsigned i = 0; i < 40; i++)
+        vars.push_back(m.mk_fresh_const("p", m.mk_bool_sort()));
+    unsigned num_scopes = smt::clause::MAX_DEP_LVL + 20;
+    expr_ref c(m);
+    for (unsigned s = 0; s < num_scopes; s++) {
+        push(ctx1, ctx2);
+        c = mk_random_clause(m, vars, r);
+        assert_expr(ctx1, ctx2, c);
+        if (s % 10 == 0)
+            check(ctx1, ctx2);
+    }
+    while (num_scopes > 0) {
+        unsigned n = std::min(num_scopes, 1 + r(10));
+        ctx1.pop(n);
+        ctx2.pop(n);
+        num_scopes -= n;
+        check(ctx1, ctx2);
+    }
+}
 
 void tst_smt_context()
 {
@@ -26,4 +395,30 @@ void tst_smt_context()
     }
 
     ctx.check();
+
+    tst_retained_lemmas(60, 230, 0);
+    tst_retained_lemmas(100, 400, 1);
+    // the dependency level and the retained flag share a word with the number of literals.
+    ENSURE(sizeof(smt::clause) == 2 * sizeof(unsigned));
+    unsigned num_retained = 0;
+    for (unsigned seed = 0; seed < 5; seed++) {
+        num_retained += tst_retained_lemmas_theory(false, seed);
+        num_retained += tst_retained_lemmas_theory(true, seed);
+        tst_retained_lemmas_deep(seed);
+    }
+    std::cout << "retained theory lemmas: " << num_retained << "\n";
+
+    for (unsigned seed = 0; seed < 5; seed++)
+        tst_bv_lazy_blast(seed);
+    tst_bv_lazy_factor(16, 143, l_true);
+    tst_bv_lazy_factor(16, 251, l_false);
+
+    tst_case_split(CS_ACTIVITY_DELAY_NEW, 150, 639, 10);
+    tst_case_split(CS_LEARNING_RATE, 150, 639, 10);
+    tst_case_split(CS_CONFLICT_HISTORY, 150, 639, 10);
+
+    for (unsigned seed = 0; seed < 3; seed++) {
+        tst_lu_backend(1, seed);
+        tst_lu_backend(2, seed);
+    }
 }
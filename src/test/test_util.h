@@ -1,6 +1,17 @@
 #pragma once
 
+#include<stdlib.h>
 #include "stopwatch.h"
+#include "debug.h"
+#include "error_codes.h"
+
+// Unlike VERIFY, the condition is checked in release builds too.
+#define ENSURE(_x_) do {                                                \
+        if (!(_x_)) {                                                   \
+            notify_assertion_violation(__FILE__, __LINE__, "Failed to ensure: " #_x_); \
+            exit(ERR_INTERNAL_FATAL);                                   \
+        }                                                               \
+    } while (0)
 
 struct test_context {
     bool test_ok;
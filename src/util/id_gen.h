@@ -21,6 +21,7 @@ Revision History:
 
 #include"vector.h"
 #include"util.h"
+#include"z3_atomic.h"
 
 class id_gen {
     unsigned        m_next_id;
@@ -41,6 +42,13 @@ public:
         return r;
     }
     
+    /**
+       \brief Thread safe version of mk. Recycled ids are not reused.
+    */
+    unsigned mk_atomic() {
+        return atomic_inc(m_next_id) - 1;
+    }
+    
     void recycle(unsigned id) { 
         if (memory::is_out_of_memory())
             return;
@@ -130,10 +130,13 @@ void memory::set_max_size(size_t max_size) {
 
 static bool g_finalizing = false;
 
+static void thread_cache_finalize();
+
 void memory::finalize() {
     if (g_memory_initialized) {
         g_finalizing = true;
         mem_finalize();
+        thread_cache_finalize();
         g_memory_initialized = false;
         g_finalizing = false;
     }
@@ -196,14 +199,49 @@ void * memory::allocate(char const* file, int line, char const* obj, size_t s) {
 // when the local counter > SYNCH_THRESHOLD 
 #define SYNCH_THRESHOLD 100000
 
+// Small blocks are not returned to malloc/free. Each thread keeps a free list
+// for each size class (multiple of SIZE_CLASS_GRANULARITY), and recycles them.
+// The free lists of a thread contain at most MAX_THREAD_CACHE_SIZE bytes.
+// The blocks in the free lists are not considered allocated by the memory accounting.
+#define SIZE_CLASS_GRANULARITY 8
+#define MAX_SMALL_BLOCK_SIZE   512
+#define NUM_SIZE_CLASSES       (MAX_SMALL_BLOCK_SIZE / SIZE_CLASS_GRANULARITY + 1)
+#define MAX_THREAD_CACHE_SIZE  (1 << 20)
+
 #ifdef _WINDOWS
 // Actually this is VS specific instead of Windows specific.
 __declspec(thread) long long g_memory_thread_alloc_size    = 0;
+__declspec(thread) void *    g_thread_free_lists[NUM_SIZE_CLASSES];
+__declspec(thread) long long g_thread_cache_size           = 0;
+__declspec(thread) bool      g_thread_cache_disabled       = false;
+// We do not have a hook for releasing the free lists when a thread terminates.
+// So, the cache is disabled.
+#define THREAD_CACHE_ENABLED false
 #else
 // GCC style
+#include<pthread.h>
 __thread long long g_memory_thread_alloc_size    = 0;
+__thread void *    g_thread_free_lists[NUM_SIZE_CLASSES];
+__thread long long g_thread_cache_size           = 0;
+// The cache is disabled when the thread is terminating (see thread_cache_destructor).
+__thread bool      g_thread_cache_disabled       = false;
+__thread bool      g_thread_cache_registered     = false;
+#define THREAD_CACHE_ENABLED true
 #endif
 
+static void thread_cache_release() {
+    for (unsigned i = 0; i < NUM_SIZE_CLASSES; i++) {
+        void * curr = g_thread_free_lists[i];
+        while (curr != 0) {
+            void * next = *(static_cast<void**>(curr));
+            free(static_cast<size_t*>(curr) - 1);
+            curr = next;
+        }
+        g_thread_free_lists[i] = 0;
+    }
+    g_thread_cache_size = 0;
+}
+
 static void synchronize_counters(bool allocating) {
 #ifdef PROFILE_MEMORY
     g_synch_counter++;
@@ -224,12 +262,56 @@ static void synchronize_counters(bool allocating) {
     }
 }
 
+static void thread_cache_finalize() {
+    // Release the free lists of the current thread, and integrate its counter with the global one.
+    thread_cache_release();
+    if (g_memory_thread_alloc_size != 0)
+        synchronize_counters(false);
+}
+
+#ifndef _WINDOWS
+static pthread_key_t  g_thread_cache_key;
+static pthread_once_t g_thread_cache_key_once = PTHREAD_ONCE_INIT;
+
+static void thread_cache_destructor(void *) {
+    // Blocks deallocated by destructors executed after this point are returned to the system.
+    g_thread_cache_disabled = true;
+    thread_cache_finalize();
+}
+
+static void thread_cache_mk_key() {
+    pthread_key_create(&g_thread_cache_key, thread_cache_destructor);
+}
+
+static void thread_cache_register() {
+    // Make sure the free lists are released when the current thread terminates.
+    pthread_once(&g_thread_cache_key_once, thread_cache_mk_key);
+    pthread_setspecific(g_thread_cache_key, &g_thread_cache_registered);
+    g_thread_cache_registered = true;
+}
+#endif
+
 void memory::deallocate(void * p) {
     size_t * sz_p  = reinterpret_cast<size_t*>(p) - 1;
     size_t sz      = *sz_p;
     void * real_p  = reinterpret_cast<void*>(sz_p);
     g_memory_thread_alloc_size -= sz;
-    free(real_p);
+    // the free lists are accounted with the size of their class, as in allocate.
+    unsigned idx        = static_cast<unsigned>(sz / SIZE_CLASS_GRANULARITY);
+    long long class_sz  = static_cast<long long>(idx) * SIZE_CLASS_GRANULARITY;
+    if (THREAD_CACHE_ENABLED && sz <= MAX_SMALL_BLOCK_SIZE && !g_thread_cache_disabled && 
+        g_thread_cache_size + class_sz <= MAX_THREAD_CACHE_SIZE) {
+#ifndef _WINDOWS
+        if (!g_thread_cache_registered)
+            thread_cache_register();
+#endif
+        *(static_cast<void**>(p)) = g_thread_free_lists[idx];
+        g_thread_free_lists[idx]  = p;
+        g_thread_cache_size      += class_sz;
+    }
+    else {
+        free(real_p);
+    }
     if (g_memory_thread_alloc_size < -SYNCH_THRESHOLD) {
         synchronize_counters(false);
     }
@@ -239,7 +321,24 @@ void * memory::allocate(size_t s) {
     if (s == 0) 
         return 0;
     s = s + sizeof(size_t); // we allocate an extra field!
-    void * r = malloc(s);
+    void * r;
+    if (THREAD_CACHE_ENABLED && s <= MAX_SMALL_BLOCK_SIZE) {
+        // round up to the size class
+        s = (s + SIZE_CLASS_GRANULARITY - 1) & ~static_cast<size_t>(SIZE_CLASS_GRANULARITY - 1);
+        unsigned idx = static_cast<unsigned>(s / SIZE_CLASS_GRANULARITY);
+        void * head  = g_thread_free_lists[idx];
+        if (head != 0) {
+            g_thread_free_lists[idx] = *(static_cast<void**>(head));
+            g_thread_cache_size     -= static_cast<long long>(idx) * SIZE_CLASS_GRANULARITY;
+            r = static_cast<size_t*>(head) - 1;
+        }
+        else {
+            r = malloc(s);
+        }
+    }
+    else {
+        r = malloc(s);
+    }
     if (r == 0) 
         throw_out_of_memory();
     *(static_cast<size_t*>(r)) = s;
@@ -258,6 +357,9 @@ void * memory::allocate(size_t s) {
 // ==================================
 // allocate & deallocate without using thread local storage
 
+static void thread_cache_finalize() {
+}
+
 void memory::deallocate(void * p) {
     size_t * sz_p  = reinterpret_cast<size_t*>(p) - 1;
     size_t sz      = *sz_p;
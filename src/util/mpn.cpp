@@ -197,6 +197,7 @@ bool mpn_manager::div(mpn_digit const * numer, size_t const lnum,
             rem[i] = (i < lnum) ? numer[i] : 0;       
     }        
     else  {
+        mpn_sbuffer u, v;
         size_t d = div_normalize(numer, lnum, denom, lden, u, v);
         if (lden == 1)
             res = div_1(u, v[0], quot);
@@ -320,7 +321,7 @@ bool mpn_manager::div_n(mpn_sbuffer & numer, mpn_sbuffer const & denom,
 
     SASSERT(numer.size() == m+n);
 
-    t_ms.resize(n+1);
+    mpn_sbuffer t_ms(n+1, 0), t_ab;
     
     mpn_double_digit q_hat, temp, r_hat;
     mpn_digit borrow;
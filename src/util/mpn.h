@@ -84,7 +84,6 @@ private:
     #endif
 
     static const mpn_digit zero;
-    mpn_sbuffer u, v, t_ms, t_ab;
     void display_raw(std::ostream & out, mpn_digit const * a, size_t const lng) const;
 
     size_t div_normalize(mpn_digit const * numer, size_t const lnum,
@@ -112,25 +111,15 @@ private:
 
     void trace(mpn_digit const * a, size_t const lnga) const;
     void trace_nl(mpn_digit const * a, size_t const lnga) const;
-
-public:
-    // This function is needed because of the static_mpn_manager global variable.
-    // It must be invoked by the memory_manager during finalization.
-    // After we remove MSBignum from the code base, the global variable will
-    // not be needed anymore, and we will be able to eliminate this function.
-    void finalize() {
-        u.finalize();
-        v.finalize();
-        t_ms.finalize();
-        t_ab.finalize();
-    }
 };
 
 
 // MSBignum compatible interface
 // Note: The `owner' parameter is ignored. We use separate mpn_manager objects for the
 // same purpose. Multiple owners are not supported in these compatibility functions, 
-// instead a static mpn_manager is used.
+// instead a static mpn_manager is used. 
+// The scratch buffers used by mpn_manager::div are local. So, static_mpn_manager
+// can be used by different threads.
 
 extern mpn_manager static_mpn_manager;
 
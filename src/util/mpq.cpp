@@ -21,7 +21,8 @@ Revision History:
 #include"z3_exception.h"
 
 template<bool SYNCH>
-mpq_manager<SYNCH>::mpq_manager() {
+mpq_manager<SYNCH>::mpq_manager(bool global_cells):
+    mpz_manager<SYNCH>(global_cells) {
 }
 
 template<bool SYNCH>
@@ -73,8 +73,101 @@ class mpq_manager : public mpz_manager<SYNCH> {
         }
     }
 
+    // Store the rational n/d in c. n and d must be coprime, and d positive.
+    void set_small(mpq & c, int64 n, int64 d) {
+        SASSERT(d > 0);
+        del(c.m_num);
+        del(c.m_den);
+        c.m_num.m_val = n;
+        c.m_den.m_val = d;
+    }
+
+    // Store the rational n/d in c. d must be positive.
+    void set_small_normalized(mpq & c, int64 n, int64 d) {
+        // g <= d, thus it fits in an int64
+        int64 g = static_cast<int64>(small_gcd(abs_u64(n), static_cast<uint64>(d)));
+        if (g > 1) {
+            n /= g;
+            d /= g;
+        }
+        set_small(c, n, d);
+    }
+
+    /**
+       \brief Fast path for a + b (a - b if \c is_sub) when the numerators and 
+       denominators of \c a and \c b are small. Return false if an intermediate
+       result does not fit in an int64.
+    */
+    bool small_rat_add(mpq const & a, mpq const & b, bool is_sub, mpq & c) {
+        if (!is_small(a) || !is_small(b))
+            return false;
+        int64 n1 = a.m_num.m_val, d1 = a.m_den.m_val;
+        int64 n2 = b.m_num.m_val, d2 = b.m_den.m_val;
+        int64 n, d;
+        if (d1 == d2) {
+            // common case: integers, or rationals with the same denominator
+            d = d1;
+        }
+        else if (!checked_mul_i64(n1, d2, n1) || !checked_mul_i64(n2, d1, n2) || !checked_mul_i64(d1, d2, d)) {
+            return false;
+        }
+        if (is_sub ? !checked_sub_i64(n1, n2, n) : !checked_add_i64(n1, n2, n))
+            return false;
+        if (d == 1)
+            set_small(c, n, 1);
+        else
+            set_small_normalized(c, n, d);
+        return true;
+    }
+
+    /**
+       \brief Store (n1/d1) * (n2/d2) in c. The cross gcds are removed before multiplying. 
+       Return false if a product does not fit in an int64.
+    */
+    bool small_rat_mul(int64 n1, int64 d1, int64 n2, int64 d2, mpq & c) {
+        if (d2 != 1) {
+            int64 g = static_cast<int64>(small_gcd(abs_u64(n1), static_cast<uint64>(d2)));
+            if (g > 1) { n1 /= g; d2 /= g; }
+        }
+        if (d1 != 1) {
+            int64 g = static_cast<int64>(small_gcd(abs_u64(n2), static_cast<uint64>(d1)));
+            if (g > 1) { n2 /= g; d1 /= g; }
+        }
+        int64 n, d;
+        if (!checked_mul_i64(n1, n2, n) || !checked_mul_i64(d1, d2, d))
+            return false;
+        set_small(c, n, n == 0 ? 1 : d);
+        return true;
+    }
+
+    // Fast path for a * b when the numerators and denominators of a and b are small.
+    bool small_rat_mul(mpq const & a, mpq const & b, mpq & c) {
+        if (!is_small(a) || !is_small(b))
+            return false;
+        return small_rat_mul(a.m_num.m_val, a.m_den.m_val, b.m_num.m_val, b.m_den.m_val, c);
+    }
+
+    // Fast path for a / b when the numerators and denominators of a and b are small.
+    bool small_rat_div(mpq const & a, mpq const & b, mpq & c) {
+        if (!is_small(a) || !is_small(b))
+            return false;
+        int64 n2 = b.m_num.m_val, d2 = b.m_den.m_val;
+        SASSERT(n2 != 0);
+        if (n2 < 0) {
+            if (n2 == INT64_MIN)
+                return false;
+            n2 = -n2;
+            d2 = -d2;
+        }
+        return small_rat_mul(a.m_num.m_val, a.m_den.m_val, d2, n2, c);
+    }
+
     void rat_add(mpq const & a, mpq const & b, mpq & c) {
         STRACE("rat_mpq", tout << "[mpq] " << to_string(a) << " + " << to_string(b) << " == ";); 
+        if (small_rat_add(a, b, false, c)) {
+            STRACE("rat_mpq", tout << to_string(c) << "\n";);
+            return;
+        }
         if (SYNCH) {
             mpz tmp1, tmp2;
             mul(a.m_num, b.m_den, tmp1);
@@ -116,6 +209,10 @@ class mpq_manager : public mpz_manager<SYNCH> {
 
     void rat_sub(mpq const & a, mpq const & b, mpq & c) {
         STRACE("rat_mpq", tout << "[mpq] " << to_string(a) << " - " << to_string(b) << " == ";); 
+        if (small_rat_add(a, b, true, c)) {
+            STRACE("rat_mpq", tout << to_string(c) << "\n";);
+            return;
+        }
         if (SYNCH) {
             mpz tmp1, tmp2;
             mul(a.m_num, b.m_den, tmp1);
@@ -138,9 +235,11 @@ class mpq_manager : public mpz_manager<SYNCH> {
 
     void rat_mul(mpq const & a, mpq const & b, mpq & c) {
         STRACE("rat_mpq", tout << "[mpq] " << to_string(a) << " * " << to_string(b) << " == ";); 
-        mul(a.m_num, b.m_num, c.m_num);
-        mul(a.m_den, b.m_den, c.m_den);
-        normalize(c);
+        if (!small_rat_mul(a, b, c)) {
+            mul(a.m_num, b.m_num, c.m_num);
+            mul(a.m_den, b.m_den, c.m_den);
+            normalize(c);
+        }
         STRACE("rat_mpq", tout << to_string(c) << "\n";);
     }
 
@@ -161,7 +260,7 @@ public:
     static bool precise() { return true; }
     static bool field() { return true; }
 
-    mpq_manager();
+    explicit mpq_manager(bool global_cells = false);
 
     ~mpq_manager();
 
@@ -455,6 +554,10 @@ public:
 
     void div(mpq const & a, mpq const & b, mpq & c) {
         STRACE("mpq", tout << "[mpq] " << to_string(a) << " / " << to_string(b) << " == ";); 
+        if (small_rat_div(a, b, c)) {
+            STRACE("mpq", tout << to_string(c) << "\n";);
+            return;
+        }
         if (&b == &c) {
             mpz tmp; // it is not safe to use c.m_num at this point.
             mul(a.m_num, b.m_den, tmp);
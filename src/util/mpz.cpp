@@ -83,9 +83,16 @@ static T gcd_core(T u, T v) {
 unsigned u_gcd(unsigned u, unsigned v) { return gcd_core(u, v); }
 uint64 u64_gcd(uint64 u, uint64 v) { return gcd_core(u, v); }
 
+static unsigned hash_i64(int64 v) {
+    if (is_i32(v))
+        return static_cast<unsigned>(v);
+    return hash_ull(static_cast<unsigned long long>(v));
+}
+
 template<bool SYNCH>
-mpz_manager<SYNCH>::mpz_manager():
-    m_allocator("mpz_manager") {
+mpz_manager<SYNCH>::mpz_manager(bool global_cells):
+    m_allocator("mpz_manager"),
+    m_global_cells(global_cells) {
     if (SYNCH)
         omp_init_nest_lock(&m_lock);
 #ifndef _MP_GMP
@@ -101,7 +108,6 @@ mpz_manager<SYNCH>::mpz_manager():
         m_arg[i] = allocate(m_init_cell_capacity);
         m_arg[i]->m_size = 1;
     }
-    set(m_int_min, -static_cast<int64>(INT_MIN));
 #else
     // GMP
     mpz_init(m_tmp);
@@ -142,7 +148,6 @@ template<bool SYNCH>
 mpz_manager<SYNCH>::~mpz_manager() {
     del(m_two64);
 #ifndef _MP_GMP
-    del(m_int_min);
     for (unsigned i = 0; i < 2; i++) {
         deallocate(m_tmp[i]);
         deallocate(m_arg[i]);
@@ -161,56 +166,6 @@ mpz_manager<SYNCH>::~mpz_manager() {
         omp_destroy_nest_lock(&m_lock);
 }
 
-template<bool SYNCH>
-void mpz_manager<SYNCH>::set_big_i64(mpz & c, int64 v) {
-#ifndef _MP_GMP
-    if (is_small(c)) {
-        c.m_ptr = allocate(m_init_cell_capacity);
-    }
-    SASSERT(capacity(c) >= m_init_cell_capacity);
-    uint64 _v;
-    if (v < 0) {
-        _v = -v;
-        c.m_val = -1;
-    }
-    else {
-        _v = v;
-        c.m_val = 1;
-    }
-    if (sizeof(digit_t) == sizeof(uint64)) {
-        // 64-bit machine
-        digits(c)[0] = static_cast<digit_t>(_v);
-        c.m_ptr->m_size = 1;
-    }
-    else {
-        // 32-bit machine
-        digits(c)[0] = static_cast<unsigned>(_v);
-        digits(c)[1] = static_cast<unsigned>(_v >> 32);
-        c.m_ptr->m_size = digits(c)[1] == 0 ? 1 : 2;
-    }
-#else
-    if (is_small(c)) {
-        c.m_ptr = allocate();
-    }
-    uint64 _v;
-    bool sign;
-    if (v < 0) {
-        _v   = -v;
-        sign = true;
-    }
-    else {
-        _v   = v;
-        sign = false;
-    }
-    mpz_set_ui(*c.m_ptr, static_cast<unsigned>(_v));
-    mpz_set_ui(m_tmp,    static_cast<unsigned>(_v >> 32));
-    mpz_mul(m_tmp, m_tmp, m_two32);
-    mpz_add(*c.m_ptr, *c.m_ptr, m_tmp);
-    if (sign)
-        mpz_neg(*c.m_ptr, *c.m_ptr);
-#endif
-}
-
 template<bool SYNCH>
 void mpz_manager<SYNCH>::set_big_ui64(mpz & c, uint64 v) {
 #ifndef _MP_GMP
@@ -264,10 +219,11 @@ void mpz_manager<SYNCH>::set(mpz & a, int sign, unsigned sz) {
         return;
     }
     
-    if (i == 1 && m_tmp[IDX]->m_digits[0] <= INT_MAX) {
+    int64 v;
+    if (to_i64(sign, i, m_tmp[IDX]->m_digits, v)) {
         // m_tmp[IDX] fits is a fixnum
         del(a);
-        a.m_val = sign < 0 ? -static_cast<int>(m_tmp[IDX]->m_digits[0]) : static_cast<int>(m_tmp[IDX]->m_digits[0]);
+        a.m_val = v;
         return;
     }
 
@@ -311,6 +267,10 @@ void mpz_manager<SYNCH>::set(mpz & target, unsigned sz, digit_t const * digits)
         reset(target);
     else if (sz == 1)
         set(target, digits[0]);
+#ifndef _MP_GMP
+    else if (sz == 2 && sizeof(digit_t) < sizeof(uint64) && digits[1] <= static_cast<digit_t>(INT_MAX))
+        set(target, static_cast<int64>(static_cast<uint64>(digits[0]) | (static_cast<uint64>(digits[1]) << 32)));
+#endif
     else {
 #ifndef _MP_GMP
         target.m_val = 1; // number is positive.
@@ -573,14 +533,9 @@ void mpz_manager<SYNCH>::big_rem(mpz const & a, mpz const & b, mpz & c) {
 template<bool SYNCH>
 void mpz_manager<SYNCH>::gcd(mpz const & a, mpz const & b, mpz & c) {
     if (is_small(a) && is_small(b)) {
-        int _a = a.m_val;
-        int _b = b.m_val;
-        if (_a < 0) _a = -_a;
-        if (_b < 0) _b = -_b;
-        unsigned r = u_gcd(_a, _b);
-        // Remark: r is (INT_MAX + 1)
-        // If a == b == INT_MIN
-        set(c, r);
+        // Remark: r is (INT64_MAX + 1)
+        // If a == b == INT64_MIN
+        set(c, small_gcd(abs_u64(a.m_val), abs_u64(b.m_val)));
     }
     else {
 #ifdef _MP_GMP
@@ -753,8 +708,7 @@ void mpz_manager<SYNCH>::gcd(mpz const & a, mpz const & b, mpz & c) {
             SASSERT(ge(a1, b1));
             if (is_small(b1)) {
                 if (is_small(a1)) {
-                    unsigned r = u_gcd(a1.m_val, b1.m_val);
-                    set(c, r);
+                    set(c, small_gcd(a1.m_val, b1.m_val));
                     break;
                 }
                 else {
@@ -1456,9 +1410,14 @@ std::string mpz_manager<SYNCH>::to_string(mpz const & a) const {
 
 template<bool SYNCH>
 unsigned mpz_manager<SYNCH>::hash(mpz const & a) {
+    // Remark: numbers that fit in an int64 have the same hash code
+    // independently of their representation.
     if (is_small(a))
-        return a.m_val;
+        return hash_i64(a.m_val);
 #ifndef _MP_GMP
+    int64 v;
+    if (to_i64(static_cast<int>(a.m_val), size(a), digits(a), v))
+        return hash_i64(v);
     unsigned sz = size(a);
     if (sz == 1)
         return static_cast<unsigned>(digits(a)[0]);
@@ -1480,9 +1439,9 @@ void mpz_manager<SYNCH>::power(mpz const & a, unsigned p, mpz & b) {
 #ifndef _MP_GMP
     if (is_small(a)) {
         if (a.m_val == 2) {
-            if (p < 8 * sizeof(int) - 1) {
+            if (p < 8 * sizeof(int64) - 1) {
                 del(b);
-                b.m_val = 1 << p;
+                b.m_val = static_cast<int64>(1) << p;
             }
             else {
                 unsigned sz    = p/(8 * sizeof(digit_t)) + 1;
@@ -1534,8 +1493,9 @@ bool mpz_manager<SYNCH>::is_power_of_two(mpz const & a, unsigned & shift) {
     if (is_nonpos(a))
         return false;
     if (is_small(a)) {
-        if (::is_power_of_two(a.m_val)) {
-            shift = ::log2((unsigned)a.m_val);
+        uint64 v = static_cast<uint64>(a.m_val);
+        if (!(v & (v - 1))) {
+            shift = uint64_log2(v);
             return true;
         }
         else {
@@ -1580,22 +1540,13 @@ void mpz_manager<SYNCH>::ensure_capacity(mpz & a, unsigned capacity) {
     if (is_small(a)) {
         a.m_ptr = allocate(capacity);
         SASSERT(a.m_ptr->m_capacity == capacity);
-        if (a.m_val == INT_MIN) {
-            unsigned intmin_sz = m_int_min.m_ptr->m_size;
-            for (unsigned i = 0; i < intmin_sz; i++)
-                a.m_ptr->m_digits[i] = m_int_min.m_ptr->m_digits[i];
-            a.m_val = -1;
-            a.m_ptr->m_size = m_int_min.m_ptr->m_size;
-        }
-        else if (a.m_val < 0) {
-            a.m_ptr->m_digits[0] = -a.m_val;
-            a.m_val = -1;
-            a.m_ptr->m_size = 1;
-        }
-        else {
-            a.m_ptr->m_digits[0] =  a.m_val;
-            a.m_val = 1;
-            a.m_ptr->m_size = 1;
+        uint64 v = abs_u64(a.m_val);
+        a.m_val  = a.m_val < 0 ? -1 : 1;
+        a.m_ptr->m_digits[0] = static_cast<digit_t>(v);
+        a.m_ptr->m_size = 1;
+        if (sizeof(digit_t) < sizeof(uint64) && (v >> 32) != 0) {
+            a.m_ptr->m_digits[1] = static_cast<digit_t>(v >> 32);
+            a.m_ptr->m_size = 2;
         }
     }
     else {
@@ -1628,9 +1579,9 @@ void mpz_manager<SYNCH>::normalize(mpz & a) {
         return;
     }
     
-    if (i == 1 && ds[0] <= INT_MAX) {
+    int64 val;
+    if (to_i64(a.m_val < 0 ? -1 : 1, i, ds, val)) {
         // a is small
-        int val = a.m_val < 0 ? -static_cast<int>(ds[0]) : static_cast<int>(ds[0]);
         del(a);
         a.m_val = val;
         return;
@@ -1645,8 +1596,8 @@ void mpz_manager<SYNCH>::machine_div2k(mpz & a, unsigned k) {
     if (k == 0 || is_zero(a))
         return;
     if (is_small(a)) {
-        if (k < 32) {
-            int twok = 1 << k;
+        if (k < 63) {
+            int64 twok = static_cast<int64>(1) << k;
             a.m_val /= twok;
         }
         else {
@@ -1714,15 +1665,16 @@ template<bool SYNCH>
 void mpz_manager<SYNCH>::mul2k(mpz & a, unsigned k) {
     if (k == 0 || is_zero(a))
         return;
-    if (is_small(a) && k < 32) {
-        set_i64(a, i64(a) * (static_cast<int64>(1) << k));
+    int64 r;
+    if (is_small(a) && k < 62 && checked_mul_i64(i64(a), static_cast<int64>(1) << k, r)) {
+        set_i64(a, r);
         return;
     }
 #ifndef _MP_GMP
     TRACE("mpz_mul2k", tout << "mul2k\na: " << to_string(a) << "\nk: " << k << "\n";);
     unsigned word_shift  = k / (8 * sizeof(digit_t));
     unsigned bit_shift   = k % (8 * sizeof(digit_t));
-    unsigned old_sz      = is_small(a) ? 1 : a.m_ptr->m_size;
+    unsigned old_sz      = is_small(a) ? sizeof(uint64) / sizeof(digit_t) : a.m_ptr->m_size;
     unsigned new_sz      = old_sz + word_shift + 1;
     ensure_capacity(a, new_sz);
     TRACE("mpz_mul2k", tout << "word_shift: " << word_shift << "\nbit_shift: " << bit_shift << "\nold_sz: " << old_sz << "\nnew_sz: " << new_sz 
@@ -1782,7 +1734,11 @@ unsigned mpz_manager<SYNCH>::power_of_two_multiple(mpz const & a) {
         return 0;
     if (is_small(a)) {
         unsigned r = 0;
-        int v      = a.m_val;
+        int64 v    = a.m_val;
+        if (v % (static_cast<int64>(1) << 32) == 0) {
+            r += 32;
+            v /= (static_cast<int64>(1) << 32);
+        }
 #define COUNT_DIGIT_RIGHT_ZEROS()               \
         if (v % (1 << 16) == 0) {               \
             r += 16;                            \
@@ -1838,7 +1794,7 @@ unsigned mpz_manager<SYNCH>::log2(mpz const & a) {
     if (is_nonpos(a))
         return 0;
     if (is_small(a))
-        return ::log2((unsigned)a.m_val);
+        return uint64_log2(static_cast<uint64>(a.m_val));
 #ifndef _MP_GMP
     COMPILE_TIME_ASSERT(sizeof(digit_t) == 8 || sizeof(digit_t) == 4);
     mpz_cell * c     = a.m_ptr;
@@ -1860,7 +1816,7 @@ unsigned mpz_manager<SYNCH>::mlog2(mpz const & a) {
     if (is_nonneg(a))
         return 0;
     if (is_small(a))
-        return ::log2((unsigned)-a.m_val);
+        return uint64_log2(abs_u64(a.m_val));
 #ifndef _MP_GMP
     COMPILE_TIME_ASSERT(sizeof(digit_t) == 8 || sizeof(digit_t) == 4);
     mpz_cell * c     = a.m_ptr;
@@ -2037,14 +1993,11 @@ template<bool SYNCH>
 bool mpz_manager<SYNCH>::decompose(mpz const & a, svector<digit_t> & digits) {
     digits.reset();
     if (is_small(a)) {
-        if (a.m_val < 0) {
-            digits.push_back(-a.m_val);
-            return true;
-        }
-        else {
-            digits.push_back(a.m_val);
-            return false;
-        }
+        uint64 v = abs_u64(a.m_val);
+        digits.push_back(static_cast<digit_t>(v));
+        if (sizeof(digit_t) < sizeof(uint64) && (v >> 32) != 0)
+            digits.push_back(static_cast<digit_t>(v >> 32));
+        return a.m_val < 0;
     }
     else {
 #ifndef _MP_GMP
@@ -28,9 +28,60 @@ Revision History:
 #include"scoped_numeral_vector.h"
 #include"z3_omp.h"
 
+#if defined(_MSC_VER) && defined(_M_X64)
+#include<intrin.h>
+#pragma intrinsic(_mul128)
+#endif
+
 unsigned u_gcd(unsigned u, unsigned v);
 uint64 u64_gcd(uint64 u, uint64 v);
 
+// Overflow-checked int64 arithmetic. 
+// The functions return false if the result does not fit in an int64.
+
+inline bool checked_add_i64(int64 a, int64 b, int64 & r) {
+    r = static_cast<int64>(static_cast<uint64>(a) + static_cast<uint64>(b));
+    // overflow iff a and b have the same sign, and r has a different one.
+    return ((a ^ r) & (b ^ r)) >= 0;
+}
+
+inline bool checked_sub_i64(int64 a, int64 b, int64 & r) {
+    r = static_cast<int64>(static_cast<uint64>(a) - static_cast<uint64>(b));
+    // overflow iff a and b have different signs, and r and a have different signs.
+    return ((a ^ b) & (a ^ r)) >= 0;
+}
+
+inline bool is_i32(int64 a) { return a == static_cast<int64>(static_cast<int>(a)); }
+
+inline bool checked_mul_i64(int64 a, int64 b, int64 & r) {
+    if (is_i32(a) && is_i32(b)) {
+        r = a * b;
+        return true;
+    }
+#if defined(__SIZEOF_INT128__)
+    // 128-bit intermediate result
+    __int128 p = static_cast<__int128>(a) * static_cast<__int128>(b);
+    r = static_cast<int64>(p);
+    return p == static_cast<__int128>(r);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    int64 hi;
+    r = _mul128(a, b, &hi);
+    return hi == (r >> 63);
+#else
+    return false;
+#endif
+}
+
+// Return |a| as an uint64. It works for INT64_MIN.
+inline uint64 abs_u64(int64 a) { return a < 0 ? 0 - static_cast<uint64>(a) : static_cast<uint64>(a); }
+
+// gcd of two uint64, using 32-bit divisions whenever possible.
+inline uint64 small_gcd(uint64 u, uint64 v) { 
+    if (u <= UINT_MAX && v <= UINT_MAX)
+        return u_gcd(static_cast<unsigned>(u), static_cast<unsigned>(v));
+    return u64_gcd(u, v);
+}
+
 #ifdef _MP_GMP
 typedef unsigned digit_t;
 #endif
@@ -74,9 +125,12 @@ class mpz_cell {
    If m_ptr == 0, the it is a small number and the value is stored at m_val.
    Otherwise, m_val contains the sign (-1 negative, 1 positive), and m_ptr points to a mpz_cell that
    store the value. <<< This last statement is true only in Windows.
+
+   Any value that fits in an int64 is stored as a small number. Thus, the common
+   cases (e.g., the products of two 32-bit numbers) do not use the allocator.
 */
 class mpz {
-    int        m_val; 
+    int64      m_val; 
 #ifndef _MP_GMP
     mpz_cell * m_ptr;
 #else
@@ -104,6 +158,10 @@ inline void swap(mpz & m1, mpz & m2) { m1.swap(m2); }
 template<bool SYNCH = true>
 class mpz_manager {
     small_object_allocator  m_allocator;
+    // If true, cells are allocated using memory::allocate instead of m_allocator.
+    // Then, a cell can be deleted by any manager created in this mode, even
+    // after the manager that allocated it was destroyed.
+    bool                    m_global_cells;
     omp_nest_lock_t         m_lock;
 #define MPZ_BEGIN_CRITICAL() if (SYNCH) omp_set_nest_lock(&m_lock);
 #define MPZ_END_CRITICAL()   if (SYNCH) omp_unset_nest_lock(&m_lock);
@@ -112,13 +170,16 @@ class mpz_manager {
     unsigned                m_init_cell_capacity;
     mpz_cell *              m_tmp[2];
     mpz_cell *              m_arg[2];
-    mpz                     m_int_min;
     
     static unsigned cell_size(unsigned capacity) { return sizeof(mpz_cell) + sizeof(digit_t) * capacity; }
 
     mpz_cell * allocate(unsigned capacity) {
         SASSERT(capacity >= m_init_cell_capacity);
-        mpz_cell * cell  = reinterpret_cast<mpz_cell *>(m_allocator.allocate(cell_size(capacity)));
+        mpz_cell * cell;
+        if (m_global_cells)
+            cell = reinterpret_cast<mpz_cell *>(memory::allocate(cell_size(capacity)));
+        else
+            cell = reinterpret_cast<mpz_cell *>(m_allocator.allocate(cell_size(capacity)));
         cell->m_capacity = capacity;
         return cell;
     }
@@ -141,7 +202,10 @@ class mpz_manager {
     }
 
     void deallocate(mpz_cell * ptr) { 
-        m_allocator.deallocate(cell_size(ptr->m_capacity), ptr); 
+        if (m_global_cells)
+            memory::deallocate(ptr);
+        else
+            m_allocator.deallocate(cell_size(ptr->m_capacity), ptr); 
     }
 
     /**
@@ -161,6 +225,24 @@ class mpz_manager {
     void ensure_capacity(mpz & a, unsigned sz);
 
     void normalize(mpz & a);
+
+    /**
+       \brief Return true if the number with the given sign and absolute value 
+       stored in the sz digits \c ds fits in an int64. If that is the case, store it in \c r.
+    */
+    static bool to_i64(int sign, unsigned sz, digit_t const * ds, int64 & r) {
+        uint64 v;
+        if (sz == 1)
+            v = ds[0];
+        else if (sz == 2 && sizeof(digit_t) < sizeof(uint64))
+            v = static_cast<uint64>(ds[0]) | (static_cast<uint64>(ds[1]) << (4 * sizeof(digit_t)) << (4 * sizeof(digit_t)));
+        else
+            return false;
+        if (v > static_cast<uint64>(INT64_MAX) && (sign > 0 || v != static_cast<uint64>(INT64_MAX) + 1))
+            return false;
+        r = sign < 0 ? static_cast<int64>(0 - v) : static_cast<int64>(v);
+        return true;
+    }
 #else
     // GMP code
     mpz_t     m_tmp, m_tmp2;
@@ -171,12 +253,22 @@ class mpz_manager {
     mpz_t     m_int64_min;
 
     mpz_t * allocate() {
-        mpz_t * cell = reinterpret_cast<mpz_t*>(m_allocator.allocate(sizeof(mpz_t)));
+        mpz_t * cell;
+        if (m_global_cells)
+            cell = reinterpret_cast<mpz_t*>(memory::allocate(sizeof(mpz_t)));
+        else
+            cell = reinterpret_cast<mpz_t*>(m_allocator.allocate(sizeof(mpz_t)));
         mpz_init(*cell);
         return cell;
     }
 
-    void deallocate(mpz_t * ptr) { mpz_clear(*ptr); m_allocator.deallocate(sizeof(mpz_t), ptr); }
+    void deallocate(mpz_t * ptr) { 
+        mpz_clear(*ptr); 
+        if (m_global_cells)
+            memory::deallocate(ptr);
+        else
+            m_allocator.deallocate(sizeof(mpz_t), ptr); 
+    }
 #endif
     mpz                     m_two64;
 
@@ -187,20 +279,11 @@ class mpz_manager {
     template<int IDX>
     void set(mpz & a, int sign, unsigned sz);
 
-    static int64 i64(mpz const & a) { return static_cast<int64>(a.m_val); }
-
-    void set_big_i64(mpz & c, int64 v);
+    static int64 i64(mpz const & a) { return a.m_val; }
 
     void set_i64(mpz & c, int64 v) { 
-        if (v >= INT_MIN && v <= INT_MAX) {
-            del(c);
-            c.m_val = static_cast<int>(v); 
-        }
-        else {
-            MPZ_BEGIN_CRITICAL();
-            set_big_i64(c, v);
-            MPZ_END_CRITICAL();
-        }
+        del(c);
+        c.m_val = v; 
     }
 
     void set_big_ui64(mpz & c, uint64 v);
@@ -239,36 +322,43 @@ class mpz_manager {
     template<int IDX>
     void get_sign_cell(mpz const & a, int & sign, mpz_cell * & cell) {
         if (is_small(a)) {
-            if (a.m_val == INT_MIN) {
-                sign = -1;
-                cell = m_int_min.m_ptr;
+            cell = m_arg[IDX];
+            sign = a.m_val < 0 ? -1 : 1;
+            uint64 v = abs_u64(a.m_val);
+            if (sizeof(digit_t) == sizeof(uint64)) {
+                cell->m_digits[0] = static_cast<digit_t>(v);
+                cell->m_size      = 1;
             }
             else {
-                cell = m_arg[IDX];
-                SASSERT(cell->m_size == 1);
-                if (a.m_val < 0) {
-                    sign = -1;
-                    cell->m_digits[0] = -a.m_val;
-                }
-                else {
-                    sign = 1;
-                    cell->m_digits[0] = a.m_val;
-                }
+                cell->m_digits[0] = static_cast<digit_t>(v);
+                cell->m_digits[1] = static_cast<digit_t>(v >> 32);
+                cell->m_size      = cell->m_digits[1] == 0 ? 1 : 2;
             }
         }
         else {
-            sign = a.m_val;
+            sign = static_cast<int>(a.m_val);
             cell = a.m_ptr;
         }
     }
 #else
     // GMP code
 
+    static void set_i64(mpz_t & r, int64 v) {
+        if (sizeof(long) >= sizeof(int64) || is_i32(v)) {
+            mpz_set_si(r, static_cast<long>(v));
+        }
+        else {
+            mpz_set_si(r, static_cast<long>(v >> 32));
+            mpz_mul_2exp(r, r, 32);
+            mpz_add_ui(r, r, static_cast<unsigned long>(v & 0xFFFFFFFF));
+        }
+    }
+
     template<int IDX>
     void get_arg(mpz const & a, mpz_t * & result) {
         if (is_small(a)) {
             result = m_arg[IDX];
-            mpz_set_si(*result, a.m_val);
+            set_i64(*result, a.m_val);
         }
         else {
             result = a.m_ptr;
@@ -324,7 +414,12 @@ public:
 
     typedef mpz numeral;
 
-    mpz_manager();
+    /**
+       \brief If \c global_cells is true, big numbers are allocated using memory::allocate.
+       Unsynchronized managers created in this mode can be used by different threads
+       (one manager per thread) to manipulate the same numbers.
+    */
+    explicit mpz_manager(bool global_cells = false);
 
     ~mpz_manager();
 
@@ -343,8 +438,9 @@ public:
     
     void add(mpz const & a, mpz const & b, mpz & c) {
         STRACE("mpz", tout << "[mpz] " << to_string(a) << " + " << to_string(b) << " == ";); 
-        if (is_small(a) && is_small(b)) {
-            set_i64(c, i64(a) + i64(b));
+        int64 r;
+        if (is_small(a) && is_small(b) && checked_add_i64(a.m_val, b.m_val, r)) {
+            set_i64(c, r);
         }
         else {
             MPZ_BEGIN_CRITICAL();
@@ -356,8 +452,9 @@ public:
 
     void sub(mpz const & a, mpz const & b, mpz & c) {
         STRACE("mpz", tout << "[mpz] " << to_string(a) << " - " << to_string(b) << " == ";); 
-        if (is_small(a) && is_small(b)) {
-            set_i64(c, i64(a) - i64(b));
+        int64 r;
+        if (is_small(a) && is_small(b) && checked_sub_i64(a.m_val, b.m_val, r)) {
+            set_i64(c, r);
         }
         else {
             MPZ_BEGIN_CRITICAL();
@@ -373,8 +470,9 @@ public:
 
     void mul(mpz const & a, mpz const & b, mpz & c) {
         STRACE("mpz", tout << "[mpz] " << to_string(a) << " * " << to_string(b) << " == ";); 
-        if (is_small(a) && is_small(b)) {
-            set_i64(c, i64(a) * i64(b));
+        int64 r;
+        if (is_small(a) && is_small(b) && checked_mul_i64(a.m_val, b.m_val, r)) {
+            set_i64(c, r);
         }
         else {
             MPZ_BEGIN_CRITICAL();
@@ -418,9 +516,12 @@ public:
     }
 
 
+    // INT64_MIN / -1 is not a small number
+    static bool div_overflow(mpz const & a, mpz const & b) { return a.m_val == INT64_MIN && b.m_val == -1; }
+
     void machine_div_rem(mpz const & a, mpz const & b, mpz & q, mpz & r) {
         STRACE("mpz", tout << "[mpz-ext] divrem(" << to_string(a) << ",  " << to_string(b) << ") == ";); 
-        if (is_small(a) && is_small(b)) {
+        if (is_small(a) && is_small(b) && !div_overflow(a, b)) {
             int64 _a = i64(a);
             int64 _b = i64(b);
             set_i64(q, _a / _b);
@@ -436,7 +537,7 @@ public:
 
     void machine_div(mpz const & a, mpz const & b, mpz & c) {
         STRACE("mpz", tout << "[mpz-ext] machine-div(" << to_string(a) << ",  " << to_string(b) << ") == ";); 
-        if (is_small(a) && is_small(b)) {
+        if (is_small(a) && is_small(b) && !div_overflow(a, b)) {
             set_i64(c, i64(a) / i64(b));
         }
         else {
@@ -449,7 +550,7 @@ public:
 
     void rem(mpz const & a, mpz const & b, mpz & c) {
         STRACE("mpz", tout << "[mpz-ext] rem(" << to_string(a) << ",  " << to_string(b) << ") == ";); 
-        if (is_small(a) && is_small(b)) {
+        if (is_small(a) && is_small(b) && !div_overflow(a, b)) {
             set_i64(c, i64(a) % i64(b));
         }
         else {
@@ -493,9 +594,11 @@ public:
 
     void neg(mpz & a) {
         STRACE("mpz", tout << "[mpz] 0 - " << to_string(a) << " == ";); 
-        if (is_small(a) && a.m_val == INT_MIN) {
-            // neg(INT_MIN) is not a small int
-            set_big_i64(a, - static_cast<long long>(INT_MIN)); 
+        if (is_small(a) && a.m_val == INT64_MIN) {
+            // neg(INT64_MIN) is not a small int
+            MPZ_BEGIN_CRITICAL();
+            set_big_ui64(a, abs_u64(INT64_MIN)); 
+            MPZ_END_CRITICAL();
             return;
         }
 #ifndef _MP_GMP
@@ -514,9 +617,11 @@ public:
     void abs(mpz & a) {
         if (is_small(a)) {
             if (a.m_val < 0) {
-                if (a.m_val == INT_MIN) {
-                    // abs(INT_MIN) is not a small int
-                    set_big_i64(a, - static_cast<long long>(INT_MIN)); 
+                if (a.m_val == INT64_MIN) {
+                    // abs(INT64_MIN) is not a small int
+                    MPZ_BEGIN_CRITICAL();
+                    set_big_ui64(a, abs_u64(INT64_MIN)); 
+                    MPZ_END_CRITICAL();
                 }
                 else
                     a.m_val = -a.m_val;
@@ -566,10 +671,10 @@ public:
 
     static int sign(mpz const & a) {
 #ifndef _MP_GMP
-        return a.m_val;
+        return a.m_val < 0 ? -1 : (a.m_val > 0 ? 1 : 0);
 #else
         if (is_small(a))
-            return a.m_val;
+            return a.m_val < 0 ? -1 : (a.m_val > 0 ? 1 : 0);
         else
             return mpz_sgn(*a.m_ptr);
 #endif
@@ -659,10 +764,8 @@ public:
     }
 
     void set(mpz & a, unsigned val) {
-        if (val <= INT_MAX)
-            set(a, static_cast<int>(val));
-        else
-            set(a, static_cast<int64>(static_cast<uint64>(val)));
+        del(a);
+        a.m_val = val;
     }
 
     void set(mpz & a, char const * val);
@@ -672,9 +775,9 @@ public:
     }
 
     void set(mpz & a, uint64 val) {
-        if (val < INT_MAX) {
+        if (val <= static_cast<uint64>(INT64_MAX)) {
             del(a);
-            a.m_val = static_cast<int>(val);
+            a.m_val = static_cast<int64>(val);
         }
         else {
             MPZ_BEGIN_CRITICAL();
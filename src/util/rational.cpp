@@ -23,7 +23,84 @@ Revision History:
 #include<strsafe.h>
 #endif
 
+#ifdef _RATIONAL_THREAD_LOCAL
+#ifdef _WINDOWS
+__declspec(thread) unsynch_mpq_manager * rational::g_mpq_manager = 0;
+#else
+#include<pthread.h>
+__thread unsynch_mpq_manager * rational::g_mpq_manager = 0;
+#endif
+
+// Managers created by rational::mk_thread_manager.
+// The list is a POD, since managers may be created during static initialization.
+struct thread_mpq_manager : public unsynch_mpq_manager {
+    thread_mpq_manager * m_next;
+    thread_mpq_manager():unsynch_mpq_manager(true), m_next(0) {}
+};
+static thread_mpq_manager * g_thread_mpq_managers = 0;
+
+// Remove m from g_thread_mpq_managers and delete it.
+// Do nothing if m was already deleted by rational::finalize.
+static void del_thread_mpq_manager(thread_mpq_manager * m) {
+    bool found = false;
+    #pragma omp critical (rational_managers)
+    {
+        thread_mpq_manager ** curr = &g_thread_mpq_managers;
+        while (*curr != 0 && *curr != m)
+            curr = &((*curr)->m_next);
+        if (*curr == m) {
+            *curr = m->m_next;
+            found = true;
+        }
+    }
+    if (found)
+        dealloc(m);
+}
+
+#ifndef _WINDOWS
+static pthread_key_t  g_thread_mpq_manager_key;
+static pthread_once_t g_thread_mpq_manager_key_once = PTHREAD_ONCE_INIT;
+
+static void thread_mpq_manager_destructor(void *) {
+    rational::finalize_thread();
+}
+
+static void thread_mpq_manager_mk_key() {
+    pthread_key_create(&g_thread_mpq_manager_key, thread_mpq_manager_destructor);
+}
+#endif
+
+rational::manager & rational::mk_thread_manager() {
+    SASSERT(g_mpq_manager == 0);
+    thread_mpq_manager * r = alloc(thread_mpq_manager);
+    #pragma omp critical (rational_managers)
+    {
+        r->m_next = g_thread_mpq_managers;
+        g_thread_mpq_managers = r;
+    }
+#ifndef _WINDOWS
+    // Make sure the manager is deleted when the current thread terminates.
+    // There is no such hook for __declspec(thread), then the managers of 
+    // terminated threads are only deleted by rational::finalize.
+    pthread_once(&g_thread_mpq_manager_key_once, thread_mpq_manager_mk_key);
+    pthread_setspecific(g_thread_mpq_manager_key, r);
+#endif
+    g_mpq_manager = r;
+    return *r;
+}
+
+void rational::finalize_thread() {
+    if (g_mpq_manager != 0) {
+        del_thread_mpq_manager(static_cast<thread_mpq_manager*>(g_mpq_manager));
+        g_mpq_manager = 0;
+    }
+}
+#else
 synch_mpq_manager *  rational::g_mpq_manager = 0;
+
+void rational::finalize_thread() {
+}
+#endif
 rational             rational::m_zero(0);
 rational             rational::m_one(1);
 rational             rational::m_minus_one(-1);
@@ -54,14 +131,24 @@ rational rational::power_of_two(unsigned k) {
 }
 
 void rational::initialize() {
+#ifndef _RATIONAL_THREAD_LOCAL
     if (!g_mpq_manager) {
         g_mpq_manager = alloc(synch_mpq_manager);
     }
+#endif
 }
 
 void rational::finalize() {
     m_powers_of_two.finalize();
+#ifdef _RATIONAL_THREAD_LOCAL
+    // The managers of threads that are still alive are also deleted.
+    // So, other threads must not use rational numbers after this point.
+    g_mpq_manager = 0;
+    while (g_thread_mpq_managers != 0)
+        del_thread_mpq_manager(g_thread_mpq_managers);
+#else
     dealloc(g_mpq_manager);
     g_mpq_manager = 0;
+#endif
 }
 
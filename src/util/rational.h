@@ -21,15 +21,38 @@ Revision History:
 
 #include"mpq.h"
 
+#if defined(_WINDOWS) || defined(_USE_THREAD_LOCAL)
+// Each thread uses its own unsynchronized manager, instead of sharing 
+// a synchronized one. The managers allocate big numbers using memory::allocate,
+// so a number created by one thread can be updated and deleted by another.
+#define _RATIONAL_THREAD_LOCAL
+#endif
+
 class rational {
     mpq   m_val;
     static rational                  m_zero;
     static rational                  m_one;
     static rational                  m_minus_one;
     static vector<rational>          m_powers_of_two;
-    static synch_mpq_manager *       g_mpq_manager;
+#ifdef _RATIONAL_THREAD_LOCAL
+    typedef unsynch_mpq_manager      manager;
+#ifdef _WINDOWS
+    static __declspec(thread) manager * g_mpq_manager;
+#else
+    static __thread manager *        g_mpq_manager;
+#endif
+    static manager & mk_thread_manager();
+
+    static manager & m() { 
+        manager * r = g_mpq_manager;
+        return r != 0 ? *r : mk_thread_manager(); 
+    }
+#else
+    typedef synch_mpq_manager        manager;
+    static manager *                 g_mpq_manager;
     
-    static synch_mpq_manager & m() { return *g_mpq_manager; }
+    static manager & m() { return *g_mpq_manager; }
+#endif
 
 public:
     static void initialize();
@@ -38,6 +61,13 @@ public:
       ADD_INITIALIZER('rational::initialize();')
       ADD_FINALIZER('rational::finalize();')
     */
+
+    /**
+       \brief Release the resources used by the current thread to manipulate rational numbers.
+       On pthread platforms, this method is automatically invoked when a thread terminates.
+    */
+    static void finalize_thread();
+
     rational() {}
     
     rational(rational const & r) { m().set(m_val, r.m_val); }
@@ -60,7 +90,11 @@ public:
     struct ui64 {};
     rational(uint64 i, ui64) { m().set(m_val, i); }
     
-    ~rational() { m().del(m_val); }
+    ~rational() { 
+        // small numbers do not need the manager
+        if (!manager::is_small(m_val)) 
+            m().del(m_val); 
+    }
     
     mpq const & to_mpq() const { return m_val; }
 
@@ -104,8 +138,7 @@ public:
     }
 
     bool is_int32() const {
-        if (is_small() && is_int()) return true; 
-        // we don't assume that if it is small, then it is int32.
+        // small numbers are int64, not necessarily int32.
         if (!is_int64()) return false;
         int64 v = get_int64();
         return INT_MIN <= v && v <= INT_MAX;
@@ -0,0 +1,49 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    z3_atomic.h
+
+Abstract:
+
+    Wrapper for atomic increment/decrement of counters.
+
+Author:
+
+    agent (agent) 2026-10-16.
+
+Notes:
+
+--*/
+#ifndef _Z3_ATOMIC_H
+#define _Z3_ATOMIC_H
+
+#ifdef _MSC_VER
+#include<intrin.h>
+#pragma intrinsic(_InterlockedIncrement, _InterlockedDecrement)
+
+/**
+   \brief Atomically increment \c v, and return the new value.
+*/
+inline unsigned atomic_inc(unsigned & v) {
+    return static_cast<unsigned>(_InterlockedIncrement(reinterpret_cast<long volatile *>(&v)));
+}
+
+/**
+   \brief Atomically decrement \c v, and return the new value.
+*/
+inline unsigned atomic_dec(unsigned & v) {
+    return static_cast<unsigned>(_InterlockedDecrement(reinterpret_cast<long volatile *>(&v)));
+}
+#else
+inline unsigned atomic_inc(unsigned & v) {
+    return __sync_add_and_fetch(&v, 1u);
+}
+
+inline unsigned atomic_dec(unsigned & v) {
+    return __sync_sub_and_fetch(&v, 1u);
+}
+#endif
+
+#endif